@@ -0,0 +1,391 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Circuits parsed from a private deck, next to the loaded one.
+ *
+ * ckt_reparse_deck() builds a second, independent CKTcircuit from a deck
+ * which has been expanded like ci_deck of a loaded circuit, e.g. a Monte
+ * Carlo trial expanded from ci_mcdeck, where numparam has drawn other
+ * values.  The preprocessing of inpcom.c, numparam and the subcircuit
+ * expansion are not repeated, but the parser passes INPpas1 ... INPpas4,
+ * CKTsetup() and CKTtemp() run again.  A trial can not be a copy of the
+ * loaded circuit made by CKTclone(): numparam evaluates the drawn values
+ * in the expansion, into the lines of instances, models and subcircuit
+ * parameters, and only the parser turns them into parameters of the
+ * devices, with the model binning and the subcircuits they select.
+ * Copies of the loaded circuit itself, with the values changed by alter,
+ * are made by CKTclone().  The circuit parsed here does not see alter
+ * and altermod of the loaded one.
+ *
+ * The second circuit gets the options of the loaded one.  If that one
+ * has a solution and its matrix and state vectors have the same size,
+ * the solution and the states are copied, ckt_reparse_op() then starts
+ * from there.  The deck is freed with the circuit.
+ *
+ * Building and freeing uses the front end (ft_curckt, the model table
+ * modtab, IFnewUid) and has to be done by the main thread.  The circuit
+ * itself is self contained: ckt_reparse_op() may run on several of them
+ * in parallel if ckt_reparse_threadsafe() agrees.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/cpdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteinp.h"
+#include "ngspice/inpdefs.h"
+#include "ngspice/ifsim.h"
+#include "ngspice/smpdefs.h"
+#include "ngspice/sperror.h"
+
+#ifdef XSPICE
+#include "ngspice/mif.h"
+#include "ngspice/evtproto.h"
+#endif
+
+#include "cktreparse.h"
+#include "inp.h"
+#include "spiceif.h"
+#include "variable.h"
+
+extern INPmodel *modtab;
+
+/* The parser adds its messages to card->error.  Put the messages of
+   the expansion aside, so that only the new ones are reported. */
+
+static char **
+reparse_stash_errors(struct card *deck)
+{
+    struct card *c;
+    char **errors;
+    int n = 0;
+
+    for (c = deck; c; c = c->nextcard)
+        n++;
+
+    errors = TMALLOC(char *, n);
+
+    for (n = 0, c = deck; c; c = c->nextcard, n++) {
+        errors[n] = c->error;
+        c->error = NULL;
+    }
+
+    return errors;
+}
+
+
+/* Report the new messages like inp_dodeck() does, and put the old
+   ones back.  Return TRUE if there has been an error. */
+
+static bool
+reparse_restore_errors(struct card *deck, char **errors)
+{
+    struct card *c;
+    bool failed = FALSE;
+    int n;
+
+    for (n = 0, c = deck; c; c = c->nextcard, n++) {
+        if (c->error) {
+            if (!ciprefix(".model", c->line)) {
+                fprintf(cp_err, "Error on line %d or its substitute:\n  %s\n%s\n",
+                        c->linenum_orig, c->line, c->error);
+                failed = TRUE;
+            }
+            tfree(c->error);
+        }
+        c->error = errors[n];
+    }
+
+    tfree(errors);
+    return failed;
+}
+
+
+/* Set the .option values of the source, as inp_dodeck() does */
+
+static void
+reparse_options(CKTcircuit *ckt, struct variable *vars)
+{
+    struct variable *v;
+    bool one = TRUE;
+
+    for (v = vars; v; v = v->va_next)
+        switch (v->va_type) {
+        case CP_BOOL:
+            if_option(ckt, v->va_name, v->va_type, &one);
+            break;
+        case CP_NUM:
+            if_option(ckt, v->va_name, v->va_type, &v->va_num);
+            break;
+        case CP_REAL:
+            if_option(ckt, v->va_name, v->va_type, &v->va_real);
+            break;
+        case CP_STRING:
+            if_option(ckt, v->va_name, v->va_type, v->va_string);
+            break;
+        default:
+            break;
+        }
+}
+
+
+/* Copy the solution and the state vectors of src, if src has a
+   solution and both circuits have the same size */
+
+static bool
+reparse_copy_state(CKTcircuit *ckt, CKTcircuit *src)
+{
+    int i, size;
+
+    if (!src->CKTisSetup || !src->CKTmatrix || !ckt->CKTmatrix)
+        return FALSE;
+
+    size = SMPmatSize(src->CKTmatrix);
+    if (size != SMPmatSize(ckt->CKTmatrix) ||
+        src->CKTnumStates != ckt->CKTnumStates)
+        return FALSE;
+
+    for (i = 1; i <= size; i++)
+        if (src->CKTrhsOld[i] != 0.0)
+            break;
+    if (i > size)
+        return FALSE;
+
+    memcpy(ckt->CKTrhsOld, src->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+
+    for (i = 0; i <= MAX(2, MIN(ckt->CKTmaxOrder, src->CKTmaxOrder)) + 1; i++)
+        if (ckt->CKTstates[i] && src->CKTstates[i])
+            memcpy(ckt->CKTstates[i], src->CKTstates[i],
+                   (size_t) ckt->CKTnumStates * sizeof(double));
+
+    return TRUE;
+}
+
+
+/* Parse deck into a second circuit like ci.  deck becomes part of the
+   result, also on failure. */
+
+struct ckt_reparse *
+ckt_reparse_deck(struct circ *ci, struct card *deck)
+{
+    struct circ *curckt = ft_curckt;
+    struct ckt_reparse *rp;
+    CKTcircuit *ckt;
+    INPtables *tab = NULL;
+    INPtables *symtab;
+    INPmodel *ci_modtab, *cur_modtab;
+    TSKtask *defTask, *curTask;
+    JOB *defOpt, *curOpt;
+    char **errors;
+    bool failed;
+    int error;
+#ifdef XSPICE
+    Mif_Info_t mif = g_mif_info;
+#endif
+
+    if (!ci->ci_ckt || !deck) {
+        fprintf(cp_err, "Error: no circuit to parse again\n");
+        line_free(deck, TRUE);
+        return NULL;
+    }
+
+    /* the parse trees of 'temper' expressions point into ci->ci_ckt */
+    if (ci->devtlist || ci->modtlist) {
+        fprintf(cp_err, "Error: circuits with 'temper' expressions cannot be parsed again\n");
+        line_free(deck, TRUE);
+        return NULL;
+    }
+
+    /* if_inpdeck() enters its tables and tasks into ft_curckt */
+    ft_curckt = ci;
+    symtab = ci->ci_symtab;
+    defTask = ci->ci_defTask;
+    curTask = ci->ci_curTask;
+    defOpt = ci->ci_defOpt;
+    curOpt = ci->ci_curOpt;
+    ci_modtab = ci->ci_modtab;
+    cur_modtab = modtab;
+
+    /* CKTnewTask() would free the task of the source */
+    ci->ci_defTask = NULL;
+
+    errors = reparse_stash_errors(deck);
+
+    ckt = if_inpdeck(deck, &tab);
+
+    rp = TMALLOC(struct ckt_reparse, 1);
+    rp->ckt = ckt;
+    rp->tab = tab;
+    rp->modtab = modtab;
+    rp->task = ci->ci_defTask;
+    rp->deck = deck;
+
+    if (ckt)
+        reparse_options(ckt, ci->ci_vars);
+
+    ci->ci_symtab = symtab;
+    ci->ci_defTask = defTask;
+    ci->ci_curTask = curTask;
+    ci->ci_defOpt = defOpt;
+    ci->ci_curOpt = curOpt;
+    ci->ci_modtab = ci_modtab;
+    modtab = cur_modtab;
+    ft_curckt = curckt;
+
+    failed = reparse_restore_errors(deck, errors);
+
+    if (!ckt) {
+        if (tab)
+            INPtabEnd(tab);
+        line_free(rp->deck, TRUE);
+        tfree(rp);
+#ifdef XSPICE
+        g_mif_info = mif;
+#endif
+        return NULL;
+    }
+
+    ckt->CKTisLinear = ci->ci_ckt->CKTisLinear;
+    ckt->CKTsoaCheck = 0;
+
+    CKTtaskOpts(ckt, rp->task);
+
+    error = failed ? E_PRIVATE : CKTsetup(ckt);
+    if (!error)
+        error = CKTtemp(ckt);
+
+#ifdef XSPICE
+    g_mif_info = mif;
+#endif
+
+    if (error) {
+        if (error != E_PRIVATE)
+            ft_sperror(error, "reparse");
+        ckt_reparse_free(rp);
+        return NULL;
+    }
+
+    rp->warm = reparse_copy_state(ckt, ci->ci_ckt);
+
+    return rp;
+}
+
+
+/* TRUE if ckt_reparse_op() may run on ckt while other threads work on
+   other circuits */
+
+bool
+ckt_reparse_threadsafe(CKTcircuit *ckt)
+{
+    int i;
+
+#ifdef XSPICE
+    /* code models share g_mif_info */
+    if (ckt->CKTadevFlag)
+        return FALSE;
+#endif
+
+    for (i = 0; i < DEVmaxnum; i++)
+        if (ckt->CKThead[i] && (DEVices[i]->DEVpublic.flags & DEV_SHARED))
+            return FALSE;
+
+    return TRUE;
+}
+
+
+/* Operating point of the circuit, the solution is left in CKTrhsOld.
+   No output is written. */
+
+int
+ckt_reparse_op(struct ckt_reparse *rp)
+{
+    CKTcircuit *ckt = rp->ckt;
+
+    /* start from the solution of the source.  The states were computed
+     * with the parameters of the source, so no bypass */
+    if (rp->warm) {
+        int bypass = ckt->CKTbypass;
+        int converged;
+        ckt->CKTmode = MODEDCOP | MODEINITFLOAT;
+        ckt->CKTbypass = 0;
+        converged = NIiter(ckt, ckt->CKTdcMaxIter);
+        ckt->CKTbypass = bypass;
+        if (converged == 0)
+            return OK;
+    }
+
+    return CKTop(ckt, MODEDCOP | MODEINITJCT, MODEDCOP | MODEINITFLOAT,
+                 ckt->CKTdcMaxIter);
+}
+
+
+void
+ckt_reparse_free(struct ckt_reparse *rp)
+{
+    INPmodel *m, *next;
+#ifdef XSPICE
+    Mif_Info_t mif = g_mif_info;
+#endif
+
+    if (!rp)
+        return;
+
+#ifdef XSPICE
+    EVTunsetup(rp->ckt);
+#endif
+
+    ft_sim->deleteTask (rp->ckt, rp->task);
+    if_cktfree(rp->ckt, rp->tab);
+
+    for (m = rp->modtab; m; m = next) {
+        next = m->INPnextModel;
+        tfree(m);
+    }
+
+    line_free(rp->deck, TRUE);
+    tfree(rp);
+
+#ifdef XSPICE
+    g_mif_info = mif;
+#endif
+}
+
+
+/* Equation number of output name in ckt, -1 if there is none */
+
+int
+ckt_reparse_find(CKTcircuit *ckt, const char *name)
+{
+    CKTnode *node;
+
+    if (eq(name, "0") || cieq(name, "gnd"))
+        return 0;
+
+    for (node = ckt->CKTnodes; node; node = node->next)
+        if (node->name && cieq(node->name, name))
+            return node->number;
+
+    return -1;
+}
+
+
+/* The name of output word: v(node) -> node, i(vsrc) -> vsrc#branch */
+
+char *
+ckt_reparse_name(const char *word)
+{
+    size_t len = strlen(word);
+
+    if (len > 3 && word[1] == '(' && word[len - 1] == ')') {
+        if (word[0] == 'v' || word[0] == 'V')
+            return copy_substring(word + 2, word + len - 1);
+        if (word[0] == 'i' || word[0] == 'I')
+            return tprintf("%.*s#branch", (int) (len - 3), word + 2);
+    }
+
+    return copy(word);
+}
@@ -0,0 +1,24 @@
+/*************
+ * Header file for cktreparse.c
+ ************/
+
+#ifndef ngspice_CKTREPARSE_H
+#define ngspice_CKTREPARSE_H
+
+struct ckt_reparse {
+    CKTcircuit *ckt;        /* the private circuit */
+    INPtables *tab;         /* its symbol table */
+    INPmodel *modtab;       /* its model table */
+    TSKtask *task;          /* its options, copied from the source */
+    struct card *deck;      /* its deck */
+    bool warm;              /* solution and states copied from the source */
+};
+
+struct ckt_reparse *ckt_reparse_deck(struct circ *ci, struct card *deck);
+bool ckt_reparse_threadsafe(CKTcircuit *ckt);
+int ckt_reparse_op(struct ckt_reparse *rp);
+void ckt_reparse_free(struct ckt_reparse *rp);
+int ckt_reparse_find(CKTcircuit *ckt, const char *name);
+char *ckt_reparse_name(const char *word);
+
+#endif
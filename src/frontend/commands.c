@@ -67,6 +67,8 @@
 #include "postcoms.h"
 #include "com_option.h"
 #include "inp.h"
+#include "mcrun.h"
+#include "dcrun.h"
 #include "com_dump.h"
 #include "com_fft.h"
 #include "spec.h"
@@ -318,6 +320,13 @@ struct comm spcp_coms[] = {
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, LOTS,
       NULL,
       "[.sp line args] : Do an S-parameter analysis." },
+#ifdef WITH_HB
+/* Harmonic Balance Analysis */
+    { "hb", com_hb, TRUE, TRUE,
+      { 0, 0, 0, 0 }, E_DEFHMASK, 0, LOTS,
+      NULL,
+      "[.hb line args] : Do a harmonic balance analysis." },
+#endif
 #endif
     { "ac", com_ac, TRUE, TRUE,
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, LOTS,
@@ -355,6 +364,14 @@ struct comm spcp_coms[] = {
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, 0,
         NULL,
         ": Re-source the actual circuit deck for MC simulation." },
+    { "mc_run", com_mc_run, TRUE, FALSE,
+      { 0, 0, 0, 0 }, E_DEFHMASK, 1, LOTS,
+      NULL,
+      "trials [output ...] : Monte Carlo trials, .meas results and outputs per trial." } ,
+    { "dc_run", com_dc_run, TRUE, FALSE,
+      { 0, 0, 0, 0 }, E_DEFHMASK, 4, LOTS,
+      NULL,
+      "source start stop step output ... : DC sweep in segments solved in parallel." } ,
     { "dump", com_dump, TRUE, FALSE,
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, 0,
       NULL,
@@ -0,0 +1,405 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * dc_run source start stop step output ...
+ *
+ * DC sweep of one voltage or current source, cut into contiguous
+ * segments which are solved concurrently.  The circuit is set up as for
+ * an analysis, with its options and the values changed by alter and
+ * altermod.  The first segment is then swept on the circuit, every other
+ * one on a copy of it made by CKTclone(), as the points of a .dc sweep
+ * are: every point starts from the solution of the previous one, with
+ * gmin and source stepping as the fallback.  The values of the source are
+ * the ones of the serial sweep, accumulated step by step.
+ *
+ * The first point of the first segment starts from the junction voltages,
+ * like .dc.  The first points of the other segments are seeded by a
+ * coarse serial sweep on one more copy, which visits DC_COARSE points
+ * per segment and so follows the branch taken by the serial sweep, e.g.
+ * through the hysteresis of a latch, at a fraction of its cost.  If the
+ * coarse sweep fails to converge, the segment starts from the junction
+ * voltages.
+ *
+ * There is one segment per thread (option num_threads, 2 if it is not
+ * set).  The copies are made one after the other, the segments are then
+ * swept in parallel.  A circuit with a device which may not be copied
+ * (see DEV_CLONE in devdefs.h) is swept as one segment.  Circuits with
+ * XSPICE code models are refused.  The source is left as it was.
+ *
+ * The results agree with those of .dc within the convergence
+ * tolerances.  They may still differ where the solution jumps between
+ * two coarse points, as the branch is then chosen by the coarse step.
+ *
+ * This is a command of its own and not a mode of DCtrCurv(): a nested
+ * sweep would need its own set of copies per outer value.  Nested .dc
+ * sweeps are sped up by the 'dcseed' option instead, see dctrcurv.c.
+ *
+ * The requested node voltages v(node) and branch currents i(vsource)
+ * are stored into a plot 'dc', with the source value as scale.  Points
+ * which do not converge are set to NaN.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/cpdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/dvec.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteinp.h"
+#include "ngspice/inpdefs.h"
+#include "ngspice/sim.h"
+#include "ngspice/sperror.h"
+
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#include "cktreparse.h"
+#include "dcrun.h"
+#include "../misc/misc_time.h"
+
+/* points per segment of the coarse sweep seeding the segments */
+#define DC_COARSE 8
+
+
+/* The voltage or current source name in ckt, its type in *type */
+
+static GENinstance *
+dc_source(CKTcircuit *ckt, const char *name, int *type)
+{
+    static char *types[] = { "Vsource", "Isource", NULL };
+    GENmodel *model;
+    GENinstance *here;
+    int i;
+
+    for (i = 0; types[i]; i++) {
+        *type = CKTtypelook(types[i]);
+        if (*type < 0)
+            continue;
+        for (model = ckt->CKThead[*type]; model; model = model->GENnextModel)
+            for (here = model->GENinstances; here; here = here->GENnextInstance)
+                if (cieq(here->GENname, name))
+                    return here;
+    }
+
+    return NULL;
+}
+
+
+/* Set the dc value of source here of type */
+
+static int
+dc_set(GENinstance *here, int type, double value)
+{
+    IFparm *p = DEVices[type]->DEVpublic.instanceParms;
+    int n = *(DEVices[type]->DEVpublic.numInstanceParms);
+    IFvalue v;
+    int i;
+
+    for (i = 0; i < n; i++)
+        if (eq(p[i].keyword, "dc")) {
+            v.rValue = value;
+            return DEVices[type]->DEVparam(p[i].id, &v, here, NULL);
+        }
+
+    return E_BADPARM;
+}
+
+
+/* Sweep the source of ckt over values[0 .. n-1], the solution at each
+   point goes to out[j][k] for the equations index[j].  The first point
+   starts from the solution in the circuit if seeded, from the junction
+   voltages otherwise.  Returns the number of points which did not
+   converge. */
+
+static int
+dc_segment(CKTcircuit *ckt, const char *name, double *values, int n,
+           bool seeded, int nout, int *index, double **out)
+{
+    GENinstance *src;
+    double *temp;
+    int type, converged, failed = 0;
+    int i, j, k;
+
+    src = dc_source(ckt, name, &type);
+    if (!src) {
+        for (k = 0; k < n; k++)
+            for (j = 0; j < nout; j++)
+                out[j][k] = NAN;
+        return n;
+    }
+
+    ckt->CKTtime = 0;
+    ckt->CKTdelta = (n > 1) ? values[1] - values[0] : 0.0;
+    for (i = 0; i < 7; i++)
+        ckt->CKTdeltaOld[i] = ckt->CKTdelta;
+    ckt->CKTorder = 1;
+    ckt->CKTmode = MODEDCTRANCURVE | (seeded ? MODEINITFLOAT : MODEINITJCT);
+
+    for (k = 0; k < n; k++) {
+        bool first = (ckt->CKTmode & (MODEINITJCT | MODEINITFLOAT)) != 0;
+
+        dc_set(src, type, values[k]);
+
+        /* Rotate state vectors. */
+        temp = ckt->CKTstates[ckt->CKTmaxOrder + 1];
+        for (i = ckt->CKTmaxOrder; i >= 0; i--)
+            ckt->CKTstates[i + 1] = ckt->CKTstates[i];
+        ckt->CKTstate0 = temp;
+
+        converged = NIiter(ckt, ckt->CKTdcTrcvMaxIter);
+        if (converged != 0)
+            converged = CKTop(ckt, MODEDCTRANCURVE | MODEINITJCT,
+                              MODEDCTRANCURVE | MODEINITFLOAT,
+                              ckt->CKTdcMaxIter);
+
+        if (converged != 0) {
+            for (j = 0; j < nout; j++)
+                out[j][k] = NAN;
+            failed++;
+            ckt->CKTmode = MODEDCTRANCURVE | MODEINITJCT;
+            continue;
+        }
+
+        for (j = 0; j < nout; j++)
+            out[j][k] = (index[j] < 0) ? NAN : ckt->CKTrhsOld[index[j]];
+
+        ckt->CKTmode = MODEDCTRANCURVE | MODEINITPRED;
+        ckt->CKTtime = values[k];
+        if (first)
+            memcpy(ckt->CKTstate1, ckt->CKTstate0,
+                   (size_t) ckt->CKTnumStates * sizeof(double));
+    }
+
+    return failed;
+}
+
+
+/* Sweep coarse serially over values[0 .. npts-1], with about DC_COARSE
+   points per segment, and hand its solution at the first point of each
+   segment i > 0 to seg[i].  seeded[i] tells which segments got one. */
+
+static void
+dc_seed(CKTcircuit *coarse, const char *name, double *values,
+        int npts, CKTcircuit **seg, int nseg, bool *seeded)
+{
+    double *cval = TMALLOC(double, npts);
+    int i, k, n, last = 0;
+    int failed = 0;
+
+    for (i = 1; i < nseg; i++) {
+        int first = (int) ((long) npts * i / nseg);
+        int stride = MAX(1, (first - last) / DC_COARSE);
+
+        /* the points after last up to first, including both ends once */
+        n = 0;
+        for (k = (i == 1) ? 0 : last + stride; k < first; k += stride)
+            cval[n++] = values[k];
+        cval[n++] = values[first];
+
+        failed = dc_segment(coarse, name, cval, n, i > 1 && !failed,
+                            0, NULL, NULL);
+        seeded[i] = !failed;
+        if (seeded[i])
+            CKTcloneState(seg[i], coarse);
+        last = first;
+    }
+
+    tfree(cval);
+}
+
+
+void
+com_dc_run(wordlist *wl)
+{
+    CKTcircuit *ckt, **seg;
+    GENinstance *here;
+    struct dvec **vecs, *scale;
+    double start = 0.0, stop = 0.0, step = 0.0, val, startTime;
+    double *values;
+    char *srcname, **names, *s, *saved;
+    int *failed, *index;
+    int npts, nout, nseg = 2, total = 0, type, error;
+    size_t size;
+    bool *seeded;
+    int i, j;
+
+    if (!ft_curckt || !ft_curckt->ci_ckt) {
+        fprintf(cp_err, "Error: no circuit loaded\n");
+        return;
+    }
+
+    ckt = ft_curckt->ci_ckt;
+
+#ifdef XSPICE
+    if (ckt->CKTadevFlag) {
+        fprintf(cp_err, "Error: dc_run does not support XSPICE code models\n");
+        return;
+    }
+#endif
+
+    srcname = wl->wl_word;
+    if (!dc_source(ckt, srcname, &type)) {
+        fprintf(cp_err, "Error: no voltage or current source %s in the circuit\n",
+                srcname);
+        return;
+    }
+
+    wl = wl->wl_next;
+    for (i = 0; i < 3; i++, wl = wl->wl_next) {
+        s = wl->wl_word;
+        if (ft_numparse(&s, FALSE, &val) < 0) {
+            fprintf(cp_err, "Error: bad number %s\n", wl->wl_word);
+            return;
+        }
+        if (i == 0)
+            start = val;
+        else if (i == 1)
+            stop = val;
+        else
+            step = val;
+    }
+
+    if (step == 0.0 || SGN(step) * (stop - start) < 0) {
+        fprintf(cp_err, "Error: bad sweep %g %g %g\n", start, stop, step);
+        return;
+    }
+
+    /* the values of the serial sweep, see DCtrCurv() */
+    npts = (int) floor((stop - start) / step) + 2;
+    values = TMALLOC(double, npts);
+    val = start;
+    for (i = 0; i < npts && SGN(step) * (val - stop) <= DBL_EPSILON * 1e+03; i++) {
+        values[i] = val;
+        val += step;
+    }
+    npts = i;
+
+    nout = wl_length(wl);
+    names = TMALLOC(char *, nout);
+    index = TMALLOC(int, nout);
+    for (j = 0; j < nout; j++, wl = wl->wl_next)
+        names[j] = ckt_reparse_name(wl->wl_word);
+
+    for (j = 0; j < nout; j++) {
+        index[j] = ckt_reparse_find(ckt, names[j]);
+        if (index[j] < 0) {
+            fprintf(cp_err, "Error: no node or branch %s in the circuit\n", names[j]);
+            for (j = 0; j < nout; j++)
+                tfree(names[j]);
+            tfree(names);
+            tfree(index);
+            tfree(values);
+            return;
+        }
+    }
+
+    /* set up as for an analysis */
+    if (ft_curckt->ci_curTask)
+        CKTtaskOpts(ckt, ft_curckt->ci_curTask);
+    inp_evaluate_temper(ft_curckt);
+    error = CKTresetup(ckt);
+    if (error) {
+        ft_sperror(error, "dc_run");
+        for (j = 0; j < nout; j++)
+            tfree(names[j]);
+        tfree(names);
+        tfree(index);
+        tfree(values);
+        return;
+    }
+
+    if (!cp_getvar("num_threads", CP_NUM, &nseg, 0) || nseg < 1)
+        nseg = 2;
+    nseg = MIN(nseg, npts);
+
+    plot_cur = plot_alloc("dc");
+    plot_cur->pl_next = plot_list;
+    plot_list = plot_cur;
+    plot_cur->pl_title = copy(ft_curckt->ci_name);
+    plot_cur->pl_name = copy("DC transfer characteristic");
+    plot_cur->pl_date = copy(datestring());
+
+    scale = dvec_alloc(copy(type == CKTtypelook("Vsource") ? "v-sweep" : "i-sweep"),
+                       type == CKTtypelook("Vsource") ? SV_VOLTAGE : SV_CURRENT,
+                       VF_REAL | VF_PERMANENT, npts, NULL);
+    vec_new(scale);
+    memcpy(scale->v_realdata, values, (size_t) npts * sizeof(double));
+
+    vecs = TMALLOC(struct dvec *, nout);
+    for (j = 0; j < nout; j++) {
+        vecs[j] = dvec_alloc(copy(names[j]),
+                             strstr(names[j], "#branch") ? SV_CURRENT : SV_VOLTAGE,
+                             VF_REAL | VF_PERMANENT, npts, NULL);
+        vec_new(vecs[j]);
+    }
+
+    startTime = seconds();
+
+    /* the first segment sweeps the source of the circuit, which is put
+       back afterwards */
+    here = dc_source(ckt, srcname, &type);
+    size = (size_t) *DEVices[type]->DEVinstSize;
+    saved = TMALLOC(char, size);
+    memcpy(saved, here, size);
+
+    seg = TMALLOC(CKTcircuit *, nseg + 1);
+    failed = TMALLOC(int, nseg);
+    seeded = TMALLOC(bool, nseg);
+    seg[0] = ckt;
+    for (i = 1; i <= nseg; i++)
+        if (nseg == 1 || CKTclone(ckt, &seg[i]) != OK)
+            break;
+    if (i <= nseg) {
+        while (--i > 0)
+            CKTcloneFree(seg[i]);
+        nseg = 1;
+    }
+
+    /* the last copy does the coarse sweep */
+    if (nseg > 1)
+        dc_seed(seg[nseg], srcname, values, npts, seg, nseg, seeded);
+
+#ifdef USE_OMP
+    omp_set_num_threads(nseg);
+#pragma omp parallel for schedule(static, 1) private(j) if (nseg > 1)
+#endif
+    for (i = 0; i < nseg; i++) {
+        int first = (int) ((long) npts * i / nseg);
+        int n = (int) ((long) npts * (i + 1) / nseg) - first;
+        double **out = TMALLOC(double *, nout);
+
+        for (j = 0; j < nout; j++)
+            out[j] = vecs[j]->v_realdata + first;
+
+        failed[i] = dc_segment(seg[i], srcname, values + first, n,
+                               seeded[i], nout, index, out);
+
+        tfree(out);
+    }
+
+    for (i = 0; i < nseg; i++)
+        total += failed[i];
+    if (nseg > 1)
+        for (i = 1; i <= nseg; i++)
+            CKTcloneFree(seg[i]);
+
+    memcpy(here, saved, size);
+
+    fprintf(cp_out, "dc_run: %d points, %d failed, %d segment(s), elapsed time %g s\n",
+            npts, total, nseg, seconds() - startTime);
+
+    for (j = 0; j < nout; j++)
+        tfree(names[j]);
+    tfree(names);
+    tfree(index);
+    tfree(vecs);
+    tfree(seg);
+    tfree(failed);
+    tfree(seeded);
+    tfree(saved);
+    tfree(values);
+}
@@ -0,0 +1,10 @@
+/*************
+ * Header file for dcrun.c
+ ************/
+
+#ifndef ngspice_DCRUN_H
+#define ngspice_DCRUN_H
+
+void com_dc_run(wordlist *wl);
+
+#endif
@@ -30,6 +30,7 @@ Author: 1985 Wayne A. Christopher
 #include "../misc/mktemp.h"
 #include "../misc/misc_time.h"
 #include "subckt.h"
+#include "prima.h"
 #include "spiceif.h"
 #include "com_let.h"
 #include "com_commands.h"
@@ -410,6 +411,7 @@ inp_remove_recent(void) {
 
 /* Check for .option seed=[val|random] and set the random number generator.
    Check for .option cshunt=val and set a global variable
+   Check for .option prima=fmax, primatol=val and ticer=tau for the RC reduction
    Input is the option deck (already sorted for .option) */
 void
 eval_opt(struct card* deck)
@@ -469,6 +471,42 @@ eval_opt(struct card* deck)
                 has_cshunt = TRUE;
             }
         }
+
+        begtok = strstr(line, "prima=");
+        if (begtok) {
+            int err = 0;
+            begtok = &begtok[6]; /*skip prima=*/
+            /* option prima=fmax */
+            double sr = INPevaluate(&begtok, &err, 0);
+            if (sr <= 0 || err)
+                fprintf(cp_err, "Warning: Cannot convert 'option prima=%s' to frequency value, skipped!\n", begtok);
+            else
+                cp_vset("prima_fmax", CP_REAL, &sr);
+        }
+
+        begtok = strstr(line, "ticer=");
+        if (begtok) {
+            int err = 0;
+            begtok = &begtok[6]; /*skip ticer=*/
+            /* option ticer=tau */
+            double sr = INPevaluate(&begtok, &err, 0);
+            if (sr <= 0 || err)
+                fprintf(cp_err, "Warning: Cannot convert 'option ticer=%s' to time constant, skipped!\n", begtok);
+            else
+                cp_vset("ticer_tau", CP_REAL, &sr);
+        }
+
+        begtok = strstr(line, "primatol=");
+        if (begtok) {
+            int err = 0;
+            begtok = &begtok[9]; /*skip primatol=*/
+            /* option primatol=val */
+            double sr = INPevaluate(&begtok, &err, 0);
+            if (sr <= 0 || err)
+                fprintf(cp_err, "Warning: Cannot convert 'option primatol=%s' to tolerance value, skipped!\n", begtok);
+            else
+                cp_vset("prima_tol", CP_REAL, &sr);
+        }
     }
 }
 
@@ -852,6 +890,10 @@ inp_spsource(FILE *fp, bool comfile, char *filename, bool intfile)
                 }
             }
 
+            /* Eliminate quick RC nodes (option ticer=tau) and replace
+               linear RC networks by reduced order models (option prima=fmax) */
+            inp_prima(deck->nextcard, wl_first, controls);
+
             /* Now handle translation of spice2c6 POLYs. */
 #ifdef XSPICE
             /* Translate all SPICE 2G6 polynomial type sources */
@@ -1477,6 +1519,95 @@ com_mc_source(wordlist *wl)
 }
 
 
+/* Expand a copy of the compacted deck mcdeck (see ci_mcdeck) as
+   inp_spsource() does, but without loading it as a new circuit.  As
+   with mc_source, numparam draws new values for agauss, gauss, unif,
+   aunif and limit.  The .option lines are dropped, the options are
+   taken from the circuit and the seed is not reset.  Used by mc_run. */
+struct card *
+inp_mc_expand(struct card *mcdeck)
+{
+    struct card *deck, *dd, *ld, *options;
+    struct pt_temper *modtlist = NULL, *devtlist = NULL;
+    static char *statfcn[] = { "agauss", "gauss", "aunif", "unif", "limit" };
+    char name[BSIZE_SP + 1], *s, *t;
+    int ii;
+
+    deck = inp_deckcopy(mcdeck);
+
+    options = inp_getopts(deck);
+    line_free(options, TRUE);
+
+    /* the deck holds no .control section, handle the dot cards
+       as inp_spsource() does */
+    for (ld = deck, dd = deck->nextcard; dd; dd = ld->nextcard) {
+        if (!*dd->line) {
+            ld->nextcard = dd->nextcard;
+            line_free(dd, FALSE);
+            continue;
+        }
+        if (*skip_ws(dd->line) == '*') {
+            ld = dd;
+            continue;
+        }
+        strncpy(name, dd->line, BSIZE_SP);
+        name[BSIZE_SP] = '\0';
+        s = skip_ws(name);
+        t = skip_non_ws(s);
+        *t = '\0';
+        inp_casefix(s);
+        if (!eq(s, ".plot") && !eq(s, ".print"))
+            inp_casefix(dd->line);
+        if (eq(s, ".width") || ciprefix(".four", s) ||
+            eq(s, ".plot") || eq(s, ".print")) {
+            ld->nextcard = dd->nextcard;
+            line_free(dd, FALSE);
+            continue;
+        }
+        ld = dd;
+    }
+
+    if (!cp_getvar("nosubckt", CP_BOOL, NULL, 0)) {
+        deck->nextcard = inp_subcktexpand(deck->nextcard);
+        /* the numparam symbols of the trial are not kept */
+        nupa_del_dicoS();
+        if (ft_curckt)
+            nupa_set_dicoslist(ft_curckt->ci_dicos);
+        if (!deck->nextcard) {
+            line_free(deck, TRUE);
+            return NULL;
+        }
+    }
+
+    for (ii = 0; ii < 5; ii++)
+        eval_agauss(deck, statfcn[ii]);
+
+    for (dd = deck->nextcard; dd; dd = dd->nextcard)
+        if (ciprefix(".save", dd->line) || ciprefix(".csparam", dd->line))
+            *dd->line = '*';
+
+#ifdef XSPICE
+    deck->nextcard = ENHtranslate_poly(deck->nextcard);
+#endif
+
+    dotifeval(deck);
+
+    inp_parse_temper(deck, &modtlist, &devtlist);
+    if (modtlist || devtlist) {
+        fprintf(cp_err, "Error: expressions with 'temper' are not supported by mc_run\n");
+        rem_tlist(modtlist);
+        rem_tlist(devtlist);
+        line_free(deck, TRUE);
+        return NULL;
+    }
+
+    if (newcompat.hs || newcompat.spe)
+        rem_unused_mos_models(deck->nextcard);
+
+    return deck;
+}
+
+
 /* Edit and re-load the current input deck.  Note that if these
  * commands are used on a non-unix machine, they will leave spice.tmp
  * junk files lying around.  */
@@ -1820,10 +1951,13 @@ com_source(wordlist *wl)
         /* set the source window */
         SetSource(wl->wl_word);
 #endif
-        /* Save path name for use in XSPICE fopen_with_path() */
+        /* Save path name for use in XSPICE fopen_with_path(),
+           the directory the file has been found in by sourcepath */
+        char *path = inp_pathresolve(firstfile);
         if (Infile_Path)
             tfree(Infile_Path);
-        Infile_Path = ngdirname(firstfile);
+        Infile_Path = ngdirname(path ? path : firstfile);
+        tfree(path);
         if (inp_spsource(fp, FALSE, tempfile ? NULL : wl->wl_word, FALSE) != 0) {
             fprintf(stderr, "    Simulation interrupted due to error!\n\n");
         }
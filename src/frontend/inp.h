@@ -10,6 +10,7 @@ void com_listing(wordlist *wl);
 void com_edit(wordlist *wl);
 void com_source(wordlist *wl);
 void com_mc_source(wordlist *wl);
+struct card *inp_mc_expand(struct card *mcdeck);
 void com_circbyline(wordlist *wl);
 
 void line_free_x(struct card *deck, bool recurse);
@@ -18,6 +18,7 @@
 #include "ngspice/stringskip.h"
 #include "ngspice/stringutil.h"
 #include "ngspice/dstring.h"
+#include "ngspice/cpextern.h"
 #include "ngspice/logicexp.h"
 #include "ngspice/udevices.h"
 
@@ -34,6 +35,7 @@
 #define SYM_GATE_OP     32
 #define SYM_INVERTER    64
 #define SYM_OTHER       128
+#define SYM_DRIVEN      256
 
 typedef struct sym_entry *SYM_TAB;
 struct sym_entry {
@@ -41,6 +43,7 @@ struct sym_entry {
     char *alias;
     int attribute;
     int ref_count; // for inverters
+    int index; // signal number in a compiled logic program
     SYM_TAB left;
     SYM_TAB right;
 };
@@ -56,6 +59,7 @@ static SYM_TAB new_sym_entry(char *name, int attr)
     newp->alias = NULL;
     newp->attribute = attr;
     newp->ref_count = 0;
+    newp->index = -1;
     return newp;
 }
 
@@ -1252,6 +1256,218 @@ quick_return:
     return;
 }
 
+/*
+    Compiled logic.
+    If the variable ps_compile_logicexp is set, the zero delay gates of
+    a LOGICEXP (with timing model d0_gate) are not instantiated one by
+    one. Their gen_tab lines are collected in logic_tab, and one d_logic
+    instance evaluates all of them as a program. Only the LOGICEXP
+    inputs and outputs are event nodes then.
+    The program has the rise and fall delay of 1 ps per gate, and an
+    output changes after N ps, N being the longest path of gates to
+    it. This is the timing of the single gates when all paths to the
+    output have the same length. A change through a shorter path
+    comes later, and short pulses (glitches) of the internal signals
+    are not seen.
+    The inputs are signals 0 .. n-1 of the program, the outputs follow,
+    then the internal signals. The program has no blanks, because the
+    quotes of a string in a .model line inside a subckt are replaced
+    by blanks in subckt expansion:
+        "nand:4:!0:1/xor:5:4:2"
+    If the gates cannot be compiled, they are generated as usual by
+    gen_gates.
+*/
+static BOOL compile_logic = FALSE;
+static BOOL compile_failed = FALSE;
+static PTABLE logic_tab = NULL;
+static SYM_TAB logic_signals = NULL;
+static int num_logic_signals = 0;
+static DSTRING logic_ins;
+static DSTRING logic_outs;
+
+static void init_logic_program(void)
+{
+    logic_tab = new_parse_table();
+    logic_signals = NULL;
+    num_logic_signals = 0;
+    compile_failed = FALSE;
+    ds_init(&logic_ins, TMALLOC(char, LEX_INIT_SZ), 0,
+        LEX_INIT_SZ, ds_buf_type_heap);
+    ds_init(&logic_outs, TMALLOC(char, LEX_INIT_SZ), 0,
+        LEX_INIT_SZ, ds_buf_type_heap);
+}
+
+static void cleanup_logic_program(void)
+{
+    delete_parse_table(logic_tab);
+    logic_tab = NULL;
+    delete_sym_tab(logic_signals);
+    logic_signals = NULL;
+    ds_free(&logic_ins);
+    ds_free(&logic_outs);
+    compile_logic = FALSE;
+}
+
+static void add_logic_port(char *name, int attr)
+{
+    /* Called for the LOGICEXP inputs and outputs in order */
+    SYM_TAB entry;
+
+    if (member_sym_tab(name, logic_signals)) {
+        /* A port listed twice cannot be one signal */
+        compile_failed = TRUE;
+        return;
+    }
+    entry = add_sym_tab_entry(name, attr, &logic_signals);
+    entry->index = num_logic_signals++;
+    if (attr == SYM_INPUT)
+        ds_cat_printf(&logic_ins, " %s", name);
+    else
+        ds_cat_printf(&logic_outs, " %s", name);
+}
+
+static void add_gates(PTABLE gate_tab, SYM_TAB parser_symbols)
+{
+    TLINE t;
+
+    if (!compile_logic) {
+        gen_gates(gate_tab, parser_symbols);
+        return;
+    }
+    for (t = gate_tab->first; t; t = t->next)
+        (void) add_to_parse_table(logic_tab, t->line, TRUE);
+}
+
+static char *logic_op_name(int c, BOOL not)
+{
+    switch (c) {
+    case '&':
+        return not ? "nand" : "and";
+    case '|':
+        return not ? "nor" : "or";
+    case '^':
+        return not ? "xnor" : "xor";
+    default:
+        return not ? "inv" : "buf";
+    }
+}
+
+static BOOL logic_undriven(SYM_TAB t)
+{
+    /* TRUE if a LOGICEXP output is not driven by any gate */
+    if (t == NULL) { return FALSE; }
+    if ((t->attribute & SYM_OUTPUT) && !(t->attribute & SYM_DRIVEN))
+        return TRUE;
+    return logic_undriven(t->left) || logic_undriven(t->right);
+}
+
+static BOOL gen_logic_program(void)
+{
+    /* Translate the lines in logic_tab into the program of a d_logic
+       instance. The first pass numbers the signals driven by the
+       gates, the second writes the gates with their operands.
+    */
+    static int number = 0;
+    TLINE t;
+    LEXER lxr;
+    SYM_TAB entry;
+    int val, pass, idnum, gate_op;
+    BOOL found_tilde, ret_val = TRUE;
+    char *tail, *name;
+    DS_CREATE(prog, 1024);
+    DS_CREATE(gate, 128);
+    DS_CREATE(model_name, 32);
+    DS_CREATE(instance, 256);
+
+    if (compile_failed || !logic_tab->first)
+        ret_val = FALSE;
+
+    for (pass = 1; pass <= 2 && ret_val; pass++) {
+        for (t = logic_tab->first; t && ret_val; t = t->next) {
+            lxr = new_lexer(t->line);
+            ds_clear(&gate);
+            idnum = 0;
+            gate_op = 0;
+            found_tilde = FALSE;
+            while (ret_val && (val = lexer_scan(lxr)) != '\0') {
+                if (val == LEX_ID) {
+                    idnum++;
+                    if (idnum == 1) { // output name
+                        entry = add_sym_tab_entry(lxr->lexer_buf,
+                            SYM_ID, &logic_signals);
+                        if (pass == 1) {
+                            if (entry->attribute & (SYM_INPUT | SYM_DRIVEN)) {
+                                ret_val = FALSE;
+                                break;
+                            }
+                            entry->attribute |= SYM_DRIVEN;
+                            if (entry->index < 0)
+                                entry->index = num_logic_signals++;
+                        }
+                        ds_cat_printf(&gate, ":%d", entry->index);
+                    } else if (pass == 2) { // input name
+                        tail = get_inv_tail(lxr->lexer_buf);
+                        if (tail && strlen(tail) > 0)
+                            name = tail;
+                        else
+                            name = lxr->lexer_buf;
+                        entry = member_sym_tab(name, logic_signals);
+                        if (!entry ||
+                            !(entry->attribute & (SYM_INPUT | SYM_DRIVEN))) {
+                            ret_val = FALSE;
+                            break;
+                        }
+                        ds_cat_printf(&gate, ":%s%d",
+                            (name == tail) ? "!" : "", entry->index);
+                    }
+                } else if (val == '~') {
+                    found_tilde = TRUE;
+                } else if (lex_gate_op(val)) {
+                    if (gate_op != 0 && val != gate_op)
+                        ret_val = FALSE;
+                    gate_op = val;
+                } else if (val != '=') {
+                    ret_val = FALSE;
+                }
+            }
+            delete_lexer(lxr);
+            if (pass == 2 && ret_val) {
+                if (idnum < 2 || (idnum == 2) != (gate_op == 0)) {
+                    ret_val = FALSE;
+                } else {
+                    ds_cat_printf(&prog, "%s%s%s",
+                        (ds_get_length(&prog) > 0) ? "/" : "",
+                        logic_op_name(gate_op, found_tilde),
+                        ds_get_buf(&gate));
+                }
+            }
+        }
+        if (pass == 1 && ret_val && logic_undriven(logic_signals))
+            ret_val = FALSE;
+    }
+
+    if (ret_val) {
+        number++;
+        ds_cat_printf(&model_name, "d__logic__%d", number);
+        ds_cat_printf(&instance,
+            ".model %s d_logic(rise_delay=1.0e-12 fall_delay=1.0e-12 "
+            "program=\"%s\")", ds_get_buf(&model_name), ds_get_buf(&prog));
+        u_add_instance(ds_get_buf(&instance));
+
+        ds_clear(&instance);
+        ds_cat_printf(&instance, "%s [%s ] [%s ] %s", get_inst_name(),
+            ds_get_buf(&logic_ins), ds_get_buf(&logic_outs),
+            ds_get_buf(&model_name));
+        u_add_instance(ds_get_buf(&instance));
+    }
+
+    ds_free(&prog);
+    ds_free(&gate);
+    ds_free(&model_name);
+    ds_free(&instance);
+    return ret_val;
+}
+
 /*
     gen_tab lines format:
         name1 = [~] name2 [op name3 {op namei}+]
@@ -1411,7 +1627,7 @@ static BOOL bparse(char *line, BOOL new_lexer)
         }
         last_count = gen_tab->entry_count;
         if (last_count == 1) {
-            gen_gates(gen_tab, lx->lexer_sym_tab);
+            add_gates(gen_tab, lx->lexer_sym_tab);
         } else if (last_count > 1) {
             opt_tab1 = optimize_gen_tab(gen_tab);
             if (prit) {
@@ -1437,7 +1653,7 @@ static BOOL bparse(char *line, BOOL new_lexer)
                     curr_count = opt_tab2->entry_count;
                 }
                 if (opt_tab2) {
-                    gen_gates(opt_tab2, lx->lexer_sym_tab);
+                    add_gates(opt_tab2, lx->lexer_sym_tab);
                     delete_parse_table(opt_tab2);
                 }
             } else {
@@ -1452,6 +1668,13 @@ static BOOL bparse(char *line, BOOL new_lexer)
         }
     }
 
+    if (compile_logic) {
+        /* Fall back to single gates if the program cannot be made */
+        if (!ret_val || !gen_logic_program())
+            gen_gates(logic_tab, lx->lexer_sym_tab);
+        cleanup_logic_program();
+    }
+
     ds_free(&d_curr_line);
     gen_models();
     ds_free(&stmt);
@@ -1540,12 +1763,24 @@ BOOL f_logicexp(char *line)
     if (!expect_token(t, LEX_ID, NULL, TRUE, 8)) goto error_return;
     t = lex_scan(); // gnd
     if (!expect_token(t, LEX_ID, NULL, TRUE, 9)) goto error_return;
+    /*
+      Set ps_compile_logicexp to evaluate the zero delay gates of
+      a LOGICEXP in a single d_logic instance. This may change the
+      event timing, see above. Set ps_compile_gates to compile the
+      other gates with timing model d0_gate, see udevices.c.
+    */
+    compile_logic = cp_getvar("ps_compile_logicexp", CP_BOOL, NULL, 0)
+        && num_ins > 0 && num_outs > 0;
+    if (compile_logic)
+        init_logic_program();
     /* num_ins input ids */
     for (i = 0; i < num_ins; i++) {
         t = lex_scan();
         if (!expect_token(t, LEX_ID, NULL, TRUE, 10)) goto error_return;
         (void) add_sym_tab_entry(parse_lexer->lexer_buf,
             SYM_INPUT, &parse_lexer->lexer_sym_tab);
+        if (compile_logic)
+            add_logic_port(parse_lexer->lexer_buf, SYM_INPUT);
     }
     /* num_outs output ids */
     for (i = 0; i < num_outs; i++) {
@@ -1553,11 +1788,16 @@ BOOL f_logicexp(char *line)
         if (!expect_token(t, LEX_ID, NULL, TRUE, 11)) goto error_return;
         (void) add_sym_tab_entry(parse_lexer->lexer_buf,
             SYM_OUTPUT, &parse_lexer->lexer_sym_tab);
+        if (compile_logic)
+            add_logic_port(parse_lexer->lexer_buf, SYM_OUTPUT);
     }
     /* timing model */
     t = lex_scan();
     if (!expect_token(t, LEX_ID, NULL, TRUE, 12)) goto error_return;
     if (!eq(parse_lexer->lexer_buf, "d0_gate")) {
+        /* The gates driving the outputs have delays */
+        if (compile_logic)
+            cleanup_logic_program();
         u_add_logicexp_model(parse_lexer->lexer_buf,
             "d_and", "dxspice_dly_and");
         u_add_logicexp_model(parse_lexer->lexer_buf,
@@ -1582,6 +1822,8 @@ BOOL f_logicexp(char *line)
     return ret_val;
 
 error_return:
+    if (compile_logic)
+        cleanup_logic_program();
     delete_lexer(parse_lexer);
     current_lexer = NULL;
     return FALSE;
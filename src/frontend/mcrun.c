@@ -0,0 +1,648 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * mc_run trials [output ...]
+ *
+ * Monte Carlo analysis on parallel circuits.  Each trial expands the
+ * compacted deck ci_mcdeck again (inp_mc_expand()), numparam then draws
+ * new values for agauss, gauss, unif, aunif and limit, see
+ * inp_fix_agauss_in_param().  The trial deck is parsed into a second
+ * circuit (cktreparse.c), which is set up and starts from the solution
+ * of the current circuit, if there is one.  Values changed by alter and
+ * altermod on the current circuit are not in the trials, a warning says
+ * so.
+ *
+ * If the deck has no analysis lines, each trial computes the operating
+ * point.  Otherwise the analyses of the deck (.op, .tran, .ac ...) are
+ * run on each trial, see CKTdoJobNoSetup().  Their output does not go to
+ * plots of the front end but is collected per trial by the hooks below,
+ * the .meas lines of the deck are then evaluated on it one trial after
+ * the other.  Measurements of type 'param' and 'expr' are not evaluated,
+ * they would need the numparam symbols of the trial.
+ *
+ * Expanding, parsing and setting up a trial use the front end (parser,
+ * symbol table, IFnewUid) and are done one trial after the other, as are
+ * the measurements.  The operating points or analyses of a batch of
+ * trials are then computed in parallel by the OpenMP threads (option
+ * num_threads), if the circuit has no devices with global data, see
+ * ckt_reparse_threadsafe(), and the deck only asks for .op, .tran and .ac.
+ * The other analyses keep their plot in static data and run one trial
+ * after the other.
+ *
+ * The results are stored into one plot 'mc', with the trial number as
+ * scale: a vector per .meas line, named by it, and one per requested
+ * node voltage v(node) or branch current i(vsource).  With analyses, the
+ * latter is the value at the last point of the last analysis with real
+ * output, e.g. at the stop time of .tran.  The vectors are filled batch
+ * by batch, failed trials are set to NaN.  They may then be evaluated
+ * with the vector functions (mean, stddev ...).
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/cpdefs.h"
+#include "ngspice/dvec.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteext.h"
+#include "ngspice/fteinp.h"
+#include "ngspice/inpdefs.h"
+#include "ngspice/sim.h"
+#include "ngspice/sperror.h"
+
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#include "com_measure2.h"
+#include "cktreparse.h"
+#include "inp.h"
+#include "mcrun.h"
+#include "postcoms.h"
+#include "../misc/misc_time.h"
+
+#define MC_BATCH 4      /* trials per thread and batch */
+
+
+/* The output of one analysis of a trial, collected by mc_begin_plot()
+   and mc_data() instead of a plot of the front end */
+struct mc_out {
+    char *type;             /* name of the analysis, e.g. "AC Analysis" */
+    char *refName;          /* scale, NULL for an operating point */
+    int numNames;
+    char **names;           /* the data vectors */
+    bool complex;
+    int length;             /* points stored */
+    int size;               /* points allocated */
+    double *ref;
+    double *re, *im;        /* numNames values per point */
+    struct mc_out *next;
+};
+
+/* The trials of the running batch and their output.  The hooks find the
+   trial of a circuit here, the trials are not changed while they run. */
+static struct ckt_reparse **mc_trial;
+static struct mc_out **mc_out;
+static int mc_ntrial;
+
+/* the front end of the simulator, while the hooks are installed */
+static IFfrontEnd *mc_frontend;
+
+
+static int
+mc_begin_plot(CKTcircuit *ckt, JOB *job, IFuid analName, IFuid refName,
+              int refType, int numNames, IFuid *dataNames, int dataType,
+              runDesc **plotPtr)
+{
+    struct mc_out *o, **tail;
+    int i, t;
+
+    NG_IGNORE(job);
+    NG_IGNORE(refType);
+
+    *plotPtr = NULL;
+
+    for (t = 0; t < mc_ntrial; t++)
+        if (mc_trial[t] && mc_trial[t]->ckt == ckt)
+            break;
+    if (t == mc_ntrial)
+        return OK;
+
+    o = TMALLOC(struct mc_out, 1);
+    o->type = copy(analName);
+    o->refName = refName ? copy(refName) : NULL;
+    o->numNames = numNames;
+    o->names = TMALLOC(char *, numNames);
+    for (i = 0; i < numNames; i++)
+        o->names[i] = copy(dataNames[i]);
+    o->complex = (dataType == IF_COMPLEX);
+
+    for (tail = &mc_out[t]; *tail; tail = &(*tail)->next)
+        ;
+    *tail = o;
+
+    *plotPtr = (runDesc *) o;
+    return OK;
+}
+
+
+static int
+mc_data(runDesc *plot, IFvalue *refValue, IFvalue *valuePtr)
+{
+    struct mc_out *o = (struct mc_out *) plot;
+    int i, n;
+
+    if (!o)
+        return OK;
+
+    if (o->length == o->size) {
+        o->size = MAX(64, 2 * o->size);
+        o->ref = TREALLOC(double, o->ref, o->size);
+        o->re = TREALLOC(double, o->re, (size_t) o->size * (size_t) o->numNames);
+        if (o->complex)
+            o->im = TREALLOC(double, o->im, (size_t) o->size * (size_t) o->numNames);
+    }
+
+    o->ref[o->length] = refValue ? refValue->rValue : 0.0;
+
+    n = MIN(valuePtr->v.numValue, o->numNames);
+    for (i = 0; i < n; i++) {
+        size_t k = (size_t) o->length * (size_t) o->numNames + (size_t) i;
+        if (o->complex) {
+            o->re[k] = valuePtr->v.vec.cVec[i].real;
+            o->im[k] = valuePtr->v.vec.cVec[i].imag;
+        } else {
+            o->re[k] = valuePtr->v.vec.rVec[i];
+        }
+    }
+
+    o->length++;
+    return OK;
+}
+
+
+static int
+mc_reference(runDesc *plot, IFvalue *refValue, void **refPtr)
+{
+    NG_IGNORE(plot);
+    NG_IGNORE(refValue);
+
+    *refPtr = NULL;
+    return OK;
+}
+
+
+static int
+mc_wdata(runDesc *plot, int index, IFvalue *value, void *refPtr)
+{
+    NG_IGNORE(plot);
+    NG_IGNORE(index);
+    NG_IGNORE(value);
+    NG_IGNORE(refPtr);
+
+    return OK;
+}
+
+
+static int
+mc_end(runDesc *plot)
+{
+    NG_IGNORE(plot);
+
+    return OK;
+}
+
+
+static int
+mc_begin_domain(runDesc *plot, IFuid refName, int refType, IFvalue *outerRefValue)
+{
+    NG_IGNORE(plot);
+    NG_IGNORE(refName);
+    NG_IGNORE(refType);
+    NG_IGNORE(outerRefValue);
+
+    return OK;
+}
+
+
+static int
+mc_attributes(runDesc *plot, IFuid varName, int param, IFvalue *value)
+{
+    NG_IGNORE(plot);
+    NG_IGNORE(varName);
+    NG_IGNORE(param);
+    NG_IGNORE(value);
+
+    return OK;
+}
+
+
+/* The uids go to the symbol table of the current circuit */
+
+static int
+mc_new_uid(CKTcircuit *ckt, IFuid *newuid, IFuid olduid, char *suffix,
+           int type, CKTnode **nodedata)
+{
+    int error;
+
+#ifdef USE_OMP
+#pragma omp critical (mc_run_uid)
+#endif
+    error = mc_frontend->IFnewUid(ckt, newuid, olduid, suffix, type, nodedata);
+
+    return error;
+}
+
+
+static int
+mc_del_uid(CKTcircuit *ckt, IFuid uid, int type)
+{
+    int error;
+
+#ifdef USE_OMP
+#pragma omp critical (mc_run_uid)
+#endif
+    error = mc_frontend->IFdelUid(ckt, uid, type);
+
+    return error;
+}
+
+
+static void
+mc_free_out(struct mc_out *o)
+{
+    struct mc_out *next;
+    int i;
+
+    for (; o; o = next) {
+        next = o->next;
+        for (i = 0; i < o->numNames; i++)
+            tfree(o->names[i]);
+        tfree(o->names);
+        tfree(o->type);
+        tfree(o->refName);
+        tfree(o->ref);
+        tfree(o->re);
+        tfree(o->im);
+        tfree(o);
+    }
+}
+
+
+#ifdef USE_OMP
+
+/* TRUE if the analyses of task may run on several trials at once */
+
+static bool
+mc_parallel_jobs(TSKtask *task)
+{
+    JOB *job;
+
+#ifdef HAS_PROGREP
+    /* SetAnalyse() of the progress report keeps static data */
+    if (task->jobs)
+        return FALSE;
+#endif
+
+    for (job = task->jobs; job; job = job->JOBnextJob) {
+        char *name = ft_sim->analyses[job->JOBtype]->name;
+        if (!eq(name, "OP") && !eq(name, "TRAN") && !eq(name, "AC"))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+#endif
+
+
+/* Evaluate the .meas lines meas[0 .. nmeas-1] of the analysis type of o
+   on its output, the results go to mvecs[m]->v_realdata[trial] */
+
+static void
+mc_measure(struct mc_out *o, struct card **meas, int nmeas,
+           struct dvec **mvecs, int trial)
+{
+    struct plot *keep = plot_cur, *pl;
+    struct dvec *v;
+    char *an = ft_plotabbrev(o->type);
+    short flags = (short) (VF_PERMANENT | (o->complex ? VF_COMPLEX : VF_REAL));
+    int i, k, m;
+
+    if (!an || !o->refName || o->length == 0)
+        return;
+
+    for (m = 0; m < nmeas; m++)
+        if (ciprefix(an, nexttok(meas[m]->line)))
+            break;
+    if (m == nmeas)
+        return;
+
+    pl = plot_alloc(o->type);
+    pl->pl_title = copy(ft_curckt->ci_name);
+    pl->pl_name = copy(o->type);
+    pl->pl_date = copy(datestring());
+    plot_new(pl);
+    plot_cur = pl;
+
+    /* the vectors of a plot of the front end, see plotInit(), the
+       first one becomes the scale */
+    for (i = -1; i < o->numNames; i++) {
+        char *name;
+        int type;
+
+        if (i < 0) {
+            name = copy(o->refName);
+            type = eq(name, "time") ? SV_TIME :
+                eq(name, "frequency") ? SV_FREQUENCY : SV_NOTYPE;
+        } else {
+            name = isdigit_c(o->names[i][0]) ?
+                tprintf("V(%s)", o->names[i]) : copy(o->names[i]);
+            type = strstr(name, "#branch") ? SV_CURRENT : SV_VOLTAGE;
+        }
+
+        v = dvec_alloc(name, type, flags, o->length, NULL);
+        for (k = 0; k < o->length; k++) {
+            size_t n = (size_t) k * (size_t) o->numNames + (size_t) i;
+            double re = (i < 0) ? o->ref[k] : o->re[n];
+            double im = (i < 0) ? 0.0 : (o->complex ? o->im[n] : 0.0);
+            if (o->complex) {
+                v->v_compdata[k].cx_real = re;
+                v->v_compdata[k].cx_imag = im;
+            } else {
+                v->v_realdata[k] = re;
+            }
+        }
+        vec_new(v);
+    }
+
+    for (m = 0; m < nmeas; m++) {
+        char out_line[1000];    /* the report, see do_measure() */
+        wordlist *wl;
+        double result;
+
+        if (!ciprefix(an, nexttok(meas[m]->line)))
+            continue;
+
+        wl = measure_parse_line(meas[m]->line);
+        if (wl && get_measure2(wl, &result, out_line, TRUE) == 0)
+            mvecs[m]->v_realdata[trial] = result;
+        wl_free(wl);
+    }
+
+    killplot(pl);
+    plot_cur = keep;
+}
+
+
+/* The value of output name at the last point of the last analysis of
+   out with real output, NaN if there is none */
+
+static double
+mc_last_value(struct mc_out *out, const char *name)
+{
+    struct mc_out *o, *last = NULL;
+    int i;
+
+    for (o = out; o; o = o->next)
+        if (!o->complex && o->length > 0)
+            last = o;
+
+    if (!last)
+        return NAN;
+
+    if (eq(name, "0") || cieq(name, "gnd"))
+        return 0.0;
+
+    for (i = 0; i < last->numNames; i++)
+        if (cieq(last->names[i], name))
+            return last->re[(size_t) (last->length - 1) * (size_t) last->numNames
+                            + (size_t) i];
+
+    return NAN;
+}
+
+
+void
+com_mc_run(wordlist *wl)
+{
+    struct ckt_reparse **trial;
+    struct mc_out **out;
+    struct card **meas, *c;
+    IFfrontEnd hooks;
+    int *status;
+    struct dvec **vecs, **mvecs, *scale;
+    char **names, *s;
+    double val, startTime;
+    int trials, nout, nmeas, nthreads = 1, batch, first, failed = 0;
+    bool noinitprint = ft_noinitprint;
+    int i, j, k;
+
+    if (!ft_curckt || !ft_curckt->ci_ckt || !ft_curckt->ci_mcdeck) {
+        fprintf(cp_err, "Error: no circuit loaded\n");
+        return;
+    }
+
+    s = wl->wl_word;
+    if (ft_numparse(&s, FALSE, &val) < 0 || val < 1) {
+        fprintf(cp_err, "Error: bad number of trials %s\n", wl->wl_word);
+        return;
+    }
+    trials = (int) val;
+
+    if (ft_curckt->ci_ckt->CKTparamKey)
+        fprintf(cp_err, "Warning: mc_run: the trials do not see the values changed by alter and altermod\n");
+
+    wl = wl->wl_next;
+    nout = wl_length(wl);
+    names = TMALLOC(char *, nout);
+    for (j = 0; j < nout; j++, wl = wl->wl_next)
+        names[j] = ckt_reparse_name(wl->wl_word);
+
+    for (j = 0; j < nout; j++)
+        if (ckt_reparse_find(ft_curckt->ci_ckt, names[j]) < 0) {
+            fprintf(cp_err, "Error: no node or branch %s in the circuit\n", names[j]);
+            for (j = 0; j < nout; j++)
+                tfree(names[j]);
+            tfree(names);
+            return;
+        }
+
+    /* the .meas lines with a result of their own */
+    nmeas = 0;
+    for (c = ft_curckt->ci_meas; c; c = c->nextcard)
+        nmeas++;
+    meas = TMALLOC(struct card *, nmeas);
+    nmeas = 0;
+    for (c = ft_curckt->ci_meas; c; c = c->nextcard) {
+        char *line = nexttok(nexttok(nexttok(c->line)));
+        if (!ciprefix("param", line) && !ciprefix("expr", line))
+            meas[nmeas++] = c;
+    }
+
+    if (nout == 0 && nmeas == 0) {
+        fprintf(cp_err, "Error: no outputs and no .meas lines\n");
+        tfree(names);
+        tfree(meas);
+        return;
+    }
+
+    plot_cur = plot_alloc("mc");
+    plot_cur->pl_next = plot_list;
+    plot_list = plot_cur;
+    plot_cur->pl_title = copy(ft_curckt->ci_name);
+    plot_cur->pl_name = copy("Monte Carlo Analysis");
+    plot_cur->pl_date = copy(datestring());
+
+    scale = dvec_alloc(copy("trial"), SV_NOTYPE,
+                       VF_REAL | VF_PERMANENT, trials, NULL);
+    vec_new(scale);
+    for (i = 0; i < trials; i++)
+        scale->v_realdata[i] = i;
+
+    vecs = TMALLOC(struct dvec *, nout);
+    for (j = 0; j < nout; j++) {
+        vecs[j] = dvec_alloc(copy(names[j]),
+                             strstr(names[j], "#branch") ? SV_CURRENT : SV_VOLTAGE,
+                             VF_REAL | VF_PERMANENT, trials, NULL);
+        vec_new(vecs[j]);
+    }
+
+    mvecs = TMALLOC(struct dvec *, nmeas);
+    for (j = 0; j < nmeas; j++) {
+        char *line = nexttok(nexttok(meas[j]->line));
+        mvecs[j] = dvec_alloc(gettok(&line), SV_NOTYPE,
+                              VF_REAL | VF_PERMANENT, trials, NULL);
+        for (i = 0; i < trials; i++)
+            mvecs[j]->v_realdata[i] = NAN;
+        vec_new(mvecs[j]);
+    }
+
+#ifdef USE_OMP
+    if (!cp_getvar("num_threads", CP_NUM, &nthreads, 0))
+        nthreads = 2;
+    omp_set_num_threads(nthreads);
+#endif
+
+    batch = MC_BATCH * nthreads;
+    trial = TMALLOC(struct ckt_reparse *, batch);
+    out = TMALLOC(struct mc_out *, batch);
+    status = TMALLOC(int, batch);
+
+    /* the hooks collecting the output of the analyses */
+    hooks = *SPfrontEnd;
+    hooks.IFnewUid = mc_new_uid;
+    hooks.IFdelUid = mc_del_uid;
+    hooks.OUTpBeginPlot = mc_begin_plot;
+    hooks.OUTpData = mc_data;
+    hooks.OUTwBeginPlot = mc_begin_plot;
+    hooks.OUTwReference = mc_reference;
+    hooks.OUTwData = mc_wdata;
+    hooks.OUTwEnd = mc_end;
+    hooks.OUTendPlot = mc_end;
+    hooks.OUTbeginDomain = mc_begin_domain;
+    hooks.OUTendDomain = mc_end;
+    hooks.OUTattributes = mc_attributes;
+
+    startTime = seconds();
+
+    for (first = 0; first < trials; first += batch) {
+        int n = MIN(batch, trials - first);
+        bool analyses = FALSE;
+#ifdef USE_OMP
+        bool parallel = TRUE;
+#endif
+
+        for (i = 0; i < n; i++) {
+            struct card *deck = inp_mc_expand(ft_curckt->ci_mcdeck);
+            trial[i] = deck ? ckt_reparse_deck(ft_curckt, deck) : NULL;
+            out[i] = NULL;
+            if (!trial[i])
+                continue;
+            if (trial[i]->task->jobs)
+                analyses = TRUE;
+#ifdef USE_OMP
+            if (!ckt_reparse_threadsafe(trial[i]->ckt) ||
+                !mc_parallel_jobs(trial[i]->task))
+                parallel = FALSE;
+#endif
+        }
+
+        mc_trial = trial;
+        mc_out = out;
+        mc_ntrial = n;
+        mc_frontend = SPfrontEnd;
+        SPfrontEnd = &hooks;
+        ft_noinitprint = TRUE;
+
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1) private(j, k) if (parallel)
+#endif
+        for (i = 0; i < n; i++) {
+            CKTcircuit *ckt;
+            if (!trial[i])
+                status[i] = E_PRIVATE;
+            else if (analyses)
+                status[i] = CKTdoJobNoSetup(trial[i]->ckt, trial[i]->task);
+            else
+                status[i] = ckt_reparse_op(trial[i]);
+            if (status[i] != OK || analyses) {
+                for (j = 0; j < nout; j++)
+                    vecs[j]->v_realdata[first + i] = NAN;
+                continue;
+            }
+            ckt = trial[i]->ckt;
+            for (j = 0; j < nout; j++) {
+                k = ckt_reparse_find(ckt, names[j]);
+                vecs[j]->v_realdata[first + i] = (k < 0) ? NAN : ckt->CKTrhsOld[k];
+            }
+        }
+
+        ft_noinitprint = noinitprint;
+        SPfrontEnd = mc_frontend;
+        mc_frontend = NULL;
+        mc_trial = NULL;
+        mc_out = NULL;
+        mc_ntrial = 0;
+
+        for (i = 0; i < n; i++) {
+            struct mc_out *o;
+            if (status[i] != OK)
+                failed++;
+            else if (analyses) {
+                for (o = out[i]; o; o = o->next)
+                    mc_measure(o, meas, nmeas, mvecs, first + i);
+                for (j = 0; j < nout; j++)
+                    vecs[j]->v_realdata[first + i] = mc_last_value(out[i], names[j]);
+            }
+            mc_free_out(out[i]);
+            ckt_reparse_free(trial[i]);
+        }
+
+        if (SPfrontEnd->IFpauseTest()) {
+            fprintf(cp_err, "mc_run interrupted after %d trials\n", first + n);
+            for (j = 0; j < nout; j++)
+                vecs[j]->v_length = first + n;
+            for (j = 0; j < nmeas; j++)
+                mvecs[j]->v_length = first + n;
+            scale->v_length = first + n;
+            trials = first + n;
+            break;
+        }
+    }
+
+    fprintf(cp_out, "mc_run: %d trials, %d failed, %d thread(s), elapsed time %g s\n",
+            trials, failed, nthreads, seconds() - startTime);
+
+    for (j = 0; j < nout + nmeas; j++) {
+        struct dvec *v = (j < nout) ? vecs[j] : mvecs[j - nout];
+        double sum = 0.0, sum2 = 0.0, mean, var;
+        int m = 0;
+        for (i = 0; i < trials; i++) {
+            double x = v->v_realdata[i];
+            if (isnan(x))
+                continue;
+            sum += x;
+            sum2 += x * x;
+            m++;
+        }
+        if (m == 0)
+            continue;
+        mean = sum / m;
+        var = (m > 1) ? (sum2 - m * mean * mean) / (m - 1) : 0.0;
+        fprintf(cp_out, "  %-20s mean %-14g sigma %g\n",
+                v->v_name, mean, sqrt(MAX(var, 0.0)));
+    }
+
+    for (j = 0; j < nout; j++)
+        tfree(names[j]);
+    tfree(names);
+    tfree(vecs);
+    tfree(mvecs);
+    tfree(meas);
+    tfree(trial);
+    tfree(out);
+    tfree(status);
+}
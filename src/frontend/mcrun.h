@@ -0,0 +1,10 @@
+/*************
+ * Header file for mcrun.c
+ ************/
+
+#ifndef ngspice_MCRUN_H
+#define ngspice_MCRUN_H
+
+void com_mc_run(wordlist *wl);
+
+#endif
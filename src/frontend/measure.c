@@ -21,7 +21,6 @@
 #include "com_display.h"
 
 
-static wordlist *measure_parse_line(char *line);
 
 extern bool ft_batchmode;
 extern bool rflag;
@@ -510,7 +509,7 @@ check_autostop(char* what)
 
 
 /* parses the .meas line into a wordlist (without leading .meas) */
-static wordlist *
+wordlist *
 measure_parse_line(char *line)
 {
     size_t len;                         /* length of string */
@@ -27,7 +27,6 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "ngspice/dstring.h"
 #include "numparam/general.h"
 
-static void killplot(struct plot *pl);
 static void DelPlotWindows(struct plot *pl);
 
 /* check if the user want's to delete the scale vector of the current plot.
@@ -922,7 +921,8 @@ void com_destroy(wordlist *wl)
 
 
 
-static void killplot(struct plot *pl)
+/* Free plot pl and take it out of the plot list */
+void killplot(struct plot *pl)
 {
     if (eq(pl->pl_typename, "const")) {
         fprintf(cp_err, "Error: can't destroy the constant plot\n");
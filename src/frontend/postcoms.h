@@ -18,6 +18,7 @@ void com_splot(wordlist *wl);
 void com_remzerovec(wordlist* wl);
 
 void destroy_const_plot(void);
+void killplot(struct plot *pl);
 
 
 #endif
@@ -0,0 +1,1346 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Reduction of linear RC networks by PRIMA projection and TICER.
+ *
+ * With '.option prima=fmax' the expanded netlist is searched for plain
+ * resistors and capacitors (name, two nodes and a numerical value, nothing
+ * else).  Their nodes which are not referenced anywhere else in the deck,
+ * in the .save/.print/.meas lines or in the .control section are internal
+ * nodes.  Each connected group of internal nodes forms an RC network,
+ * which sees the rest of the circuit only through its port nodes.
+ *
+ * The network with internal nodes i and ports p is projected by the
+ * congruence transform
+ *
+ *      x_i = R0 v_p + X z,     R0 = -Gii^-1 Gip
+ *
+ * The first part keeps the DC behaviour exact: the port conductances
+ * become the Schur complement Gpp + Gpi R0, which stays an M-matrix, and
+ * the conductive coupling between ports and states vanishes.  The columns
+ * of X are an orthonormal basis of the block Krylov space of Gii^-1 Cii,
+ * started from Gii^-1 (Cii R0 + Cip).  As in PRIMA the transform is a
+ * congruence, so the reduced model is passive.  The basis is grown block
+ * by block until the port admittance of the model agrees with that of the
+ * full network, computed once by sparse factorization, within
+ * 'option primatol' (default 1e-3, relative) at frequencies up to fmax.
+ *
+ * The reduced matrices are brought into modal form, the states then only
+ * couple capacitively to the ports.  The model is written back as
+ * resistors and capacitors, which may have negative values, with one new
+ * node per state.  The original elements are commented out.  Networks are
+ * left alone if the model would not have fewer elements, if Gii is
+ * singular (nodes connected only by capacitors) or if the accuracy is not
+ * reached with PRIMA_MAXQ states.
+ *
+ * '.option ticer=tau' is a cheaper alternative, or a first step before
+ * PRIMA: the internal nodes with a time constant below tau are eliminated
+ * one by one, see prima_ticer().
+ *
+ * Inductors are not reduced, they and their nodes stay as they are.  The
+ * noise of the reduced resistors is not modelled, and the internal nodes
+ * and the replaced elements are no longer available to commands entered
+ * after the circuit has been loaded.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cpextern.h"
+#include "ngspice/hash.h"
+#include "ngspice/inpdefs.h"
+#include "ngspice/wordlist.h"
+#include "ngspice/stringutil.h"
+#include "ngspice/stringskip.h"
+#include "ngspice/spmatrix.h"
+
+#include "inpcom.h"
+#include "prima.h"
+
+
+#define PRIMA_MAXQ     200      /* limit of the states of one model */
+#define PRIMA_DEFLATE  1.0e-8   /* Krylov vectors below this are dropped,
+                                   relative to their norm before
+                                   orthogonalization */
+#define PRIMA_DROP     1.0e-12  /* elements below this, relative to the
+                                   largest diagonal entry, are dropped */
+#define PRIMA_NFREQ    4
+
+#define TICER_MAXDEG   4        /* nodes with more neighbours are kept */
+#define TICER_MAXPASS  10
+
+/* frequencies of the accuracy check, relative to fmax */
+static const double prima_freqs[PRIMA_NFREQ] = { 1.0, 0.5, 0.2, 0.05 };
+
+static const char prima_delim[] = " \t\r\n()[]{},='\"";
+static const char prima_opdelim[] = " \t\r\n()[]{},='\"+-*/<>!&|^?:;%";
+
+static double *ticer_tau;       /* sort key of ticer_cmp() */
+
+
+struct prima_node {
+    char *name;
+    int parent;                 /* union-find of the internal nodes */
+    bool port;                  /* referenced outside of the RC elements */
+    int loc;                    /* index in the current network */
+};
+
+struct prima_elt {
+    struct card *card;
+    int n1, n2;                 /* node indices, -1 for ground */
+    double val;                 /* conductance or capacitance */
+    bool cap;
+};
+
+struct prima_list {             /* sparse matrix block as triplets */
+    int n, size;
+    int *row, *col;
+    double *val;
+};
+
+struct prima_sys {              /* one RC network */
+    int ni, np;
+    struct prima_list gii, cii; /* internal block */
+    struct prima_list gip, cip; /* internal rows, port columns */
+    double *gpp, *cpp;          /* port block, np x np */
+};
+
+struct ticer_edge {             /* all elements between two nodes */
+    int a, b;                   /* b is -1 for ground */
+    double g, c;
+    bool changed;               /* to be written anew */
+    bool dead;                  /* removed with an eliminated node */
+};
+
+struct st_prima {
+    struct prima_node *nodes;
+    int nnodes, nsize;
+    struct prima_elt *elts;
+    int nelts, esize;
+    NGHASHPTR hash;
+    char *buf;
+    size_t bufsize;
+    double fmax, tol;
+    int nets, reduced;          /* statistics */
+    int oldelts, newelts;
+    int oldnodes, newnodes;
+};
+
+
+static void prima_scan(struct st_prima *pr, struct card *deck, wordlist *wl,
+                       wordlist *controls);
+static void prima_free(struct st_prima *pr);
+static void prima_reduce(struct st_prima *pr);
+static void prima_ticer(struct st_prima *pr, double tau);
+static int ticer_edge(struct ticer_edge **edges, int *nedges, int *esize,
+                      int **adj, int *nadj, int *sadj, int a, int b);
+static void ticer_link(int **adj, int *nadj, int *sadj, int n, int e);
+static int ticer_cmp(const void *a, const void *b);
+static int prima_node(struct st_prima *pr, char *name, bool create);
+static bool prima_parse(struct st_prima *pr, struct card *card);
+static void prima_mark(struct st_prima *pr, const char *line, const char *delim);
+static int prima_root(struct st_prima *pr, int n);
+static bool prima_net(struct st_prima *pr, int *elist, int ne, int netno);
+static void prima_add(struct prima_list *l, int row, int col, double val);
+static void prima_stamp(struct st_prima *pr, struct prima_sys *sy,
+                        int a, int b, double val, bool cap);
+static void prima_mult(struct prima_list *l, double *x, double *y);
+static void prima_solve(MatrixPtr mat, int n, double *x, double *work);
+static bool prima_modal(int q, int np, int ld, double *gz, double *cz,
+                        double *cpz, double *lambda, double *b);
+static void prima_jacobi(int n, double *a, double *v, double *d);
+static double prima_error(int np, int q, double w, double *gt, double *ct,
+                          double *lambda, double *b, double *yre, double *yim);
+
+
+/* Reduce the linear RC networks in the expanded deck.  wl and controls
+   hold the .save, .print, .meas etc. lines and the .control commands,
+   the nodes they reference are kept. */
+void
+inp_prima(struct card *deck, wordlist *wl, wordlist *controls)
+{
+    struct st_prima prima, *pr = &prima;
+    double tau;
+
+    if (cp_getvar("ticer_tau", CP_REAL, &tau, 0) && tau > 0) {
+        prima_scan(pr, deck, wl, controls);
+        prima_ticer(pr, tau);
+        prima_free(pr);
+    }
+
+    if (cp_getvar("prima_fmax", CP_REAL, &pr->fmax, 0) && pr->fmax > 0) {
+        if (!cp_getvar("prima_tol", CP_REAL, &pr->tol, 0) || pr->tol <= 0)
+            pr->tol = 1.0e-3;
+        prima_scan(pr, deck, wl, controls);
+        prima_reduce(pr);
+        prima_free(pr);
+    }
+}
+
+
+/* Collect the RC elements of the deck and find the ports. */
+static void
+prima_scan(struct st_prima *pr, struct card *deck, wordlist *wl,
+           wordlist *controls)
+{
+    struct card *card;
+    wordlist *ww;
+    int i;
+
+    pr->nodes = NULL;
+    pr->nnodes = pr->nsize = 0;
+    pr->elts = NULL;
+    pr->nelts = pr->esize = 0;
+    pr->hash = nghash_init(1024);
+    pr->buf = NULL;
+    pr->bufsize = 0;
+    pr->nets = pr->reduced = 0;
+    pr->oldelts = pr->newelts = 0;
+    pr->oldnodes = pr->newnodes = 0;
+
+    /* the RC elements and their nodes */
+    for (card = deck; card; card = card->nextcard)
+        prima_parse(pr, card);
+
+    if (pr->nelts == 0)
+        return;
+
+    /* any node referenced by another line is a port, the elements are
+       in deck order */
+    for (card = deck, i = 0; card; card = card->nextcard) {
+        char *line = card->line;
+        if (i < pr->nelts && pr->elts[i].card == card) {
+            i++;
+            continue;
+        }
+        if (*line == '*' || *line == '\0')
+            continue;
+        prima_mark(pr, line, prima_delim);
+        prima_mark(pr, line, prima_opdelim);
+    }
+    for (ww = wl; ww; ww = ww->wl_next) {
+        prima_mark(pr, ww->wl_word, prima_delim);
+        prima_mark(pr, ww->wl_word, prima_opdelim);
+    }
+    for (ww = controls; ww; ww = ww->wl_next) {
+        prima_mark(pr, ww->wl_word, prima_delim);
+        prima_mark(pr, ww->wl_word, prima_opdelim);
+    }
+}
+
+
+static void
+prima_free(struct st_prima *pr)
+{
+    int i;
+
+    nghash_free(pr->hash, NULL, NULL);
+    for (i = 0; i < pr->nnodes; i++)
+        tfree(pr->nodes[i].name);
+    tfree(pr->nodes);
+    tfree(pr->elts);
+    tfree(pr->buf);
+}
+
+
+/* Replace each RC network by its PRIMA model. */
+static void
+prima_reduce(struct st_prima *pr)
+{
+    int *netof, *count, *start, *elist;
+    int i, k, nnets;
+
+    if (pr->nelts == 0)
+        return;
+
+    /* connected groups of internal nodes */
+    for (i = 0; i < pr->nelts; i++) {
+        struct prima_elt *e = &pr->elts[i];
+        if (e->n1 >= 0 && e->n2 >= 0 &&
+            !pr->nodes[e->n1].port && !pr->nodes[e->n2].port) {
+            int r1 = prima_root(pr, e->n1);
+            int r2 = prima_root(pr, e->n2);
+            if (r1 != r2)
+                pr->nodes[r1].parent = r2;
+        }
+    }
+
+    /* number the networks, and sort the elements by network */
+    netof = TMALLOC(int, pr->nnodes);
+    for (i = 0; i < pr->nnodes; i++)
+        netof[i] = -1;
+    nnets = 0;
+    for (i = 0; i < pr->nnodes; i++)
+        if (!pr->nodes[i].port) {
+            int r = prima_root(pr, i);
+            if (netof[r] < 0)
+                netof[r] = nnets++;
+        }
+
+    count = TMALLOC(int, nnets + 1);
+    start = TMALLOC(int, nnets + 1);
+    elist = TMALLOC(int, pr->nelts);
+    for (i = 0; i < pr->nelts; i++) {
+        struct prima_elt *e = &pr->elts[i];
+        int n = (e->n1 >= 0 && !pr->nodes[e->n1].port) ? e->n1 : e->n2;
+        if (n >= 0 && !pr->nodes[n].port)
+            count[netof[prima_root(pr, n)]]++;
+    }
+    start[0] = 0;
+    for (k = 0; k < nnets; k++)
+        start[k + 1] = start[k] + count[k];
+    for (k = 0; k < nnets; k++)
+        count[k] = 0;
+    for (i = 0; i < pr->nelts; i++) {
+        struct prima_elt *e = &pr->elts[i];
+        int n = (e->n1 >= 0 && !pr->nodes[e->n1].port) ? e->n1 : e->n2;
+        if (n >= 0 && !pr->nodes[n].port) {
+            k = netof[prima_root(pr, n)];
+            elist[start[k] + count[k]++] = i;
+        }
+    }
+
+    for (k = 0; k < nnets; k++) {
+        pr->nets++;
+        if (prima_net(pr, elist + start[k], count[k], k + 1))
+            pr->reduced++;
+    }
+
+    tfree(netof);
+    tfree(count);
+    tfree(start);
+    tfree(elist);
+
+    fprintf(cp_out,
+            "PRIMA: %d of %d RC networks reduced, "
+            "%d elements replaced by %d, %d internal nodes by %d\n",
+            pr->reduced, pr->nets, pr->oldelts, pr->newelts,
+            pr->oldnodes, pr->newnodes);
+}
+
+
+/* TICER: eliminate the quick internal nodes, those with a time constant
+   C/G below tau.  A node with the conductances g_k and the capacitances
+   c_k to its neighbours k (ground included) is replaced by
+
+        g_kl = g_k g_l / G,     c_kl = (g_k c_l + g_l c_k) / G
+
+   between each pair of its neighbours, with G the sum of the g_k.  This
+   keeps the first two moments of the node's response, the Elmore delay
+   of the net is unchanged.  The quickest nodes go first, nodes with more
+   than TICER_MAXDEG neighbours are kept to limit the fill in.  The
+   elements between nodes that have been touched are written anew. */
+static void
+prima_ticer(struct st_prima *pr, double tau)
+{
+    struct ticer_edge *edges = NULL;
+    int nedges = 0, esize = 0;
+    int **adj, *nadj, *sadj, *nbr;
+    double *order;
+    int *eofelt, *idx;
+    bool *gone;
+    int i, j, k, n, pass, ncand, nelim = 0, nint = 0, nnew = 0, nold = 0;
+    struct card *anchor = NULL;
+    static int ticerno = 0;
+
+    if (pr->nelts == 0)
+        return;
+
+    adj = TMALLOC(int *, pr->nnodes);
+    nadj = TMALLOC(int, pr->nnodes);
+    sadj = TMALLOC(int, pr->nnodes);
+    gone = TMALLOC(bool, pr->nnodes);
+    eofelt = TMALLOC(int, pr->nelts);
+
+    /* one edge per pair of nodes, holding g and c */
+    for (i = 0; i < pr->nelts; i++) {
+        struct prima_elt *e = &pr->elts[i];
+        int a = e->n1, b = e->n2;
+        if (a < 0) {
+            a = b;
+            b = -1;
+        }
+        k = ticer_edge(&edges, &nedges, &esize, adj, nadj, sadj, a, b);
+        if (e->cap)
+            edges[k].c += e->val;
+        else
+            edges[k].g += e->val;
+        eofelt[i] = k;
+    }
+
+    /* candidates, sorted by their time constant */
+    order = TMALLOC(double, pr->nnodes);
+    idx = TMALLOC(int, pr->nnodes);
+    nbr = TMALLOC(int, TICER_MAXDEG + 2);
+    ncand = 0;
+    for (n = 0; n < pr->nnodes; n++) {
+        double g = 0.0, c = 0.0;
+        if (pr->nodes[n].port)
+            continue;
+        nint++;
+        for (k = 0; k < nadj[n]; k++) {
+            g += edges[adj[n][k]].g;
+            c += edges[adj[n][k]].c;
+        }
+        if (g > 0.0 && c < tau * g) {
+            order[n] = c / g;
+            idx[ncand++] = n;
+        }
+    }
+    ticer_tau = order;
+    qsort(idx, (size_t) ncand, sizeof(int), ticer_cmp);
+
+    for (pass = 0; pass < TICER_MAXPASS; pass++) {
+        int elim = 0;
+        for (i = 0; i < ncand; i++) {
+            double g = 0.0, c = 0.0;
+            int deg = 0, ground = -1;
+
+            n = idx[i];
+            if (gone[n])
+                continue;
+            for (k = 0; k < nadj[n]; k++) {
+                struct ticer_edge *ed = &edges[adj[n][k]];
+                if (ed->dead)
+                    continue;
+                g += ed->g;
+                c += ed->c;
+                if (ed->b < 0) {
+                    ground = adj[n][k];
+                } else {
+                    if (deg <= TICER_MAXDEG)
+                        nbr[deg] = adj[n][k];
+                    deg++;
+                }
+            }
+            if (deg > TICER_MAXDEG || !(g > 0.0) || c >= tau * g)
+                continue;
+            if (ground >= 0)
+                nbr[deg++] = ground;
+
+            /* connect the neighbours, the ground edge comes last.  New
+               edges may move the edge array. */
+            for (j = 0; j < deg; j++) {
+                int nj = (edges[nbr[j]].a == n) ? edges[nbr[j]].b
+                                                : edges[nbr[j]].a;
+                double gj = edges[nbr[j]].g, cj = edges[nbr[j]].c;
+                for (k = j + 1; k < deg; k++) {
+                    int nk = (edges[nbr[k]].a == n) ? edges[nbr[k]].b
+                                                    : edges[nbr[k]].a;
+                    double gk = edges[nbr[k]].g, ck = edges[nbr[k]].c;
+                    double dg = gj * gk / g;
+                    double dc = (gj * ck + gk * cj) / g;
+                    int e;
+                    if (dg == 0.0 && dc == 0.0)
+                        continue;
+                    e = ticer_edge(&edges, &nedges, &esize, adj, nadj, sadj,
+                                   nj, nk);
+                    edges[e].g += dg;
+                    edges[e].c += dc;
+                    edges[e].changed = TRUE;
+                }
+            }
+            for (k = 0; k < nadj[n]; k++) {
+                edges[adj[n][k]].dead = TRUE;
+                edges[adj[n][k]].changed = TRUE;
+            }
+            gone[n] = TRUE;
+            elim++;
+        }
+        nelim += elim;
+        if (elim == 0)
+            break;
+    }
+
+    /* comment out the elements of the changed edges, write the new ones
+       behind the first of them */
+    for (i = 0; i < pr->nelts; i++)
+        if (edges[eofelt[i]].changed) {
+            struct card *card = pr->elts[i].card;
+            if (!anchor)
+                anchor = card;
+            *card->line = '*';
+            nold++;
+        }
+    if (anchor) {
+        int linenum = anchor->linenum, linenum_orig = anchor->linenum_orig;
+        ticerno++;
+        for (k = 0; k < nedges; k++) {
+            struct ticer_edge *ed = &edges[k];
+            char *nb;
+            if (!ed->changed || ed->dead)
+                continue;
+            nb = (ed->b < 0) ? "0" : pr->nodes[ed->b].name;
+            /* every nonzero value is written, a zero one is no element */
+            if (ed->g != 0.0) {
+                anchor = insert_new_line(anchor,
+                                         tprintf("rticer%d_%d %s %s %.15g",
+                                                 ticerno, ++nnew,
+                                                 pr->nodes[ed->a].name, nb,
+                                                 1.0 / ed->g),
+                                         linenum, linenum_orig);
+            }
+            if (ed->c != 0.0) {
+                anchor = insert_new_line(anchor,
+                                         tprintf("cticer%d_%d %s %s %.15g",
+                                                 ticerno, ++nnew,
+                                                 pr->nodes[ed->a].name, nb,
+                                                 ed->c),
+                                         linenum, linenum_orig);
+            }
+        }
+    }
+
+    fprintf(cp_out,
+            "TICER: %d of %d internal nodes eliminated, "
+            "%d elements replaced by %d\n",
+            nelim, nint, nold, nnew);
+
+    for (n = 0; n < pr->nnodes; n++)
+        tfree(adj[n]);
+    tfree(adj);
+    tfree(nadj);
+    tfree(sadj);
+    tfree(gone);
+    tfree(eofelt);
+    tfree(order);
+    tfree(idx);
+    tfree(nbr);
+    tfree(edges);
+}
+
+
+/* Index of the edge between the nodes a and b (b may be ground), it is
+   added if not found. */
+static int
+ticer_edge(struct ticer_edge **edges, int *nedges, int *esize,
+           int **adj, int *nadj, int *sadj, int a, int b)
+{
+    struct ticer_edge *ed;
+    int k;
+
+    for (k = 0; k < nadj[a]; k++) {
+        ed = &(*edges)[adj[a][k]];
+        if (!ed->dead && ((ed->a == a && ed->b == b) ||
+                          (ed->a == b && ed->b == a)))
+            return adj[a][k];
+    }
+
+    if (*nedges == *esize) {
+        *esize = *esize ? 2 * *esize : 256;
+        *edges = TREALLOC(struct ticer_edge, *edges, *esize);
+    }
+    ed = &(*edges)[*nedges];
+    ed->a = a;
+    ed->b = b;
+    ed->g = ed->c = 0.0;
+    ed->changed = ed->dead = FALSE;
+
+    ticer_link(adj, nadj, sadj, a, *nedges);
+    if (b >= 0)
+        ticer_link(adj, nadj, sadj, b, *nedges);
+
+    return (*nedges)++;
+}
+
+
+static void
+ticer_link(int **adj, int *nadj, int *sadj, int n, int e)
+{
+    if (nadj[n] == sadj[n]) {
+        sadj[n] = sadj[n] ? 2 * sadj[n] : 4;
+        adj[n] = TREALLOC(int, adj[n], sadj[n]);
+    }
+    adj[n][nadj[n]++] = e;
+}
+
+
+static int
+ticer_cmp(const void *a, const void *b)
+{
+    double ta = ticer_tau[*(const int *) a];
+    double tb = ticer_tau[*(const int *) b];
+
+    return (ta < tb) ? -1 : (ta > tb) ? 1 : 0;
+}
+
+
+/* Index of the node called name, -1 for ground.  If it is not known yet,
+   it is added if create is set, else -2 is returned. */
+static int
+prima_node(struct st_prima *pr, char *name, bool create)
+{
+    void *data;
+
+    if (eq(name, "0"))
+        return -1;
+
+    data = nghash_find(pr->hash, name);
+    if (data)
+        return (int) ((size_t) data - 1);
+    if (!create)
+        return -2;
+
+    if (pr->nnodes == pr->nsize) {
+        pr->nsize = pr->nsize ? 2 * pr->nsize : 256;
+        pr->nodes = TREALLOC(struct prima_node, pr->nodes, pr->nsize);
+    }
+    pr->nodes[pr->nnodes].name = copy(name);
+    pr->nodes[pr->nnodes].parent = pr->nnodes;
+    pr->nodes[pr->nnodes].port = FALSE;
+    pr->nodes[pr->nnodes].loc = -1;
+    nghash_insert(pr->hash, pr->nodes[pr->nnodes].name,
+                  (void *) (size_t) (pr->nnodes + 1));
+    return pr->nnodes++;
+}
+
+
+/* Accept card if it is a plain resistor or capacitor. */
+static bool
+prima_parse(struct st_prima *pr, struct card *card)
+{
+    char *line = card->line;
+    char *tok[5], *s;
+    size_t len = strlen(line);
+    int ntok, err;
+    bool cap;
+    double val;
+    struct prima_elt *e;
+
+    if (*line == 'r' || *line == 'R')
+        cap = FALSE;
+    else if (*line == 'c' || *line == 'C')
+        cap = TRUE;
+    else
+        return FALSE;
+
+    if (pr->bufsize < len + 1) {
+        pr->bufsize = len + 1;
+        pr->buf = TREALLOC(char, pr->buf, pr->bufsize);
+    }
+    strcpy(pr->buf, line);
+
+    s = pr->buf;
+    for (ntok = 0; ntok < 5; ntok++) {
+        s = skip_ws(s);
+        if (*s == '\0')
+            break;
+        tok[ntok] = s;
+        while (*s && !isspace_c(*s))
+            s++;
+        if (*s)
+            *s++ = '\0';
+    }
+    if (ntok != 4 || eq(tok[1], tok[2]))
+        return FALSE;
+
+    s = tok[3];
+    if (!isdigit_c(*s) && *s != '.')
+        return FALSE;
+    if (cap)
+        val = INPevaluateRKM_C(&s, &err, 0);
+    else
+        val = INPevaluateRKM_R(&s, &err, 0);
+    if (err)
+        return FALSE;
+    while (isalpha_c(*s))
+        s++;
+    if (*s != '\0')
+        return FALSE;
+    if (cap ? !(val >= 0.0) : !(val > 0.0))
+        return FALSE;
+
+    if (pr->nelts == pr->esize) {
+        pr->esize = pr->esize ? 2 * pr->esize : 256;
+        pr->elts = TREALLOC(struct prima_elt, pr->elts, pr->esize);
+    }
+    e = &pr->elts[pr->nelts++];
+    e->card = card;
+    e->n1 = prima_node(pr, tok[1], TRUE);
+    e->n2 = prima_node(pr, tok[2], TRUE);
+    e->val = cap ? val : 1.0 / val;
+    e->cap = cap;
+
+    return TRUE;
+}
+
+
+/* Mark the nodes among the tokens of line as ports. */
+static void
+prima_mark(struct st_prima *pr, const char *line, const char *delim)
+{
+    const char *s = line;
+
+    for (;;) {
+        size_t len;
+        int n;
+
+        s += strspn(s, delim);
+        len = strcspn(s, delim);
+        if (len == 0)
+            break;
+        if (pr->bufsize < len + 1) {
+            pr->bufsize = len + 1;
+            pr->buf = TREALLOC(char, pr->buf, pr->bufsize);
+        }
+        memcpy(pr->buf, s, len);
+        pr->buf[len] = '\0';
+        n = prima_node(pr, pr->buf, FALSE);
+        if (n >= 0)
+            pr->nodes[n].port = TRUE;
+        s += len;
+    }
+}
+
+
+static int
+prima_root(struct st_prima *pr, int n)
+{
+    while (pr->nodes[n].parent != n) {
+        pr->nodes[n].parent = pr->nodes[pr->nodes[n].parent].parent;
+        n = pr->nodes[n].parent;
+    }
+    return n;
+}
+
+
+static void
+prima_add(struct prima_list *l, int row, int col, double val)
+{
+    if (l->n == l->size) {
+        l->size = l->size ? 2 * l->size : 64;
+        l->row = TREALLOC(int, l->row, l->size);
+        l->col = TREALLOC(int, l->col, l->size);
+        l->val = TREALLOC(double, l->val, l->size);
+    }
+    l->row[l->n] = row;
+    l->col[l->n] = col;
+    l->val[l->n] = val;
+    l->n++;
+}
+
+
+/* Stamp an element of value val between the nodes a and b.  The block
+   Gpi is the transpose of Gip and is not stored. */
+static void
+prima_stamp(struct st_prima *pr, struct prima_sys *sy,
+            int a, int b, double val, bool cap)
+{
+    int n[2], m[2];
+    int i, j;
+
+    n[0] = a;
+    n[1] = b;
+    for (i = 0; i < 2; i++)
+        for (j = 0; j < 2; j++) {
+            struct prima_node *x, *y;
+            double v = (i == j) ? val : -val;
+            if (n[i] < 0 || n[j] < 0)
+                continue;
+            x = &pr->nodes[n[i]];
+            y = &pr->nodes[n[j]];
+            m[0] = x->loc;
+            m[1] = y->loc;
+            if (!x->port && !y->port)
+                prima_add(cap ? &sy->cii : &sy->gii, m[0], m[1], v);
+            else if (!x->port)
+                prima_add(cap ? &sy->cip : &sy->gip, m[0], m[1], v);
+            else if (y->port)
+                (cap ? sy->cpp : sy->gpp)[m[0] * sy->np + m[1]] += v;
+        }
+}
+
+
+/* y += L x */
+static void
+prima_mult(struct prima_list *l, double *x, double *y)
+{
+    int k;
+
+    for (k = 0; k < l->n; k++)
+        y[l->row[k]] += l->val[k] * x[l->col[k]];
+}
+
+
+/* x = G^-1 x, the sparse package counts from 1 */
+static void
+prima_solve(MatrixPtr mat, int n, double *x, double *work)
+{
+    work[0] = 0.0;
+    memcpy(work + 1, x, (size_t) n * sizeof(double));
+    spSolve(mat, work, work, NULL, NULL);
+    memcpy(x, work + 1, (size_t) n * sizeof(double));
+}
+
+
+/* Reduce the network made of the elements elist[].  Returns TRUE if it
+   has been replaced by its model. */
+static bool
+prima_net(struct st_prima *pr, int *elist, int ne, int netno)
+{
+    struct prima_sys sys, *sy = &sys;
+    int *inodes, *pnodes;
+    int ni = 0, np = 0, nq, qcap, q = 0, bs, be;
+    int i, j, k, l, p, f, err, nnew;
+    MatrixPtr gmat = NULL, cmat = NULL;
+    double *r0 = NULL, *cr0 = NULL, *gt = NULL, *ct = NULL;
+    double *yre = NULL, *yim = NULL, *x = NULL;
+    double *gz = NULL, *cz = NULL, *cpz = NULL, *lambda = NULL, *b = NULL;
+    double *v, *gv, *cv, *work, *wim;
+    double g0, gmax, cmax, sg0;
+    bool ok = FALSE;
+    wordlist *lines = NULL, *end = NULL, *ww;
+
+    inodes = TMALLOC(int, 2 * ne);
+    pnodes = TMALLOC(int, 2 * ne);
+    for (k = 0; k < ne; k++) {
+        struct prima_elt *e = &pr->elts[elist[k]];
+        int nn[2];
+        nn[0] = e->n1;
+        nn[1] = e->n2;
+        for (i = 0; i < 2; i++) {
+            struct prima_node *node;
+            if (nn[i] < 0)
+                continue;
+            node = &pr->nodes[nn[i]];
+            if (node->loc >= 0)
+                continue;
+            if (node->port) {
+                node->loc = np;
+                pnodes[np++] = nn[i];
+            } else {
+                node->loc = ni;
+                inodes[ni++] = nn[i];
+            }
+        }
+    }
+
+    memset(sy, 0, sizeof(*sy));
+    sy->ni = ni;
+    sy->np = np;
+
+    /* the port block alone is dense, nothing to gain if it is as large
+       as the network */
+    if (np == 0 || np * (np + 1) / 2 >= ne)
+        goto cleanup;
+
+    sy->gpp = TMALLOC(double, np * np);
+    sy->cpp = TMALLOC(double, np * np);
+    for (k = 0; k < ne; k++) {
+        struct prima_elt *e = &pr->elts[elist[k]];
+        prima_stamp(pr, sy, e->n1, e->n2, e->val, e->cap);
+    }
+
+    work = TMALLOC(double, ni + 1);
+    wim = TMALLOC(double, ni + 1);
+    v = TMALLOC(double, ni);
+    gv = TMALLOC(double, ni);
+    cv = TMALLOC(double, ni);
+
+    /* Gii */
+    gmat = spCreate(ni, 0, &err);
+    if (!gmat || err != spOKAY)
+        goto fail;
+    for (k = 0; k < sy->gii.n; k++)
+        *spGetElement(gmat, sy->gii.row[k] + 1, sy->gii.col[k] + 1) +=
+            sy->gii.val[k];
+    if (spOrderAndFactor(gmat, NULL, 1.0e-3, 0.0, 1) != spOKAY)
+        goto fail;
+
+    g0 = 0.0;
+    for (k = 0; k < sy->gii.n; k++)
+        if (sy->gii.row[k] == sy->gii.col[k])
+            g0 += sy->gii.val[k];
+    g0 /= ni;
+
+    /* R0 = -Gii^-1 Gip, and Cii R0 */
+    r0 = TMALLOC(double, ni * np);
+    cr0 = TMALLOC(double, ni * np);
+    for (p = 0; p < np; p++) {
+        double *r = r0 + p * ni;
+        for (i = 0; i < ni; i++)
+            v[i] = 0.0;
+        for (k = 0; k < sy->gip.n; k++)
+            if (sy->gip.col[k] == p)
+                v[sy->gip.row[k]] -= sy->gip.val[k];
+        prima_solve(gmat, ni, v, work);
+        memcpy(r, v, (size_t) ni * sizeof(double));
+        prima_mult(&sy->cii, r, cr0 + p * ni);
+    }
+
+    /* port blocks of the transformed network */
+    gt = TMALLOC(double, np * np);
+    ct = TMALLOC(double, np * np);
+    for (p = 0; p < np; p++) {
+        double *rp = r0 + p * ni;
+        for (k = 0; k < np; k++) {
+            double *rk = r0 + k * ni;
+            double *crk = cr0 + k * ni;
+            double sg = 0.0, sc = 0.0;
+            for (l = 0; l < sy->gip.n; l++)
+                if (sy->gip.col[l] == p)
+                    sg += sy->gip.val[l] * rk[sy->gip.row[l]];
+            for (l = 0; l < sy->cip.n; l++) {
+                if (sy->cip.col[l] == p)
+                    sc += sy->cip.val[l] * rk[sy->cip.row[l]];
+                if (sy->cip.col[l] == k)
+                    sc += sy->cip.val[l] * rp[sy->cip.row[l]];
+            }
+            for (i = 0; i < ni; i++)
+                sc += rp[i] * crk[i];
+            gt[p * np + k] = sy->gpp[p * np + k] + sg;
+            ct[p * np + k] = sy->cpp[p * np + k] + sc;
+        }
+    }
+    for (p = 0; p < np; p++)
+        for (k = 0; k < p; k++) {
+            gt[p * np + k] = gt[k * np + p] =
+                0.5 * (gt[p * np + k] + gt[k * np + p]);
+            ct[p * np + k] = ct[k * np + p] =
+                0.5 * (ct[p * np + k] + ct[k * np + p]);
+        }
+
+    /* admittance of the full network at the test frequencies */
+    yre = TMALLOC(double, PRIMA_NFREQ * np * np);
+    yim = TMALLOC(double, PRIMA_NFREQ * np * np);
+    cmat = spCreate(ni, 1, &err);
+    if (!cmat || err != spOKAY)
+        goto fail;
+    for (f = 0; f < PRIMA_NFREQ; f++) {
+        double w = 2.0 * M_PI * pr->fmax * prima_freqs[f];
+        double *fre = yre + f * np * np, *fim = yim + f * np * np;
+        spClear(cmat);
+        for (k = 0; k < sy->gii.n; k++)
+            spGetElement(cmat, sy->gii.row[k] + 1,
+                         sy->gii.col[k] + 1)[0] += sy->gii.val[k];
+        for (k = 0; k < sy->cii.n; k++)
+            spGetElement(cmat, sy->cii.row[k] + 1,
+                         sy->cii.col[k] + 1)[1] += w * sy->cii.val[k];
+        if (spOrderAndFactor(cmat, NULL, 1.0e-3, 0.0, 1) != spOKAY)
+            goto fail;
+        for (p = 0; p < np; p++) {
+            for (i = 0; i <= ni; i++)
+                work[i] = wim[i] = 0.0;
+            for (k = 0; k < sy->gip.n; k++)
+                if (sy->gip.col[k] == p)
+                    work[sy->gip.row[k] + 1] += sy->gip.val[k];
+            for (k = 0; k < sy->cip.n; k++)
+                if (sy->cip.col[k] == p)
+                    wim[sy->cip.row[k] + 1] += w * sy->cip.val[k];
+            spSolve(cmat, work, work, wim, wim);
+            for (k = 0; k < np; k++) {
+                fre[k * np + p] = sy->gpp[k * np + p];
+                fim[k * np + p] = w * sy->cpp[k * np + p];
+            }
+            for (k = 0; k < sy->gip.n; k++) {
+                int r = sy->gip.row[k] + 1, c = sy->gip.col[k];
+                fre[c * np + p] -= sy->gip.val[k] * work[r];
+                fim[c * np + p] -= sy->gip.val[k] * wim[r];
+            }
+            for (k = 0; k < sy->cip.n; k++) {
+                int r = sy->cip.row[k] + 1, c = sy->cip.col[k];
+                fre[c * np + p] += w * sy->cip.val[k] * wim[r];
+                fim[c * np + p] -= w * sy->cip.val[k] * work[r];
+            }
+        }
+    }
+
+    /* the model may not have more elements than the network: each state
+       brings at least a resistor, a capacitor and a coupling */
+    qcap = MIN(ni, MIN(PRIMA_MAXQ, (ne - np * (np + 1) / 2) / 3));
+    x = TMALLOC(double, ni * (qcap + 1));
+    gz = TMALLOC(double, qcap * qcap + 1);
+    cz = TMALLOC(double, qcap * qcap + 1);
+    cpz = TMALLOC(double, np * qcap + 1);
+    lambda = TMALLOC(double, qcap + 1);
+    b = TMALLOC(double, np * qcap + 1);
+
+    /* block Krylov space of Gii^-1 Cii from Gii^-1 (Cii R0 + Cip) */
+    bs = be = 0;
+    for (nq = 0;; nq++) {
+        int nb = (nq == 0) ? np : be - bs;
+        int nstart = q;
+        double maxerr;
+
+        for (j = 0; j < nb && q < qcap; j++) {
+            double norm0, norm;
+            int pass;
+
+            if (nq == 0) {
+                memcpy(v, cr0 + j * ni, (size_t) ni * sizeof(double));
+                for (k = 0; k < sy->cip.n; k++)
+                    if (sy->cip.col[k] == j)
+                        v[sy->cip.row[k]] += sy->cip.val[k];
+            } else {
+                for (i = 0; i < ni; i++)
+                    v[i] = 0.0;
+                prima_mult(&sy->cii, x + (bs + j) * ni, v);
+            }
+            prima_solve(gmat, ni, v, work);
+
+            norm0 = 0.0;
+            for (i = 0; i < ni; i++)
+                norm0 += v[i] * v[i];
+            norm0 = sqrt(norm0);
+            if (norm0 == 0.0)
+                continue;
+            for (pass = 0; pass < 2; pass++)
+                for (l = 0; l < q; l++) {
+                    double *xl = x + l * ni, h = 0.0;
+                    for (i = 0; i < ni; i++)
+                        h += xl[i] * v[i];
+                    for (i = 0; i < ni; i++)
+                        v[i] -= h * xl[i];
+                }
+            norm = 0.0;
+            for (i = 0; i < ni; i++)
+                norm += v[i] * v[i];
+            norm = sqrt(norm);
+            if (norm <= PRIMA_DEFLATE * norm0)
+                continue;
+
+            /* new column, extend the projected matrices */
+            for (i = 0; i < ni; i++)
+                x[q * ni + i] = v[i] / norm;
+            for (i = 0; i < ni; i++)
+                gv[i] = cv[i] = 0.0;
+            prima_mult(&sy->gii, x + q * ni, gv);
+            prima_mult(&sy->cii, x + q * ni, cv);
+            for (l = 0; l <= q; l++) {
+                double *xl = x + l * ni, sg = 0.0, sc = 0.0;
+                for (i = 0; i < ni; i++) {
+                    sg += xl[i] * gv[i];
+                    sc += xl[i] * cv[i];
+                }
+                gz[l * qcap + q] = gz[q * qcap + l] = sg;
+                cz[l * qcap + q] = cz[q * qcap + l] = sc;
+            }
+            for (p = 0; p < np; p++) {
+                double sc = 0.0, *crp = cr0 + p * ni;
+                for (i = 0; i < ni; i++)
+                    sc += crp[i] * x[q * ni + i];
+                cpz[p * qcap + q] = sc;
+            }
+            for (k = 0; k < sy->cip.n; k++)
+                cpz[sy->cip.col[k] * qcap + q] +=
+                    sy->cip.val[k] * x[q * ni + sy->cip.row[k]];
+            q++;
+        }
+        bs = nstart;
+        be = q;
+
+        /* compare the model with the network */
+        if (!prima_modal(q, np, qcap, gz, cz, cpz, lambda, b))
+            break;
+        maxerr = 0.0;
+        for (f = 0; f < PRIMA_NFREQ; f++) {
+            double w = 2.0 * M_PI * pr->fmax * prima_freqs[f];
+            double e = prima_error(np, q, w, gt, ct, lambda, b,
+                                   yre + f * np * np, yim + f * np * np);
+            maxerr = MAX(maxerr, e);
+        }
+        if (maxerr <= pr->tol) {
+            ok = TRUE;
+            break;
+        }
+        if (be == bs || q >= qcap)
+            break;
+    }
+    if (!ok)
+        goto fail;
+
+    /* Write the model.  The states have g0 to ground, the capacitance
+       matrix of ports and states is made of elements between each pair
+       of nodes and to ground. */
+    sg0 = sqrt(g0);
+    gmax = cmax = 0.0;
+    for (p = 0; p < np; p++) {
+        gmax = MAX(gmax, fabs(gt[p * np + p]));
+        cmax = MAX(cmax, fabs(ct[p * np + p]));
+    }
+    for (j = 0; j < q; j++)
+        cmax = MAX(cmax, g0 * lambda[j]);
+
+    nnew = 0;
+    for (p = 0; p < np; p++) {
+        char *pn = pr->nodes[pnodes[p]].name;
+        double gsum = 0.0, csum = 0.0;
+        for (k = 0; k < np; k++) {
+            gsum += gt[p * np + k];
+            csum += ct[p * np + k];
+            if (k <= p)
+                continue;
+            if (fabs(gt[p * np + k]) > PRIMA_DROP * gmax)
+                wl_append_word(&lines, &end,
+                               tprintf("rprima%d_%d %s %s %.15g", netno,
+                                       ++nnew, pn,
+                                       pr->nodes[pnodes[k]].name,
+                                       -1.0 / gt[p * np + k]));
+            if (fabs(ct[p * np + k]) > PRIMA_DROP * cmax)
+                wl_append_word(&lines, &end,
+                               tprintf("cprima%d_%d %s %s %.15g", netno,
+                                       ++nnew, pn,
+                                       pr->nodes[pnodes[k]].name,
+                                       -ct[p * np + k]));
+        }
+        for (j = 0; j < q; j++) {
+            double c = sg0 * b[p * q + j];
+            csum += c;
+            if (fabs(c) > PRIMA_DROP * cmax)
+                wl_append_word(&lines, &end,
+                               tprintf("cprima%d_%d %s prima%d_%d %.15g",
+                                       netno, ++nnew, pn, netno, j + 1, -c));
+        }
+        if (fabs(gsum) > PRIMA_DROP * gmax)
+            wl_append_word(&lines, &end,
+                           tprintf("rprima%d_%d %s 0 %.15g", netno, ++nnew,
+                                   pn, 1.0 / gsum));
+        if (fabs(csum) > PRIMA_DROP * cmax)
+            wl_append_word(&lines, &end,
+                           tprintf("cprima%d_%d %s 0 %.15g", netno, ++nnew,
+                                   pn, csum));
+    }
+    for (j = 0; j < q; j++) {
+        double csum = g0 * lambda[j];
+        for (p = 0; p < np; p++)
+            csum += sg0 * b[p * q + j];
+        wl_append_word(&lines, &end,
+                       tprintf("rprima%d_%d prima%d_%d 0 %.15g", netno,
+                               ++nnew, netno, j + 1, 1.0 / g0));
+        if (fabs(csum) > PRIMA_DROP * cmax)
+            wl_append_word(&lines, &end,
+                           tprintf("cprima%d_%d prima%d_%d 0 %.15g", netno,
+                                   ++nnew, netno, j + 1, csum));
+    }
+
+    if (nnew < ne) {
+        struct card *prev = pr->elts[elist[0]].card;
+        int linenum = prev->linenum, linenum_orig = prev->linenum_orig;
+        for (ww = lines; ww; ww = ww->wl_next) {
+            prev = insert_new_line(prev, ww->wl_word, linenum, linenum_orig);
+            ww->wl_word = NULL;
+        }
+        for (k = 0; k < ne; k++)
+            *pr->elts[elist[k]].card->line = '*';
+        pr->oldelts += ne;
+        pr->newelts += nnew;
+        pr->oldnodes += ni;
+        pr->newnodes += q;
+        ok = TRUE;
+    } else {
+        ok = FALSE;
+    }
+    wl_free(lines);
+
+fail:
+    if (gmat)
+        spDestroy(gmat);
+    if (cmat)
+        spDestroy(cmat);
+    tfree(work);
+    tfree(wim);
+    tfree(v);
+    tfree(gv);
+    tfree(cv);
+
+cleanup:
+    for (i = 0; i < ni; i++)
+        pr->nodes[inodes[i]].loc = -1;
+    for (p = 0; p < np; p++)
+        pr->nodes[pnodes[p]].loc = -1;
+    tfree(inodes);
+    tfree(pnodes);
+    tfree(sy->gii.row); tfree(sy->gii.col); tfree(sy->gii.val);
+    tfree(sy->cii.row); tfree(sy->cii.col); tfree(sy->cii.val);
+    tfree(sy->gip.row); tfree(sy->gip.col); tfree(sy->gip.val);
+    tfree(sy->cip.row); tfree(sy->cip.col); tfree(sy->cip.val);
+    tfree(sy->gpp);
+    tfree(sy->cpp);
+    tfree(r0);
+    tfree(cr0);
+    tfree(gt);
+    tfree(ct);
+    tfree(yre);
+    tfree(yim);
+    tfree(x);
+    tfree(gz);
+    tfree(cz);
+    tfree(cpz);
+    tfree(lambda);
+    tfree(b);
+
+    return ok;
+}
+
+
+/* Modal form of the states: with Gz = L L^T and L^-1 Cz L^-T = V D V^T
+   the states S^-1 z, S = L^-T V, have unit conductance to ground and the
+   capacitances lambda = D.  b returns Cpz S, np x q.  The matrices have
+   the leading dimension ld. */
+static bool
+prima_modal(int q, int np, int ld, double *gz, double *cz, double *cpz,
+            double *lambda, double *b)
+{
+    double *lm, *t, *m, *vec;
+    int i, j, k, p;
+    bool ok = TRUE;
+
+    if (q == 0)
+        return TRUE;
+
+    lm = TMALLOC(double, q * q);
+    t = TMALLOC(double, q * q);
+    m = TMALLOC(double, q * q);
+    vec = TMALLOC(double, q * q);
+
+    for (j = 0; j < q; j++) {
+        double s = gz[j * ld + j];
+        for (k = 0; k < j; k++)
+            s -= lm[j * q + k] * lm[j * q + k];
+        if (s <= 0.0) {
+            ok = FALSE;
+            goto done;
+        }
+        lm[j * q + j] = sqrt(s);
+        for (i = j + 1; i < q; i++) {
+            s = gz[i * ld + j];
+            for (k = 0; k < j; k++)
+                s -= lm[i * q + k] * lm[j * q + k];
+            lm[i * q + j] = s / lm[j * q + j];
+        }
+    }
+
+    /* T = L^-1 Cz, and L^-1 Cz L^-T = L^-1 T^T as Cz is symmetric */
+    for (j = 0; j < q; j++)
+        for (i = 0; i < q; i++) {
+            double s = cz[i * ld + j];
+            for (k = 0; k < i; k++)
+                s -= lm[i * q + k] * t[k * q + j];
+            t[i * q + j] = s / lm[i * q + i];
+        }
+    for (j = 0; j < q; j++)
+        for (i = 0; i < q; i++) {
+            double s = t[j * q + i];
+            for (k = 0; k < i; k++)
+                s -= lm[i * q + k] * m[k * q + j];
+            m[i * q + j] = s / lm[i * q + i];
+        }
+    for (i = 0; i < q; i++)
+        for (j = 0; j < i; j++)
+            m[i * q + j] = m[j * q + i] = 0.5 * (m[i * q + j] + m[j * q + i]);
+
+    prima_jacobi(q, m, vec, lambda);
+    for (j = 0; j < q; j++)
+        if (lambda[j] < 0.0)
+            lambda[j] = 0.0;
+
+    /* S = L^-T V */
+    for (j = 0; j < q; j++)
+        for (i = q - 1; i >= 0; i--) {
+            double s = vec[i * q + j];
+            for (k = i + 1; k < q; k++)
+                s -= lm[k * q + i] * t[k * q + j];
+            t[i * q + j] = s / lm[i * q + i];
+        }
+
+    for (p = 0; p < np; p++)
+        for (j = 0; j < q; j++) {
+            double s = 0.0;
+            for (k = 0; k < q; k++)
+                s += cpz[p * ld + k] * t[k * q + j];
+            b[p * q + j] = s;
+        }
+
+done:
+    tfree(lm);
+    tfree(t);
+    tfree(m);
+    tfree(vec);
+    return ok;
+}
+
+
+/* Eigenvalues d and eigenvectors, the columns of v, of the symmetric
+   n x n matrix a by cyclic Jacobi rotations.  a is destroyed. */
+static void
+prima_jacobi(int n, double *a, double *v, double *d)
+{
+    int i, j, k, sweep;
+
+    for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+            v[i * n + j] = (i == j) ? 1.0 : 0.0;
+
+    for (sweep = 0; sweep < 50; sweep++) {
+        double off = 0.0, diag = 0.0;
+        for (i = 0; i < n; i++) {
+            diag += a[i * n + i] * a[i * n + i];
+            for (j = i + 1; j < n; j++)
+                off += a[i * n + j] * a[i * n + j];
+        }
+        if (off <= 1.0e-30 * diag)
+            break;
+
+        for (i = 0; i < n - 1; i++)
+            for (j = i + 1; j < n; j++) {
+                double aij = a[i * n + j], theta, t, c, s;
+                if (aij == 0.0)
+                    continue;
+                theta = (a[j * n + j] - a[i * n + i]) / (2.0 * aij);
+                t = 1.0 / (fabs(theta) + sqrt(theta * theta + 1.0));
+                if (theta < 0.0)
+                    t = -t;
+                c = 1.0 / sqrt(t * t + 1.0);
+                s = t * c;
+                for (k = 0; k < n; k++) {
+                    double aki = a[k * n + i], akj = a[k * n + j];
+                    a[k * n + i] = c * aki - s * akj;
+                    a[k * n + j] = s * aki + c * akj;
+                }
+                for (k = 0; k < n; k++) {
+                    double aik = a[i * n + k], ajk = a[j * n + k];
+                    a[i * n + k] = c * aik - s * ajk;
+                    a[j * n + k] = s * aik + c * ajk;
+                }
+                for (k = 0; k < n; k++) {
+                    double vki = v[k * n + i], vkj = v[k * n + j];
+                    v[k * n + i] = c * vki - s * vkj;
+                    v[k * n + j] = s * vki + c * vkj;
+                }
+            }
+    }
+
+    for (i = 0; i < n; i++)
+        d[i] = a[i * n + i];
+}
+
+
+/* Relative difference of the admittance of the model at w to that of the
+   network, yre + j yim. */
+static double
+prima_error(int np, int q, double w, double *gt, double *ct,
+            double *lambda, double *b, double *yre, double *yim)
+{
+    double diff = 0.0, norm = 0.0;
+    int p, k, j;
+
+    for (p = 0; p < np; p++)
+        for (k = 0; k < np; k++) {
+            double re = gt[p * np + k], im = w * ct[p * np + k], dr, di;
+            for (j = 0; j < q; j++) {
+                double bb = b[p * q + j] * b[k * q + j];
+                double wl = w * lambda[j];
+                double den = 1.0 + wl * wl;
+                re += w * w * bb / den;
+                im -= w * w * wl * bb / den;
+            }
+            dr = re - yre[p * np + k];
+            di = im - yim[p * np + k];
+            diff += dr * dr + di * di;
+            norm += yre[p * np + k] * yre[p * np + k] +
+                yim[p * np + k] * yim[p * np + k];
+        }
+
+    return (norm > 0.0) ? sqrt(diff / norm) : 0.0;
+}
@@ -0,0 +1,10 @@
+/*************
+ * Header file for prima.c
+ ************/
+
+#ifndef ngspice_PRIMA_H
+#define ngspice_PRIMA_H
+
+void inp_prima(struct card *deck, wordlist *wl, wordlist *controls);
+
+#endif
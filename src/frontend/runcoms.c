@@ -193,6 +193,15 @@ com_sp(wordlist* wl)
 {
     dosim("sp", wl);
 }
+
+#ifdef WITH_HB
+/* Harmonic Balance Analysis */
+void
+com_hb(wordlist* wl)
+{
+    dosim("hb", wl);
+}
+#endif
 #endif
 
 static int dosim(
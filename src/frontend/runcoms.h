@@ -22,6 +22,9 @@ void com_noise(wordlist *wl);
 void com_run(wordlist *wl);
 #ifdef RFSPICE
 void com_sp(wordlist* wl);
+#ifdef WITH_HB
+void com_hb(wordlist* wl);
+#endif
 #endif
 
 extern FILE *rawfileFp;
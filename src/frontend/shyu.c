@@ -355,42 +355,35 @@ if_sens_run(CKTcircuit *ckt, wordlist *args, INPtables *tab)
     }
 #ifdef WITH_HB
     if (strcmp(token, "hb") == 0) {
-        JOB* spJob;
+        JOB* hbJob;
         which = ft_find_analysis("HB");
         if (which == -1) {
             current->error = INPerrCat
             (current->error,
-                INPmkTemp("S-Param analysis unsupported\n"));
+                INPmkTemp("Harmonic balance analysis unsupported\n"));
             return (0); /* temporary */
         }
         err = ft_sim->newAnalysis(ft_curckt->ci_ckt, which, "hban",
-            &spJob, ft_curckt->ci_specTask);
+            &hbJob, ft_curckt->ci_specTask);
         if (err) {
             ft_sperror(err, "createHB"); /* or similar error message */
             return (0); /* temporary */
         }
 
-        INPgetTok(&line, &steptype, 1); /* get DEC, OCT, or LIN */
-        ptemp.iValue = 1;
-        error = INPapName(ckt, which, spJob, steptype, &ptemp);
-        if (error)
-            current->error = INPerrCat(current->error, INPerror(error));
-        parm = INPgetValue(ckt, &line, IF_INTEGER, tab);/* number of points*/
-        error = INPapName(ckt, which, spJob, "numsteps", parm);
-        if (error)
-            current->error = INPerrCat(current->error, INPerror(error));
-        parm = INPgetValue(ckt, &line, IF_REAL, tab); /* fstart */
-        error = INPapName(ckt, which, spJob, "start", parm);
-        if (error)
-            current->error = INPerrCat(current->error, INPerror(error));
-        parm = INPgetValue(ckt, &line, IF_REAL, tab); /* fstop */
-        error = INPapName(ckt, which, spJob, "stop", parm);
+        parm = INPgetValue(ckt, &line, IF_REAL, tab); /* fundamental */
+        error = INPapName(ckt, which, hbJob, "freq", parm);
         if (error)
             current->error = INPerrCat(current->error, INPerror(error));
-        parm = INPgetValue(ckt, &line, IF_INTEGER, tab); /* fstop */
-        error = INPapName(ckt, which, spJob, "donoise", parm);
+        parm = INPgetValue(ckt, &line, IF_INTEGER, tab); /* harmonics */
+        error = INPapName(ckt, which, hbJob, "harmonics", parm);
         if (error)
             current->error = INPerrCat(current->error, INPerror(error));
+        if (*line) {
+            parm = INPgetValue(ckt, &line, IF_INTEGER, tab); /* points */
+            error = INPapName(ckt, which, hbJob, "points", parm);
+            if (error)
+                current->error = INPerrCat(current->error, INPerror(error));
+        }
     }
 #endif
 #endif
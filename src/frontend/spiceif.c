@@ -870,6 +870,10 @@ if_setparam_model(CKTcircuit *ckt, char **name, char *val)
         return;
     }
     curMod = dev->GENmodPtr;
+    /* the instance changes its model, see cktalter.c */
+    CKTalterFull(ckt);
+    CKTfingerprintParam(ckt, *name, -1, NULL, 0);
+    CKTfingerprintParam(ckt, val, -1, NULL, 0);
     modname = copy(dev->GENmodPtr->GENmodName);
     modname = strtok(modname, "."); /* want only have the parent model name */
     /*
@@ -1188,6 +1192,11 @@ doset(CKTcircuit *ckt, int typecode, GENinstance *dev, GENmodel *mod, IFparm *op
     else
         err = ft_sim->setModelParm (ckt, mod, opt->id, &nval, NULL);
 
+    /* the operating point cache has to tell the changed circuit */
+    if (!err)
+        CKTfingerprintParam(ckt, dev ? dev->GENname : mod->GENmodName,
+                            opt->id, val->v_realdata, val->v_length);
+
     return err;
 }
 
@@ -1490,6 +1499,7 @@ void com_snload(wordlist *wl)
     _t(CKTnumSrcSteps);
     _t(CKTnumGminSteps);
     _t(CKTgminFactor);
+    _t(CKTopStrategy);
     _t(CKTnoncon);
     _t(CKTdefaultMosM);
     _t(CKTdefaultMosL);
@@ -1499,6 +1509,15 @@ void com_snload(wordlist *wl)
     _t(CKThadNodeset);
     _t(CKTfixLimit);
     _t(CKTnoOpIter);
+    _t(CKTdcSeed);
+    _t(CKTwaveRelax);
+    _t(CKTmultiRate);
+    _t(CKTnoTruncBatch);
+    _t(CKTpzArnoldi);
+    _t(CKTpzRoots);
+    _t(CKTalterInc);
+    _t(CKTopRemember);
+    _t(CKTopRace);
     _t(CKTisSetup);
 #ifdef XSPICE
     _t(CKTadevFlag);
@@ -13,7 +13,6 @@
 #include "ngspice/1-f-code.h"
 
 #include "ngspice/fftext.h"
-#include "ngspice/wallace.h"
 
 #ifdef HAVE_LIBFFTW3
 #include "fftw3.h"
@@ -21,7 +20,8 @@
 
 
 void
-f_alpha(int n_pts, int n_exp, double X[], double Q_d, double alpha)
+f_alpha(int n_pts, int n_exp, double X[], double Q_d, double alpha,
+        const unsigned int key[2], unsigned int run)
 {
     int i, length;
     double ha;
@@ -44,14 +44,16 @@ f_alpha(int n_pts, int n_exp, double X[], double Q_d, double alpha)
     hfa = TMALLOC(double, length);
     wfa = TMALLOC(double, length);
 
+    /* fill the sequence wk with white noise */
+    PhiloxGauss(key, TRNOISE_ONEOF, run, 0, (size_t) n_pts, wfa);
+
     hfa[0] = 1.0;
-    wfa[0] = Q_d * GaussWa;
+    wfa[0] *= Q_d;
     /* generate the coefficients hk */
     for (i = 1; i < n_pts; i++) {
         /* generate the coefficients hk */
         hfa[i] = hfa[i-1] * (ha + (double)(i-1)) / ((double)(i));
-        /* fill the sequence wk with white noise */
-        wfa[i] = Q_d * GaussWa;
+        wfa[i] *= Q_d;
     }
 
 #ifdef HAVE_LIBFFTW3
@@ -114,11 +116,28 @@ f_alpha(int n_pts, int n_exp, double X[], double Q_d, double alpha)
 
 /*-----------------------------------------------------------------------------*/
 
+/* Generate the aligned block of samples which contains sample 'index',
+   into the half of points[] for even or odd blocks.
+   The samples are a function of the source, the run and the index only,
+   so they may be requested in any order, and noise waveforms do not
+   depend on the order or the thread in which the sources are evaluated.
+*/
 void
-trnoise_state_gen(struct trnoise_state *this, CKTcircuit *ckt)
+trnoise_state_gen(struct trnoise_state *this, CKTcircuit *ckt, size_t index)
 {
+    size_t first = index - index % TRNOISE_STATE_MEM_LEN;
+    size_t n = index / TRNOISE_STATE_MEM_LEN;
+    double *points = this->points + (n % 2) * TRNOISE_STATE_MEM_LEN;
+    size_t i;
+
     if (this->top == 0) {
 
+        this->block[0] = this->block[1] = 0;
+
+        /* a new realization of the noise for each run */
+        this->run++;
+        this->key[0] = PhiloxSeed();
+
         if (cp_getvar("notrnoise", CP_BOOL, NULL, 0))
             this -> NA = this -> TS = this -> NALPHA = this -> NAMP =
                 this -> RTSAM = this -> RTSCAPT = this -> RTSEMT = 0.0;
@@ -149,61 +168,66 @@ trnoise_state_gen(struct trnoise_state *this, CKTcircuit *ckt)
             f_alpha((int) newsteps, newexp,
                     this -> oneof,
                     this -> NAMP,
-                    this -> NALPHA);
+                    this -> NALPHA,
+                    this -> key,
+                    this -> run);
         }
-
-        trnoise_state_push(this, 0.0); /* first is deterministic */
-        return;
     }
 
+    if (this->oneof && index >= this->oneof_length) {
+        fprintf(stderr, "ouch, noise data exhausted\n");
+        controlled_exit(1);
+    }
 
-    // make use of two random variables per call to rgauss()
-    {
-        double ra1, ra2;
-        double NA = this -> NA;
-
-        if (NA != 0.0) {
+    if (this->NA != 0.0) {
+        double NA = this->NA;
+        PhiloxGauss(this->key, TRNOISE_WHITE, this->run,
+                    first, TRNOISE_STATE_MEM_LEN, points);
+        for (i = 0; i < TRNOISE_STATE_MEM_LEN; i++)
+            points[i] *= NA;
+    } else {
+        for (i = 0; i < TRNOISE_STATE_MEM_LEN; i++)
+            points[i] = 0.0;
+    }
 
-#ifdef FastRand
-            // use FastNorm3
-            ra1 = NA * FastNorm;
-            ra2 = NA * FastNorm;
-#elif defined(WaGauss)
-            // use WallaceHV
-            ra1 = NA * GaussWa;
-            ra2 = NA * GaussWa;
-#else
-            rgauss(&ra1, &ra2);
-            ra1 *= NA;
-            ra2 *= NA;
-#endif
+    if (this->oneof)
+        for (i = 0; i < TRNOISE_STATE_MEM_LEN && first + i < this->oneof_length; i++)
+            points[i] += this->oneof[first + i] - this->oneof[0];
 
-        } else {
+    if (first == 0)
+        points[0] = 0.0; /* first is deterministic */
 
-            ra1 = 0.0;
-            ra2 = 0.0;
+    this->block[n % 2] = n + 1;
+    this->top = MAX(this->top, first + TRNOISE_STATE_MEM_LEN);
+}
 
-        }
 
-        if (this -> oneof) {
+/* draw the next trap capture and emission times of the RTS noise */
+void
+trnoise_rts_next(struct trnoise_state *this, double time)
+{
+    size_t k = this->RTSevent++;
 
-            if (this->top + 1 >= this->oneof_length) {
-                fprintf(stderr, "ouch, noise data exhausted\n");
-                controlled_exit(1);
-            }
+    this->RTScapTime = time - this->RTSCAPT *
+        log(PhiloxUniform(this->key, TRNOISE_RTSCAPT, this->RTSrun, k));
+    this->RTSemTime = this->RTScapTime - this->RTSEMT *
+        log(PhiloxUniform(this->key, TRNOISE_RTSEMT, this->RTSrun, k));
+}
 
-            ra1 += this->oneof[this->top]      -  this->oneof[0];
-            ra2 += this->oneof[this->top + 1]  -  this->oneof[0];
-        }
 
-        trnoise_state_push(this, ra1);
-        trnoise_state_push(this, ra2);
-    }
+/* a new realization of the RTS noise, at the start of a run */
+void
+trnoise_rts_restart(struct trnoise_state *this)
+{
+    this->RTSrun++;
+    this->RTSevent = 0;
+    this->key[0] = PhiloxSeed();
+    trnoise_rts_next(this, 0.0);
 }
 
 
 struct trnoise_state *
-trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSAM, double RTSCAPT, double RTSEMT)
+trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSAM, double RTSCAPT, double RTSEMT, const char *name)
 {
     struct trnoise_state *this = TMALLOC(struct trnoise_state, 1);
 
@@ -215,10 +239,13 @@ trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSA
     this->RTSCAPT = RTSCAPT;
     this->RTSEMT = RTSEMT;
 
-    if (RTSAM > 0) {
-        this->RTScapTime = exprand(RTSCAPT);
-        this->RTSemTime = this->RTScapTime + exprand(RTSEMT);
-    }
+    this->key[0] = PhiloxSeed();
+    this->key[1] = PhiloxHash(name);
+    this->run = 0;
+    this->RTSrun = 0;
+
+    if (RTSAM > 0)
+        trnoise_rts_next(this, 0.0);
 
     this -> top = 0;
     this -> oneof = NULL;
@@ -228,7 +255,7 @@ trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSA
 
 
 struct trrandom_state *
-trrandom_state_init(int rndtype, double TS, double TD, double PARAM1, double PARAM2)
+trrandom_state_init(int rndtype, double TS, double TD, double PARAM1, double PARAM2, const char *name)
 {
     struct trrandom_state *this = TMALLOC(struct trrandom_state, 1);
 
@@ -239,9 +266,23 @@ trrandom_state_init(int rndtype, double TS, double TD, double PARAM1, double PAR
     this->PARAM2 = PARAM2;
     this->value = PARAM2;
 
+    this->key[0] = PhiloxSeed();
+    this->key[1] = PhiloxHash(name);
+    this->run = 0;
+
     return this;
 }
 
+
+/* a new sequence of values, at the start of a run */
+void
+trrandom_state_restart(struct trrandom_state *this)
+{
+    this->run++;
+    this->key[0] = PhiloxSeed();
+    this->value = this->PARAM2;
+}
+
 void
 trnoise_state_free(struct trnoise_state *this)
 {
@@ -84,6 +84,7 @@ static struct plotab plotabs[NUMPLOTTYPES] = {
     { "sens2", "sens2", FALSE, FALSE },
     { "sp", "s.p.", FALSE, FALSE },
     { "sp", "sp", FALSE, FALSE },
+    { "hb", "harmonic balance", FALSE, FALSE },
     { "harm", "harm", FALSE, FALSE },
     { "spect", "spect", FALSE, FALSE },
     { "pss", "periodic", FALSE, FALSE }
@@ -37,6 +37,10 @@
    Finally, call cleanup_udevice() before repeating the sequence for
    another subcircuit.
 
+   If the variable ps_compile_gates is set, the gates with timing model
+   d0_gate are not translated one by one, but become one d_logic instance
+   per subcircuit, see add_logic_gates() and gen_logic_gates().
+
    More explanations are provided below in comments with NOTE.
 */
 
@@ -50,6 +54,7 @@
 #include "ngspice/bool.h"
 #include "ngspice/stringskip.h"
 #include "ngspice/stringutil.h"
+#include "ngspice/dstring.h"
 #include "ngspice/inpdefs.h"
 #include "ngspice/cpextern.h"
 #include "ngspice/macros.h"
@@ -204,6 +209,16 @@ struct name_entry {
     NAME_ENTRY next;
 };
 
+/* zero delay gates kept for a d_logic program */
+typedef struct logic_gate *LOGIC_GATE;
+struct logic_gate {
+    char *op;       // d_logic operator: and, nand, ..., buf, inv
+    char *out;
+    int num_ins;
+    char **ins;
+    LOGIC_GATE next;
+};
+
 #ifdef TRACE
 static void print_name_list(NAME_ENTRY nelist);
 #endif
@@ -303,6 +318,12 @@ static BOOL add_zero_delay_inverter_model = FALSE;
 static BOOL add_drive_hilo = FALSE;
 static char *current_subckt = NULL;
 static unsigned int subckt_msg_count = 0;
+/* gates with timing model d0_gate, if ps_compile_gates is set */
+static BOOL compile_gates = FALSE;
+static LOGIC_GATE logic_gates = NULL;
+static LOGIC_GATE last_logic_gate = NULL;
+/* names on the lines of the U* instances which are not kept */
+static NAME_ENTRY instance_nodes_list = NULL;
 
 static void check_name_unused(char *name)
 {
@@ -693,6 +714,12 @@ static Xlatorp default_models = NULL;
 /* static Xlatorp for storing translated instance and model statements */
 static Xlatorp translated_p = NULL;
 
+/* static Xlatorp for the usual translation of the kept gates */
+static Xlatorp logic_xlatorp = NULL;
+
+static void gen_logic_gates(void);
+static void delete_logic_gates(void);
+
 static void create_translated_xlator(void)
 {
     translated_p = create_xlator();
@@ -720,6 +747,9 @@ struct card *replacement_udevice_cards(void)
     if (there_are_name_collisions()) {
         return NULL;
     }
+    if (logic_gates) {
+        gen_logic_gates();
+    }
     if (add_zero_delay_inverter_model) {
         x = create_xlate_translated(
         ".model d_zero_inv99 d_inverter(rise_delay=1.0e-12 fall_delay=1.0e-12)");
@@ -819,6 +849,13 @@ void initialize_udevice(char *subckt_line)
     if (!cp_getvar("ps_udevice_msgs", CP_NUM, &ps_udevice_msgs, 0)) {
         ps_udevice_msgs = 0;
     }
+    /*
+      Set ps_compile_gates to evaluate the gates with timing model
+      d0_gate in one d_logic instance, as ps_compile_logicexp does for
+      LOGICEXP in logicexp.c. This may change the event timing, see
+      gen_logic_gates().
+    */
+    compile_gates = cp_getvar("ps_compile_gates", CP_BOOL, NULL, 0);
     if (subckt_line && strncmp(subckt_line, ".subckt", 7) == 0) {
         add_all_port_names(subckt_line);
         current_subckt = TMALLOC(char, strlen(subckt_line) + 1);
@@ -899,6 +936,9 @@ void cleanup_udevice(void)
     port_names_list = NULL;
     clear_name_list(new_names_list, "NEW_NAMES");
     new_names_list = NULL;
+    clear_name_list(instance_nodes_list, "INSTANCE_NODES");
+    instance_nodes_list = NULL;
+    delete_logic_gates();
     if (current_subckt) {
         tfree(current_subckt);
         current_subckt = NULL;
@@ -3528,6 +3568,224 @@ static Xlatorp translate_ff_latch(struct instance_hdr *hdr, char *start)
     return NULL;
 }
 
+/*
+  Compiled gates.
+  If the variable ps_compile_gates is set, the simple gates and gate
+  arrays with timing model d0_gate are kept by add_logic_gates() instead
+  of being translated. At the end of the subckt, gen_logic_gates() makes
+  one d_logic instance which evaluates all of them in level order. The
+  d_logic ports are the gate inputs not driven by a kept gate, and the
+  gate outputs which are subckt ports or are found on the line of
+  another U* instance. The other gate outputs are internal signals of
+  the program and no event nodes.
+  The d_logic has the delays of d0_gate per gate: an output changes
+  after N gate delays, N being the longest path of gates to it. This
+  is the timing of the single gates when all paths to the output have
+  the same length. A change through a shorter path comes later, and
+  glitches of the internal signals are not seen.
+  If the program cannot be made, the usual translation of the kept
+  gates is used.
+*/
+static void delete_logic_gates(void)
+{
+    LOGIC_GATE lg, next;
+    int i;
+
+    for (lg = logic_gates; lg; lg = next) {
+        next = lg->next;
+        for (i = 0; i < lg->num_ins; i++) {
+            tfree(lg->ins[i]);
+        }
+        tfree(lg->ins);
+        tfree(lg->out);
+        tfree(lg);
+    }
+    logic_gates = NULL;
+    last_logic_gate = NULL;
+    delete_xlator(logic_xlatorp);
+    logic_xlatorp = NULL;
+}
+
+static void add_instance_nodes(char *line)
+{
+    /* The words on the line of a U* instance which is not kept */
+    char *copy_line, *tok;
+
+    if (!compile_gates) { return; }
+    copy_line = tprintf("%s", line);
+    for (tok = strtok(copy_line, " \t"); tok; tok = strtok(NULL, " \t")) {
+        add_pin_name(tok, &instance_nodes_list);
+    }
+    tfree(copy_line);
+}
+
+static char *logic_gate_op(char *itype)
+{
+    if (strncmp(itype, "and", 3) == 0) { return "and"; }
+    if (strncmp(itype, "nand", 4) == 0) { return "nand"; }
+    if (strncmp(itype, "or", 2) == 0) { return "or"; }
+    if (strncmp(itype, "nor", 3) == 0) { return "nor"; }
+    if (strncmp(itype, "xor", 3) == 0) { return "xor"; }
+    if (strncmp(itype, "nxor", 4) == 0) { return "xnor"; }
+    if (strncmp(itype, "buf", 3) == 0) { return "buf"; }
+    if (strncmp(itype, "inv", 3) == 0) { return "inv"; }
+    return NULL;
+}
+
+static BOOL add_logic_gates(struct gate_instance *gip, Xlatorp xp)
+{
+    /*
+      Keep the gates of gip and their translation xp if they are
+      simple gates with timing model d0_gate. Return TRUE if kept.
+    */
+    char *itype = gip->hdrp->instance_type, *op;
+    LOGIC_GATE lg;
+    int i, j;
+
+    if (!compile_gates || !gip->tmodel || !eq(gip->tmodel, "d0_gate")) {
+        return FALSE;
+    }
+    if (!is_gate(itype) && !is_gate_array(itype)) { return FALSE; }
+    op = logic_gate_op(itype);
+    if (!op) { return FALSE; }
+    for (i = 0; i < gip->num_gates; i++) {
+        lg = TMALLOC(struct logic_gate, 1);
+        lg->op = op;
+        lg->out = copy(gip->outputs[i]);
+        lg->num_ins = gip->width;
+        lg->ins = TMALLOC(char *, gip->width);
+        for (j = 0; j < gip->width; j++) {
+            lg->ins[j] = copy(gip->inputs[i * gip->width + j]);
+        }
+        lg->next = NULL;
+        if (last_logic_gate) {
+            last_logic_gate->next = lg;
+        } else {
+            logic_gates = lg;
+        }
+        last_logic_gate = lg;
+    }
+    if (!logic_xlatorp) {
+        logic_xlatorp = create_xlator();
+    }
+    (void) append_xlator(logic_xlatorp, xp);
+    return TRUE;
+}
+
+static int name_index(char *name, NAME_ENTRY nelist)
+{
+    NAME_ENTRY x;
+    int i = 0;
+
+    for (x = nelist; x; x = x->next, i++) {
+        if (eq(x->name, name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void gen_logic_gates(void)
+{
+    /*
+      Translate the kept gates into a d_logic instance, or use their
+      usual translation if the program cannot be made.
+      The program numbers the d_logic inputs first, then the outputs,
+      then the internal signals. It has no blanks, see logicexp.c.
+    */
+    NAME_ENTRY ins = NULL, outs = NULL, internals = NULL, driven = NULL, x;
+    LOGIC_GATE lg;
+    Xlatep xin, xout;
+    BOOL ok = TRUE;
+    int i, idx, num_ins, num_outs;
+    DS_CREATE(prog, 1024);
+    DS_CREATE(line, 256);
+
+    /* Each gate output has one driver */
+    for (lg = logic_gates; lg && ok; lg = lg->next) {
+        if (find_name_entry(lg->out, driven)) {
+            ok = FALSE;
+        } else {
+            driven = add_name_entry(lg->out, driven);
+        }
+    }
+    for (lg = logic_gates; lg && ok; lg = lg->next) {
+        for (i = 0; i < lg->num_ins; i++) {
+            if (!find_name_entry(lg->ins[i], driven)) {
+                ins = add_name_entry(lg->ins[i], ins);
+            }
+        }
+    }
+    for (x = driven; x && ok; x = x->next) {
+        if (find_name_entry(x->name, port_names_list)
+            || find_name_entry(x->name, instance_nodes_list)) {
+            outs = add_name_entry(x->name, outs);
+        } else {
+            internals = add_name_entry(x->name, internals);
+        }
+    }
+    for (x = ins, num_ins = 0; x; x = x->next) { num_ins++; }
+    for (x = outs, num_outs = 0; x; x = x->next) { num_outs++; }
+    if (num_ins == 0 || num_outs == 0) {
+        ok = FALSE;
+    }
+
+    for (lg = logic_gates; lg && ok; lg = lg->next) {
+        ds_cat_printf(&prog, "%s%s", (ds_get_length(&prog) > 0) ? "/" : "",
+            lg->op);
+        for (i = -1; i < lg->num_ins; i++) {
+            char *name = (i < 0) ? lg->out : lg->ins[i];
+            if ((idx = name_index(name, ins)) >= 0) {
+                ds_cat_printf(&prog, ":%d", idx);
+            } else if ((idx = name_index(name, outs)) >= 0) {
+                ds_cat_printf(&prog, ":%d", num_ins + idx);
+            } else {
+                idx = name_index(name, internals);
+                ds_cat_printf(&prog, ":%d", num_ins + num_outs + idx);
+            }
+        }
+    }
+
+    if (ok) {
+        /* d_logic has the delays of d0_gate */
+        xin = create_xlate_model("", "ugate", "", "d0_gate");
+        xout = find_in_model_xlator(xin);
+        delete_xlate(xin);
+        if (xout && xout->delays && strlen(xout->delays) > 1) {
+            /* (rise_delay = .. fall_delay = ..) */
+            ds_cat_printf(&line, ".model d__logic__gates d_logic%.*s "
+                "program=\"%s\")", (int) strlen(xout->delays) - 1,
+                xout->delays, ds_get_buf(&prog));
+        } else {
+            ds_cat_printf(&line, ".model d__logic__gates d_logic("
+                "program=\"%s\")", ds_get_buf(&prog));
+        }
+        u_add_instance(ds_get_buf(&line));
+
+        ds_clear(&line);
+        ds_cat_printf(&line, "a__logic__gates [");
+        for (x = ins; x; x = x->next) {
+            ds_cat_printf(&line, " %s", x->name);
+        }
+        ds_cat_printf(&line, " ] [");
+        for (x = outs; x; x = x->next) {
+            ds_cat_printf(&line, " %s", x->name);
+        }
+        ds_cat_printf(&line, " ] d__logic__gates");
+        u_add_instance(ds_get_buf(&line));
+    } else {
+        (void) append_xlator(translated_p, logic_xlatorp);
+    }
+
+    clear_name_list(ins, "LOGIC_INPUTS");
+    clear_name_list(outs, "LOGIC_OUTPUTS");
+    clear_name_list(internals, "LOGIC_INTERNALS");
+    clear_name_list(driven, "LOGIC_DRIVEN");
+    ds_free(&prog);
+    ds_free(&line);
+    delete_logic_gates();
+}
+
 static Xlatorp translate_gate(struct instance_hdr *hdr, char *start)
 {
     /* If OK return Xlatorp else return NULL */
@@ -3541,6 +3799,11 @@ static Xlatorp translate_gate(struct instance_hdr *hdr, char *start)
         igatep = add_gate_inout_timing_model(hdr, start);
         if (igatep) {
             xp = gen_gate_instance(igatep);
+            if (xp && add_logic_gates(igatep, xp)) {
+                /* An empty translation, the gate is kept for d_logic */
+                delete_xlator(xp);
+                xp = create_xlator();
+            }
             delete_gate_instance(igatep);
             return xp;
         }
@@ -3548,6 +3811,10 @@ static Xlatorp translate_gate(struct instance_hdr *hdr, char *start)
         igatep = add_array_inout_timing_model(hdr, start);
         if (igatep) {
             xp = gen_gate_instance(igatep);
+            if (xp && add_logic_gates(igatep, xp)) {
+                delete_xlator(xp);
+                xp = create_xlator();
+            }
             delete_gate_instance(igatep);
             return xp;
         }
@@ -3616,6 +3883,7 @@ BOOL u_process_instance(char *nline)
     itype = hdr->instance_type;
     xspice = find_xspice_for_delay(itype);
     if (!xspice) {
+        add_instance_nodes(nline);
         if (eq(itype, "logicexp")) {
             delete_instance_hdr(hdr);
             return f_logicexp(nline);
@@ -3651,6 +3919,9 @@ BOOL u_process_instance(char *nline)
         return FALSE;
     }
     if (xp) {
+        if (xp->head) {
+            add_instance_nodes(nline);
+        }
         append_xlator(translated_p, xp);
         delete_xlator(xp);
         return TRUE;
@@ -1,16 +1,29 @@
 #include "ngspice/randnumb.h"
 
 void f_alpha(int n_pts, int n_exp, double X[], double Q_d,
-double alpha);
+double alpha, const unsigned int key[2], unsigned int run);
 
 void rvfft(float X[], unsigned long int n);
 
 
-#define TRNOISE_STATE_MEM_LEN 4
+/* streams of the counter based generator, see PhiloxGauss() */
+enum {
+    TRNOISE_WHITE = 1,
+    TRNOISE_ONEOF,
+    TRNOISE_RTSCAPT,
+    TRNOISE_RTSEMT,
+    TRRANDOM_VALUE,
+};
+
+/* samples are generated in aligned blocks of this size, two adjacent
+   blocks are kept, so that the pair n, n+1 interpolated in a timestep is
+   always at hand */
+#define TRNOISE_STATE_MEM_LEN 64
 struct trnoise_state
 {
-    double points[TRNOISE_STATE_MEM_LEN];
-    size_t top;
+    double points[2 * TRNOISE_STATE_MEM_LEN];
+    size_t block[2];    /* block number + 1 held in each half of points */
+    size_t top;     /* one past the last block generated, 0 after a restart */
 
     double NA, TS, NAMP, NALPHA, RTSAM, RTSCAPT, RTSEMT;
 
@@ -21,6 +34,11 @@ struct trnoise_state
 
     double RTScapTime, RTSemTime;
     bool RTS;
+
+    unsigned int key[2];        /* seed, source name */
+    unsigned int run;           /* counts the restarts of the noise */
+    unsigned int RTSrun;        /* counts the restarts of the RTS noise */
+    size_t RTSevent;            /* number of trap events drawn */
 };
 
 struct trrandom_state
@@ -29,67 +47,67 @@ struct trrandom_state
 
     int rndtype;
     double TS, TD, PARAM1, PARAM2;
+
+    unsigned int key[2];
+    unsigned int run;
 };
 
-struct trnoise_state *trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSAM, double RTSCAPT, double RTSEMT);
-struct trrandom_state *trrandom_state_init(int rndtype, double TS, double TD, double PARAM1, double PARAM2);
+struct trnoise_state *trnoise_state_init(double NA, double TS, double NALPHA, double NAMP, double RTSAM, double RTSCAPT, double RTSEMT, const char *name);
+struct trrandom_state *trrandom_state_init(int rndtype, double TS, double TD, double PARAM1, double PARAM2, const char *name);
 
 
-void trnoise_state_gen(struct trnoise_state *this, CKTcircuit *ckt);
+void trnoise_state_gen(struct trnoise_state *this, CKTcircuit *ckt, size_t index);
 void trnoise_state_free(struct trnoise_state *this);
-
-
-static inline void
-trnoise_state_push(struct trnoise_state *this, double val)
-{
-    this->points[this->top++ % TRNOISE_STATE_MEM_LEN] = val;
-}
+void trnoise_rts_restart(struct trnoise_state *this);
+void trnoise_rts_next(struct trnoise_state *this, double time);
+void trrandom_state_restart(struct trrandom_state *this);
 
 
 static inline double
 trnoise_state_get(struct trnoise_state *this, CKTcircuit *ckt, size_t index)
 {
-    while(index >= this->top)
-        trnoise_state_gen(this, ckt);
+    size_t n = index / TRNOISE_STATE_MEM_LEN;
 
-    if(index + TRNOISE_STATE_MEM_LEN < this->top) {
-        fprintf(stderr, "ouch, trying to fetch from the past %d %d\n",
-                (int)index, (int)this->top);
-        controlled_exit(1);
-    }
+    if (this->top == 0 || this->block[n % 2] != n + 1)
+        trnoise_state_gen(this, ckt, index);
 
-    return this->points[index % TRNOISE_STATE_MEM_LEN];
+    return this->points[index % (2 * TRNOISE_STATE_MEM_LEN)];
 }
 
+/* value of the interval n, each interval has its own counter */
 static inline double
-trrandom_state_get(struct trrandom_state *this)
+trrandom_state_get(struct trrandom_state *this, size_t n)
 {
     double param1 = this->PARAM1;
     double param2 = this->PARAM2;
+    double u = PhiloxUniform(this->key, TRRANDOM_VALUE, this->run, 2 * n);
     switch (this->rndtype) {
         case 1:
             /* param1: range -param1[ ... +param1[  (default = 1)
                param2: offset  (default = 0)
             */
-            return (param1 * drand() + param2);
+            return (param1 * (2.0 * u - 1.0) + param2);
             break;
         case 2:
             /* param1: standard deviation (default = 1)
                param2: mean  (default = 0)
             */
-            return param1 * gauss0() + param2;
+            {
+                double u2 = PhiloxUniform(this->key, TRRANDOM_VALUE, this->run, 2 * n + 1);
+                return param1 * sqrt(-2.0 * log(u)) * cos(6.283185307179586 * u2) + param2;
+            }
             break;
         case 3:
             /* param1: mean (default = 1)
                param2: offset  (default = 0)
             */
-            return exprand(param1) + param2;
+            return -log(u) * param1 + param2;
             break;
         case 4:
             /* param1: lambda (default = 1)
                param2: offset  (default = 0)
             */
-            return (double)poisson(param1) + param2;
+            return (double)poisson_inv(param1, u) + param2;
             break;
 
         default:
@@ -7,6 +7,7 @@ Author: 1985 Thomas L. Quarles
 #define ngspice_ACDEFS_H
 
 #include "ngspice/jobdefs.h"
+#include "ngspice/smpdefs.h"
 
     /* structure used to describe an AC analysis to be performed */
 
@@ -21,8 +22,30 @@ typedef struct {
     double ACsaveFreq;  /* frequency at which we left off last time*/
     int ACstepType;     /* values described below */
     int ACnumberSteps;
+    runDesc *ACplot;    /* output plot, kept for a resumed analysis */
 } ACAN;
 
+/* Private copies of the circuit matrix, used to factor and solve several
+ * frequency points of a small signal sweep at once (see cktacslot.c) */
+
+typedef struct {
+    SMPmatrix *matrix;  /* clone of CKTmatrix, same structure and pivots */
+    double *rhs;        /* loaded rhs, solution after CKTacSlotsSolve() */
+    double *irhs;
+    double *arhs;       /* solution of the adjoint system, if requested */
+    double *airhs;
+    double freq;
+    int error;
+    int stale;          /* reordered on its own, clone again before use */
+} ACslot;
+
+typedef struct {
+    ACslot *slots;
+    int numSlots;
+    int size;           /* size of the circuit matrix */
+    int adjoint;        /* also solve the adjoint system */
+} ACslots;
+
 /* available step types: XXX should be somewhere else */
 
 #ifdef RFSPICE
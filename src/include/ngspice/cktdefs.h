@@ -196,6 +196,11 @@ struct CKTcircuit {
 #define MODESPNOISE     0x8000
 #endif
 
+/* homotopies of CKTop(), see CKTopStrategy */
+#define OP_GMINSTEP 1
+#define OP_SRCSTEP  2
+#define OP_OPTRAN   3
+
 /* old 'nosolv' paramater */
 #define MODEUIC 0x10000l
 
@@ -237,6 +242,15 @@ struct CKTcircuit {
     int CKTnumSrcSteps;         /* .options SRCSTEPS */
     int CKTnumGminSteps;        /* .options GMINSTEPS */
     double CKTgminFactor;       /* gmin stepping scaling factor */
+    int CKTopStrategy;          /* homotopy which made the last CKTop()
+                                   converge, tried first the next time
+                                   with option opremember */
+    int CKTopTried[3];          /* homotopies the last CKTop() has tried, */
+    int CKTopNumTried;          /* in this order */
+    int CKTopChosen;            /* the one of them which converged, 0 if
+                                   none or none was needed */
+    int *CKTopCancel;           /* set when a copy racing its homotopy
+                                   against others may give up */
     int CKTnoncon;              /* used by devices (and few other places)
                                    to announce non-convergence */
     double CKTdefaultMosM;      /* Default MOS multiplier parameter m */
@@ -251,13 +265,43 @@ struct CKTcircuit {
     unsigned int CKTnoOpIter:1; /* flag to indicate not to try the operating
                                    point brute force, but to use gmin stepping
                                    first */
+    unsigned int CKTdcSeed:1;   /* flag to seed each inner sweep of a nested
+                                   DC sweep by the previous one */
+    unsigned int CKTwaveRelax:1; /* flag for the waveform relaxation
+                                    transient */
+    unsigned int CKTmultiRate:1; /* flag for the multirate transient */
+    unsigned int CKTnoTruncBatch:1; /* flag to call DEVtrunc() of every
+                                       device type in CKTtrunc() */
+    unsigned int CKTpzArnoldi:1; /* flag to find poles and zeros as
+                                    eigenvalues, by shift-and-invert
+                                    Arnoldi */
+    unsigned int CKTalterInc:1; /* flag to set up only the devices changed
+                                   by alter and altermod */
+    unsigned int CKTopRemember:1; /* flag to try CKTopStrategy first */
+    unsigned int CKTopRace:1;   /* flag to run the homotopies of CKTop()
+                                   concurrently on copies of the circuit */
     unsigned int CKTisSetup:1;  /* flag to indicate if CKTsetup done */
+    unsigned int CKTtruncRecord:1; /* flag for CKTterr() to collect the
+                                      charge states for CKTtrunc() */
 #ifdef XSPICE
     unsigned int CKTadevFlag:1; /* flag indicates 'A' devices in the circuit */
 #endif
     JOB *CKTcurJob;             /* Next analysis to be performed ??? */
 
     SENstruct *CKTsenInfo;      /* the sensitivity information */
+    struct st_sentrace *CKTsenTrace; /* accepted timepoints recorded for
+                                        the transient sensitivity */
+    struct st_wavrel *CKTwavrel; /* blocks of the waveform relaxation */
+    char *CKTwrSteps;           /* timepoints each block has taken in
+                                   the last one */
+    int CKTpzRoots;             /* number of roots closest to the shift
+                                   wanted from the Arnoldi pole-zero */
+    struct st_truncbatch *CKTtruncBatch; /* charge states of the batched
+                                            truncation error test */
+    struct st_alter *CKTalter;  /* devices changed since the last setup */
+    unsigned long long CKTparamKey; /* hash of the parameters changed by
+                                       alter and altermod, see
+                                       CKTfingerprint() */
     double *CKTtimePoints;      /* list of all accepted timepoints in
                                    the current transient simulation */
     double *CKTdeltaList;       /* list of all timesteps in the
@@ -335,6 +379,13 @@ extern int ACaskQuest(CKTcircuit *, JOB *, int , IFvalue *);
 extern int ACsetParm(CKTcircuit *, JOB *, int , IFvalue *);
 extern int CKTacDump(CKTcircuit *, double , runDesc *);
 extern int CKTacLoad(CKTcircuit *);
+extern int CKTacSlotsCreate(CKTcircuit *, ACslots *, int, int);
+extern int CKTacSlotsReclone(CKTcircuit *, ACslots *);
+extern void CKTacSlotsDestroy(ACslots *);
+extern int CKTacSlotLoad(CKTcircuit *, ACslot *, double);
+extern void CKTacSlotsSolve(CKTcircuit *, ACslots *, int, int, int, int);
+extern int CKTacSlotRedo(CKTcircuit *, ACslots *, ACslot *, int, int, int);
+extern void CKTacSlotRestore(CKTcircuit *, ACslots *, ACslot *);
 extern int CKTaccept(CKTcircuit *);
 extern int CKTacct(CKTcircuit *, JOB *, int , IFvalue *);
 extern int CKTask(CKTcircuit *, GENinstance *, int , IFvalue *, IFvalue *);
@@ -353,6 +404,9 @@ extern int CKTdltMod(CKTcircuit *, GENmodel *);
 extern int CKTdltNNum(CKTcircuit *, int);
 extern int CKTdltNod(CKTcircuit *, CKTnode *);
 extern int CKTdoJob(CKTcircuit *, int , TSKtask *);
+extern int CKTdoJobNoSetup(CKTcircuit *, TSKtask *);
+extern int CKTresetup(CKTcircuit *);
+extern void CKTtaskOpts(CKTcircuit *, TSKtask *);
 extern void CKTdump(CKTcircuit *, double, runDesc *);
 extern int CKTsoaInit(void);
 extern int CKTsoaCheck(CKTcircuit *);
@@ -393,9 +447,11 @@ extern IFuid CKTnodName(CKTcircuit *, int);
 extern void CKTnodOut(CKTcircuit *);
 extern CKTnode * CKTnum2nod(CKTcircuit *, int);
 extern int CKTop(CKTcircuit *, long, long, int);
+extern int CKTopCancelled(CKTcircuit *);
 extern int CKTpModName(char *, IFvalue *, CKTcircuit *, int , IFuid , GENmodel **);
 extern int CKTpName(char *, IFvalue *, CKTcircuit *, int , char *, GENinstance **);
 extern int CKTparam(CKTcircuit *, GENinstance *, int , IFvalue *, IFvalue *);
+extern int CKTpzArnoldi(CKTcircuit *, PZtrial **, int *);
 extern int CKTpzFindZeros(CKTcircuit *, PZtrial **, int *);
 extern int CKTpzLoad(CKTcircuit *, SPcomplex *);
 extern int CKTpzSetup(CKTcircuit *, int);
@@ -415,7 +471,10 @@ extern int CKTunsetup(CKTcircuit *);
 extern int CKTtemp(CKTcircuit *);
 extern char *CKTtrouble(CKTcircuit *, char *);
 extern void CKTterr(int , CKTcircuit *, double *);
+extern void CKTterrBatch(CKTcircuit *, int *, int, double *);
 extern int CKTtrunc(CKTcircuit *, double *);
+extern void CKTtruncAddState(CKTcircuit *, int);
+extern void CKTtruncDestroy(CKTcircuit *);
 extern int CKTtypelook(char *);
 extern int DCOaskQuest(CKTcircuit *, JOB *, int , IFvalue *);
 extern int DCOsetParm(CKTcircuit  *, JOB *, int , IFvalue *);
@@ -433,6 +492,30 @@ extern int PZaskQuest(CKTcircuit *, JOB *, int , IFvalue *);
 extern int PZsetParm(CKTcircuit *, JOB *, int , IFvalue *);
 
 extern int OPtran(CKTcircuit *, int);
+extern int OPtranEnabled(void);
+extern int CKTopCacheLoad(CKTcircuit *);
+extern void CKTopCacheSave(CKTcircuit *);
+extern void CKTalterMark(CKTcircuit *, GENmodel *, GENinstance *);
+extern void CKTalterFull(CKTcircuit *);
+extern int CKTalterSetup(CKTcircuit *);
+extern void CKTalterDone(CKTcircuit *);
+extern int CKTalterLoadOp(CKTcircuit *);
+extern void CKTalterSaveOp(CKTcircuit *);
+extern void CKTalterDestroy(CKTcircuit *);
+extern int CKTclone(CKTcircuit *, CKTcircuit **);
+extern void CKTcloneFree(CKTcircuit *);
+extern int CKTcloneable(CKTcircuit *);
+extern void CKTcloneState(CKTcircuit *, CKTcircuit *);
+extern unsigned long long CKTfingerprint(CKTcircuit *);
+extern void CKTfingerprintParam(CKTcircuit *, const char *, int, const double *, int);
+extern int CKTcheckpointWrite(CKTcircuit *, const char *);
+extern int CKTcheckpointRead(CKTcircuit *, const char *);
+extern int CKTwrSetup(CKTcircuit *);
+extern int CKTwrWindow(CKTcircuit *, runDesc *);
+extern int CKTwrLoad(CKTcircuit *);
+extern int CKTwrTrunc(CKTcircuit *, double *);
+extern int CKTwrConvTest(CKTcircuit *);
+extern void CKTwrDestroy(CKTcircuit *);
 
 #ifdef WANT_SENSE2
 extern int SENaskQuest(CKTcircuit *, JOB *, int , IFvalue *);
@@ -466,6 +549,11 @@ extern int CKTspLoad(CKTcircuit*);
 extern int CKTmatrixIndex(CKTcircuit*, int, int);
 extern int CKTspCalcPowerWave(CKTcircuit* ckt);
 extern int CKTspCalcSMatrix(CKTcircuit* ckt);
+#ifdef WITH_HB
+extern int HBan(CKTcircuit*, int);
+extern int HBaskQuest(CKTcircuit*, JOB*, int, IFvalue*);
+extern int HBsetParm(CKTcircuit*, JOB*, int, IFvalue*);
+#endif
 #endif
 
 #ifdef __cplusplus
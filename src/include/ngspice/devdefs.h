@@ -60,6 +60,10 @@ typedef struct SPICEdev {
         /* setup routine to preprocess devices once before soloution begins */
     int (*DEVunsetup)(GENmodel*,CKTcircuit*);
 	/* clean up before running again */
+    int (*DEVinstUnsetup)(GENinstance*,CKTcircuit*);
+	/* clean up a single instance for its DEVsetup() again, keeping the
+	 * nodes and branches it made, for the setup after alter (see
+	 * cktalter.c) */
     int (*DEVpzSetup)(SMPmatrix *, GENmodel *, CKTcircuit *, int *);
         /* setup routine to process devices specially for pz analysis */
     int (*DEVtemperature)(GENmodel*,CKTcircuit*);
@@ -104,9 +108,15 @@ typedef struct SPICEdev {
     int (*DEVdisto)(int,GENmodel*,CKTcircuit*);  
     	/* procedure to do distortion operations */
     int (*DEVnoise)(int, int, GENmodel*,CKTcircuit*, Ndata *, double *);
-	/* noise routine */
+	/* noise routine, the DEVacLoad() of a device with one may only
+	 * write into the matrix and the rhs: the threaded noise sweep loads
+	 * several frequencies ahead of DEVnoise() (see noisean.c) */
     int (*DEVsoaCheck)(CKTcircuit*,GENmodel*);
 	/* subroutine to call on soa check */
+    int (*DEVclone)(GENmodel*,GENmodel*);
+        /* routine to check the models of a copy made by CKTclone() after
+         * their DEVsetup(), or to free what the DEVsetup() of the copy
+         * allocated if the source is NULL */
 #ifdef CIDER 	
     void (*DEVdump)(GENmodel *, CKTcircuit *);
     void (*DEVacct)(GENmodel *, CKTcircuit *, FILE *);
@@ -184,5 +194,11 @@ extern int        DEVmaxnum;    /* size of DEVices array */
 
 
 #define DEV_DEFAULT	0x1
+#define DEV_SHARED	0x2	/* loading uses global data, one circuit at a time */
+#define DEV_CLONE	0x4	/* may be copied by CKTclone(), see cktclone.c */
+#define DEV_TERR	0x8	/* DEVtrunc() is CKTterr() on charge states fixed
+				   at setup, see ckttrunc.c */
+#define DEV_OMPLOAD	0x10	/* with USE_OMP, DEVload() runs over an array of
+				   all instances, made by DEVsetup() */
 
 #endif
@@ -114,34 +114,74 @@ struct Evt_Info {
 
 
 
+/* ************** */
+/* Pool structure */
+/* ************** */
+
+
+
+struct Evt_Pool {
+    Evt_Pool_t        *next;        /* Pool for the next item size */
+    size_t            size;         /* Size of the items */
+    char              *avail;       /* Next unused item in the newest block */
+    int               num_avail;    /* Number of unused items in the newest block */
+    void              *blocks;      /* Linked list of allocated blocks */
+};
+
+
+
+
+
+
+
+
 /* *************** */
 /* Queue structure */
 /* *************** */
 
 
 
+struct Evt_Heap {
+    int               num;          /* Number of indexes in the heap */
+    int               *index;       /* Indexes ordered as binary heap by time */
+    int               *pos;         /* Position of each index in heap, -1 if none */
+    double            *time;        /* Time of next pending event of each index */
+};
+
 struct Evt_Inst_Event {
     Evt_Inst_Event_t  *next;        /* the next in the linked list */
     double            event_time;   /* Time for this event to happen */
     double            posted_time;  /* Time at which event was entered in queue */
 };
 
+struct Evt_Inst_Defer {
+    int               num;          /* Number of events in the buffer */
+    int               size;         /* Allocated size of the arrays */
+    int               next;         /* Next event to be moved to the queue */
+    int               call;         /* Position in the call list of the running instance */
+    int               *call_pos;    /* Position in the call list of the instance */
+    double            *posted_time; /* Time at which event was entered */
+    double            *event_time;  /* Time for this event to happen */
+};
+
 struct Evt_Inst_Queue {
     Evt_Inst_Event_t  **head;          /* Beginning of linked lists */
     Evt_Inst_Event_t  ***current;      /* Beginning of pending events */
     Evt_Inst_Event_t  ***last_step;    /* Values of 'current' at last accepted timepoint */
     Evt_Inst_Event_t  **free;          /* Linked lists of items freed by backups */
+    Evt_Pool_t        *pool;           /* Storage of the events */
     double            last_time;       /* Time at which last_step was set */
-    double            next_time;       /* Earliest next event time in queue */
     int               num_modified;    /* Number modified since last accepted timepoint */
     int               *modified_index; /* Indexes of modified instances */
     Mif_Boolean_t     *modified;       /* Flags used to prevent multiple entries */
-    int               num_pending;     /* Count of number of pending events in lists */
-    int               *pending_index;  /* Indexes of pending events */
-    Mif_Boolean_t     *pending;        /* Flags used to prevent multiple entries */
+    Evt_Heap_t        pending;         /* Instances with pending events by event time */
     int               num_to_call;     /* Count of number of instances that need to be called */
     int               *to_call_index;  /* Indexes of instances to be called */
     Mif_Boolean_t     *to_call;        /* Flags used to prevent multiple entries */
+    Mif_Boolean_t     *parallel;       /* Flags for the calls made in parallel */
+    Mif_Boolean_t     deferring;       /* True while code models run in parallel */
+    int               num_defer;       /* Number of thread buffers */
+    Evt_Inst_Defer_t  *defer;          /* Events queued by the code models of each thread */
 };
 
 
@@ -173,14 +213,12 @@ struct Evt_Output_Queue {
     Evt_Output_Event_t  ***current;      /* Beginning of pending events */
     Evt_Output_Event_t  ***last_step;    /* Values of 'current' at last accepted timepoint */
     Evt_Output_Event_t  **free;          /* Linked lists of items freed by backups */
+    Evt_Pool_t          *pool;           /* Storage of the events */
     double              last_time;       /* Time at which last_step was set */
-    double              next_time;       /* Earliest next event time in queue */
     int                 num_modified;    /* Number modified since last accepted timepoint */
     int                 *modified_index; /* Indexes of modified outputs */
     Mif_Boolean_t       *modified;       /* Flags used to prevent multiple entries */
-    int                 num_pending;     /* Count of number of pending events in lists */
-    int                 *pending_index;  /* Indexes of pending events */
-    Mif_Boolean_t       *pending;        /* Flags used to prevent multiple entries */
+    Evt_Heap_t          pending;         /* Outputs with pending events by event time */
     int                 num_changed;     /* Count of number of outputs that changed */
     int                 *changed_index;  /* Indexes of outputs that changed */
     Mif_Boolean_t       *changed;        /* Flags used to prevent multiple entries */
@@ -214,17 +252,43 @@ struct Evt_Node {
     void             *inverted_value; /* Inverted copy of node_value */
 };
 
+struct Evt_Node_Hist {
+    FILE           *file;           /* Scratch file holding the older records */
+    int            window;          /* Accepted records kept in memory per node */
+    int            num_nodes;       /* Number of nodes */
+    Mif_Boolean_t  *stream;         /* Flags for nodes whose records go to the file */
+    int            *num_accepted;   /* Accepted records in memory, per node */
+    int            *num_file;       /* Records in the file, per node */
+    long           **blocks;        /* File offsets of the blocks, per node */
+    int            *num_blocks;     /* Blocks in the file, per node */
+};
+
+struct Evt_Hist_Cursor {
+    Evt_Node_Data_t  *node_data;    /* The node data read from */
+    int              node_index;    /* Index of the node */
+    int              udn_index;     /* Index of the node type */
+    int              block;         /* Index of the next block of the node */
+    long             offset;        /* File position of the next record */
+    int              num_block;     /* Records left in the current block */
+    int              value_size;    /* Bytes of a value in the current block */
+    int              num_file;      /* Records left in the file */
+    Evt_Node_t       record;        /* The record last read from the file */
+    Evt_Node_t       *next;         /* Next record in memory */
+};
+
 struct Evt_Node_Data {
     Evt_Node_t     **head;          /* Beginning of linked lists */
     Evt_Node_t     ***tail;         /* Location of last item added to list */
     Evt_Node_t     ***last_step;    /* 'tail' at last accepted timepoint */
     Evt_Node_t     **free;          /* Linked lists of items freed by backups */
+    Evt_Pool_t     *pool;           /* Storage of the items, by size */
     int            num_modified;    /* Number modified since last accepted timepoint */
     int            *modified_index; /* Indexes of modified nodes */
     Mif_Boolean_t  *modified;       /* Flags used to prevent multiple entries */
     Evt_Node_t     *rhs;            /* Location where model outputs are placed */
     Evt_Node_t     *rhsold;         /* Location where model inputs are retrieved */
     double         *total_load;     /* Location where total load inputs are retrieved */
+    Evt_Node_Hist_t *hist;          /* Older records streamed to a file, or NULL */
 };
 
 
@@ -251,6 +315,7 @@ struct Evt_State_Data {
     Evt_State_t    ***tail;             /* Location of last item added to list */
     Evt_State_t    ***last_step;        /* 'tail' at last accepted timepoint */
     Evt_State_t    **free;              /* Linked lists of items freed by backups */
+    Evt_Pool_t     *pool;               /* Storage of the items, by state size */
     int            num_modified;        /* Number modified since last accepted timepoint */
     int            *modified_index;     /* List of indexes modified */
     Mif_Boolean_t  *modified;           /* Flags used to prevent multiple entries */
@@ -275,6 +340,7 @@ struct Evt_Msg_Data {
     Evt_Msg_t      ***tail;             /* Location of last item added to list */
     Evt_Msg_t      ***last_step;        /* 'tail' at last accepted timepoint */
     Evt_Msg_t      **free;              /* Linked lists of items freed by backups */
+    Evt_Pool_t     *pool;               /* Storage of the items */
     int            num_modified;        /* Number modified since last accepted timepoint */
     int            *modified_index;     /* List of indexes modified */
     Mif_Boolean_t  *modified;           /* Flags used to prevent multiple entries */
@@ -353,6 +419,8 @@ struct Evt_Job {
 
 struct Evt_Option {
     Mif_Boolean_t   op_alternate;        /* Alternate analog/event solutions in OP analysis */
+    int             hist_window;         /* Node records kept in memory, 0 for all */
+    Mif_Boolean_t   parallel;            /* Call event-driven code models in parallel */
 };
 
 
@@ -92,7 +92,26 @@ void EVTqueue_inst(
 
 void EVTdequeue(CKTcircuit *ckt, double time);
 
+void EVTheap_set(Evt_Heap_t *heap, int index, double time);
+void EVTheap_remove(Evt_Heap_t *heap, int index);
+
+void *EVTpool_alloc(Evt_Pool_t **pools, size_t size);
+void EVTpool_release(Evt_Pool_t **pools);
+
+void EVThist_setup(CKTcircuit *ckt, Evt_Node_Data_t *node_data);
+void EVThist_retire(CKTcircuit *ckt, int node_index, int num_new);
+void EVThist_destroy(Evt_Node_Data_t *node_data);
+int EVThist_count(Evt_Node_Data_t *node_data, int node_index);
+Evt_Node_t *EVThist_first(
+    Evt_Hist_Cursor_t *cursor,
+    Evt_Node_Data_t   *node_data,
+    int               node_index,
+    int               udn_index);
+Evt_Node_t *EVThist_next(Evt_Hist_Cursor_t *cursor);
+void EVThist_close(Evt_Hist_Cursor_t *cursor);
+
 int EVTload(CKTcircuit *ckt, int inst_index);
+void EVTload_parallel(CKTcircuit *ckt, int num_calls, int *inst_index);
 
 void EVTprint(wordlist *wl);
 void EVTprintvcd(wordlist *wl);
@@ -8,13 +8,18 @@ typedef struct Evt_Inst_Index Evt_Inst_Index_t;
 typedef struct Evt_Node_Info Evt_Node_Info_t;
 typedef struct Evt_Inst_Info Evt_Inst_Info_t;
 typedef struct Evt_Info Evt_Info_t;
+typedef struct Evt_Pool Evt_Pool_t;
+typedef struct Evt_Heap Evt_Heap_t;
 typedef struct Evt_Inst_Event Evt_Inst_Event_t;
+typedef struct Evt_Inst_Defer Evt_Inst_Defer_t;
 typedef struct Evt_Inst_Queue Evt_Inst_Queue_t;
 typedef struct Evt_Node_Queue Evt_Node_Queue_t;
 typedef struct Evt_Output_Event Evt_Output_Event_t;
 typedef struct Evt_Output_Queue Evt_Output_Queue_t;
 typedef struct Evt_Queue Evt_Queue_t;
 typedef struct Evt_Node Evt_Node_t;
+typedef struct Evt_Node_Hist Evt_Node_Hist_t;
+typedef struct Evt_Hist_Cursor Evt_Hist_Cursor_t;
 typedef struct Evt_Node_Data Evt_Node_Data_t;
 typedef struct Evt_State Evt_State_t;
 typedef struct Evt_State_Desc Evt_State_Desc_t;
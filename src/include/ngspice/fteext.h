@@ -218,6 +218,7 @@ extern void inp_list(FILE *file, struct card *deck, struct card *extras, int typ
 struct card *inp_readall(FILE *fp, const char *dir_name,
         bool comfile, bool intfile, bool *expr_w_temper_p);
 extern FILE *inp_pathopen(const char *name, const char *mode);
+extern char *inp_pathresolve(const char *name);
 extern char *search_identifier(char *str, const char *identifier, char *str_begin);
 extern char *find_assignment(const char *s);
 extern char *find_back_assignment(const char *s, const char *start);
@@ -296,6 +297,7 @@ extern struct plot *raw_read(char *name);
 
 /* meas.c */
 extern bool do_measure(char *what, bool chk_only);
+extern wordlist *measure_parse_line(char *line);
 extern bool check_autostop(char *what);
 
 /* resource.c */
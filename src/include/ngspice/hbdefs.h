@@ -0,0 +1,29 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+#ifndef ngspice_HBDEFS_H
+#define ngspice_HBDEFS_H
+
+#include "ngspice/jobdefs.h"
+
+#ifdef WITH_HB
+    /* structure used to describe a harmonic balance analysis */
+
+typedef struct {
+    int JOBtype;
+    JOB *JOBnextJob;    /* pointer to next thing to do */
+    char *JOBname;      /* name of this job */
+    double HBfreq;      /* fundamental frequency */
+    int HBharms;        /* number of harmonics above DC */
+    int HBpoints;       /* time samples per period, 0 for automatic */
+} HBAN;
+
+enum {
+    HB_FREQ = 1,
+    HB_HARMS,
+    HB_POINTS,
+};
+#endif
+#endif
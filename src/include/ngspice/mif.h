@@ -84,4 +84,16 @@ extern int MIFmSize;
 
 extern Mif_Info_t  g_mif_info;
 
+/* EVTload_parallel() calls event-driven code models from several   */
+/* threads.  Each of these threads then points g_mif_thread_info to */
+/* its own copy of g_mif_info, which the cm_... functions find with */
+/* MIF_INFO.  Everywhere else g_mif_thread_info is NULL.            */
+#ifdef USE_OMP
+extern Mif_Info_t  *g_mif_thread_info;
+#pragma omp threadprivate(g_mif_thread_info)
+#define MIF_INFO (*(g_mif_thread_info ? g_mif_thread_info : &g_mif_info))
+#else
+#define MIF_INFO g_mif_info
+#endif
+
 #endif
@@ -121,6 +121,18 @@ enum {
     OPT_INDVERBOSITY,
     OPT_EPSMIN,
     OPT_CSHUNT,
+    OPT_DCSEED,
+    OPT_WAVERELAX,
+    OPT_MULTIRATE,
+    OPT_NOTRUNCBATCH,
+    OPT_PZARNOLDI,
+    OPT_PZROOTS,
+    OPT_ALTERINC,
+    OPT_OPREMEMBER,
+    OPT_OPRACE,
+    OPT_OPCHOSEN,
+    OPT_OPTRIED,
+    OPT_BLOCKSTEPS,
 };
 
 #ifdef XSPICE
@@ -135,6 +147,8 @@ enum {
     OPT_ENH_CONV_STEP,
     OPT_MIF_AUTO_PARTIAL,
     OPT_ENH_RSHUNT,
+    OPT_EVT_HIST_WINDOW,
+    OPT_EVT_PARALLEL,
 };
 
 /* gtri - end   - wbk - add new options */
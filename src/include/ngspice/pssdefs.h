@@ -39,4 +39,23 @@ enum {
     STEADY_COEFF,
 };
 
+/* accepted timepoints of one shooting period, with the integration
+ * coefficients of the step leading to each of them */
+typedef struct {
+    int num_points, max_points;
+    int size;           /* length of a solution vector */
+    int num_states;
+    double *time;
+    double *ag0, *ag1;
+    double **sol;
+    double **states;
+} PSStrace;
+
+extern int PSSshootSupported(CKTcircuit *);
+extern void PSStraceAdd(CKTcircuit *, PSStrace *, int);
+extern void PSStraceFree(PSStrace *);
+extern int PSSshootStep(CKTcircuit *, PSStrace *, int, double *, double *,
+                        double *);
+extern int PSSshootRestart(CKTcircuit *, double *);
+
 #endif
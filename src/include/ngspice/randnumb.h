@@ -13,10 +13,18 @@ extern double drand(void);
 extern double gauss0(void);
 extern double gauss1(void);
 extern int poisson(double);
+extern int poisson_inv(double, double);
 extern double exprand(double);
 
 extern void TausSeed(void);
 extern unsigned int CombLCGTausInt(void);
 extern unsigned int CombLCGTausInt2(void);
 
+/* counter based generator for the transient noise sources */
+extern unsigned int PhiloxSeed(void);
+extern unsigned int PhiloxHash(const char *name);
+extern double PhiloxUniform(const unsigned int key[2], unsigned int stream, unsigned int run, size_t index);
+extern void PhiloxGauss(const unsigned int key[2], unsigned int stream, unsigned int run,
+                        size_t first, size_t n, double *out);
+
 #endif
@@ -15,6 +15,7 @@ typedef struct st_modsen ModSenList;
 typedef struct st_devsen ParamSenList;
 typedef struct st_nodes Nodes;
 typedef struct st_output output;
+typedef struct st_sentrace SENtrace;
 
 struct st_sens {
     int		JOBtype;
@@ -37,6 +38,24 @@ struct st_sens {
     double	defperturb;
     unsigned int pct_flag :1;
 
+    double	tran_step;	/* transient sensitivity, TSTEP and TSTOP */
+    double	tran_stop;	/* of the forward transient */
+
+};
+
+/* solution and states of the accepted timepoints of the forward transient,
+ * recorded by DCtran() for the adjoint transient sensitivity */
+#define SEN_NCOEF 8
+
+struct st_sentrace {
+	int	num_points, max_points;
+	int	size;		/* length of a solution vector */
+	int	num_states;
+	double	*time;
+	double	**sol;
+	double	**states;
+	int	*order;		/* order of the formula leading to each point */
+	double	*coef;		/* its coefficients, SEN_NCOEF per point */
 };
 
 struct st_output {
@@ -70,6 +89,7 @@ struct st_devsenlist {
 extern int SENSask(CKTcircuit *,JOB *,int ,IFvalue *);
 extern int SENSsetParam(CKTcircuit *,JOB *,int ,IFvalue *);
 extern int sens_sens(CKTcircuit *,int);
+extern int sens_trace(CKTcircuit *, int);
 
 enum {
     SENS_POS = 2,
@@ -92,12 +112,15 @@ enum {
     SENS_DEVDEFPERT,
     SENS_TYPE,
     SENS_DEVICE,
+    SENS_TRAN,
 };
 
 enum {
     SENS_PARAM = 24,
     SENS_TOL,
     SENS_PERT,
+    SENS_TSTEP,
+    SENS_TSTOP,
 };
 
 #endif /*DEFS*/
@@ -26,8 +26,11 @@ void SMPcaSolve(SMPmatrix *Matrix, double RHS[], double iRHS[],
 		double Spare[], double iSpare[]);
 void SMPcSolve( SMPmatrix *, double [], double [], double [], double []);
 void SMPsolve( SMPmatrix *, double [], double []);
+void SMPaSolve( SMPmatrix *, double [], double []);
 int SMPmatSize( SMPmatrix *);
 int SMPnewMatrix( SMPmatrix **, int );
+int SMPcloneMatrix( SMPmatrix *, SMPmatrix ** );
+void SMPcopyValues( SMPmatrix *, SMPmatrix * );
 void SMPdestroy( SMPmatrix *);
 int SMPpreOrder( SMPmatrix *);
 void SMPprint( SMPmatrix * , char *);
@@ -36,10 +39,12 @@ void SMPgetError( SMPmatrix *, int *, int *);
 int SMPcProdDiag( SMPmatrix *, SPcomplex *, int *);
 int SMPcDProd(SMPmatrix *Matrix, SPcomplex *pMantissa, int *pExponent);
 SMPelement * SMPfindElt( SMPmatrix *, int , int , int );
+int SMPelementList(SMPmatrix *, double ***, int **, int **);
 int SMPcZeroCol(SMPmatrix *Matrix, int Col);
 int SMPcAddCol(SMPmatrix *Matrix, int Accum_Col, int Addend_Col);
 int SMPzeroRow(SMPmatrix *Matrix, int Row);
 void SMPconstMult(SMPmatrix *, double);
 void SMPmultiply(SMPmatrix *, double *, double *, double *, double *);
+void SMPmultTransposed(SMPmatrix *, double *, double *, double *, double *);
 
 #endif
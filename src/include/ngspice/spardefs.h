@@ -27,6 +27,10 @@ typedef struct {
 
     int SPnoiseInput;
     int SPnoiseOutput;
+
+#ifdef USE_OMP
+    struct SPpool *SPpool;  /* threaded sweep state, see span.c */
+#endif
 } SPAN;
 
 /* available step types: XXX should be somewhere else */
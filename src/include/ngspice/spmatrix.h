@@ -250,7 +250,9 @@ typedef struct MatrixFrame *MatrixPtr;
 /* Begin function declarations. */
 
 extern  void     spClear( MatrixPtr );
+extern  MatrixPtr spClone( MatrixPtr, int* );
 extern  spREAL   spCondition( MatrixPtr, spREAL, int* );
+extern  void     spCopyValues( MatrixPtr, MatrixPtr );
 extern  MatrixPtr spCreate( int, int, int* );
 extern  void     spDeleteRowAndCol( MatrixPtr, int, int );
 extern  void     spDestroy( MatrixPtr);
@@ -41,6 +41,9 @@ typedef struct {
     int TRCVset[TRCVNESTLEVEL];     /* flag to indicate this nest level used */
     int TRCVnestLevel;      /* number of levels of nesting called for */
     int TRCVnestState;      /* iteration state during pause */
+    double *TRCVseedRhs;    /* solution at the first point of the inner */
+    double *TRCVseedState;  /* sweep, seeds the next one */
+    int TRCVseedValid;      /* flag to indicate the seed is set */
 } TRCV;
 
 enum {
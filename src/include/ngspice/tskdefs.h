@@ -70,6 +70,15 @@ struct TSKtask {
     unsigned int TSKcopyNodesets:1; /* flag for nodeset copy */
     unsigned int TSKnodeDamping:1;  /* flag for node damping */
     unsigned int TSKnoopac:1; /* flag for no OP calculation before AC */
+    unsigned int TSKdcSeed:1; /* flag for seeding nested DC sweeps */
+    unsigned int TSKwaveRelax:1; /* flag for waveform relaxation */
+    unsigned int TSKmultiRate:1; /* flag for multirate integration */
+    unsigned int TSKnoTruncBatch:1; /* flag for device by device CKTtrunc() */
+    unsigned int TSKpzArnoldi:1; /* flag for eigenvalue pole-zero analysis */
+    int TSKpzRoots;           /* number of roots wanted from it */
+    unsigned int TSKalterInc:1; /* flag for incremental setup after alter */
+    unsigned int TSKopRemember:1; /* flag to try the last homotopy first */
+    unsigned int TSKopRace:1; /* flag to race the homotopies on copies */
     double TSKabsDv;                 /* abs limit for iter-iter voltage change */
     double TSKrelDv;                 /* rel limit for iter-iter voltage change */
     double TSKepsmin;         /* minimum value for log */
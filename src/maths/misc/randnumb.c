@@ -61,6 +61,9 @@ static unsigned CombState8 = 138; /* LCG state variable */
 static unsigned TauS(unsigned *state, int C1, int C2, int C3, unsigned m);
 static unsigned LGCS(unsigned *state, unsigned A1, unsigned A2);
 
+/* seed part of the key of the counter based generator */
+static unsigned PhiloxSeedKey = 0x9E3779B9U;
+
 double CombLCGTaus(void);
 float  CombLCGTaus2(void);
 
@@ -114,6 +117,10 @@ void TausSeed(void)
    CombState7 = (unsigned int)((double)rand()/(double)RAND_MAX * 32638.) + 129;
    CombState8 = (unsigned int)((double)rand()/(double)RAND_MAX * 32638.) + 129;
 
+   /* derived from the Tausworthe states, so rand() is not called again */
+   PhiloxSeedKey = (CombState1 << 17) ^ (CombState2 << 2) ^ (CombState3 >> 3) ^
+      (CombState4 * 2654435761U);
+
 #ifdef HVDEBUG
    printf("\nTausworthe Double generator init states: %d, %d, %d, %d\n", 
       CombState1, CombState2, CombState3, CombState4);
@@ -258,10 +265,16 @@ void rgauss(double* py1, double* py2)
 /** Code by: Inexpensive
     http://everything2.com/title/Generating+random+numbers+with+a+Poisson+distribution **/
 int poisson(double lambda)
+{
+  return poisson_inv(lambda, CombLCGTaus());
+}
+
+
+/* inverse of the Poisson distribution function at p in [0 .. 1[ */
+int poisson_inv(double lambda, double p)
 {
   int k=0;                          //Counter
   const int max_k = 1000;           //k upper limit
-  double p = CombLCGTaus();         //uniform random number
   double P = exp(-lambda);        //probability
   double sum=P;                     //cumulant
   if (sum>=p) return 0;             //done allready
@@ -283,6 +296,154 @@ double exprand(double mean)
 }
 
 
+/* Philox4x32-10 counter based generator, from:
+   J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw: "Parallel random
+   numbers: as easy as 1, 2, 3", Proc. SC11, 2011.
+   The random numbers are a pure function of a key and a counter, so
+   any sample of a stream may be generated at any time, in any order
+   and by any thread, with identical results.
+   The transient noise sources use key[0] = seed, key[1] = source name
+   and the counter {index low, index high, stream, run}.
+*/
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+/* number of counters evaluated together, the inner loops have this
+   constant trip count and are vectorized by the compiler */
+#define PHILOX_LANES 16
+
+static void
+philox_block(const unsigned key[2], const unsigned ctr[4], unsigned out[4])
+{
+   unsigned c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+   unsigned k0 = key[0], k1 = key[1];
+   int r;
+
+   for (r = 0; r < 10; r++) {
+      unsigned long long p0 = (unsigned long long) PHILOX_M0 * c0;
+      unsigned long long p1 = (unsigned long long) PHILOX_M1 * c2;
+      c0 = (unsigned) (p1 >> 32) ^ c1 ^ k0;
+      c1 = (unsigned) p1;
+      c2 = (unsigned) (p0 >> 32) ^ c3 ^ k1;
+      c3 = (unsigned) p0;
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+   }
+
+   out[0] = c0;
+   out[1] = c1;
+   out[2] = c2;
+   out[3] = c3;
+}
+
+
+/* uniform variate in ]0 .. 1[ from a 32 bit integer */
+static inline double
+philox_u01(unsigned x)
+{
+   return ((double) x + 0.5) * 2.3283064365386963e-10;
+}
+
+
+/* seed part of the key, follows 'setseed' and 'set rndseed' */
+unsigned int
+PhiloxSeed(void)
+{
+   return PhiloxSeedKey;
+}
+
+
+/* name part of the key, FNV-1a hash */
+unsigned int
+PhiloxHash(const char *name)
+{
+   unsigned h = 2166136261U;
+
+   if (name)
+      for (; *name; name++)
+         h = (h ^ (unsigned char) *name) * 16777619U;
+
+   return h;
+}
+
+
+/* uniform variate in ]0 .. 1[, sample 'index' of the stream */
+double
+PhiloxUniform(const unsigned int key[2], unsigned int stream, unsigned int run, size_t index)
+{
+   unsigned ctr[4], out[4];
+
+   ctr[0] = (unsigned) (index / 4);
+   ctr[1] = (unsigned) ((unsigned long long) index >> 34);
+   ctr[2] = stream;
+   ctr[3] = run;
+
+   philox_block(key, ctr, out);
+
+   return philox_u01(out[index % 4]);
+}
+
+
+/* fill out[0 .. n-1] with the Gaussian samples first .. first+n-1 of
+   the stream, zero mean and unit variance.
+   Four samples per counter, by the trigonometric Box-Muller transform,
+   which needs no rejection and keeps the sample to counter mapping fixed.
+*/
+void
+PhiloxGauss(const unsigned int key[2], unsigned int stream, unsigned int run,
+            size_t first, size_t n, double *out)
+{
+   const double twopi = 6.283185307179586;
+   unsigned bits[PHILOX_LANES][4];
+   double g[PHILOX_LANES][4];
+   size_t group = first / 4;
+   size_t last = first + n;
+   size_t i = first;
+
+   while (i < last) {
+      size_t ngroups = (last + 3) / 4 - group;
+      size_t j, k;
+
+      if (ngroups > PHILOX_LANES)
+         ngroups = PHILOX_LANES;
+
+      for (j = 0; j < ngroups; j++) {
+         unsigned ctr[4];
+         size_t c = group + j;
+         ctr[0] = (unsigned) c;
+         ctr[1] = (unsigned) ((unsigned long long) c >> 32);
+         ctr[2] = stream;
+         ctr[3] = run;
+         philox_block(key, ctr, bits[j]);
+      }
+
+      for (j = 0; j < ngroups; j++) {
+         double r0 = sqrt(-2.0 * log(philox_u01(bits[j][0])));
+         double r1 = sqrt(-2.0 * log(philox_u01(bits[j][2])));
+         double a0 = twopi * philox_u01(bits[j][1]);
+         double a1 = twopi * philox_u01(bits[j][3]);
+         g[j][0] = r0 * cos(a0);
+         g[j][1] = r0 * sin(a0);
+         g[j][2] = r1 * cos(a1);
+         g[j][3] = r1 * sin(a1);
+      }
+
+      for (j = 0; j < ngroups; j++)
+         for (k = 0; k < 4; k++) {
+            size_t s = 4 * (group + j) + k;
+            if (s >= i && s < last)
+               out[s - first] = g[j][k];
+         }
+
+      group += ngroups;
+      i = 4 * group;
+   }
+}
+
+
 /* seed random number generators immediately
 * command "setseed"
 *   take value of variable rndseed as seed
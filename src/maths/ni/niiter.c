@@ -122,6 +122,10 @@ NIiter(CKTcircuit *ckt, int maxIter)
                      * wrong - so we ask for the troublesome entry
                      * Limit the number of messages to 6, if not 'set ngdebug'.
                      */
+#ifdef USE_OMP
+                    /* copies made by CKTclone() may iterate in parallel */
+#pragma omp critical(ni_message)
+#endif
                     if (ft_ngdebug || msgcount < 6) {
                         SMPgetError(ckt->CKTmatrix, &i, &j);
                         if(eq(NODENAME(ckt, i), NODENAME(ckt, j)))
@@ -191,8 +195,13 @@ NIiter(CKTcircuit *ckt, int maxIter)
                 ckt->CKTstat->STATnumIter += iterno;
                 /* we don't use this info during transient analysis */
                 if (ckt->CKTcurrentAnalysis != DOING_TRAN) {
-                    FREE(errMsg);
-                    errMsg = copy("Too many iterations without convergence");
+#ifdef USE_OMP
+#pragma omp critical(ni_message)
+#endif
+                    {
+                        FREE(errMsg);
+                        errMsg = copy("Too many iterations without convergence");
+                    }
 #ifdef STEPDEBUG
                     fprintf(stderr, "too many iterations without convergence: %d iter's (max iter == %d)\n",
                     iterno, maxIter);
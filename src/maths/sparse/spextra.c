@@ -5,6 +5,8 @@
  *
  *  >>> User accessible functions contained in this file:
  *  spConstMul
+ *  spClone
+ *  spCopyValues
  *
  *  >>> Other functions contained in this file:
  */
@@ -22,6 +24,8 @@
  *      Matrix type and macro definitions for the sparse matrix routines.
  */
 
+#include <assert.h>
+
 #define spINSIDE_SPARSE
 #include "spconfig.h"
 #include "ngspice/spmatrix.h"
@@ -43,3 +47,167 @@ spConstMult(MatrixPtr matrix, double constant)
 	}
 
 }
+
+
+
+
+
+/*
+ *  CLONE MATRIX
+ *
+ *  Creates a new matrix with the same structure, pivot order and
+ *  partitioning as an already ordered matrix.  Fill-ins of the source
+ *  become ordinary elements of the clone, so the clone can be factored
+ *  with spFactor() and solved with spSolve() independently of the
+ *  source, e.g. from another thread.  Element values are copied as
+ *  well, use spCopyValues() to refresh them later on.  A source which
+ *  has not been ordered yet gives a clone which is not either, with the
+ *  same elements and the same internal numbering, to be ordered by its
+ *  first spOrderAndFactor().
+ *
+ *  >>> Returned:
+ *  A pointer to the new matrix, NULL on error.
+ *
+ *  >>> Arguments:
+ *  Source  <input>  (MatrixPtr)
+ *      Pointer to the matrix to be cloned.
+ *  pError  <output>  (int *)
+ *      Returns error flag.
+ *
+ *  >>> Possible errors:
+ *  spNO_MEMORY
+ */
+
+MatrixPtr
+spClone(MatrixPtr Source, int *pError)
+{
+    MatrixPtr  Matrix;
+    ElementPtr  pSource, pElement, *ppLast;
+    int  I, Col, Size;
+
+    /* Begin `spClone'. */
+    assert( IS_SPARSE( Source ) );
+
+    Matrix = spCreate( MAX(Source->AllocatedSize, Source->AllocatedExtSize),
+                       Source->Complex, pError );
+    if (Matrix == NULL)
+        return NULL;
+
+    Size = Source->Size;
+    Matrix->Size = Size;
+    Matrix->ExtSize = Source->ExtSize;
+    Matrix->CurrentSize = Source->CurrentSize;
+
+    for (I = 0; I <= Size; I++) {
+        Matrix->IntToExtRowMap[I] = Source->IntToExtRowMap[I];
+        Matrix->IntToExtColMap[I] = Source->IntToExtColMap[I];
+    }
+#if TRANSLATE
+    for (I = 0; I <= Source->ExtSize; I++) {
+        Matrix->ExtToIntRowMap[I] = Source->ExtToIntRowMap[I];
+        Matrix->ExtToIntColMap[I] = Source->ExtToIntColMap[I];
+    }
+#endif
+
+    /* Rebuild the columns in the same order, fill-ins included. */
+    for (Col = 1; Col <= Size; Col++) {
+        ppLast = &Matrix->FirstInCol[Col];
+        for (pSource = Source->FirstInCol[Col]; pSource != NULL;
+             pSource = pSource->NextInCol) {
+            pElement = spcGetElement( Matrix );
+            if (pElement == NULL) {
+                *pError = spNO_MEMORY;
+                spDestroy( Matrix );
+                return NULL;
+            }
+            *pElement = *pSource;
+            pElement->NextInRow = NULL;
+            pElement->NextInCol = NULL;
+            if (pElement->Row == Col)
+                Matrix->Diag[Col] = pElement;
+            *ppLast = pElement;
+            ppLast = &pElement->NextInCol;
+        }
+    }
+    spcLinkRows( Matrix );
+
+    spcCreateInternalVectors( Matrix );
+    if (Matrix->Error == spNO_MEMORY) {
+        *pError = spNO_MEMORY;
+        spDestroy( Matrix );
+        return NULL;
+    }
+    if (Source->Partitioned) {
+        for (I = 1; I <= Size; I++) {
+            Matrix->DoRealDirect[I] = Source->DoRealDirect[I];
+            Matrix->DoCmplxDirect[I] = Source->DoCmplxDirect[I];
+        }
+        Matrix->Partitioned = YES;
+    } else if (!Source->NeedsOrdering) {
+        spPartition( Matrix, spDEFAULT_PARTITION );
+    }
+
+    Matrix->PreviousMatrixWasComplex = Source->PreviousMatrixWasComplex;
+    Matrix->Elements = Source->Elements;
+    Matrix->Originals = Source->Originals;
+    Matrix->Fillins = Source->Fillins;
+    Matrix->Reordered = Source->Reordered;
+    Matrix->NeedsOrdering = Source->NeedsOrdering;
+    Matrix->NumberOfInterchangesIsOdd = Source->NumberOfInterchangesIsOdd;
+    Matrix->MaxRowCountInLowerTri = Source->MaxRowCountInLowerTri;
+    Matrix->Singletons = Source->Singletons;
+    Matrix->RelThreshold = Source->RelThreshold;
+    Matrix->AbsThreshold = Source->AbsThreshold;
+    Matrix->Factored = NO;
+
+    return Matrix;
+}
+
+
+
+
+
+/*
+ *  COPY MATRIX VALUES
+ *
+ *  Copies the element values of Source into Dest, where Dest has been
+ *  created from Source by spClone() and Source has not been reordered
+ *  since.  Dest is left unfactored and takes over the real/complex mode
+ *  of Source.
+ *
+ *  >>> Arguments:
+ *  Dest  <output>  (MatrixPtr)
+ *      Pointer to the clone.
+ *  Source  <input>  (MatrixPtr)
+ *      Pointer to the matrix the clone has been made from.
+ */
+
+void
+spCopyValues(MatrixPtr Dest, MatrixPtr Source)
+{
+    ElementPtr  pSource, pDest;
+    int  Col, Size;
+
+    /* Begin `spCopyValues'. */
+    assert( IS_SPARSE( Dest ) && IS_SPARSE( Source ) );
+    assert( Dest->Size == Source->Size );
+
+    Size = Source->Size;
+    for (Col = 1; Col <= Size; Col++) {
+        pDest = Dest->FirstInCol[Col];
+        for (pSource = Source->FirstInCol[Col]; pSource != NULL;
+             pSource = pSource->NextInCol) {
+            assert( pDest != NULL && pDest->Row == pSource->Row );
+            pDest->Real = pSource->Real;
+            pDest->Imag = pSource->Imag;
+            pDest = pDest->NextInCol;
+        }
+    }
+
+    Dest->Complex = Source->Complex;
+    Dest->PreviousMatrixWasComplex = Source->PreviousMatrixWasComplex;
+    Dest->Factored = NO;
+    Dest->Error = spOKAY;
+    Dest->SingularRow = 0;
+    Dest->SingularCol = 0;
+}
@@ -22,8 +22,11 @@
  *  SMPcaSolve
  *  SMPcSolve
  *  SMPsolve
+ *  SMPaSolve
  *  SMPmatSize
  *  SMPnewMatrix
+ *  SMPcloneMatrix
+ *  SMPcopyValues
  *  SMPdestroy
  *  SMPpreOrder
  *  SMPprint
@@ -31,6 +34,7 @@
  *  SMPcProdDiag
  *  LoadGmin
  *  SMPfindElt
+ *  SMPelementList
  */
 
 /*
@@ -236,6 +240,17 @@ SMPsolve(SMPmatrix *Matrix, double RHS[], double Spare[])
     spSolve( Matrix, RHS, RHS, NULL, NULL );
 }
 
+/*
+ * SMPaSolve()
+ */
+void
+SMPaSolve(SMPmatrix *Matrix, double RHS[], double Spare[])
+{
+    NG_IGNORE(Spare);
+
+    spSolveTransposed( Matrix, RHS, RHS, NULL, NULL );
+}
+
 /*
  * SMPmatSize()
  */
@@ -256,6 +271,26 @@ SMPnewMatrix(SMPmatrix **pMatrix, int size)
     return Error;
 }
 
+/*
+ * SMPcloneMatrix()
+ */
+int
+SMPcloneMatrix(SMPmatrix *Matrix, SMPmatrix **pClone)
+{
+    int Error;
+    *pClone = spClone( Matrix, &Error );
+    return Error;
+}
+
+/*
+ * SMPcopyValues()
+ */
+void
+SMPcopyValues(SMPmatrix *Clone, SMPmatrix *Matrix)
+{
+    spCopyValues( Clone, Matrix );
+}
+
 /*
  * SMPdestroy()
  */
@@ -470,6 +505,40 @@ SMPfindElt(SMPmatrix *Matrix, int Row, int Col, int CreateIfMissing)
     return Element;
 }
 
+/*
+ * SMPelementList()
+ *
+ * The addresses of the values of all elements of the matrix, with their
+ * external row and column numbers.  The arrays are allocated here, the
+ * number of elements is returned.
+ */
+int
+SMPelementList(SMPmatrix *Matrix, double ***pValues, int **pRows, int **pCols)
+{
+    ElementPtr Element;
+    int Col, n = 0;
+
+    assert( IS_SPARSE( Matrix ) );
+    for (Col = 1; Col <= Matrix->Size; Col++)
+        for (Element = Matrix->FirstInCol[Col]; Element; Element = Element->NextInCol)
+            n++;
+
+    *pValues = SP_MALLOC(double *, n);
+    *pRows = SP_MALLOC(int, n);
+    *pCols = SP_MALLOC(int, n);
+
+    n = 0;
+    for (Col = 1; Col <= Matrix->Size; Col++)
+        for (Element = Matrix->FirstInCol[Col]; Element; Element = Element->NextInCol) {
+            (*pValues)[n] = &Element->Real;
+            (*pRows)[n] = Matrix->IntToExtRowMap[Element->Row];
+            (*pCols)[n] = Matrix->IntToExtColMap[Col];
+            n++;
+        }
+
+    return n;
+}
+
 /* XXX The following should probably be implemented in spUtils */
 
 /*
@@ -574,3 +643,12 @@ SMPmultiply(SMPmatrix *Matrix, double *RHS, double *Solution, double *iRHS, doub
 {
     spMultiply(Matrix, RHS, Solution, iRHS, iSolution);
 }
+
+/*
+ * SMPmultTransposed()
+ */
+void
+SMPmultTransposed(SMPmatrix *Matrix, double *RHS, double *Solution, double *iRHS, double *iSolution)
+{
+    spMultTransposed(Matrix, RHS, Solution, iRHS, iSolution);
+}
@@ -40,6 +40,187 @@ do { \
     ckt->CKTstat->STATacSyncTime += ckt->CKTstat->STATsyncTime - startkTime; \
 } while(0)
 
+/* Advance freq to the next point of the sweep.
+ * Sets *done if the sweep consists of a single point only. */
+static int
+ACnextFreq(ACAN *job, double *freq, int *done)
+{
+    switch (job->ACstepType) {
+    case DECADE:
+    case OCTAVE:
+
+/* inserted again 14.12.2001  */
+#ifdef HAS_PROGREP
+        {
+            double endfreq   = job->ACstopFreq;
+            double startfreq = job->ACstartFreq;
+            endfreq   = log(endfreq);
+            if (startfreq == 0.0)
+                startfreq = 1e-12;
+            startfreq = log(startfreq);
+
+            if (*freq > 0.0)
+                SetAnalyse( "ac", (int)((log(*freq)-startfreq) * 1000.0 / (endfreq-startfreq)));
+        }
+#endif
+
+        *freq *= job->ACfreqDelta;
+        *done = (job->ACfreqDelta == 1);
+        return OK;
+
+    case LINEAR:
+
+#ifdef HAS_PROGREP
+        {
+            double endfreq   = job->ACstopFreq;
+            double startfreq = job->ACstartFreq;
+            SetAnalyse( "ac", (int)((*freq - startfreq)* 1000.0 / (endfreq-startfreq)));
+        }
+#endif
+
+        *freq += job->ACfreqDelta;
+        *done = (job->ACfreqDelta == 0);
+        return OK;
+
+    default:
+        return E_INTERN;
+    }
+}
+
+
+/* Send the solution in CKTrhsOld/CKTirhsOld to the output plot */
+static int
+ACdump(CKTcircuit *ckt, double freq, runDesc *acPlot)
+{
+    int error;
+
+#ifdef XSPICE
+/* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
+
+    if(g_ipc.enabled)
+        ipc_send_data_prefix(freq);
+
+    error = CKTacDump(ckt,freq,acPlot);
+
+    if(g_ipc.enabled)
+        ipc_send_data_suffix();
+
+/* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
+#else
+    error = CKTacDump(ckt,freq,acPlot);
+#endif
+
+    return error;
+}
+
+
+#ifdef USE_OMP
+
+extern int nthreads;
+
+/* The frequency points of an AC sweep are independent once the operating
+ * point is known.  The threaded sweep loads a batch of frequencies one
+ * after the other, factors and solves them concurrently on private copies
+ * of the matrix (see cktacslot.c) and dumps the results in frequency
+ * order.  The results are identical to the ones of the serial sweep, as
+ * long as no point needs a new pivot order.  Loading stays serial, so
+ * little is gained where device evaluation dominates.
+ */
+
+static int
+ACthreaded(CKTcircuit *ckt)
+{
+    if (nthreads < 2)
+        return 0;
+
+    /* a new operating point at every frequency */
+    if (ckt->CKTvarHertz)
+        return 0;
+
+#ifdef WANT_SENSE2
+    if (ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & ACSEN))
+        return 0;
+#endif
+
+    return 1;
+}
+
+
+/* Solve the frequency on the shared matrix */
+static int
+ACsolveShared(CKTcircuit *ckt, double freq)
+{
+    ckt->CKTomega = 2.0 * M_PI * freq;
+    ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC;
+    return NIacIter(ckt);
+}
+
+
+static int
+ACsweepThreaded(CKTcircuit *ckt, ACAN *job, double freq, double freqTol,
+                runDesc *acPlot)
+{
+    ACslots pool = { NULL, 0, 0, 0 };
+    int done = 0;
+    int error;
+    int i, n;
+
+    /* The first point settles the complex pivot order of the shared
+     * matrix, which is then handed down to the slots. */
+    error = ACsolveShared(ckt, freq);
+    if (!error)
+        error = ACdump(ckt, freq, acPlot);
+    if (!error)
+        error = ACnextFreq(job, &freq, &done);
+    if (!error)
+        error = CKTacSlotsCreate(ckt, &pool, nthreads, 0);
+
+    while (!error && !done && freq <= job->ACstopFreq + freqTol) {
+
+        if (SPfrontEnd->IFpauseTest()) {
+            /* user asked us to pause via an interrupt */
+            job->ACsaveFreq = freq;
+            error = E_PAUSE;
+            break;
+        }
+
+        /* load a batch of frequencies */
+        ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC;
+        for (n = 0; n < pool.numSlots && !done && freq <= job->ACstopFreq + freqTol; n++) {
+            error = CKTacSlotLoad(ckt, &pool.slots[n], freq);
+            if (!error)
+                error = ACnextFreq(job, &freq, &done);
+            if (error)
+                break;
+        }
+        if (error)
+            break;
+
+        CKTacSlotsSolve(ckt, &pool, n, 1, 0, 0);
+
+        /* emit in frequency order */
+        for (i = 0; i < n; i++) {
+            ACslot *slot = &pool.slots[i];
+            if (slot->error == E_SINGULAR)
+                /* the pivot order does not fit this frequency */
+                error = CKTacSlotRedo(ckt, &pool, slot, 1, 0, 0);
+            else
+                error = slot->error;
+            if (!error) {
+                CKTacSlotRestore(ckt, &pool, slot);
+                error = ACdump(ckt, slot->freq, acPlot);
+            }
+            if (error)
+                break;
+        }
+    }
+
+    CKTacSlotsDestroy(&pool);
+    return error;
+}
+
+#endif
+
 
 int
 ACan(CKTcircuit *ckt, int restart)
@@ -54,10 +235,10 @@ ACan(CKTcircuit *ckt, int restart)
     double startkTime;
     double startTime;
     int error;
+    int done = 0;
     int numNames;
     IFuid *nameList;  /* va: tmalloc'ed list of names */
     IFuid freqUid;
-    static runDesc *acPlot = NULL;
     runDesc *plot = NULL;
 
 
@@ -165,14 +346,14 @@ ACan(CKTcircuit *ckt, int restart)
                                    ckt->CKTcurJob->JOBname,
                                    NULL, IF_REAL,
                                    numNames, nameList, IF_REAL,
-                                   &acPlot);
+                                   &job->ACplot);
         txfree(nameList);
 
         ipc_send_dcop_prefix();
-        CKTdump(ckt, 0.0, acPlot);
+        CKTdump(ckt, 0.0, job->ACplot);
         ipc_send_dcop_suffix();
 
-        SPfrontEnd->OUTendPlot (acPlot);
+        SPfrontEnd->OUTendPlot (job->ACplot);
     }
 /* gtri - end - wbk */
 #endif
@@ -202,12 +383,12 @@ ACan(CKTcircuit *ckt, int restart)
                                            ckt->CKTcurJob->JOBname,
                                            freqUid, IF_REAL,
                                            numNames, nameList, IF_COMPLEX,
-                                           &acPlot);
+                                           &job->ACplot);
 	tfree(nameList);		
 	if(error) return(error);
 
         if (job->ACstepType != LINEAR) {
-	    SPfrontEnd->OUTattributes (acPlot, NULL, OUT_SCALE_LOG, NULL);
+	    SPfrontEnd->OUTattributes (job->ACplot, NULL, OUT_SCALE_LOG, NULL);
 	}
         freq = job->ACstartFreq;
 
@@ -219,7 +400,7 @@ ACan(CKTcircuit *ckt, int restart)
                                            NULL,
                                            NULL, 0,
                                            666, NULL, 666,
-                                           &acPlot);
+                                           &job->ACplot);
 	/* saj*/    
     }
         
@@ -252,6 +433,22 @@ ACan(CKTcircuit *ckt, int restart)
 
     ckt->CKTcurrentAnalysis = DOING_AC;
 
+#ifdef USE_OMP
+    if (ACthreaded(ckt)) {
+        error = ACsweepThreaded(ckt, job, freq, freqTol, job->ACplot);
+        if (error == E_PAUSE)
+            return(error);
+        if (error) {
+            UPDATE_STATS(DOING_AC);
+            return(error);
+        }
+        SPfrontEnd->OUTendPlot (job->ACplot);
+        job->ACplot = NULL;
+        UPDATE_STATS(0);
+        return(0);
+    }
+#endif
+
     /* main loop through all scheduled frequencies */
     while (freq <= job->ACstopFreq + freqTol) {
         if(SPfrontEnd->IFpauseTest()) {
@@ -323,72 +520,24 @@ ACan(CKTcircuit *ckt, int restart)
         }
 #endif
 
-#ifdef XSPICE
-/* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
-
-        if(g_ipc.enabled)
-            ipc_send_data_prefix(freq);
-
-        error = CKTacDump(ckt,freq,acPlot);
-
-        if(g_ipc.enabled)
-            ipc_send_data_suffix();
-
-/* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
-#else
-        error = CKTacDump(ckt,freq,acPlot);
-#endif	
+        error = ACdump(ckt, freq, job->ACplot);
         if (error) {
 	    UPDATE_STATS(DOING_AC);
  	    return(error);
  	}
 
         /*  increment frequency */
-
-        switch (job->ACstepType) {
-        case DECADE:
-        case OCTAVE:
-
-/* inserted again 14.12.2001  */
-#ifdef HAS_PROGREP
-            {
-                double endfreq   = job->ACstopFreq;
-                double startfreq = job->ACstartFreq;
-                endfreq   = log(endfreq);
-                if (startfreq == 0.0)
-                    startfreq = 1e-12;
-                startfreq = log(startfreq);
-
-                if (freq > 0.0)
-                    SetAnalyse( "ac", (int)((log(freq)-startfreq) * 1000.0 / (endfreq-startfreq)));
-            }
-#endif
-
-            freq *= job->ACfreqDelta;
-            if (job->ACfreqDelta == 1) goto endsweep;
-        break;
-        case LINEAR:
-
-#ifdef HAS_PROGREP
-			 {
-				 double endfreq   = job->ACstopFreq;
-				 double startfreq = job->ACstartFreq;
-				 SetAnalyse( "ac", (int)((freq - startfreq)* 1000.0 / (endfreq-startfreq)));
-			 }
-#endif
-
-            freq += job->ACfreqDelta;
-            if (job->ACfreqDelta == 0) goto endsweep;
-            break;
-        default:
-            return(E_INTERN);
-    
+        error = ACnextFreq(job, &freq, &done);
+        if (error) {
+            UPDATE_STATS(DOING_AC);
+            return(error);
         }
-
+        if (done)
+            break;
     }
-endsweep:
-    SPfrontEnd->OUTendPlot (acPlot);
-    acPlot = NULL;
+
+    SPfrontEnd->OUTendPlot (job->ACplot);
+    job->ACplot = NULL;
     UPDATE_STATS(0);
     return(0);
 }
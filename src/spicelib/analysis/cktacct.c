@@ -19,6 +19,21 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/spmatrix.h"
 
 
+static const char *
+homotopy_name(int strategy)
+{
+    switch (strategy) {
+    case OP_GMINSTEP:
+        return "gmin";
+    case OP_SRCSTEP:
+        return "source";
+    case OP_OPTRAN:
+        return "optran";
+    default:
+        return "none";
+    }
+}
+
 
 /* ARGSUSED */
 int
@@ -121,6 +136,25 @@ CKTacct(CKTcircuit *ckt, JOB *anal, int which, IFvalue *val)
     case OPT_ACSOLVE:
         val->rValue = ckt->CKTstat->STATacSolveTime;
         break;
+    case OPT_OPCHOSEN:
+        val->sValue = copy(homotopy_name(ckt->CKTopChosen));
+        break;
+    case OPT_OPTRIED: {
+        char buf[32] = "none";
+        int i;
+        for (i = 0; i < ckt->CKTopNumTried; i++) {
+            if (i == 0)
+                buf[0] = '\0';
+            else
+                strcat(buf, " ");
+            strcat(buf, homotopy_name(ckt->CKTopTried[i]));
+        }
+        val->sValue = copy(buf);
+        break;
+    }
+    case OPT_BLOCKSTEPS:
+        val->sValue = copy(ckt->CKTwrSteps ? ckt->CKTwrSteps : "none");
+        break;
     case OPT_TEMP:
         val->rValue = ckt->CKTtemp - CONSTCtoK;
         break;
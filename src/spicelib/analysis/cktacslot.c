@@ -0,0 +1,246 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Solving several frequency points of a small signal sweep at once.
+ *
+ * Once the operating point is known, the points of an AC, noise or
+ * S-parameter sweep are independent of each other.  Only loading the
+ * matrix touches the device instances, which share CKTmatrix through
+ * their element pointers, so loading stays serial: each point is loaded
+ * on CKTmatrix and copied into a slot holding a private clone of the
+ * matrix with the same structure and pivot order.  The slots are then
+ * factored and solved concurrently.  The arithmetic is the one of
+ * NIacIter() and NInzIter(), so results do not depend on the number of
+ * slots or threads.
+ *
+ * CKTmatrix must have been factored as a complex matrix before the slots
+ * are created, typically by solving the first point of the sweep with
+ * NIacIter().  A slot which fails to factor with the inherited pivot
+ * order reports E_SINGULAR; the caller then hands it to CKTacSlotRedo(),
+ * which reorders that clone only.  CKTmatrix and the other slots keep
+ * their order, where the serial sweep would have reordered CKTmatrix for
+ * all points to come, so the points after a reordering may differ from
+ * the serial sweep in the last digits.
+ *
+ * Loading is not shared out: it is one CKTacLoad() per point, as in the
+ * serial sweep, and only factoring and solving run in parallel.  The gain
+ * therefore depends on the share of the factorization, it is large for
+ * big matrices and small for circuits dominated by device evaluation.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/smpdefs.h"
+#include "ngspice/sperror.h"
+
+#ifdef USE_OMP
+extern int nthreads;
+#endif
+
+
+int
+CKTacSlotsCreate(CKTcircuit *ckt, ACslots *pool, int numSlots, int adjoint)
+{
+    int i;
+
+    pool->size = SMPmatSize(ckt->CKTmatrix);
+    pool->numSlots = numSlots;
+    pool->adjoint = adjoint;
+    pool->slots = TMALLOC(ACslot, numSlots);
+
+    for (i = 0; i < numSlots; i++) {
+        ACslot *slot = &pool->slots[i];
+        slot->rhs = TMALLOC(double, pool->size + 1);
+        slot->irhs = TMALLOC(double, pool->size + 1);
+        if (adjoint) {
+            slot->arhs = TMALLOC(double, pool->size + 1);
+            slot->airhs = TMALLOC(double, pool->size + 1);
+        }
+    }
+
+    return CKTacSlotsReclone(ckt, pool);
+}
+
+
+/* (Re)create the matrix clones from the current state of CKTmatrix */
+int
+CKTacSlotsReclone(CKTcircuit *ckt, ACslots *pool)
+{
+    int i, error;
+
+    for (i = 0; i < pool->numSlots; i++) {
+        ACslot *slot = &pool->slots[i];
+        if (slot->matrix)
+            SMPdestroy(slot->matrix);
+        slot->matrix = NULL;
+        slot->stale = 0;
+        error = SMPcloneMatrix(ckt->CKTmatrix, &slot->matrix);
+        if (error)
+            return error;
+    }
+
+    return OK;
+}
+
+
+void
+CKTacSlotsDestroy(ACslots *pool)
+{
+    int i;
+
+    if (!pool->slots)
+        return;
+
+    for (i = 0; i < pool->numSlots; i++) {
+        ACslot *slot = &pool->slots[i];
+        if (slot->matrix)
+            SMPdestroy(slot->matrix);
+        tfree(slot->rhs);
+        tfree(slot->irhs);
+        tfree(slot->arhs);
+        tfree(slot->airhs);
+    }
+    tfree(pool->slots);
+    pool->numSlots = 0;
+}
+
+
+/* Load the circuit at freq into slot, CKTmode has to be set by the caller */
+int
+CKTacSlotLoad(CKTcircuit *ckt, ACslot *slot, double freq)
+{
+    size_t bytes = (size_t) (SMPmatSize(ckt->CKTmatrix) + 1) * sizeof(double);
+    int error;
+
+    /* reordered by CKTacSlotRedo(), take it again from CKTmatrix */
+    if (slot->stale) {
+        SMPdestroy(slot->matrix);
+        slot->matrix = NULL;
+        error = SMPcloneMatrix(ckt->CKTmatrix, &slot->matrix);
+        if (error)
+            return error;
+        slot->stale = 0;
+    }
+
+    ckt->CKTomega = 2.0 * M_PI * freq;
+    ckt->CKTnoncon = 0;
+
+    error = CKTacLoad(ckt);
+    if (error)
+        return error;
+
+    SMPcopyValues(slot->matrix, ckt->CKTmatrix);
+    memcpy(slot->rhs, ckt->CKTrhs, bytes);
+    memcpy(slot->irhs, ckt->CKTirhs, bytes);
+    slot->freq = freq;
+    slot->error = OK;
+
+    return OK;
+}
+
+
+/* Solve a factored slot, and the adjoint system if the pool has one */
+static void
+slot_solve(ACslots *pool, ACslot *slot, int posDrive, int negDrive)
+{
+    int j;
+
+    SMPcSolve(slot->matrix, slot->rhs, slot->irhs, NULL, NULL);
+    slot->rhs[0] = 0.0;
+    slot->irhs[0] = 0.0;
+
+    if (pool->adjoint) {
+        for (j = 0; j <= pool->size; j++) {
+            slot->arhs[j] = 0.0;
+            slot->airhs[j] = 0.0;
+        }
+        slot->arhs[posDrive] = 1.0;     /* apply unit current excitation */
+        slot->arhs[negDrive] = -1.0;
+        SMPcaSolve(slot->matrix, slot->arhs, slot->airhs, NULL, NULL);
+        slot->arhs[0] = 0.0;
+        slot->airhs[0] = 0.0;
+    }
+}
+
+
+/* Factor the first n slots and, if solve is set, solve them.  With an
+ * adjoint pool the adjoint system driven by a unit current between
+ * posDrive and negDrive is solved as well, see NInzIter(). */
+void
+CKTacSlotsSolve(CKTcircuit *ckt, ACslots *pool, int n, int solve,
+                int posDrive, int negDrive)
+{
+    double startTime = SPfrontEnd->IFseconds();
+    int i;
+
+#ifdef USE_OMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+#endif
+    for (i = 0; i < n; i++) {
+        ACslot *slot = &pool->slots[i];
+
+        slot->error = SMPcLUfac(slot->matrix, ckt->CKTpivotAbsTol);
+        if (slot->error || !solve)
+            continue;
+
+        slot_solve(pool, slot, posDrive, negDrive);
+    }
+
+    ckt->CKTstat->STATdecompTime += SPfrontEnd->IFseconds() - startTime;
+}
+
+
+/* Load, factor and solve again the point of a slot which failed to factor
+ * with the inherited pivot order.  As NIacIter() would, the matrix is
+ * reordered, but only the clone of this slot.  It no longer fits
+ * CKTmatrix then, and the next CKTacSlotLoad() into the slot clones it
+ * again, so a singular point costs one clone and not one per slot.
+ * CKTmode has to be set by the caller, as for CKTacSlotLoad(). */
+int
+CKTacSlotRedo(CKTcircuit *ckt, ACslots *pool, ACslot *slot, int solve,
+              int posDrive, int negDrive)
+{
+    double startTime;
+    int error, ignore;
+
+    error = CKTacSlotLoad(ckt, slot, slot->freq);
+    if (error)
+        return error;
+
+    startTime = SPfrontEnd->IFseconds();
+    error = SMPcReorder(slot->matrix, ckt->CKTpivotAbsTol,
+                        ckt->CKTpivotRelTol, &ignore);
+    ckt->CKTstat->STATreorderTime += SPfrontEnd->IFseconds() - startTime;
+    slot->stale = 1;
+    slot->error = error;
+    if (error)
+        return error;
+
+    if (solve)
+        slot_solve(pool, slot, posDrive, negDrive);
+
+    return OK;
+}
+
+
+/* Hand the solution of a slot over to the circuit, as NIacIter() and
+ * NInzIter() would have left it: the solution in CKTrhsOld/CKTirhsOld,
+ * the adjoint solution in CKTrhs/CKTirhs. */
+void
+CKTacSlotRestore(CKTcircuit *ckt, ACslots *pool, ACslot *slot)
+{
+    size_t bytes = (size_t) (pool->size + 1) * sizeof(double);
+
+    memcpy(ckt->CKTrhsOld, slot->rhs, bytes);
+    memcpy(ckt->CKTirhsOld, slot->irhs, bytes);
+
+    if (pool->adjoint) {
+        memcpy(ckt->CKTrhs, slot->arhs, bytes);
+        memcpy(ckt->CKTirhs, slot->airhs, bytes);
+    }
+
+    ckt->CKTomega = 2.0 * M_PI * slot->freq;
+}
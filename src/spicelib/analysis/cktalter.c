@@ -0,0 +1,401 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Incremental setup after alter and altermod.
+ *
+ * Every analysis normally starts with CKTunsetup(), CKTsetup() and
+ * CKTtemp() of the whole circuit, a new matrix and a new ordering.  With
+ * 'option alterinc' the instances and models changed by CKTparam() and
+ * CKTmodParam() since the last setup are recorded here, and the next
+ * analysis only sets up these instances again and computes the
+ * temperature dependent parameters of their models.  The matrix, its
+ * ordering and the state vector are kept.
+ *
+ * Setup is done instance by instance.  An instance has to come out of
+ * its DEVsetup() byte for byte as it went in, with no new node and no
+ * more states than it had.  Before, the DEVinstUnsetup() of the device
+ * clears the internal nodes shorted to a terminal, so that DEVsetup()
+ * decides on them again, and keeps the nodes the instance made.  A
+ * device with a DEVunsetup() but without a DEVinstUnsetup() is set up
+ * with the whole circuit.  If a change needs a different structure,
+ * e.g. a series resistance altered to or from zero, the instance is
+ * restored and the circuit is set up from scratch as before.  The same
+ * happens if the temperature changed or an option read by the setup was
+ * set since the last setup (see CKTsetOpt()).
+ *
+ * The operating point of the last analysis is kept as well, and the
+ * next CKTop() starts its Newton iteration from it.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/const.h"
+#include "ngspice/sperror.h"
+
+struct st_alter {
+    GENmodel **models;      /* altered by altermod */
+    int nmodels, maxmodels;
+    GENinstance **insts;    /* altered by alter */
+    int ninsts, maxinsts;
+    int full;               /* needs the full setup */
+    int valid;              /* the circuit is set up with the values below */
+    double temp, nomtemp;
+    double mosdef[5];
+    int maxorder;
+    double *rhs;            /* operating point of the last analysis */
+    double *states;
+    int size, numstates;
+    int warm;               /* start the next CKTop() from it */
+};
+
+
+static struct st_alter *
+alter_get(CKTcircuit *ckt)
+{
+    if (!ckt->CKTalter)
+        ckt->CKTalter = TMALLOC(struct st_alter, 1);
+    return ckt->CKTalter;
+}
+
+
+static void
+alter_mosdef(CKTcircuit *ckt, double *mosdef)
+{
+    mosdef[0] = ckt->CKTdefaultMosM;
+    mosdef[1] = ckt->CKTdefaultMosL;
+    mosdef[2] = ckt->CKTdefaultMosW;
+    mosdef[3] = ckt->CKTdefaultMosAD;
+    mosdef[4] = ckt->CKTdefaultMosAS;
+}
+
+
+/* Record a changed model or instance, called by CKTparam() and
+ * CKTmodParam() */
+void
+CKTalterMark(CKTcircuit *ckt, GENmodel *model, GENinstance *inst)
+{
+    struct st_alter *al;
+    int i;
+
+    if (!ckt || !ckt->CKTalterInc || !ckt->CKTisSetup)
+        return;
+
+    al = alter_get(ckt);
+    if (al->full || !al->valid)
+        return;
+
+    if (inst) {
+        for (i = 0; i < al->ninsts; i++)
+            if (al->insts[i] == inst)
+                return;
+        if (al->ninsts == al->maxinsts) {
+            al->maxinsts = MAX(16, 2 * al->maxinsts);
+            al->insts = TREALLOC(GENinstance *, al->insts, al->maxinsts);
+        }
+        al->insts[al->ninsts++] = inst;
+    } else if (model) {
+        for (i = 0; i < al->nmodels; i++)
+            if (al->models[i] == model)
+                return;
+        if (al->nmodels == al->maxmodels) {
+            al->maxmodels = MAX(16, 2 * al->maxmodels);
+            al->models = TREALLOC(GENmodel *, al->models, al->maxmodels);
+        }
+        al->models[al->nmodels++] = model;
+    }
+}
+
+
+/* A change the incremental setup can not follow, e.g. an instance moved
+ * to another model */
+void
+CKTalterFull(CKTcircuit *ckt)
+{
+    struct st_alter *al = ckt ? ckt->CKTalter : NULL;
+
+    if (!al)
+        return;
+    al->full = 1;
+    al->nmodels = 0;
+    al->ninsts = 0;
+}
+
+
+/* After the full setup of the circuit */
+void
+CKTalterDone(CKTcircuit *ckt)
+{
+    struct st_alter *al;
+
+    if (!ckt->CKTalterInc) {
+        CKTalterDestroy(ckt);
+        return;
+    }
+
+    al = alter_get(ckt);
+    al->nmodels = 0;
+    al->ninsts = 0;
+    al->full = 0;
+    al->valid = 1;
+    al->warm = 0;
+    al->temp = ckt->CKTtemp;
+    al->nomtemp = ckt->CKTnomTemp;
+    al->maxorder = ckt->CKTmaxOrder;
+    alter_mosdef(ckt, al->mosdef);
+}
+
+
+static int
+alter_type_ok(CKTcircuit *ckt, int type)
+{
+    const char *name = DEVices[type]->DEVpublic.name;
+    int j;
+
+    /* the coupling of inductors is computed from their values */
+    if (strcmp(name, "mutual") == 0)
+        return 0;
+    if (strcmp(name, "Inductor") == 0) {
+        j = CKTtypelook("mutual");
+        if (j >= 0 && ckt->CKThead[j])
+            return 0;
+    }
+    /* what its DEVunsetup() clears is known to the device only */
+    if (DEVices[type]->DEVunsetup && !DEVices[type]->DEVinstUnsetup)
+        return 0;
+#ifdef USE_OMP
+    /* its setup collects all instances for the parallel load */
+    if (DEVices[type]->DEVpublic.flags & DEV_OMPLOAD)
+        return 0;
+#endif
+    return 1;
+}
+
+
+/* The first state of the instances following 'inst' in the order of
+ * CKTsetup(), the limit for the states of 'inst' */
+static int
+alter_state_bound(CKTcircuit *ckt, int type, GENmodel *model,
+                  GENinstance *inst)
+{
+    GENinstance *here = inst->GENnextInstance;
+
+    for (;;) {
+        for (; here; here = here->GENnextInstance)
+            if (here->GENstate >= inst->GENstate)
+                return here->GENstate;
+        if (model && (model = model->GENnextModel) != NULL) {
+            here = model->GENinstances;
+            continue;
+        }
+        do
+            type++;
+        while (type < DEVmaxnum &&
+               !(DEVices[type] && DEVices[type]->DEVsetup && ckt->CKThead[type]));
+        if (type >= DEVmaxnum)
+            return ckt->CKTnumStates;
+        model = ckt->CKThead[type];
+        here = model->GENinstances;
+    }
+}
+
+
+/* Set up a single instance again, the model and the instance are taken
+ * out of their lists for the call */
+static int
+alter_setup_inst(CKTcircuit *ckt, GENinstance *inst)
+{
+    GENmodel *model = inst->GENmodPtr;
+    int type = model->GENmodType;
+    GENmodel *nextmodel = model->GENnextModel;
+    GENinstance *first = model->GENinstances;
+    GENinstance *next = inst->GENnextInstance;
+    CKTnode *lastnode = ckt->CKTlastNode;
+    size_t size = (size_t) *DEVices[type]->DEVinstSize;
+    int bound, states, error;
+    char *saved;
+
+    bound = alter_state_bound(ckt, type, model, inst);
+
+    model->GENnextModel = NULL;
+    model->GENinstances = inst;
+    inst->GENnextInstance = NULL;
+
+    saved = TMALLOC(char, size);
+    memcpy(saved, inst, size);
+
+    states = inst->GENstate;
+    error = OK;
+    if (DEVices[type]->DEVinstUnsetup)
+        error = DEVices[type]->DEVinstUnsetup (inst, ckt);
+    if (!error)
+        error = DEVices[type]->DEVsetup (ckt->CKTmatrix, model, ckt, &states);
+
+    if (!error && (ckt->CKTlastNode != lastnode ||
+                   states > MAX(bound, inst->GENstate) ||
+                   memcmp(saved, inst, size) != 0))
+        error = E_NOCHANGE;
+
+    if (error) {
+        memcpy(inst, saved, size);
+        while (ckt->CKTlastNode != lastnode)
+            CKTdltNNum(ckt, ckt->CKTlastNode->number);
+    }
+    tfree(saved);
+
+    inst->GENnextInstance = next;
+    model->GENinstances = first;
+    model->GENnextModel = nextmodel;
+
+    return error;
+}
+
+
+static int
+alter_temp_model(CKTcircuit *ckt, GENmodel *model)
+{
+    GENmodel *nextmodel = model->GENnextModel;
+    int type = model->GENmodType;
+    int error = OK;
+
+    if (DEVices[type]->DEVtemperature) {
+        model->GENnextModel = NULL;
+        error = DEVices[type]->DEVtemperature (model, ckt);
+        model->GENnextModel = nextmodel;
+    }
+    return error;
+}
+
+
+static int
+alter_model_marked(struct st_alter *al, GENmodel *model, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+        if (al->models[i] == model)
+            return 1;
+    return 0;
+}
+
+
+/* Set up the changed instances and models, returns OK if the circuit is
+ * ready for the next analysis, else E_NOCHANGE for the full setup */
+int
+CKTalterSetup(CKTcircuit *ckt)
+{
+    struct st_alter *al = ckt->CKTalter;
+    double mosdef[5];
+    GENinstance *here;
+    int i, error;
+
+    if (!ckt->CKTalterInc || !ckt->CKTisSetup || !al || !al->valid || al->full)
+        return E_NOCHANGE;
+
+#ifdef WANT_SENSE2
+    if (ckt->CKTsenInfo)
+        return E_NOCHANGE;
+#endif
+
+    alter_mosdef(ckt, mosdef);
+    if (al->temp != ckt->CKTtemp || al->nomtemp != ckt->CKTnomTemp ||
+        al->maxorder != ckt->CKTmaxOrder ||
+        memcmp(al->mosdef, mosdef, sizeof(mosdef)) != 0)
+        return E_NOCHANGE;
+
+    for (i = 0; i < al->nmodels; i++)
+        if (!alter_type_ok(ckt, al->models[i]->GENmodType))
+            return E_NOCHANGE;
+    for (i = 0; i < al->ninsts; i++)
+        if (!alter_type_ok(ckt, al->insts[i]->GENmodPtr->GENmodType))
+            return E_NOCHANGE;
+
+    for (i = 0; i < al->nmodels; i++)
+        for (here = al->models[i]->GENinstances; here; here = here->GENnextInstance)
+            if (alter_setup_inst(ckt, here) != OK)
+                return E_NOCHANGE;
+    for (i = 0; i < al->ninsts; i++)
+        if (!alter_model_marked(al, al->insts[i]->GENmodPtr, al->nmodels))
+            if (alter_setup_inst(ckt, al->insts[i]) != OK)
+                return E_NOCHANGE;
+
+    /* the temperature for all instances of a model, some models share
+     * size dependent parameters among their instances */
+    for (i = 0; i < al->ninsts; i++)
+        CKTalterMark(ckt, al->insts[i]->GENmodPtr, NULL);
+
+    ckt->CKTvt = CONSTKoverQ * ckt->CKTtemp;
+    for (i = 0; i < al->nmodels; i++)
+        if ((error = alter_temp_model(ckt, al->models[i])) != OK)
+            return error;
+
+    /* the charge states may differ now */
+    CKTtruncDestroy(ckt);
+
+    al->nmodels = 0;
+    al->ninsts = 0;
+    al->warm = (al->rhs != NULL);
+    return OK;
+}
+
+
+/* Keep the operating point for the next analysis */
+void
+CKTalterSaveOp(CKTcircuit *ckt)
+{
+    struct st_alter *al;
+    int size;
+
+    if (!ckt->CKTalterInc)
+        return;
+
+    al = alter_get(ckt);
+    size = SMPmatSize(ckt->CKTmatrix);
+    if (size != al->size || ckt->CKTnumStates != al->numstates) {
+        tfree(al->rhs);
+        tfree(al->states);
+        al->size = size;
+        al->numstates = ckt->CKTnumStates;
+        al->rhs = TMALLOC(double, size + 1);
+        al->states = TMALLOC(double, MAX(1, al->numstates));
+    }
+    memcpy(al->rhs, ckt->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+    memcpy(al->states, ckt->CKTstate0, (size_t) al->numstates * sizeof(double));
+}
+
+
+/* Load the operating point of the last analysis into CKTrhsOld and
+ * CKTstate0, returns 1 if there is one for the circuit as it is set up */
+int
+CKTalterLoadOp(CKTcircuit *ckt)
+{
+    struct st_alter *al = ckt->CKTalter;
+
+    if (!ckt->CKTalterInc || !al || !al->warm || !al->rhs ||
+        al->size != SMPmatSize(ckt->CKTmatrix) ||
+        al->numstates != ckt->CKTnumStates)
+        return 0;
+
+    memcpy(ckt->CKTrhsOld, al->rhs, (size_t) (al->size + 1) * sizeof(double));
+    memcpy(ckt->CKTstate0, al->states, (size_t) al->numstates * sizeof(double));
+    return 1;
+}
+
+
+void
+CKTalterDestroy(CKTcircuit *ckt)
+{
+    struct st_alter *al = ckt->CKTalter;
+
+    if (!al)
+        return;
+    tfree(al->models);
+    tfree(al->insts);
+    tfree(al->rhs);
+    tfree(al->states);
+    tfree(al);
+    ckt->CKTalter = NULL;
+}
@@ -0,0 +1,396 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Checkpoint and restart of a transient analysis.
+ *
+ * With 'set tran_checkpoint=<file>' DCtran() writes the state of the
+ * transient at an accepted timepoint to <file>, every
+ * 'tran_checkpoint_time' seconds of wall time (default 600).  With
+ * 'set tran_restart=<file>' the next transient does not compute an
+ * operating point but continues from the checkpoint, in a new process or
+ * after 'alter' for a what-if branch of the same prefix.  The variable
+ * is unset by the restart, the transient after it starts at time zero.
+ *
+ * A checkpoint holds the time, the timestep history, the integration
+ * order and coefficients, the breakpoints ahead, the solution and the
+ * state vectors CKTstates[], which carry the history of all devices
+ * which store it there, and the past timepoints and terminal waveforms
+ * of LTRA lines.  The breakpoint table of the restarted transient is the
+ * one of its own final time and 'stop when' commands, the breakpoints
+ * ahead which devices set before the checkpoint are added to it.
+ * Circuits with TXL or CPL lines, which keep their history in lists of
+ * their own, or with XSPICE event-driven instances, whose event queues
+ * are not saved, are refused.  Sources with random noise (trnoise,
+ * trrandom) draw new values after a restart.
+ *
+ * A checkpoint is read completely and checked against the circuit
+ * before anything of the circuit is changed.  The file is binary, for
+ * the machine which wrote it.  It is written to <file>.tmp first and
+ * renamed, so that a crash leaves the previous checkpoint intact.
+ */
+
+#include <errno.h>
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/sperror.h"
+#include "../devices/ltra/ltradefs.h"
+
+#ifdef XSPICE
+#include "ngspice/evt.h"
+#endif
+
+
+#define CKPT_MAGIC "ngspice tran checkpoint 2"
+
+
+/* Can the whole history of the circuit be saved ? */
+static int
+ckpt_supported(CKTcircuit *ckt)
+{
+    static char *types[] = { "TransLine", "CplLines", NULL };
+    int i;
+
+    for (i = 0; types[i]; i++) {
+        int type = CKTtypelook(types[i]);
+        if (type >= 0 && ckt->CKThead[type]) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "transient checkpoints do not support %s devices", types[i]);
+            return 0;
+        }
+    }
+
+#ifdef XSPICE
+    if (ckt->evt->counts.num_insts > 0) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "transient checkpoints do not support event-driven instances");
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+
+/* The LTRA lines of the circuit, in the order of CKThead[] */
+static LTRAinstance *
+ckpt_ltra_next(CKTcircuit *ckt, LTRAinstance *here)
+{
+    LTRAmodel *model;
+    int type;
+
+    if (here) {
+        if (LTRAnextInstance(here))
+            return LTRAnextInstance(here);
+        for (model = LTRAnextModel((LTRAmodel *) here->gen.GENmodPtr);
+             model; model = LTRAnextModel(model))
+            if (LTRAinstances(model))
+                return LTRAinstances(model);
+        return NULL;
+    }
+
+    type = CKTtypelook("LTRA");
+    if (type < 0)
+        return NULL;
+    for (model = (LTRAmodel *) ckt->CKThead[type]; model;
+         model = LTRAnextModel(model))
+        if (LTRAinstances(model))
+            return LTRAinstances(model);
+    return NULL;
+}
+
+
+/* The past timepoints, the initial conditions and the terminal waveforms
+ * of the LTRA lines */
+static int
+ckpt_ltra_write(CKTcircuit *ckt, FILE *fp)
+{
+    LTRAinstance *here;
+    int n = ckt->CKTtimePoints ? ckt->CKTtimeIndex + 1 : 0;
+    int ok;
+
+    ok = fwrite(&n, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTsizeIncr, sizeof(int), 1, fp) == 1;
+    if (n <= 0)
+        return ok;
+    ok = ok && fwrite(ckt->CKTtimePoints, sizeof(double), (size_t) n, fp) ==
+        (size_t) n;
+    for (here = ckpt_ltra_next(ckt, NULL); ok && here;
+         here = ckpt_ltra_next(ckt, here))
+        ok = fwrite(&here->LTRAinitVolt1, sizeof(double), 1, fp) == 1 &&
+            fwrite(&here->LTRAinitCur1, sizeof(double), 1, fp) == 1 &&
+            fwrite(&here->LTRAinitVolt2, sizeof(double), 1, fp) == 1 &&
+            fwrite(&here->LTRAinitCur2, sizeof(double), 1, fp) == 1 &&
+            fwrite(here->LTRAv1, sizeof(double), (size_t) n, fp) == (size_t) n &&
+            fwrite(here->LTRAi1, sizeof(double), (size_t) n, fp) == (size_t) n &&
+            fwrite(here->LTRAv2, sizeof(double), (size_t) n, fp) == (size_t) n &&
+            fwrite(here->LTRAi2, sizeof(double), (size_t) n, fp) == (size_t) n;
+
+    return ok;
+}
+
+
+int
+CKTcheckpointWrite(CKTcircuit *ckt, const char *file)
+{
+    unsigned long long key = CKTfingerprint(ckt);
+    int size = SMPmatSize(ckt->CKTmatrix);
+    char *tmp;
+    FILE *fp;
+    int i, ok;
+
+    if (!ckpt_supported(ckt))
+        return E_BADPARM;
+
+    tmp = tprintf("%s.tmp", file);
+    fp = fopen(tmp, "wb");
+    if (!fp) {
+        SPfrontEnd->IFerrorf(ERR_WARNING, "cannot write checkpoint %s: %s",
+                             tmp, strerror(errno));
+        tfree(tmp);
+        return E_BADPARM;
+    }
+
+    ok = fwrite(CKPT_MAGIC, sizeof(CKPT_MAGIC), 1, fp) == 1;
+    ok = ok && fwrite(&key, sizeof(key), 1, fp) == 1;
+    ok = ok && fwrite(&size, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTnumStates, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTmaxOrder, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTintegrateMethod, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTorder, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTtime, sizeof(double), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTdelta, sizeof(double), 1, fp) == 1;
+    ok = ok && fwrite(ckt->CKTdeltaOld, sizeof(double), 7, fp) == 7;
+    ok = ok && fwrite(ckt->CKTag, sizeof(double), 7, fp) == 7;
+    ok = ok && fwrite(&ckt->CKTsaveDelta, sizeof(double), 1, fp) == 1;
+    ok = ok && fwrite(&ckt->CKTbreakSize, sizeof(int), 1, fp) == 1;
+    ok = ok && fwrite(ckt->CKTbreaks, sizeof(double),
+                      (size_t) ckt->CKTbreakSize, fp) ==
+                      (size_t) ckt->CKTbreakSize;
+    ok = ok && fwrite(ckt->CKTrhsOld, sizeof(double), (size_t) size + 1,
+                      fp) == (size_t) size + 1;
+    for (i = 0; ok && i <= ckt->CKTmaxOrder + 1; i++)
+        ok = fwrite(ckt->CKTstates[i], sizeof(double),
+                    (size_t) ckt->CKTnumStates, fp) ==
+                    (size_t) ckt->CKTnumStates;
+    if (ok)
+        ok = ckpt_ltra_write(ckt, fp);
+
+    if (fclose(fp) != 0)
+        ok = 0;
+
+#ifdef _WIN32
+    if (ok)
+        remove(file);
+#endif
+    if (!ok || rename(tmp, file) != 0) {
+        SPfrontEnd->IFerrorf(ERR_WARNING, "cannot write checkpoint %s", file);
+        remove(tmp);
+        tfree(tmp);
+        return E_BADPARM;
+    }
+
+    tfree(tmp);
+    return OK;
+}
+
+
+static void
+ckpt_ltra_restore(CKTcircuit *ckt, double *points, double *ltra, int n,
+                  int size_incr)
+{
+    LTRAinstance *here;
+    LTRAmodel *model;
+    int list_size = n + size_incr;
+    int type = CKTtypelook("LTRA");
+
+    ckt->CKTtimeIndex = n - 1;
+    ckt->CKTsizeIncr = size_incr;
+    if (ckt->CKTtimeListSize < list_size) {
+        ckt->CKTtimeListSize = list_size;
+        ckt->CKTtimePoints = TREALLOC(double, ckt->CKTtimePoints, list_size);
+    }
+    memcpy(ckt->CKTtimePoints, points, (size_t) n * sizeof(double));
+
+    for (model = (LTRAmodel *) ckt->CKThead[type]; model;
+         model = LTRAnextModel(model)) {
+        model->LTRAmodelListSize = list_size;
+        model->LTRAh1dashCoeffs = TREALLOC(double, model->LTRAh1dashCoeffs, list_size);
+        model->LTRAh2Coeffs = TREALLOC(double, model->LTRAh2Coeffs, list_size);
+        model->LTRAh3dashCoeffs = TREALLOC(double, model->LTRAh3dashCoeffs, list_size);
+    }
+
+    for (here = ckpt_ltra_next(ckt, NULL); here;
+         here = ckpt_ltra_next(ckt, here)) {
+        double **lists[4];
+        int k;
+
+        lists[0] = &here->LTRAv1;
+        lists[1] = &here->LTRAi1;
+        lists[2] = &here->LTRAv2;
+        lists[3] = &here->LTRAi2;
+        here->LTRAinitVolt1 = *ltra++;
+        here->LTRAinitCur1 = *ltra++;
+        here->LTRAinitVolt2 = *ltra++;
+        here->LTRAinitCur2 = *ltra++;
+        here->LTRAinstListSize = list_size;
+        for (k = 0; k < 4; k++) {
+            *lists[k] = TREALLOC(double, *lists[k], list_size);
+            memcpy(*lists[k], ltra, (size_t) n * sizeof(double));
+            ltra += n;
+        }
+    }
+}
+
+
+int
+CKTcheckpointRead(CKTcircuit *ckt, const char *file)
+{
+    char magic[sizeof(CKPT_MAGIC)];
+    unsigned long long key;
+    int size, num_states, max_order, method, break_size, order;
+    int num_points = 0, size_incr = 0;
+    double time, delta, save_delta, delta_old[7], ag[7];
+    double *breaks = NULL, *rhs = NULL, **states = NULL;
+    double *points = NULL, *ltra = NULL;
+    FILE *fp;
+    int i, ok, error = OK;
+
+    if (!ckpt_supported(ckt))
+        return E_BADPARM;
+
+    fp = fopen(file, "rb");
+    if (!fp) {
+        SPfrontEnd->IFerrorf(ERR_FATAL, "cannot open checkpoint %s: %s",
+                             file, strerror(errno));
+        return E_NOTFOUND;
+    }
+
+    ok = fread(magic, sizeof(magic), 1, fp) == 1 &&
+        memcmp(magic, CKPT_MAGIC, sizeof(magic)) == 0;
+    ok = ok && fread(&key, sizeof(key), 1, fp) == 1;
+    ok = ok && fread(&size, sizeof(int), 1, fp) == 1;
+    ok = ok && fread(&num_states, sizeof(int), 1, fp) == 1;
+    ok = ok && fread(&max_order, sizeof(int), 1, fp) == 1;
+    ok = ok && fread(&method, sizeof(int), 1, fp) == 1;
+    if (!ok) {
+        SPfrontEnd->IFerrorf(ERR_FATAL, "%s is not a transient checkpoint",
+                             file);
+        fclose(fp);
+        return E_BADPARM;
+    }
+
+    if (size != SMPmatSize(ckt->CKTmatrix) ||
+        num_states != ckt->CKTnumStates ||
+        max_order != ckt->CKTmaxOrder ||
+        method != ckt->CKTintegrateMethod) {
+        SPfrontEnd->IFerrorf(ERR_FATAL,
+            "checkpoint %s was written for another circuit or method", file);
+        fclose(fp);
+        return E_BADPARM;
+    }
+
+    if (key != CKTfingerprint(ckt))
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "the deck has changed since checkpoint %s was written", file);
+
+    ok = fread(&order, sizeof(int), 1, fp) == 1;
+    ok = ok && fread(&time, sizeof(double), 1, fp) == 1;
+    ok = ok && fread(&delta, sizeof(double), 1, fp) == 1;
+    ok = ok && fread(delta_old, sizeof(double), 7, fp) == 7;
+    ok = ok && fread(ag, sizeof(double), 7, fp) == 7;
+    ok = ok && fread(&save_delta, sizeof(double), 1, fp) == 1;
+    ok = ok && fread(&break_size, sizeof(int), 1, fp) == 1 &&
+        break_size >= 2;
+    if (ok) {
+        breaks = TMALLOC(double, break_size);
+        ok = fread(breaks, sizeof(double), (size_t) break_size, fp) ==
+            (size_t) break_size;
+    }
+    if (ok) {
+        rhs = TMALLOC(double, size + 1);
+        ok = fread(rhs, sizeof(double), (size_t) size + 1, fp) ==
+            (size_t) size + 1;
+    }
+    if (ok) {
+        states = TMALLOC(double *, max_order + 2);
+        for (i = 0; ok && i <= max_order + 1; i++) {
+            states[i] = TMALLOC(double, num_states);
+            ok = fread(states[i], sizeof(double), (size_t) num_states, fp) ==
+                (size_t) num_states;
+        }
+    }
+
+    /* the LTRA history */
+    ok = ok && fread(&num_points, sizeof(int), 1, fp) == 1;
+    ok = ok && fread(&size_incr, sizeof(int), 1, fp) == 1;
+    if (ok && num_points > 0) {
+        LTRAinstance *here;
+        int num_ltra = 0;
+
+        for (here = ckpt_ltra_next(ckt, NULL); here;
+             here = ckpt_ltra_next(ckt, here))
+            num_ltra++;
+        points = TMALLOC(double, num_points);
+        ok = fread(points, sizeof(double), (size_t) num_points, fp) ==
+            (size_t) num_points;
+        ltra = TMALLOC(double, 4 * (size_t) num_ltra * (size_t) (num_points + 1));
+        ok = ok && fread(ltra, sizeof(double),
+                         4 * (size_t) num_ltra * (size_t) (num_points + 1), fp) ==
+            4 * (size_t) num_ltra * (size_t) (num_points + 1);
+    }
+    ok = ok && (num_points > 0) == (ckt->CKTtimePoints != NULL);
+
+    fclose(fp);
+
+    if (ok && (time < 0 || time >= ckt->CKTfinalTime)) {
+        SPfrontEnd->IFerrorf(ERR_FATAL,
+            "checkpoint %s at time %g is not before the final time %g",
+            file, time, ckt->CKTfinalTime);
+        error = E_BADPARM;
+    } else if (!ok) {
+        SPfrontEnd->IFerrorf(ERR_FATAL, "checkpoint %s is truncated", file);
+        error = E_BADPARM;
+    }
+
+    if (!error) {
+        ckt->CKTorder = order;
+        ckt->CKTtime = time;
+        ckt->CKTdelta = delta;
+        memcpy(ckt->CKTdeltaOld, delta_old, sizeof(delta_old));
+        memcpy(ckt->CKTag, ag, sizeof(ag));
+        ckt->CKTsaveDelta = save_delta;
+        memcpy(ckt->CKTrhsOld, rhs, (size_t) (size + 1) * sizeof(double));
+        memcpy(ckt->CKTrhs, rhs, (size_t) (size + 1) * sizeof(double));
+        for (i = 0; i <= max_order + 1; i++)
+            memcpy(ckt->CKTstates[i], states[i],
+                   (size_t) num_states * sizeof(double));
+
+        /* The table of this run, set up by DCtran(), without the
+         * breakpoints passed.  breaks[0] is the last one passed before
+         * the checkpoint, the last one its final time. */
+        while (ckt->CKTbreakSize > 2 && ckt->CKTbreaks[1] <= time)
+            CKTclrBreak(ckt);
+        ckt->CKTbreaks[0] = breaks[0];
+        for (i = 1; i < break_size - 1 && !error; i++)
+            if (breaks[i] > time && breaks[i] < ckt->CKTfinalTime)
+                error = CKTsetBreak(ckt, breaks[i]);
+
+        if (num_points > 0)
+            ckpt_ltra_restore(ckt, points, ltra, num_points, size_incr);
+    }
+
+    tfree(breaks);
+    tfree(rhs);
+    if (states)
+        for (i = 0; i <= max_order + 1; i++)
+            tfree(states[i]);
+    tfree(states);
+    tfree(points);
+    tfree(ltra);
+
+    return error;
+}
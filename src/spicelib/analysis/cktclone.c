@@ -0,0 +1,368 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Copies of a circuit which is set up.
+ *
+ * CKTclone() copies a circuit after CKTsetup() and CKTtemp(), with its
+ * present solution, states, options and analysis parameters, into a new
+ * CKTcircuit on which .op, .dc and .tran iterations run on their own,
+ * e.g. in another thread.  Nothing is parsed, set up or computed again,
+ * so the copy has the values changed by alter and altermod and those of
+ * 'temper' expressions, as the source has them.
+ *
+ * The matrix is copied with its ordering by SMPcloneMatrix(), the nodes,
+ * models and instances byte by byte, and their lists are linked again.
+ * The DEVsetup() of every device type then runs on the copy, as
+ * CKTsetup() would run it on the source: the instances keep their nodes
+ * and states and get the pointers to their elements in the matrix of the
+ * copy.  The copy is refused if an instance would make a node or get
+ * other states than in the source.  All the other data a model or an
+ * instance points to is shared with the source: the names, the
+ * coefficients of PWL sources, the size dependent parameters of the BSIM
+ * models, noise and sensitivity data.  It is read only during .op, .dc
+ * and .tran, the copy must not run other analyses or CKTtemp().
+ *
+ * Only device types which agree to this have the flag DEV_CLONE: their
+ * instances point to no other instance, model, node or circuit, or their
+ * DEVsetup() looks it up again in the circuit it sets up, as the one of
+ * the mutual inductors does.  Their DEVsetup() may run again on
+ * instances which are set up.  Their DEVclone() routine, if any, then
+ * checks the copy of their models or refuses it, and frees what the
+ * DEVsetup() of the copy allocated.  A device type with DEV_CLONE does
+ * not keep data of the load in global variables, copies of one circuit
+ * may then be loaded concurrently.
+ *
+ * A copy is freed by CKTcloneFree(), before the source.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/smpdefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/hash.h"
+
+#ifdef XSPICE
+#include "ngspice/evt.h"
+#include "ngspice/evtproto.h"
+#include "ngspice/enh.h"
+#endif
+
+
+/* TRUE if all devices of ckt may be copied */
+
+int
+CKTcloneable(CKTcircuit *ckt)
+{
+    int i;
+
+#ifdef XSPICE
+    if (ckt->CKTadevFlag)
+        return FALSE;
+#endif
+
+    for (i = 0; i < DEVmaxnum; i++)
+        if (ckt->CKThead[i] && !(DEVices[i]->DEVpublic.flags & DEV_CLONE))
+            return FALSE;
+
+    return TRUE;
+}
+
+
+/* Free the copy ckt, the DEVclone() of the first num types has run */
+
+static void
+clone_free(CKTcircuit *ckt, int num)
+{
+    CKTnode *node, *next;
+    int i;
+
+    for (i = 0; i < num; i++)
+        if (ckt->CKThead[i] && DEVices[i]->DEVclone)
+            DEVices[i]->DEVclone(ckt->CKThead[i], NULL);
+
+    CKTwrDestroy(ckt);
+    CKTtruncDestroy(ckt);
+    CKTalterDestroy(ckt);
+
+    for (i = 0; i < DEVmaxnum; i++) {
+        GENmodel *model = ckt->CKThead[i];
+        while (model) {
+            GENmodel *next_model = model->GENnextModel;
+            GENinstance *inst = model->GENinstances;
+            while (inst) {
+                GENinstance *next_inst = inst->GENnextInstance;
+                tfree(inst);
+                inst = next_inst;
+            }
+            tfree(model);
+            model = next_model;
+        }
+    }
+
+    for (i = 0; i < 8; i++)
+        tfree(ckt->CKTstates[i]);
+
+    NIdestroy(ckt);
+
+    tfree(ckt->CKTbreaks);
+    for (node = ckt->CKTnodes; node; node = next) {
+        next = node->next;
+        tfree(node);
+    }
+
+    tfree(ckt->CKTstat->STATdevNum);
+    tfree(ckt->CKTstat);
+    tfree(ckt->CKThead);
+
+#ifdef XSPICE
+    if (ckt->enh->rshunt_data.enabled)
+        tfree(ckt->enh->rshunt_data.diag);
+    tfree(ckt->enh);
+    tfree(ckt->evt);
+#endif
+
+    nghash_free(ckt->DEVnameHash, NULL, NULL);
+    nghash_free(ckt->MODnameHash, NULL, NULL);
+
+    tfree(ckt);
+}
+
+
+void
+CKTcloneFree(CKTcircuit *ckt)
+{
+    if (ckt)
+        clone_free(ckt, DEVmaxnum);
+}
+
+
+/* The DEVsetup() of the device type on the copy ckt of src, an instance
+   has to keep its nodes and states */
+
+static int
+clone_setup(CKTcircuit *ckt, CKTcircuit *src, int type, int *states)
+{
+    CKTnode *lastnode = ckt->CKTlastNode;
+    GENmodel *model, *smodel;
+    GENinstance *here, *shere;
+    int error;
+
+    error = DEVices[type]->DEVsetup (ckt->CKTmatrix, ckt->CKThead[type],
+                                     ckt, states);
+    if (error)
+        return error;
+
+    if (ckt->CKTlastNode != lastnode)
+        return E_UNSUPP;
+
+    smodel = src->CKThead[type];
+    for (model = ckt->CKThead[type]; model; model = model->GENnextModel) {
+        shere = smodel->GENinstances;
+        for (here = model->GENinstances; here; here = here->GENnextInstance) {
+            if (here->GENstate != shere->GENstate)
+                return E_UNSUPP;
+            shere = shere->GENnextInstance;
+        }
+        smodel = smodel->GENnextModel;
+    }
+
+    return OK;
+}
+
+
+/* Copy src into *pclone.  E_UNSUPP if a device may not be copied. */
+
+int
+CKTclone(CKTcircuit *src, CKTcircuit **pclone)
+{
+    CKTcircuit *ckt;
+    CKTnode *node, **last;
+    int i, size, states, error;
+#ifdef XSPICE
+    int n;
+#endif
+
+    *pclone = NULL;
+
+    if (!src->CKTisSetup || !src->CKTmatrix || !CKTcloneable(src))
+        return E_UNSUPP;
+
+    ckt = TMALLOC(CKTcircuit, 1);
+    *ckt = *src;
+
+    /* what the copy does not share with the source */
+    ckt->CKThead = TMALLOC(GENmodel *, DEVmaxnum);
+    ckt->CKTmatrix = NULL;
+    ckt->CKTrhs = ckt->CKTrhsOld = ckt->CKTrhsSpare = NULL;
+    ckt->CKTirhs = ckt->CKTirhsOld = ckt->CKTirhsSpare = NULL;
+    ckt->CKTrhsOp = ckt->CKTsenRhs = ckt->CKTseniRhs = NULL;
+    for (i = 0; i < 8; i++)
+        ckt->CKTstates[i] = NULL;
+    ckt->CKTnodes = ckt->CKTlastNode = ckt->prev_CKTlastNode = NULL;
+    ckt->CKTbreaks = NULL;
+    ckt->CKTsenInfo = NULL;
+    ckt->CKTsenTrace = NULL;
+    ckt->CKTwavrel = NULL;
+    ckt->CKTwrSteps = NULL;
+    ckt->CKTtruncBatch = NULL;
+    ckt->CKTalter = NULL;
+    ckt->CKTopCancel = NULL;
+    ckt->CKTtimePoints = NULL;
+    ckt->CKTdeltaList = NULL;
+    ckt->CKTtimeListSize = 0;
+    ckt->CKTtroubleElt = NULL;
+    ckt->noise_input = NULL;
+#ifdef RFSPICE
+    ckt->CKTrfPorts = NULL;
+    ckt->CKTAmat = ckt->CKTBmat = ckt->CKTSmat = NULL;
+    ckt->CKTYmat = ckt->CKTZmat = NULL;
+    ckt->CKTportY = NULL;
+    ckt->CKTNoiseCYmat = ckt->CKTadjointRHS = NULL;
+#endif
+
+    ckt->CKTstat = TMALLOC(STATistics, 1);
+    *ckt->CKTstat = *src->CKTstat;
+    ckt->CKTstat->STATdevNum = TMALLOC(STATdevList, DEVmaxnum);
+    memcpy(ckt->CKTstat->STATdevNum, src->CKTstat->STATdevNum,
+           (size_t) DEVmaxnum * sizeof(STATdevList));
+
+    ckt->DEVnameHash = nghash_init_pointer(100);
+    ckt->MODnameHash = nghash_init_pointer(100);
+
+#ifdef XSPICE
+    /* no event driven instances */
+    ckt->evt = TMALLOC(Evt_Ckt_Data_t, 1);
+    ckt->evt->options = src->evt->options;
+    ckt->enh = TMALLOC(Enh_Ckt_Data_t, 1);
+    *ckt->enh = *src->enh;
+    ckt->enh->rshunt_data.diag = NULL;
+    ckt->enh->rshunt_data.enabled = MIF_FALSE;
+#endif
+
+    /* the matrix, with the ordering of the source */
+    error = SMPcloneMatrix(src->CKTmatrix, &ckt->CKTmatrix);
+    if (error) {
+        ckt->CKTmatrix = NULL;
+        clone_free(ckt, 0);
+        return error;
+    }
+
+    /* the solution */
+    error = NIreinit(ckt);
+    if (error) {
+        clone_free(ckt, 0);
+        return error;
+    }
+    ckt->CKTniState = src->CKTniState;
+    size = SMPmatSize(src->CKTmatrix);
+    memcpy(ckt->CKTrhs, src->CKTrhs, (size_t) (size + 1) * sizeof(double));
+    memcpy(ckt->CKTrhsOld, src->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+    memcpy(ckt->CKTrhsSpare, src->CKTrhsSpare, (size_t) (size + 1) * sizeof(double));
+
+    for (i = 0; i < 8; i++)
+        if (src->CKTstates[i]) {
+            ckt->CKTstates[i] = TMALLOC(double, src->CKTnumStates);
+            memcpy(ckt->CKTstates[i], src->CKTstates[i],
+                   (size_t) src->CKTnumStates * sizeof(double));
+        }
+
+    if (src->CKTbreaks) {
+        ckt->CKTbreaks = TMALLOC(double, src->CKTbreakSize);
+        memcpy(ckt->CKTbreaks, src->CKTbreaks,
+               (size_t) src->CKTbreakSize * sizeof(double));
+    }
+
+    /* the nodes, the element of a nodeset or an initial condition as
+       CKTic() makes it */
+    last = &ckt->CKTnodes;
+    for (node = src->CKTnodes; node; node = node->next) {
+        CKTnode *copy = TMALLOC(CKTnode, 1);
+        *copy = *node;
+        copy->next = NULL;
+        if (node->ptr)
+            copy->ptr = SMPmakeElt(ckt->CKTmatrix, node->number, node->number);
+        if (node == src->CKTlastNode)
+            ckt->CKTlastNode = copy;
+        if (node == src->prev_CKTlastNode)
+            ckt->prev_CKTlastNode = copy;
+        *last = copy;
+        last = &copy->next;
+    }
+
+    /* the models and instances */
+    for (i = 0; i < DEVmaxnum; i++) {
+        GENmodel *model, **mlast = &ckt->CKThead[i];
+        for (model = src->CKThead[i]; model; model = model->GENnextModel) {
+            GENinstance *here, **ilast;
+            GENmodel *mcopy = tmalloc((size_t) *DEVices[i]->DEVmodSize);
+            memcpy(mcopy, model, (size_t) *DEVices[i]->DEVmodSize);
+            mcopy->GENnextModel = NULL;
+            mcopy->GENinstances = NULL;
+            nghash_insert(ckt->MODnameHash, mcopy->GENmodName, mcopy);
+            *mlast = mcopy;
+            mlast = &mcopy->GENnextModel;
+            ilast = &mcopy->GENinstances;
+            for (here = model->GENinstances; here; here = here->GENnextInstance) {
+                GENinstance *icopy = tmalloc((size_t) *DEVices[i]->DEVinstSize);
+                memcpy(icopy, here, (size_t) *DEVices[i]->DEVinstSize);
+                icopy->GENnextInstance = NULL;
+                icopy->GENmodPtr = mcopy;
+                nghash_insert(ckt->DEVnameHash, icopy->GENname, icopy);
+                *ilast = icopy;
+                ilast = &icopy->GENnextInstance;
+            }
+        }
+    }
+
+    /* the pointers to the matrix elements */
+    states = 0;
+    for (i = 0; i < DEVmaxnum; i++)
+        if (ckt->CKThead[i] && DEVices[i]->DEVsetup) {
+            error = clone_setup(ckt, src, i, &states);
+            if (!error && DEVices[i]->DEVclone) {
+                error = DEVices[i]->DEVclone(ckt->CKThead[i], src->CKThead[i]);
+                if (error)
+                    DEVices[i]->DEVclone(ckt->CKThead[i], NULL);
+            }
+            if (error) {
+                clone_free(ckt, i);
+                return error;
+            }
+        }
+
+#ifdef XSPICE
+    if (src->enh->rshunt_data.enabled && src->enh->rshunt_data.diag) {
+        n = src->enh->rshunt_data.num_nodes;
+        ckt->enh->rshunt_data.diag = TMALLOC(double *, n);
+        for (i = 0, node = ckt->CKTnodes; node; node = node->next)
+            if (node->type == SP_VOLTAGE && node->number != 0 && i < n)
+                ckt->enh->rshunt_data.diag[i++] =
+                    SMPmakeElt(ckt->CKTmatrix, node->number, node->number);
+        ckt->enh->rshunt_data.enabled = MIF_TRUE;
+    }
+#endif
+
+    *pclone = ckt;
+    return OK;
+}
+
+
+/* Copy the solution and the states of src, a copy of the same circuit
+   or its source */
+
+void
+CKTcloneState(CKTcircuit *ckt, CKTcircuit *src)
+{
+    int i, size = SMPmatSize(src->CKTmatrix);
+
+    memcpy(ckt->CKTrhsOld, src->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+
+    for (i = 0; i < 8; i++)
+        if (ckt->CKTstates[i] && src->CKTstates[i])
+            memcpy(ckt->CKTstates[i], src->CKTstates[i],
+                   (size_t) ckt->CKTnumStates * sizeof(double));
+}
@@ -31,6 +31,9 @@ CKTdestroy(CKTcircuit *ckt)
     if (!ckt)
         return (E_NOTFOUND);
 
+    CKTwrDestroy(ckt);
+    CKTtruncDestroy(ckt);
+    CKTalterDestroy(ckt);
 
 #ifdef WANT_SENSE2
     if(ckt->CKTsenInfo){
@@ -83,6 +86,8 @@ CKTdestroy(CKTcircuit *ckt)
     if (ckt->CKTtimePoints != NULL)
         FREE(ckt->CKTtimePoints);
 
+    FREE(ckt->CKTwrSteps);
+
     FREE(ckt->CKTrhs);
     FREE(ckt->CKTrhsOld);
     FREE(ckt->CKTrhsSpare);
@@ -25,16 +25,89 @@ Modified: 2000 AlansFixes
 
 extern SPICEanalysis* analInfo[];
 
+
+/* Run the analyses of task in the order of analInfo[], all but the one
+   numbered skip */
+
+static int
+CKTrunJobs(CKTcircuit* ckt, int reset, TSKtask* task, int skip)
+{
+    JOB* job;
+    int error, error2 = OK, i;
+
+    int ANALmaxnum = spice_num_analysis();
+
+    /* Analysis order is important */
+    for (i = 0; i < ANALmaxnum; i++) {
+
+        if (i == skip)
+            continue;
+
+        for (job = task->jobs; job; job = job->JOBnextJob) {
+            if (job->JOBtype == i) {
+                ckt->CKTcurJob = job;
+                error = OK;
+                if (analInfo[i]->an_init)
+                    error = analInfo[i]->an_init(ckt, job);
+                if (!error && analInfo[i]->do_ic)
+                    error = CKTic(ckt);
+                if (!error) {
+#ifdef XSPICE
+                    if (reset) {
+                        /* gtri - begin - 6/10/91 - wbk - Setup event-driven data */
+                        error = EVTsetup(ckt);
+                        if (error)
+                            return(error);
+                        /* gtri - end - 6/10/91 - wbk - Setup event-driven data */
+                    }
+#endif
+                    error = analInfo[i]->an_func(ckt, reset);
+                    /* txl, cpl addition */
+                    if (error == 1111) break;
+                }
+                if (error)
+                    error2 = error;
+            }
+        }
+    }
+
+    return(error2);
+}
+
+
+/* Set up ckt again for the next analysis.  After alter and altermod
+   only the changed devices are set up again, see cktalter.c */
+
+int
+CKTresetup(CKTcircuit* ckt)
+{
+    int error;
+
+    if (CKTalterSetup(ckt) == OK)
+        return OK;
+
+    error = CKTunsetup(ckt);
+    if (!error)
+        error = CKTsetup(ckt);
+    if (!error)
+        error = CKTtemp(ckt);
+    if (!error)
+        CKTalterDone(ckt);
+
+    return error;
+}
+
+
 int
 CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
 {
-    JOB* job;
     double	startTime;
-    int		error, i, error2;
-
-    int         ANALmaxnum = spice_num_analysis();
+    int		error, error2;
 
 #ifdef WANT_SENSE2
+    JOB* job;
+    int         i;
+    int         ANALmaxnum = spice_num_analysis();
     int		senflag;
     static int	sens_num = -1;
 
@@ -49,69 +122,7 @@ CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
 
     startTime = SPfrontEnd->IFseconds();
 
-    ckt->CKTtemp = task->TSKtemp;
-    ckt->CKTnomTemp = task->TSKnomTemp;
-    ckt->CKTmaxOrder = task->TSKmaxOrder;
-    ckt->CKTintegrateMethod = task->TSKintegrateMethod;
-    ckt->CKTindverbosity = task->TSKindverbosity;
-    ckt->CKTxmu = task->TSKxmu;
-    ckt->CKTbypass = task->TSKbypass;
-    ckt->CKTdcMaxIter = task->TSKdcMaxIter;
-    ckt->CKTdcTrcvMaxIter = task->TSKdcTrcvMaxIter;
-    ckt->CKTtranMaxIter = task->TSKtranMaxIter;
-    ckt->CKTnumSrcSteps = task->TSKnumSrcSteps;
-    ckt->CKTnumGminSteps = task->TSKnumGminSteps;
-    ckt->CKTgminFactor = task->TSKgminFactor;
-    ckt->CKTminBreak = task->TSKminBreak;
-    ckt->CKTabstol = task->TSKabstol;
-    ckt->CKTpivotAbsTol = task->TSKpivotAbsTol;
-    ckt->CKTpivotRelTol = task->TSKpivotRelTol;
-    ckt->CKTreltol = task->TSKreltol;
-    ckt->CKTchgtol = task->TSKchgtol;
-    ckt->CKTvoltTol = task->TSKvoltTol;
-    ckt->CKTgmin = task->TSKgmin;
-    ckt->CKTgshunt = task->TSKgshunt;
-    ckt->CKTcshunt = task->TSKcshunt;
-    ckt->CKTdelmin = task->TSKdelmin;
-    ckt->CKTtrtol = task->TSKtrtol;
-#ifdef XSPICE
-    /* Lower value of trtol to give smaller stepsize and more accuracy,
-       but only if there are 'A' devices in the circuit,
-       may be overridden by 'set xtrtol=newval' */
-    if (ckt->CKTadevFlag && (ckt->CKTtrtol > 1)) {
-        int newtol;
-        if (cp_getvar("xtrtol", CP_NUM, &newtol, 0)) {
-            printf("Override trtol to %d for xspice 'A' devices\n", newtol);
-            ckt->CKTtrtol = newtol;
-        }
-        else {
-            printf("Reducing trtol to 1 for xspice 'A' devices\n");
-            ckt->CKTtrtol = 1;
-        }
-    }
-#endif
-    ckt->CKTdefaultMosM = task->TSKdefaultMosM;
-    ckt->CKTdefaultMosL = task->TSKdefaultMosL;
-    ckt->CKTdefaultMosW = task->TSKdefaultMosW;
-    ckt->CKTdefaultMosAD = task->TSKdefaultMosAD;
-    ckt->CKTdefaultMosAS = task->TSKdefaultMosAS;
-    ckt->CKTfixLimit = task->TSKfixLimit;
-    ckt->CKTnoOpIter = task->TSKnoOpIter;
-    ckt->CKTtryToCompact = task->TSKtryToCompact;
-    ckt->CKTbadMos3 = task->TSKbadMos3;
-    ckt->CKTkeepOpInfo = task->TSKkeepOpInfo;
-    ckt->CKTcopyNodesets = task->TSKcopyNodesets;
-    ckt->CKTnodeDamping = task->TSKnodeDamping;
-    ckt->CKTabsDv = task->TSKabsDv;
-    ckt->CKTrelDv = task->TSKrelDv;
-    ckt->CKTtroubleNode = 0;
-    ckt->CKTtroubleElt = NULL;
-    ckt->CKTnoopac = task->TSKnoopac && ckt->CKTisLinear;
-    ckt->CKTepsmin = task->TSKepsmin;
-#ifdef NEWTRUNC
-    ckt->CKTlteReltol = task->TSKlteReltol;
-    ckt->CKTlteAbstol = task->TSKlteAbstol;
-#endif /* NEWTRUNC */
+    CKTtaskOpts(ckt, task);
 
     fprintf(stdout, "Doing analysis at TEMP = %f and TNOM = %f\n\n",
         ckt->CKTtemp - CONSTCtoK, ckt->CKTnomTemp - CONSTCtoK);
@@ -147,27 +158,8 @@ CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
         /* make sure this is either up do date or NULL */
         ckt->CKTcurJob = NULL;
 
-        /* normal reset */
         if (!error)
-            error = CKTunsetup(ckt);
-
-#ifdef XSPICE
-        /* gtri - add - 12/12/90 - wbk - set ipc syntax error flag */
-        if (error)   g_ipc.syntax_error = IPC_TRUE;
-        /* gtri - end - 12/12/90 */
-#endif
-
-        if (!error)
-            error = CKTsetup(ckt);
-
-#ifdef XSPICE
-        /* gtri - add - 12/12/90 - wbk - set ipc syntax error flag */
-        if (error)   g_ipc.syntax_error = IPC_TRUE;
-        /* gtri - end - 12/12/90 */
-#endif
-
-        if (!error)
-            error = CKTtemp(ckt);
+            error = CKTresetup(ckt);
 
 #ifdef XSPICE
         /* gtri - add - 12/12/90 - wbk - set ipc syntax error flag */
@@ -198,46 +190,11 @@ CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
         }/* if error  */
     }
 
-    error2 = OK;
-
-    /* Analysis order is important */
-    for (i = 0; i < ANALmaxnum; i++) {
-
 #ifdef WANT_SENSE2
-        if (i == sens_num)
-            continue;
-#endif
-
-        for (job = task->jobs; job; job = job->JOBnextJob) {
-            if (job->JOBtype == i) {
-                ckt->CKTcurJob = job;
-                error = OK;
-                if (analInfo[i]->an_init)
-                    error = analInfo[i]->an_init(ckt, job);
-                if (!error && analInfo[i]->do_ic)
-                    error = CKTic(ckt);
-                if (!error) {
-#ifdef XSPICE
-                    if (reset) {
-                        /* gtri - begin - 6/10/91 - wbk - Setup event-driven data */
-                        error = EVTsetup(ckt);
-                        if (error) {
-                            ckt->CKTstat->STATtotAnalTime +=
-                                SPfrontEnd->IFseconds() - startTime;
-                            return(error);
-                        }
-                        /* gtri - end - 6/10/91 - wbk - Setup event-driven data */
-                    }
+    error2 = CKTrunJobs(ckt, reset, task, sens_num);
+#else
+    error2 = CKTrunJobs(ckt, reset, task, -1);
 #endif
-                    error = analInfo[i]->an_func(ckt, reset);
-                    /* txl, cpl addition */
-                    if (error == 1111) break;
-                }
-                if (error)
-                    error2 = error;
-            }
-        }
-    }
 
     ckt->CKTstat->STATtotAnalTime += SPfrontEnd->IFseconds() - startTime;
 
@@ -249,3 +206,117 @@ CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
     return(error2);
 }
 
+
+/* Run the analyses of task on ckt, which is set up already, e.g. a second
+   circuit parsed and set up by the front end (cktreparse.c).  Unlike
+   CKTdoJob(), the circuit is not set up again and the temper expressions
+   of the current circuit are not evaluated, so several circuits may run
+   their analyses in parallel.  Sensitivity analyses are skipped. */
+
+int
+CKTdoJobNoSetup(CKTcircuit* ckt, TSKtask* task)
+{
+    int skip = -1;
+    int error;
+    double startTime = SPfrontEnd->IFseconds();
+
+#ifdef WANT_SENSE2
+    int ANALmaxnum = spice_num_analysis();
+    for (skip = 0; skip < ANALmaxnum; skip++)
+        if (!strcmp("SENS2", analInfo[skip]->if_analysis.name))
+            break;
+#endif
+
+    CKTtaskOpts(ckt, task);
+
+    ckt->CKTdelta = 0.0;
+    ckt->CKTtime = 0.0;
+    ckt->CKTcurrentAnalysis = 0;
+    ckt->CKTcurJob = NULL;
+
+    error = CKTrunJobs(ckt, 1, task, skip);
+
+    ckt->CKTstat->STATtotAnalTime += SPfrontEnd->IFseconds() - startTime;
+
+    return(error);
+}
+
+
+/* Copy the options of task into the circuit */
+
+void
+CKTtaskOpts(CKTcircuit *ckt, TSKtask *task)
+{
+    ckt->CKTtemp = task->TSKtemp;
+    ckt->CKTnomTemp = task->TSKnomTemp;
+    ckt->CKTmaxOrder = task->TSKmaxOrder;
+    ckt->CKTintegrateMethod = task->TSKintegrateMethod;
+    ckt->CKTindverbosity = task->TSKindverbosity;
+    ckt->CKTxmu = task->TSKxmu;
+    ckt->CKTbypass = task->TSKbypass;
+    ckt->CKTdcMaxIter = task->TSKdcMaxIter;
+    ckt->CKTdcTrcvMaxIter = task->TSKdcTrcvMaxIter;
+    ckt->CKTtranMaxIter = task->TSKtranMaxIter;
+    ckt->CKTnumSrcSteps = task->TSKnumSrcSteps;
+    ckt->CKTnumGminSteps = task->TSKnumGminSteps;
+    ckt->CKTgminFactor = task->TSKgminFactor;
+    ckt->CKTminBreak = task->TSKminBreak;
+    ckt->CKTabstol = task->TSKabstol;
+    ckt->CKTpivotAbsTol = task->TSKpivotAbsTol;
+    ckt->CKTpivotRelTol = task->TSKpivotRelTol;
+    ckt->CKTreltol = task->TSKreltol;
+    ckt->CKTchgtol = task->TSKchgtol;
+    ckt->CKTvoltTol = task->TSKvoltTol;
+    ckt->CKTgmin = task->TSKgmin;
+    ckt->CKTgshunt = task->TSKgshunt;
+    ckt->CKTcshunt = task->TSKcshunt;
+    ckt->CKTdelmin = task->TSKdelmin;
+    ckt->CKTtrtol = task->TSKtrtol;
+#ifdef XSPICE
+    /* Lower value of trtol to give smaller stepsize and more accuracy,
+       but only if there are 'A' devices in the circuit,
+       may be overridden by 'set xtrtol=newval' */
+    if (ckt->CKTadevFlag && (ckt->CKTtrtol > 1)) {
+        int newtol;
+        if (cp_getvar("xtrtol", CP_NUM, &newtol, 0)) {
+            printf("Override trtol to %d for xspice 'A' devices\n", newtol);
+            ckt->CKTtrtol = newtol;
+        }
+        else {
+            printf("Reducing trtol to 1 for xspice 'A' devices\n");
+            ckt->CKTtrtol = 1;
+        }
+    }
+#endif
+    ckt->CKTdefaultMosM = task->TSKdefaultMosM;
+    ckt->CKTdefaultMosL = task->TSKdefaultMosL;
+    ckt->CKTdefaultMosW = task->TSKdefaultMosW;
+    ckt->CKTdefaultMosAD = task->TSKdefaultMosAD;
+    ckt->CKTdefaultMosAS = task->TSKdefaultMosAS;
+    ckt->CKTfixLimit = task->TSKfixLimit;
+    ckt->CKTnoOpIter = task->TSKnoOpIter;
+    ckt->CKTdcSeed = task->TSKdcSeed;
+    ckt->CKTwaveRelax = task->TSKwaveRelax;
+    ckt->CKTmultiRate = task->TSKmultiRate;
+    ckt->CKTnoTruncBatch = task->TSKnoTruncBatch;
+    ckt->CKTpzArnoldi = task->TSKpzArnoldi;
+    ckt->CKTpzRoots = task->TSKpzRoots;
+    ckt->CKTalterInc = task->TSKalterInc;
+    ckt->CKTopRemember = task->TSKopRemember;
+    ckt->CKTopRace = task->TSKopRace;
+    ckt->CKTtryToCompact = task->TSKtryToCompact;
+    ckt->CKTbadMos3 = task->TSKbadMos3;
+    ckt->CKTkeepOpInfo = task->TSKkeepOpInfo;
+    ckt->CKTcopyNodesets = task->TSKcopyNodesets;
+    ckt->CKTnodeDamping = task->TSKnodeDamping;
+    ckt->CKTabsDv = task->TSKabsDv;
+    ckt->CKTrelDv = task->TSKrelDv;
+    ckt->CKTtroubleNode = 0;
+    ckt->CKTtroubleElt = NULL;
+    ckt->CKTnoopac = task->TSKnoopac && ckt->CKTisLinear;
+    ckt->CKTepsmin = task->TSKepsmin;
+#ifdef NEWTRUNC
+    ckt->CKTlteReltol = task->TSKlteReltol;
+    ckt->CKTlteAbstol = task->TSKlteAbstol;
+#endif /* NEWTRUNC */
+}
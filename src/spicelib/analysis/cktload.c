@@ -59,19 +59,25 @@ CKTload(CKTcircuit *ckt)
     noncon = ckt->CKTnoncon;
 #endif /* STEPDEBUG */
 
-    for (i = 0; i < DEVmaxnum; i++) {
-        if (DEVices[i] && DEVices[i]->DEVload && ckt->CKThead[i]) {
-            error = DEVices[i]->DEVload (ckt->CKThead[i], ckt);
-            if (ckt->CKTnoncon)
-                ckt->CKTtroubleNode = 0;
+    if (ckt->CKTwavrel && (ckt->CKTmode & MODETRAN)) {
+        /* waveform relaxation, one block against the others */
+        error = CKTwrLoad(ckt);
+        if (error) return(error);
+    } else {
+        for (i = 0; i < DEVmaxnum; i++) {
+            if (DEVices[i] && DEVices[i]->DEVload && ckt->CKThead[i]) {
+                error = DEVices[i]->DEVload (ckt->CKThead[i], ckt);
+                if (ckt->CKTnoncon)
+                    ckt->CKTtroubleNode = 0;
 #ifdef STEPDEBUG
-            if (noncon != ckt->CKTnoncon) {
-                printf("device type %s nonconvergence\n",
-                       DEVices[i]->DEVpublic.name);
-                noncon = ckt->CKTnoncon;
-            }
+                if (noncon != ckt->CKTnoncon) {
+                    printf("device type %s nonconvergence\n",
+                           DEVices[i]->DEVpublic.name);
+                    noncon = ckt->CKTnoncon;
+                }
 #endif /* STEPDEBUG */
-            if (error) return(error);
+                if (error) return(error);
+            }
         }
     }
 
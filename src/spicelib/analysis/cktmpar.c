@@ -20,10 +20,10 @@ CKTmodParam(CKTcircuit *ckt, GENmodel *modfast, int param, IFvalue *val, IFvalue
 {
     int type = modfast->GENmodType;
 
-    NG_IGNORE(ckt);
     NG_IGNORE(selector);
 
     if (DEVices[type]->DEVmodParam) {
+        CKTalterMark(ckt, modfast, NULL);
         return(DEVices[type]->DEVmodParam (param, val, modfast));
     } else {
         return(E_BADPARM);
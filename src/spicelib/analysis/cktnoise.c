@@ -20,6 +20,76 @@ Author: 1987 Gary W. Ng
 #include "ngspice/sperror.h"
 
 
+#ifdef USE_OMP
+#include <omp.h>
+
+extern int nthreads;
+#endif
+
+/* Evaluate the noise densities of all device types.  Every type gets a
+ * private copy of data, with its own partial sums and its own piece of
+ * outpVector, so that the types may run concurrently.  The pieces are
+ * merged in device order, which keeps the summary vectors where the
+ * serial loop of CKTnoise() puts them.
+ *
+ * The sums of the densities and of the integrated noise are therefore
+ * formed per device type first and then added up in device order.  This
+ * is done with and without threads, so the results do not depend on the
+ * number of threads, down to the last bit.
+ */
+static int
+CKTnoiseDens(CKTcircuit *ckt, int mode, Ndata *data, double *outNdens)
+{
+    Ndata *part;
+    double *dens, *vec;
+    int *type, *err;
+    int i, k, num = 0;
+    int error = OK;
+
+    type = TMALLOC(int, DEVmaxnum);
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVnoise && ckt->CKThead[i])
+            type[num++] = i;
+
+    part = TMALLOC(Ndata, num);
+    dens = TMALLOC(double, num);
+    err = TMALLOC(int, num);
+    vec = TMALLOC(double, (size_t) num * (size_t) data->numPlots);
+
+    for (k = 0; k < num; k++) {
+        part[k] = *data;
+        part[k].outNoiz = 0.0;
+        part[k].inNoise = 0.0;
+        part[k].outNumber = 0;
+        dens[k] = 0.0;
+        part[k].outpVector = vec + (size_t) k * (size_t) data->numPlots;
+    }
+
+#ifdef USE_OMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+#endif
+    for (k = 0; k < num; k++)
+        err[k] = DEVices[type[k]]->DEVnoise (mode, N_CALC,
+            ckt->CKThead[type[k]], ckt, &part[k], &dens[k]);
+
+    for (k = 0; k < num && !error; k++) {
+        error = err[k];
+        data->outNoiz += part[k].outNoiz;
+        data->inNoise += part[k].inNoise;
+        *outNdens += dens[k];
+        for (i = 0; i < part[k].outNumber; i++)
+            data->outpVector[data->outNumber++] = part[k].outpVector[i];
+    }
+
+    tfree(vec);
+    tfree(err);
+    tfree(dens);
+    tfree(part);
+    tfree(type);
+    return (error);
+}
+
+
 int
 CKTnoise (CKTcircuit *ckt, int mode, int operation, Ndata *data)
 {
@@ -35,6 +105,10 @@ CKTnoise (CKTcircuit *ckt, int mode, int operation, Ndata *data)
 
     /* let each device decide how many and what type of noise sources it has */
 
+    if (operation == N_CALC && mode == N_DENS) {
+        error = CKTnoiseDens(ckt, mode, data, &outNdens);
+        if (error) return (error);
+    } else
     for (i=0; i < DEVmaxnum; i++) {
 	if ( DEVices[i] && DEVices[i]->DEVnoise && ckt->CKThead[i] ) {
 	    error = DEVices[i]->DEVnoise (mode, operation, ckt->CKThead[i],
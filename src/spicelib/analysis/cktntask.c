@@ -75,6 +75,15 @@ CKTnewTask(CKTcircuit *ckt, TSKtask **taskPtr, IFuid taskName, TSKtask **defPtr)
         tsk->TSKabsDv           = def->TSKabsDv;
         tsk->TSKrelDv           = def->TSKrelDv;
         tsk->TSKnoopac          = def->TSKnoopac;
+        tsk->TSKdcSeed          = def->TSKdcSeed;
+        tsk->TSKwaveRelax       = def->TSKwaveRelax;
+        tsk->TSKmultiRate       = def->TSKmultiRate;
+        tsk->TSKnoTruncBatch    = def->TSKnoTruncBatch;
+        tsk->TSKpzArnoldi       = def->TSKpzArnoldi;
+        tsk->TSKpzRoots         = def->TSKpzRoots;
+        tsk->TSKalterInc        = def->TSKalterInc;
+        tsk->TSKopRemember      = def->TSKopRemember;
+        tsk->TSKopRace          = def->TSKopRace;
         tsk->TSKepsmin          = def->TSKepsmin;
 #ifdef NEWTRUNC
         tsk->TSKlteReltol       = def->TSKlteReltol;
@@ -130,6 +139,15 @@ CKTnewTask(CKTcircuit *ckt, TSKtask **taskPtr, IFuid taskName, TSKtask **defPtr)
         tsk->TSKkeepOpInfo      = 0;
         tsk->TSKcopyNodesets    = 0;
         tsk->TSKnodeDamping     = 0;
+        tsk->TSKdcSeed          = 0;
+        tsk->TSKwaveRelax       = 0;
+        tsk->TSKmultiRate       = 0;
+        tsk->TSKnoTruncBatch    = 0;
+        tsk->TSKpzArnoldi       = 0;
+        tsk->TSKpzRoots         = 20;
+        tsk->TSKalterInc        = 0;
+        tsk->TSKopRemember      = 0;
+        tsk->TSKopRace          = 0;
         tsk->TSKabsDv           = 0.5;
         tsk->TSKrelDv           = 2.0;
         tsk->TSKepsmin          = 1e-28;
@@ -15,12 +15,29 @@ Modified: 2005 Paolo Nenzi - Restructured
 #include "ngspice/enh.h"
 #endif
 
+#ifdef USE_OMP
+#include <omp.h>
+extern int nthreads;
+#endif
+
 
 static int dynamic_gmin(CKTcircuit *, long int, long int, int);
 static int spice3_gmin(CKTcircuit *, long int, long int, int);
 static int new_gmin(CKTcircuit*, long int, long int, int);
 static int gillespie_src(CKTcircuit *, long int, long int, int);
 static int spice3_src(CKTcircuit *, long int, long int, int);
+static int homotopy(CKTcircuit *, int, long int, long int, int, int);
+static int homotopy_enabled(CKTcircuit *, int);
+#ifdef USE_OMP
+static int homotopy_race(CKTcircuit *, long int, long int, int, int *);
+#endif
+
+/* the order in which the homotopies are tried, by the last successful one */
+static const int homotopy_order[3][3] = {
+    { OP_GMINSTEP, OP_SRCSTEP, OP_OPTRAN },
+    { OP_SRCSTEP, OP_GMINSTEP, OP_OPTRAN },
+    { OP_OPTRAN, OP_GMINSTEP, OP_SRCSTEP }
+};
 
 
 int
@@ -28,12 +45,53 @@ CKTop (CKTcircuit *ckt, long int firstmode, long int continuemode,
        int iterlim)
 {
     int converged;
+    const int *order;
+    int i, raced;
 
 #ifdef HAS_PROGREP
     SetAnalyse("op", 0);
 #endif
 
     ckt->CKTmode = firstmode;
+    ckt->CKTopNumTried = 0;
+    ckt->CKTopChosen = 0;
+
+    /* start from a cached operating point, see cktopcache.c.  The cached
+     * states need not belong to the present parameters, so no bypass.
+     * If the fingerprint matched, the file holds this point already */
+    if (firstmode & (MODEDCOP | MODETRANOP)) {
+        int cached = CKTopCacheLoad(ckt);
+        if (cached) {
+            int bypass = ckt->CKTbypass;
+            ckt->CKTmode = continuemode;
+            ckt->CKTbypass = 0;
+            converged = NIiter (ckt, iterlim);
+            ckt->CKTbypass = bypass;
+            if (converged == 0) {
+                if (cached != 2)
+                    CKTopCacheSave(ckt);
+                CKTalterSaveOp(ckt);
+                return converged;
+            }
+            ckt->CKTmode = firstmode;
+        }
+    }
+
+    /* start from the operating point before alter, see cktalter.c.  The
+     * states of the altered devices are stale, so no bypass */
+    if ((firstmode & (MODEDCOP | MODETRANOP)) && CKTalterLoadOp(ckt)) {
+        int bypass = ckt->CKTbypass;
+        ckt->CKTmode = continuemode;
+        ckt->CKTbypass = 0;
+        converged = NIiter (ckt, iterlim);
+        ckt->CKTbypass = bypass;
+        if (converged == 0) {
+            CKTopCacheSave(ckt);
+            CKTalterSaveOp(ckt);
+            return converged;
+        }
+        ckt->CKTmode = firstmode;
+    }
 
     if (!ckt->CKTnoOpIter) {
 #ifdef XSPICE
@@ -42,17 +100,90 @@ CKTop (CKTcircuit *ckt, long int firstmode, long int continuemode,
             (ckt->CKTnumGminSteps <= 0) && (ckt->CKTnumSrcSteps <= 0);
 #endif
         converged = NIiter (ckt, iterlim);
-        if (converged == 0)
+        if (converged == 0) {
+            if (firstmode & (MODEDCOP | MODETRANOP)) {
+                CKTopCacheSave(ckt);
+                CKTalterSaveOp(ckt);
+            }
             return converged;   /* successfull */
+        }
     } else {
         converged = 1;          /* the 'go directly to gmin stepping' option */
     }
 
 
-    /* no convergence on the first try, so we do something else */
-    /* first, check if we should try gmin stepping */
+    /* no convergence on the first try, so we do something else:
+     * gmin stepping, source stepping and transient op, in this order.
+     * With option opremember, a homotopy which succeeded in an earlier
+     * call is tried first, the others being the more likely to fail
+     * again.  If it fails, the others follow in their usual order.
+     * The homotopies enabled are recorded in CKTopTried, in this order,
+     * the one which converged in CKTopChosen, see 'rusage optried' and
+     * 'rusage ophomotopy'. */
+
+    order = homotopy_order[0];
+    if (ckt->CKTopRemember) {
+        if (ckt->CKTopStrategy == OP_SRCSTEP)
+            order = homotopy_order[1];
+        else if (ckt->CKTopStrategy == OP_OPTRAN)
+            order = homotopy_order[2];
+    }
+
+    for (i = 0; i < 3; i++)
+        if (homotopy_enabled(ckt, order[i]))
+            ckt->CKTopTried[ckt->CKTopNumTried++] = order[i];
+
+    raced = FALSE;
+#ifdef USE_OMP
+    /* with option oprace, they run at once on copies of the circuit */
+    if (ckt->CKTopRace && ckt->CKTopNumTried > 1 && nthreads > 1 &&
+        !omp_in_parallel())
+        raced = (homotopy_race(ckt, firstmode, continuemode, iterlim,
+                               &converged) == OK);
+#endif
+
+    for (i = 0; !raced && i < ckt->CKTopNumTried; i++) {
+        converged = homotopy(ckt, ckt->CKTopTried[i], firstmode,
+                             continuemode, iterlim, converged);
+        if (converged == 0) {
+            ckt->CKTopChosen = ckt->CKTopTried[i];
+            break;
+        }
+    }
+
+    if (converged == 0) {
+        ckt->CKTopStrategy = ckt->CKTopChosen;
+        if (firstmode & (MODEDCOP | MODETRANOP)) {
+            CKTopCacheSave(ckt);
+            CKTalterSaveOp(ckt);
+        }
+        return converged;
+    }
+
+#ifdef XSPICE
+    /* gtri - wbk - add convergence problem reporting flags */
+    ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
+#endif
+
+    return converged;
+}
+
+
+/* Try one of the homotopies of CKTop(), returns the previous 'converged'
+ * if it is not enabled */
 
-    if (ckt->CKTnumGminSteps >= 1) {
+static int
+homotopy(CKTcircuit *ckt, int strategy, long int firstmode,
+         long int continuemode, int iterlim, int converged)
+{
+    int prevconverged;
+
+    if (CKTopCancelled(ckt))
+        return E_ITERLIM;
+
+    switch (strategy) {
+
+    case OP_GMINSTEP:
         if (ckt->CKTnumGminSteps == 1) {
             /* only the old gmin */
             if (cp_getvar("dyngmin", CP_BOOL, NULL, 0)) {
@@ -67,45 +198,142 @@ CKTop (CKTcircuit *ckt, long int firstmode, long int continuemode,
 
             }
         }
-        else {
+        else if (ckt->CKTnumGminSteps > 1) {
             converged = spice3_gmin(ckt, firstmode, continuemode, iterlim);
         }
-        if (converged == 0) /* If gmin-stepping worked... move out */
-            return converged;
-    }
-
-    /* ... otherwise try stepping sources ...
-     * now, we'll try source stepping - we scale the sources
-     * to 0, converge, then start stepping them up until they
-     * are at their normal values
-     */
+        break;
 
-    if (ckt->CKTnumSrcSteps >= 1) {
+    case OP_SRCSTEP:
+        /* we scale the sources to 0, converge, then start stepping
+         * them up until they are at their normal values */
         if (ckt->CKTnumSrcSteps == 1)
             converged = gillespie_src(ckt, firstmode, continuemode, iterlim);
-        else
+        else if (ckt->CKTnumSrcSteps > 1)
             converged = spice3_src(ckt, firstmode, continuemode, iterlim);
-        if (converged == 0) /* If gmin-stepping worked... move out */
-            return converged;
+        break;
+
+    case OP_OPTRAN:
+        /* If command 'optran' is not given, the function
+           returns immediately with the previous 'converged' */
+        prevconverged = converged;
+        converged = OPtran(ckt, converged);
+        if (CKTopCancelled(ckt))
+            break;
+        if (converged == 106)
+            fprintf(cp_err, "Error: Transient op failed, timestep too small\n\n");
+        else if (converged != 0 && converged != prevconverged)
+            fprintf(cp_err, "Error: Transient op failed, cause unrecorded\n\n");
+        break;
+    }
+
+    return converged;
+}
+
+
+/* TRUE if homotopy() would try strategy */
+
+static int
+homotopy_enabled(CKTcircuit *ckt, int strategy)
+{
+    switch (strategy) {
+    case OP_GMINSTEP:
+        return ckt->CKTnumGminSteps >= 1;
+    case OP_SRCSTEP:
+        return ckt->CKTnumSrcSteps >= 1;
+    case OP_OPTRAN:
+        return OPtranEnabled();
+    default:
+        return FALSE;
+    }
+}
+
+
+/* TRUE if ckt is a copy racing its homotopy in homotopy_race(), and a
+ * homotopy before it in CKTopTried has converged.  The homotopies check
+ * this after each step and then give up. */
+
+int
+CKTopCancelled(CKTcircuit *ckt)
+{
+    int cancel = 0;
+
+    if (ckt->CKTopCancel) {
+#ifdef USE_OMP
+#pragma omp atomic read
+#endif
+        cancel = *ckt->CKTopCancel;
+    }
+
+    return cancel;
+}
+
+
+#ifdef USE_OMP
+
+/* Run the homotopies of CKTopTried concurrently, each of them on a copy
+ * of ckt made by CKTclone().  When one of them converges, those after it
+ * in CKTopTried are cancelled, but not those before it: the first one
+ * in this order which converges wins, as it does when they are tried in
+ * turn, whatever the timing of the threads.  Its solution and states are
+ * copied to ckt.  E_UNSUPP if ckt may not be copied, the homotopies are
+ * then tried in turn. */
+
+static int
+homotopy_race(CKTcircuit *ckt, long int firstmode, long int continuemode,
+              int iterlim, int *converged)
+{
+    CKTcircuit *copy[3];
+    int result[3], cancel[3];
+    int num = ckt->CKTopNumTried;
+    int iters = ckt->CKTstat->STATnumIter;
+    int i, error;
+
+    for (i = 0; i < num; i++) {
+        error = CKTclone(ckt, &copy[i]);
+        if (error) {
+            while (--i >= 0)
+                CKTcloneFree(copy[i]);
+            return error;
+        }
+        cancel[i] = 0;
+        copy[i]->CKTopCancel = &cancel[i];
     }
 
-    /* If command 'optran' is not given, the function
-       returns immediately with the previous 'converged' */
-    int prevconverged = converged;
-    converged = OPtran(ckt, converged);
-    if (converged == 106)
-        fprintf(cp_err, "Error: Transient op failed, timestep too small\n\n");
-    else if (converged != 0 && converged != prevconverged)
-        fprintf(cp_err, "Error: Transient op failed, cause unrecorded\n\n");
+#pragma omp parallel for num_threads(num) schedule(static, 1)
+    for (i = 0; i < num; i++) {
+        int j;
+        result[i] = homotopy(copy[i], ckt->CKTopTried[i], firstmode,
+                             continuemode, iterlim, *converged);
+        if (result[i] == 0)
+            for (j = i + 1; j < num; j++) {
+#pragma omp atomic write
+                cancel[j] = 1;
+            }
+    }
 
+    *converged = result[num - 1];
+    for (i = 0; i < num; i++)
+        if (result[i] == 0) {
+            CKTcloneState(ckt, copy[i]);
+            ckt->CKTmode = copy[i]->CKTmode;
+            ckt->CKTopChosen = ckt->CKTopTried[i];
+            *converged = 0;
 #ifdef XSPICE
-    /* gtri - wbk - add convergence problem reporting flags */
-    ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
+            ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
 #endif
+            break;
+        }
 
-    return converged;
+    for (i = 0; i < num; i++) {
+        ckt->CKTstat->STATnumIter += copy[i]->CKTstat->STATnumIter - iters;
+        CKTcloneFree(copy[i]);
+    }
+
+    return OK;
 }
 
+#endif
+
 
 /* CKTconvTest(ckt)
  *    this is a driver program to iterate through all the various
@@ -118,6 +346,9 @@ CKTconvTest (CKTcircuit *ckt)
 {
     int i;
 
+    if (ckt->CKTwavrel && (ckt->CKTmode & MODETRAN))
+        return CKTwrConvTest(ckt);
+
     for (i = 0; i < DEVmaxnum; i++) {
 
         if (DEVices[i] && DEVices[i]->DEVconvTest && ckt->CKThead[i]) {
@@ -182,6 +413,9 @@ dynamic_gmin (CKTcircuit *ckt, long int firstmode,
     gtarget = MAX (ckt->CKTgmin, ckt->CKTgshunt);
 
     for (;;) {
+        if (CKTopCancelled(ckt))
+            break;
+
         fprintf (stderr, "Trying gmin = %12.4E ", ckt->CKTdiagGmin);
 
         ckt->CKTnoncon = 1;
@@ -240,6 +474,9 @@ dynamic_gmin (CKTcircuit *ckt, long int firstmode,
     FREE (OldRhsOld);
     FREE (OldCKTstate0);
 
+    if (CKTopCancelled(ckt))
+        return E_ITERLIM;
+
 #ifdef XSPICE
     /* gtri - wbk - add convergence problem reporting flags */
     ckt->enh->conv_debug.last_NIiter_call = (ckt->CKTnumSrcSteps <= 0);
@@ -294,7 +531,7 @@ spice3_gmin (CKTcircuit *ckt, long int firstmode,
         ckt->CKTnoncon = 1;
         converged = NIiter (ckt, ckt->CKTdcTrcvMaxIter);
 
-        if (converged != 0) {
+        if (converged != 0 || CKTopCancelled(ckt)) {
             ckt->CKTdiagGmin = ckt->CKTgshunt;
             SPfrontEnd->IFerrorf (ERR_WARNING, "gmin step failed");
             break;
@@ -308,6 +545,9 @@ spice3_gmin (CKTcircuit *ckt, long int firstmode,
 
     ckt->CKTdiagGmin = ckt->CKTgshunt;
 
+    if (CKTopCancelled(ckt))
+        return E_ITERLIM;
+
 #ifdef XSPICE
     /* gtri - wbk - add convergence problem reporting flags */
     ckt->enh->conv_debug.last_NIiter_call = (ckt->CKTnumSrcSteps <= 0);
@@ -365,6 +605,9 @@ new_gmin(CKTcircuit* ckt, long int firstmode,
     gtarget = MAX(startgmin, ckt->CKTgshunt);
 
     for (;;) {
+        if (CKTopCancelled(ckt))
+            break;
+
         fprintf(stderr, "Trying gmin = %12.4E ", ckt->CKTgmin);
 
         ckt->CKTnoncon = 1;
@@ -425,6 +668,9 @@ new_gmin(CKTcircuit* ckt, long int firstmode,
     FREE(OldRhsOld);
     FREE(OldCKTstate0);
 
+    if (CKTopCancelled(ckt))
+        return E_ITERLIM;
+
 #ifdef XSPICE
     /* gtri - wbk - add convergence problem reporting flags */
     ckt->enh->conv_debug.last_NIiter_call = (ckt->CKTnumSrcSteps <= 0);
@@ -508,7 +754,7 @@ gillespie_src (CKTcircuit *ckt, long int firstmode,
             ckt->CKTnoncon = 1;
             converged = NIiter (ckt, ckt->CKTdcTrcvMaxIter);
 
-            if (converged != 0) {
+            if (converged != 0 || CKTopCancelled(ckt)) {
                 ckt->CKTdiagGmin = ckt->CKTgshunt;
                 SPfrontEnd->IFerrorf (ERR_WARNING, "gmin step failed");
 #ifdef XSPICE
@@ -548,6 +794,9 @@ gillespie_src (CKTcircuit *ckt, long int firstmode,
         ckt->CKTsrcFact = ConvFact + raise;
 
         do {
+            if (CKTopCancelled(ckt))
+                break;
+
             fprintf (stderr,
                      "Supplies reduced to %8.4f%% ", ckt->CKTsrcFact * 100);
 
@@ -663,6 +912,8 @@ spice3_src (CKTcircuit *ckt, long int firstmode,
 #endif
         converged = NIiter (ckt, ckt->CKTdcTrcvMaxIter);
         ckt->CKTmode = continuemode;
+        if (converged == 0 && CKTopCancelled(ckt))
+            converged = E_ITERLIM;
         if (converged != 0) {
             ckt->CKTsrcFact = 1;
             ckt->CKTcurrentAnalysis = DOING_TRAN;
@@ -0,0 +1,247 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Operating point cache.
+ *
+ * The cache is off unless the variable opcache is set.  With 'set
+ * opcache' every converged operating point (dc op and the op of a
+ * transient) is written to a file, by default the input file name with
+ * the extension .opc added, or the file given by 'set opcache=<file>'.
+ * A point restored from a matching cache is not written again.  Together
+ * with the solution the file holds a fingerprint of the expanded deck,
+ * the parameters changed by alter and altermod, the options and the
+ * temperature.
+ *
+ * The next operating point of a circuit starts from the cache instead of
+ * the junction voltages.  If the fingerprint matches, the solution and
+ * the device states are restored as they were, and Newton normally stops
+ * after two iterations.  Otherwise node voltages and branch currents are
+ * taken over by name as a warm start.  In both cases the solution is
+ * verified by Newton iterations without bypass, CKTop() falls back to
+ * its usual path if these do not converge, so a stale cache costs time,
+ * never accuracy.
+ *
+ * The file is plain text, similar to the output of 'wrnodev':
+ *
+ *	* ngspice operating point cache
+ *	* Circuit: <title>
+ *	fingerprint <hex> <size> <number of states>
+ *	node <node or branch name> <value>
+ *	...
+ *	state <value>
+ *	...
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/cpextern.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteext.h"
+#include "ngspice/inpdefs.h"
+#include "ngspice/hash.h"
+
+
+/* FNV-1a */
+static unsigned long long
+fp_add(unsigned long long h, const void *data, size_t n)
+{
+    const unsigned char *p = (const unsigned char *) data;
+
+    while (n--) {
+        h ^= *p++;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+
+/* Fingerprint of the expanded deck of the current circuit, the
+ * parameters changed by alter and altermod, the options and the
+ * temperature */
+unsigned long long
+CKTfingerprint(CKTcircuit *ckt)
+{
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    struct card *c;
+
+    for (c = ft_curckt->ci_deck; c; c = c->nextcard)
+        if (c->line) {
+            h = fp_add(h, c->line, strlen(c->line));
+            h = fp_add(h, "\n", 1);
+        }
+    for (c = ft_curckt->ci_options; c; c = c->nextcard)
+        if (c->line) {
+            h = fp_add(h, c->line, strlen(c->line));
+            h = fp_add(h, "\n", 1);
+        }
+
+    h = fp_add(h, &ckt->CKTparamKey, sizeof(ckt->CKTparamKey));
+    h = fp_add(h, &ckt->CKTtemp, sizeof(double));
+    h = fp_add(h, &ckt->CKTnomTemp, sizeof(double));
+    h = fp_add(h, &ckt->CKTgmin, sizeof(double));
+    h = fp_add(h, &ckt->CKTreltol, sizeof(double));
+    h = fp_add(h, &ckt->CKTabstol, sizeof(double));
+    h = fp_add(h, &ckt->CKTvoltTol, sizeof(double));
+
+    return h;
+}
+
+
+/* Add a parameter of instance or model name, changed by alter or
+ * altermod, to the fingerprint of the circuit.  param is the parameter
+ * id, or -1 for a new model of the instance, which is then the name */
+void
+CKTfingerprintParam(CKTcircuit *ckt, const char *name, int param,
+                    const double *values, int n)
+{
+    unsigned long long h = ckt->CKTparamKey;
+
+    if (!h)
+        h = 0xcbf29ce484222325ULL;
+
+    if (name)
+        h = fp_add(h, name, strlen(name) + 1);
+    h = fp_add(h, &param, sizeof(int));
+    if (values && n > 0)
+        h = fp_add(h, values, (size_t) n * sizeof(double));
+
+    ckt->CKTparamKey = h;
+}
+
+
+/* The cache file of the current circuit, NULL if there is none */
+static char *
+opcache_file(CKTcircuit *ckt)
+{
+    char buf[BSIZE_SP];
+
+    if (!ft_curckt || ft_curckt->ci_ckt != ckt)
+        return NULL;
+
+    if (cp_getvar("opcache", CP_STRING, buf, sizeof(buf)) && *buf)
+        return copy(buf);
+
+    if (cp_getvar("opcache", CP_BOOL, NULL, 0) && ft_curckt->ci_filename)
+        return tprintf("%s.opc", ft_curckt->ci_filename);
+
+    return NULL;
+}
+
+
+/* Load the cached operating point into CKTrhsOld and CKTstate0.
+ * Returns 0 if there is none, 1 for a warm start by names, 2 if
+ * the fingerprint matched. */
+int
+CKTopCacheLoad(CKTcircuit *ckt)
+{
+    char *file = opcache_file(ckt);
+    char line[BSIZE_SP], name[BSIZE_SP];
+    unsigned long long key;
+    NGHASHPTR names = NULL;
+    CKTnode *node, *next = NULL;
+    FILE *fp;
+    int size, n, m, matched = 0, found = 0, loaded = 0, num_states = 0;
+    double value;
+
+    if (!file)
+        return 0;
+
+    fp = fopen(file, "r");
+    tfree(file);
+    if (!fp)
+        return 0;
+
+    size = SMPmatSize(ckt->CKTmatrix);
+
+    while (fgets(line, sizeof(line), fp)) {
+
+        if (sscanf(line, "fingerprint %llx %d %d", &key, &n, &m) == 3) {
+            found = 1;
+            matched = key == CKTfingerprint(ckt) &&
+                n == size && m == ckt->CKTnumStates;
+            if (matched) {
+                next = ckt->CKTnodes->next;
+            } else {
+                names = nghash_init(size);
+                for (node = ckt->CKTnodes->next; node; node = node->next)
+                    nghash_insert(names, node->name, node);
+            }
+
+        } else if (!found) {
+            continue;
+
+        } else if (sscanf(line, "node %s %lf", name, &value) == 2) {
+            if (matched) {
+                /* same deck, the nodes come in the order of the list */
+                for (node = next; node; node = node->next)
+                    if (node->number <= size)
+                        break;
+                if (!node || strcmp(node->name, name) != 0) {
+                    matched = 0;
+                    break;
+                }
+                next = node->next;
+            } else {
+                node = nghash_find(names, name);
+                if (!node || node->number <= 0 || node->number > size)
+                    continue;
+            }
+            ckt->CKTrhsOld[node->number] = value;
+            loaded++;
+
+        } else if (sscanf(line, "state %lf", &value) == 1) {
+            if (matched && num_states < ckt->CKTnumStates)
+                ckt->CKTstate0[num_states++] = value;
+        }
+    }
+
+    fclose(fp);
+    if (names)
+        nghash_free(names, NULL, NULL);
+
+    if (!loaded)
+        return 0;
+
+    return matched ? 2 : 1;
+}
+
+
+/* Write the converged operating point of the circuit to its cache */
+void
+CKTopCacheSave(CKTcircuit *ckt)
+{
+    char *file = opcache_file(ckt);
+    CKTnode *node;
+    FILE *fp;
+    int size, i;
+
+    if (!file)
+        return;
+
+    fp = fopen(file, "w");
+    if (!fp) {
+        fprintf(cp_err, "Warning: cannot write operating point cache %s\n",
+                file);
+        tfree(file);
+        return;
+    }
+    tfree(file);
+
+    size = SMPmatSize(ckt->CKTmatrix);
+
+    fprintf(fp, "* ngspice operating point cache\n");
+    fprintf(fp, "* Circuit: %s\n", ft_curckt->ci_name);
+    fprintf(fp, "fingerprint %016llx %d %d\n",
+            CKTfingerprint(ckt), size, ckt->CKTnumStates);
+    for (node = ckt->CKTnodes->next; node; node = node->next)
+        if (node->number <= size)
+            fprintf(fp, "node %s %.17g\n", node->name,
+                    ckt->CKTrhsOld[node->number]);
+    for (i = 0; i < ckt->CKTnumStates; i++)
+        fprintf(fp, "state %.17g\n", ckt->CKTstate0[i]);
+
+    fclose(fp);
+}
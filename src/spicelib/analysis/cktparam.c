@@ -20,10 +20,9 @@ CKTparam(CKTcircuit *ckt, GENinstance *fast, int param, IFvalue *val, IFvalue *s
 {
     int type;
 
-    NG_IGNORE(ckt);
-
     type = fast->GENmodPtr->GENmodType;
     if(DEVices[type]->DEVparam) {
+        CKTalterMark(ckt, NULL, fast);
         return(DEVices[type]->DEVparam (param, val, fast, selector));
     } else {
         return(E_BADPARM);
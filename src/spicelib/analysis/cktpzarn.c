@@ -0,0 +1,761 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Pole-zero analysis by shift-and-invert Arnoldi.
+ *
+ * With '.options pzarnoldi' the roots of the matrix set up by CKTpzSetup()
+ * are found as eigenvalues instead of by the search of CKTpzFindZeros().
+ * The pole-zero loads of the devices are linear in s, so the matrix loaded
+ * by CKTpzLoad() at s = j is G + jC and holds G and C at once.  The roots
+ * are the eigenvalues of the pencil G + sC.  With a real shift sigma
+ *
+ *      (G + sigma C)^-1 C x = mu x,        s = sigma - 1/mu
+ *
+ * and the roots closest to the shift have the largest |mu|, they are the
+ * first ones to converge in the Arnoldi iteration.  G + sigma C is factored
+ * once, each Arnoldi step is one product with C and one solve.  The start
+ * vector is mapped through the operator twice, which removes the
+ * components of the infinite roots (singular C).  That is not enough for
+ * longer Jordan chains of infinite roots: rounding turns a chain of length
+ * k into k finite Ritz values of size eps^(1/k) on a circle, which then
+ * come out as large spurious roots.  Their condition number is of the
+ * order eps^(1/k - 1), so they are not larger than their own uncertainty
+ * cond * eps * |H|, and they are dropped.  A genuine multiple root (three
+ * equal stages) is as ill-conditioned, but far from 0.  Ritz values which
+ * are neither, as in the cascades below, are not trusted, and the
+ * analysis falls back to the search.
+ *
+ * 'option pzroots' (default 20) sets the number of roots wanted.  The
+ * Krylov space is grown until they have converged, or until it is
+ * invariant, which means that all finite roots have been found.  The
+ * roots are returned nearest to the shift first.
+ *
+ * The shift is 0, which gives the dominant roots, unless G is singular;
+ * then it is moved to small positive values relative to the circuit's
+ * own ratio of conductances to capacitances.
+ *
+ * In cascades of very high gain (tests/polezero/pz2.cir, 1e9 per stage)
+ * the eigenvectors span too many decades and the roots are ill-conditioned
+ * as eigenvalues; they are caught by the check above.  The search on the
+ * determinant in cktpzstr.c does not suffer from this and remains the
+ * default.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/pzdefs.h"
+#include "ngspice/smpdefs.h"
+#include "ngspice/complex.h"
+#include "ngspice/sperror.h"
+
+
+#define PZA_TOL      1.0e-10    /* residual of a converged root, relative */
+#define PZA_LINTOL   1.0e-9     /* check of the loads linear in s */
+#define PZA_ZERO     1.0e-10    /* |mu| below this relative to the largest
+                                   one belongs to an infinite root */
+#define PZA_MAXDIM   500        /* limit of the Krylov space */
+#define PZA_INFTY    20.0       /* |mu| up to this times its uncertainty
+                                   belongs to an infinite root */
+#define PZA_RESOLVED 1.0e4      /* |mu| from this times its uncertainty on
+                                   is a finite root */
+
+
+struct st_pzarn {
+    int size;                   /* matrix size */
+    int num_elts;
+    double **elts;              /* matrix elements */
+    int *rows, *cols;
+    double *g, *c;              /* G and C, per element */
+    double *spare;
+};
+
+
+static int pza_matrix(CKTcircuit *ckt, struct st_pzarn *pa);
+static int pza_factor(CKTcircuit *ckt, double sigma);
+static void pza_apply(CKTcircuit *ckt, struct st_pzarn *pa, double *x, double *y);
+static double pza_dot(int n, double *x, double *y);
+static int pza_hqr(double *a, int n, int lda, double *wr, double *wi);
+static double pza_residual(double *h, int m, int ldh, double hnext,
+                           double wr, double wi, double *delta);
+
+
+int
+CKTpzArnoldi(CKTcircuit *ckt, PZtrial **rootinfo, int *rootcount)
+{
+    struct st_pzarn pa;
+    double **v = NULL, *h = NULL, *a = NULL, *wr = NULL, *wi = NULL;
+    int *order = NULL;
+    double sigma = 0.0, gmax = 0.0, cmax = 0.0, mumax, hnext;
+    double shifts[5];
+    int n, i, j, k, m = 0, mmax = 0, mwant, want, found, unresolved, ldh;
+    int invariant, converged, error;
+    unsigned int seed = 12345;
+    PZtrial *list = NULL, *prev = NULL, **last = &list;
+
+    *rootinfo = NULL;
+    *rootcount = 0;
+
+    error = pza_matrix(ckt, &pa);
+    if (error)
+        goto done;
+    n = pa.size;
+
+    for (k = 0; k < pa.num_elts; k++) {
+        gmax = MAX(gmax, fabs(pa.g[k]));
+        cmax = MAX(cmax, fabs(pa.c[k]));
+    }
+
+    if (cmax == 0.0) {
+        /* no capacitances: no finite roots */
+        error = OK;
+        goto done;
+    }
+
+    /* the shift, 0 unless G + sigma C is singular there */
+    shifts[0] = 0.0;
+    shifts[1] = 1.0e-6 * gmax / cmax;
+    shifts[2] = 1.0e-3 * gmax / cmax;
+    shifts[3] = 0.1 * gmax / cmax;
+    shifts[4] = gmax / cmax;
+    error = E_SINGULAR;
+    for (i = 0; i < 5 && error == E_SINGULAR; i++) {
+        if (i > 0 && shifts[i] == 0.0)
+            break;
+        sigma = shifts[i];
+        error = pza_factor(ckt, sigma);
+    }
+    if (error) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "pzarnoldi: no regular shift of the pole-zero matrix found");
+        goto done;
+    }
+
+    want = ckt->CKTpzRoots;
+    mmax = MIN(n, MAX(PZA_MAXDIM, 4 * want));
+    mwant = MIN(mmax, MAX(2 * want + 20, 40));
+    ldh = mmax + 1;
+
+    v = TMALLOC(double *, mmax + 1);
+    h = TMALLOC(double, ldh * mmax);
+    a = TMALLOC(double, (mmax + 1) * (mmax + 1));
+    wr = TMALLOC(double, mmax + 1);
+    wi = TMALLOC(double, mmax + 1);
+    order = TMALLOC(int, mmax + 1);
+
+    /* start vector, pseudo random but the same for every run */
+    v[0] = TMALLOC(double, n + 1);
+    v[1] = TMALLOC(double, n + 1);
+    for (i = 1; i <= n; i++) {
+        seed = seed * 1103515245U + 12345U;
+        v[1][i] = (double) (seed >> 8) / 8388608.0 - 1.0;
+    }
+    pza_apply(ckt, &pa, v[1], v[0]);
+    pza_apply(ckt, &pa, v[0], v[1]);
+    hnext = sqrt(pza_dot(n, v[1], v[1]));
+    if (hnext == 0.0) {
+        error = OK;
+        goto done;
+    }
+    for (i = 1; i <= n; i++)
+        v[0][i] = v[1][i] / hnext;
+
+    m = 0;
+    invariant = 0;
+    found = 0;
+
+    for (;;) {
+
+        /* extend the Arnoldi factorization to mwant columns */
+        for (; m < mwant && !invariant; m++) {
+            double *w, norm;
+
+            if (!v[m + 1])
+                v[m + 1] = TMALLOC(double, n + 1);
+            w = v[m + 1];
+
+            pza_apply(ckt, &pa, v[m], w);
+            norm = sqrt(pza_dot(n, w, w));
+
+            for (j = 0; j <= m + 1; j++)
+                h[j + m * ldh] = 0.0;
+
+            /* modified Gram-Schmidt, twice */
+            for (k = 0; k < 2; k++)
+                for (j = 0; j <= m; j++) {
+                    double hjm = pza_dot(n, v[j], w);
+                    h[j + m * ldh] += hjm;
+                    for (i = 1; i <= n; i++)
+                        w[i] -= hjm * v[j][i];
+                }
+
+            hnext = sqrt(pza_dot(n, w, w));
+            if (hnext <= 1.0e-12 * norm) {
+                invariant = 1;
+                hnext = 0.0;
+            } else {
+                for (i = 1; i <= n; i++)
+                    w[i] /= hnext;
+            }
+            h[m + 1 + m * ldh] = hnext;
+
+            if (SPfrontEnd->IFpauseTest()) {
+                error = E_PAUSE;
+                goto done;
+            }
+        }
+
+        if (m == 0) {
+            error = OK;
+            goto done;
+        }
+
+        /* Ritz values of the Hessenberg matrix */
+        hnext = invariant ? 0.0 : h[m + (m - 1) * ldh];
+        for (j = 1; j <= m; j++)
+            for (i = 1; i <= m; i++)
+                a[i + j * (mmax + 1)] = (i <= j + 1) ? h[(i - 1) + (j - 1) * ldh] : 0.0;
+        error = pza_hqr(a, m, mmax + 1, wr, wi);
+        if (error) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "pzarnoldi: no convergence of the Hessenberg eigenvalues");
+            goto done;
+        }
+
+        /* largest |mu| first */
+        mumax = 0.0;
+        for (i = 1; i <= m; i++) {
+            order[i - 1] = i;
+            mumax = MAX(mumax, hypot(wr[i], wi[i]));
+        }
+        for (i = 1; i < m; i++) {
+            int t = order[i];
+            double r = hypot(wr[t], wi[t]);
+            for (j = i - 1; j >= 0 && hypot(wr[order[j]], wi[order[j]]) < r; j--)
+                order[j + 1] = order[j];
+            order[j + 1] = t;
+        }
+
+        /* the wanted roots, with conjugate pairs counted twice */
+        converged = 1;
+        found = 0;
+        unresolved = 0;
+        for (k = 0; k < m && found < want; k++) {
+            double mu, delta;
+            i = order[k];
+            if (wi[i] < 0.0)
+                continue;
+            mu = hypot(wr[i], wi[i]);
+            if (mu <= PZA_ZERO * mumax)
+                break;
+            if (pza_residual(h, m, ldh, hnext, wr[i], wi[i], &delta) > PZA_TOL * mu) {
+                converged = 0;
+            } else if (mu <= PZA_INFTY * delta) {
+                continue;
+            } else if (mu < PZA_RESOLVED * delta) {
+                unresolved++;
+                continue;
+            }
+            found += (wi[i] > 0.0) ? 2 : 1;
+        }
+
+        if (converged || invariant || m >= mmax)
+            break;
+
+        mwant = MIN(mmax, 2 * m);
+    }
+
+    if (unresolved) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "pzarnoldi: %d roots too ill-conditioned as eigenvalues", unresolved);
+        error = E_SINGULAR;
+        goto done;
+    }
+
+    if (!converged && !invariant)
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "pzarnoldi: not all of %d roots converged in a Krylov space of %d",
+            want, m);
+
+    /* s = sigma - 1/mu, as a list of the converged roots */
+    found = 0;
+    for (k = 0; k < m && found < want; k++) {
+        PZtrial *root;
+        double mr, mi, mag2, delta;
+
+        i = order[k];
+        if (wi[i] < 0.0)
+            continue;
+        if (hypot(wr[i], wi[i]) <= PZA_ZERO * mumax)
+            break;
+        if (pza_residual(h, m, ldh, hnext, wr[i], wi[i], &delta) > PZA_TOL * hypot(wr[i], wi[i]))
+            continue;
+        if (hypot(wr[i], wi[i]) <= PZA_INFTY * delta)
+            continue;
+
+        mr = wr[i];
+        mi = wi[i];
+        mag2 = mr * mr + mi * mi;
+
+        root = TMALLOC(PZtrial, 1);
+        root->s.real = sigma - mr / mag2;
+        root->s.imag = mi / mag2;
+        root->multiplicity = 1;
+        root->seq_num = k + 1;
+        root->prev = prev;
+        prev = root;
+        *last = root;
+        last = &root->next;
+
+        found += (mi > 0.0) ? 2 : 1;
+    }
+
+    *rootinfo = list;
+    *rootcount = found;
+
+    SPfrontEnd->IFerrorf(ERR_INFO,
+        "pzarnoldi: %d roots, Krylov space of %d, shift %g", found, m, sigma);
+
+    error = OK;
+
+done:
+    if (v)
+        for (i = 0; i <= mmax && v[i]; i++)
+            tfree(v[i]);
+    tfree(v);
+    tfree(h);
+    tfree(a);
+    tfree(wr);
+    tfree(wi);
+    tfree(order);
+    tfree(pa.elts);
+    tfree(pa.rows);
+    tfree(pa.cols);
+    tfree(pa.g);
+    tfree(pa.c);
+    tfree(pa.spare);
+
+    return error;
+}
+
+
+/* G and C of the pole-zero matrix, from the loads at s = j and s = 1 */
+static int
+pza_matrix(CKTcircuit *ckt, struct st_pzarn *pa)
+{
+    SPcomplex s;
+    int k, error;
+
+    pa->size = SMPmatSize(ckt->CKTmatrix);
+    pa->elts = NULL;
+    pa->rows = pa->cols = NULL;
+    pa->g = pa->c = NULL;
+    pa->spare = TMALLOC(double, pa->size + 1);
+
+    s.real = 0.0;
+    s.imag = 1.0;
+    error = CKTpzLoad(ckt, &s);
+    if (error)
+        return error;
+
+    pa->num_elts = SMPelementList(ckt->CKTmatrix, &pa->elts, &pa->rows, &pa->cols);
+    pa->g = TMALLOC(double, pa->num_elts);
+    pa->c = TMALLOC(double, pa->num_elts);
+    for (k = 0; k < pa->num_elts; k++) {
+        pa->g[k] = pa->elts[k][0];
+        pa->c[k] = pa->elts[k][1];
+    }
+
+    s.real = 1.0;
+    s.imag = 0.0;
+    error = CKTpzLoad(ckt, &s);
+    if (error)
+        return error;
+
+    for (k = 0; k < pa->num_elts; k++) {
+        double sum = pa->g[k] + pa->c[k];
+        double tol = PZA_LINTOL * (fabs(pa->g[k]) + fabs(pa->c[k]));
+        if (fabs(pa->elts[k][0] - sum) > tol || fabs(pa->elts[k][1]) > tol) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "pzarnoldi: the pole-zero matrix is not linear in s");
+            return E_BADMATRIX;
+        }
+    }
+
+    return OK;
+}
+
+
+/* load G + sigma C and factor it, real */
+static int
+pza_factor(CKTcircuit *ckt, double sigma)
+{
+    SPcomplex s;
+    int error;
+
+    s.real = sigma;
+    s.imag = 0.0;
+    error = CKTpzLoad(ckt, &s);
+    if (error)
+        return error;
+
+    return SMPreorder(ckt->CKTmatrix, ckt->CKTpivotAbsTol,
+                      ckt->CKTpivotRelTol, 0.0);
+}
+
+
+/* y = (G + sigma C)^-1 C x */
+static void
+pza_apply(CKTcircuit *ckt, struct st_pzarn *pa, double *x, double *y)
+{
+    int i, k;
+
+    for (i = 0; i <= pa->size; i++)
+        y[i] = 0.0;
+    for (k = 0; k < pa->num_elts; k++)
+        y[pa->rows[k]] += pa->c[k] * x[pa->cols[k]];
+
+    SMPsolve(ckt->CKTmatrix, y, pa->spare);
+    y[0] = 0.0;
+}
+
+
+static double
+pza_dot(int n, double *x, double *y)
+{
+    double sum = 0.0;
+    int i;
+
+    for (i = 1; i <= n; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+
+/* Eigenvalues of the upper Hessenberg matrix a[1..n][1..n] (stored by
+   columns, leading dimension lda), by the shifted QR algorithm, after
+   EISPACK hqr.  a is destroyed. */
+
+#define A(i,j)  a[(i) + (j) * lda]
+#define SIGN(x,y)  ((y) >= 0.0 ? fabs(x) : -fabs(x))
+
+static int
+pza_hqr(double *a, int n, int lda, double *wr, double *wi)
+{
+    int nn, mm, l, k, j, its, i, mmin;
+    double z = 0.0, y, x, w, v, u, t, s, r = 0.0, q = 0.0, p = 0.0, anorm;
+
+    anorm = 0.0;
+    for (i = 1; i <= n; i++)
+        for (j = MAX(i - 1, 1); j <= n; j++)
+            anorm += fabs(A(i, j));
+
+    nn = n;
+    t = 0.0;
+    while (nn >= 1) {
+        its = 0;
+        do {
+            for (l = nn; l >= 2; l--) {
+                s = fabs(A(l - 1, l - 1)) + fabs(A(l, l));
+                if (s == 0.0)
+                    s = anorm;
+                if (fabs(A(l, l - 1)) + s == s) {
+                    A(l, l - 1) = 0.0;
+                    break;
+                }
+            }
+            x = A(nn, nn);
+            if (l == nn) {
+                wr[nn] = x + t;
+                wi[nn--] = 0.0;
+            } else {
+                y = A(nn - 1, nn - 1);
+                w = A(nn, nn - 1) * A(nn - 1, nn);
+                if (l == nn - 1) {
+                    p = 0.5 * (y - x);
+                    q = p * p + w;
+                    z = sqrt(fabs(q));
+                    x += t;
+                    if (q >= 0.0) {
+                        z = p + SIGN(z, p);
+                        wr[nn - 1] = wr[nn] = x + z;
+                        if (z != 0.0)
+                            wr[nn] = x - w / z;
+                        wi[nn - 1] = wi[nn] = 0.0;
+                    } else {
+                        wr[nn - 1] = wr[nn] = x + p;
+                        wi[nn - 1] = -(wi[nn] = z);
+                    }
+                    nn -= 2;
+                } else {
+                    if (its == 60)
+                        return E_ITERLIM;
+                    if (its == 10 || its == 20) {
+                        /* exceptional shift */
+                        t += x;
+                        for (i = 1; i <= nn; i++)
+                            A(i, i) -= x;
+                        s = fabs(A(nn, nn - 1)) + fabs(A(nn - 1, nn - 2));
+                        y = x = 0.75 * s;
+                        w = -0.4375 * s * s;
+                    }
+                    ++its;
+                    for (mm = nn - 2; mm >= l; mm--) {
+                        z = A(mm, mm);
+                        r = x - z;
+                        s = y - z;
+                        p = (r * s - w) / A(mm + 1, mm) + A(mm, mm + 1);
+                        q = A(mm + 1, mm + 1) - z - r - s;
+                        r = A(mm + 2, mm + 1);
+                        s = fabs(p) + fabs(q) + fabs(r);
+                        p /= s;
+                        q /= s;
+                        r /= s;
+                        if (mm == l)
+                            break;
+                        u = fabs(A(mm, mm - 1)) * (fabs(q) + fabs(r));
+                        v = fabs(p) * (fabs(A(mm - 1, mm - 1)) + fabs(z) + fabs(A(mm + 1, mm + 1)));
+                        if (u + v == v)
+                            break;
+                    }
+                    for (i = mm + 2; i <= nn; i++) {
+                        A(i, i - 2) = 0.0;
+                        if (i != mm + 2)
+                            A(i, i - 3) = 0.0;
+                    }
+                    for (k = mm; k <= nn - 1; k++) {
+                        if (k != mm) {
+                            p = A(k, k - 1);
+                            q = A(k + 1, k - 1);
+                            r = 0.0;
+                            if (k != nn - 1)
+                                r = A(k + 2, k - 1);
+                            if ((x = fabs(p) + fabs(q) + fabs(r)) != 0.0) {
+                                p /= x;
+                                q /= x;
+                                r /= x;
+                            }
+                        }
+                        if ((s = SIGN(sqrt(p * p + q * q + r * r), p)) != 0.0) {
+                            if (k == mm) {
+                                if (l != mm)
+                                    A(k, k - 1) = -A(k, k - 1);
+                            } else {
+                                A(k, k - 1) = -s * x;
+                            }
+                            p += s;
+                            x = p / s;
+                            y = q / s;
+                            z = r / s;
+                            q /= p;
+                            r /= p;
+                            for (j = k; j <= nn; j++) {
+                                p = A(k, j) + q * A(k + 1, j);
+                                if (k != nn - 1) {
+                                    p += r * A(k + 2, j);
+                                    A(k + 2, j) -= p * z;
+                                }
+                                A(k + 1, j) -= p * y;
+                                A(k, j) -= p * x;
+                            }
+                            mmin = nn < k + 3 ? nn : k + 3;
+                            for (i = l; i <= mmin; i++) {
+                                p = x * A(i, k) + y * A(i, k + 1);
+                                if (k != nn - 1) {
+                                    p += z * A(i, k + 2);
+                                    A(i, k + 2) -= p * r;
+                                }
+                                A(i, k + 1) -= p * q;
+                                A(i, k) -= p;
+                            }
+                        }
+                    }
+                }
+            }
+        } while (l < nn - 1);
+    }
+
+    return OK;
+}
+
+#undef A
+#undef SIGN
+
+
+/* Residual |h(m+1,m) y(m)| / |y| of the Ritz pair of (wr, wi), the
+   eigenvector y of the Hessenberg matrix h[0..m-1][0..m-1] by two steps
+   of inverse iteration.  The left eigenvector z is found the same way
+   with the transposed factors, and with the condition number
+   |y| |z| / |z^T y| of the Ritz value *delta is its uncertainty from
+   rounding.  Complex arithmetic on separate real and imaginary parts. */
+static double
+pza_residual(double *h, int m, int ldh, double hnext, double wr, double wi,
+             double *delta)
+{
+    double *ar, *ai, *lr, *li, *yr, *yi, *zr, *zi, hnorm = 0.0, tiny, norm, res;
+    double dotr, doti, ynorm, znorm;
+    int *swap, i, j, k, it;
+
+    ar = TMALLOC(double, m * m);
+    ai = TMALLOC(double, m * m);
+    lr = TMALLOC(double, m);
+    li = TMALLOC(double, m);
+    yr = TMALLOC(double, m);
+    yi = TMALLOC(double, m);
+    zr = TMALLOC(double, m);
+    zi = TMALLOC(double, m);
+    swap = TMALLOC(int, m);
+
+    /* a = h - theta, by rows */
+    for (i = 0; i < m; i++)
+        for (j = 0; j < m; j++) {
+            ar[i * m + j] = (j >= i - 1) ? h[i + j * ldh] : 0.0;
+            ai[i * m + j] = 0.0;
+            hnorm = MAX(hnorm, fabs(ar[i * m + j]));
+        }
+    for (i = 0; i < m; i++) {
+        ar[i * m + i] -= wr;
+        ai[i * m + i] -= wi;
+    }
+    tiny = 1.0e-14 * MAX(hnorm, hypot(wr, wi));
+
+    /* LU with partial pivoting, only the subdiagonal is eliminated */
+    for (k = 0; k < m - 1; k++) {
+        double *pr = ar + k * m, *pi = ai + k * m;
+        double *qr = ar + (k + 1) * m, *qi = ai + (k + 1) * m;
+        double dr, di, d;
+
+        swap[k] = hypot(qr[k], qi[k]) > hypot(pr[k], pi[k]);
+        if (swap[k])
+            for (j = k; j < m; j++) {
+                double t;
+                t = pr[j]; pr[j] = qr[j]; qr[j] = t;
+                t = pi[j]; pi[j] = qi[j]; qi[j] = t;
+            }
+        if (hypot(pr[k], pi[k]) < tiny) {
+            pr[k] = tiny;
+            pi[k] = 0.0;
+        }
+        /* l = q[k] / p[k] */
+        d = pr[k] * pr[k] + pi[k] * pi[k];
+        dr = (qr[k] * pr[k] + qi[k] * pi[k]) / d;
+        di = (qi[k] * pr[k] - qr[k] * pi[k]) / d;
+        lr[k] = dr;
+        li[k] = di;
+        for (j = k + 1; j < m; j++) {
+            qr[j] -= dr * pr[j] - di * pi[j];
+            qi[j] -= dr * pi[j] + di * pr[j];
+        }
+    }
+    if (hypot(ar[m * m - 1], ai[m * m - 1]) < tiny) {
+        ar[m * m - 1] = tiny;
+        ai[m * m - 1] = 0.0;
+    }
+
+    for (i = 0; i < m; i++) {
+        yr[i] = 1.0;
+        yi[i] = 0.0;
+    }
+
+    for (it = 0; it < 2; it++) {
+        /* forward, the row operations of the elimination */
+        for (k = 0; k < m - 1; k++) {
+            if (swap[k]) {
+                double t;
+                t = yr[k]; yr[k] = yr[k + 1]; yr[k + 1] = t;
+                t = yi[k]; yi[k] = yi[k + 1]; yi[k + 1] = t;
+            }
+            yr[k + 1] -= lr[k] * yr[k] - li[k] * yi[k];
+            yi[k + 1] -= lr[k] * yi[k] + li[k] * yr[k];
+        }
+        /* backward, upper triangle */
+        for (i = m - 1; i >= 0; i--) {
+            double sr = yr[i], si = yi[i], d, pr, pi;
+            for (j = i + 1; j < m; j++) {
+                sr -= ar[i * m + j] * yr[j] - ai[i * m + j] * yi[j];
+                si -= ar[i * m + j] * yi[j] + ai[i * m + j] * yr[j];
+            }
+            pr = ar[i * m + i];
+            pi = ai[i * m + i];
+            d = pr * pr + pi * pi;
+            yr[i] = (sr * pr + si * pi) / d;
+            yi[i] = (si * pr - sr * pi) / d;
+        }
+        norm = 0.0;
+        for (i = 0; i < m; i++)
+            norm = MAX(norm, hypot(yr[i], yi[i]));
+        for (i = 0; i < m; i++) {
+            yr[i] /= norm;
+            yi[i] /= norm;
+        }
+    }
+
+    /* the left eigenvector, a^T z = 0 with a = E^-1 U, E the row
+       operations: U^T w = z, then z = E^T w */
+    for (i = 0; i < m; i++) {
+        zr[i] = 1.0;
+        zi[i] = 0.0;
+    }
+
+    for (it = 0; it < 2; it++) {
+        /* forward, lower triangle U^T */
+        for (i = 0; i < m; i++) {
+            double sr = zr[i], si = zi[i], d, pr, pi;
+            for (j = 0; j < i; j++) {
+                sr -= ar[j * m + i] * zr[j] - ai[j * m + i] * zi[j];
+                si -= ar[j * m + i] * zi[j] + ai[j * m + i] * zr[j];
+            }
+            pr = ar[i * m + i];
+            pi = ai[i * m + i];
+            d = pr * pr + pi * pi;
+            zr[i] = (sr * pr + si * pi) / d;
+            zi[i] = (si * pr - sr * pi) / d;
+        }
+        /* backward, the transposed row operations */
+        for (k = m - 2; k >= 0; k--) {
+            zr[k] -= lr[k] * zr[k + 1] - li[k] * zi[k + 1];
+            zi[k] -= lr[k] * zi[k + 1] + li[k] * zr[k + 1];
+            if (swap[k]) {
+                double t;
+                t = zr[k]; zr[k] = zr[k + 1]; zr[k + 1] = t;
+                t = zi[k]; zi[k] = zi[k + 1]; zi[k + 1] = t;
+            }
+        }
+        norm = 0.0;
+        for (i = 0; i < m; i++)
+            norm = MAX(norm, hypot(zr[i], zi[i]));
+        for (i = 0; i < m; i++) {
+            zr[i] /= norm;
+            zi[i] /= norm;
+        }
+    }
+
+    ynorm = znorm = dotr = doti = 0.0;
+    for (i = 0; i < m; i++) {
+        ynorm += yr[i] * yr[i] + yi[i] * yi[i];
+        znorm += zr[i] * zr[i] + zi[i] * zi[i];
+        dotr += zr[i] * yr[i] - zi[i] * yi[i];
+        doti += zr[i] * yi[i] + zi[i] * yr[i];
+    }
+    ynorm = sqrt(ynorm);
+    znorm = sqrt(znorm);
+    norm = hypot(dotr, doti);
+    *delta = (norm > 0.0) ? ynorm * znorm / norm * DBL_EPSILON * hnorm : HUGE_VAL;
+
+    res = fabs(hnext) * hypot(yr[m - 1], yi[m - 1]) / ynorm;
+
+    tfree(ar);
+    tfree(ai);
+    tfree(lr);
+    tfree(li);
+    tfree(yr);
+    tfree(yi);
+    tfree(zr);
+    tfree(zi);
+    tfree(swap);
+
+    return res;
+}
@@ -14,15 +14,7 @@ Modified: 2000 AlanFixes
 #include "ngspice/smpdefs.h"
 #include "ngspice/sensdefs.h"
 #include "ngspice/sensgen.h"
-
-/* #define ASDEBUG */
-#ifdef ASDEBUG
-#define DEBUG(X)	if ((X) < Sens_Debug)
-int Sens_Debug = 0;
-char SF1[] = "res";
-char SF2[] = "dc";
-char SF3[] = "bf";
-#endif
+#include "ngspice/trandefs.h"
 
 char *Sfilter = NULL;
 double Sens_Delta = 0.000001;
@@ -33,6 +25,8 @@ static int sens_load(sgen *sg, CKTcircuit *ckt, int is_dc);
 static int sens_temp(sgen *sg, CKTcircuit *ckt);
 static int count_steps(int type, double low, double high, int steps, double *stepsize);
 static double inc_freq(double freq, int type, double step_size);
+static IFuid *sens_names(CKTcircuit *ckt, int is_dc, int *num_vars);
+static int sens_tran(CKTcircuit *ckt, SENS_AN *job);
 
 #define save_context(thing, place) {	    \
     place = thing;			    \
@@ -52,11 +46,21 @@ static double inc_freq(double freq, int type, double step_size);
  *
  *		For each frequency point:
  *			(for AC) call NIacIter to get base node voltages
+ *			Solve the adjoint system for the output:
+ *				lambda = Y^-T c
  *			For each element/parameter in the test list:
  *				construct the perturbation matrix
- *				Solve for the sensitivities:
- *					delta_E = Y^-1 (delta_Y E - delta_I)
+ *				The sensitivity of the output c^T E is
+ *					c^T delta_E = lambda^T (delta_I - delta_Y E)
  *				save results
+ *
+ *	The adjoint solve makes the cost of each parameter a matrix-vector
+ *	product of its own (small) perturbation matrix and a dot product,
+ *	instead of a forward and backward substitution with Y.
+ *	Only the solve count is reduced: the devices provide no derivative
+ *	stamps, so each parameter still costs two loads of its instance
+ *	(sens_load before and after the perturbation) to build delta_Y
+ *	and delta_I by finite difference.
  */
 
 static int	error;
@@ -66,7 +70,8 @@ int sens_sens(CKTcircuit *ckt, int restart)
 
 	static int	size;
 	static double	*delta_I, *delta_iI,
-			*delta_I_delta_Y, *delta_iI_delta_Y;
+			*delta_I_delta_Y, *delta_iI_delta_Y,
+			*lambda, *ilambda;
 	sgen		*sg;
 	static double	freq;
 	static int	nfreqs;
@@ -78,12 +83,12 @@ int sens_sens(CKTcircuit *ckt, int restart)
 	double		*output_values;
 	IFcomplex	*output_cvalues;
 	double		delta_var;
+	double		sens_re, sens_im;
 	int             (*fn) (SMPmatrix *, GENmodel *, CKTcircuit *, int *);
 	static int	is_dc;
-	int		k, j, n;
+	int		j, n;
 	int		num_vars, branch_eq=0;
 	runDesc		*sen_data = NULL;
-	char		namebuf[513];
 	IFuid		*output_names, freq_name;
 	int		bypass;
 	int		type;
@@ -108,10 +113,9 @@ int sens_sens(CKTcircuit *ckt, int restart)
 				sg->ptable[sg->param].keyword);
 	}
 #endif
-#ifdef ASDEBUG
-	DEBUG(1)
-		printf(">>> restart : %d\n", restart);
-#endif
+
+	if (job->step_type == SENS_TRAN)
+		return sens_tran(ckt, job);
 
 	/* get to work */
 
@@ -155,36 +159,15 @@ int sens_sens(CKTcircuit *ckt, int restart)
 		delta_I_delta_Y = TMALLOC(double, size);
 		delta_iI_delta_Y = TMALLOC(double, size);
 
+		/* and the adjoint solution */
+		lambda = TMALLOC(double, size);
+		ilambda = TMALLOC(double, size);
 
-		num_vars = 0;
-		for (sg = sgen_init(ckt, is_dc); sg; sgen_next(&sg)) {
-			num_vars += 1;
-		}
 
+		output_names = sens_names(ckt, is_dc, &num_vars);
 		if (!num_vars)
 			return OK;	/* XXXX Should be E_ something */
 
-		k = 0;
-		output_names = TMALLOC(IFuid, num_vars);
-		for (sg = sgen_init(ckt, is_dc); sg; sgen_next(&sg)) {
-			if (!sg->is_instparam) {
-				sprintf(namebuf, "%s:%s",
-					sg->instance->GENname,
-					sg->ptable[sg->param].keyword);
-			} else if ((sg->ptable[sg->param].dataType
-				& IF_PRINCIPAL) && sg->is_principle == 1)
-			{
-				sprintf(namebuf, "%s", sg->instance->GENname);
-			} else {
-				sprintf(namebuf, "%s_%s",
-					sg->instance->GENname,
-					sg->ptable[sg->param].keyword);
-			}
-
-			SPfrontEnd->IFnewUid (ckt, output_names + k, NULL, namebuf, UID_OTHER, NULL);
-			k += 1;
-		}
-
 		if (is_dc) {
 			type = IF_REAL;
 			freq_name = NULL;
@@ -221,11 +204,6 @@ int sens_sens(CKTcircuit *ckt, int restart)
 		controlled_exit(1);
 	}
 
-#ifdef ASDEBUG
-	DEBUG(1)
-		printf("start: %f, num: %d, dc: %d\n", freq, nfreqs, is_dc);
-#endif
-
 	if (!job->output_volt)
 		branch_eq = CKTfndBranch(ckt, job->output_src);
 	bypass = ckt->CKTbypass;
@@ -238,14 +216,6 @@ int sens_sens(CKTcircuit *ckt, int restart)
 	iE = ckt->CKTirhs;
 	Y = ckt->CKTmatrix;
 
-#ifdef ASDEBUG
-	DEBUG(1) {
-		printf("Operating point:\n");
-		for (i = 0; i < size; i++)
-			printf("          E [%d] = %20.15g\n", i, E[i]);
-	}
-#endif
-
 #ifdef notdef
 	for (j = 0; j <= ckt->CKTmaxOrder + 1; j++) {
 		save_states[j] = ckt->CKTstates[j];
@@ -314,6 +284,22 @@ int sens_sens(CKTcircuit *ckt, int restart)
 			Y = ckt->CKTmatrix;
 		}
 
+		/* Solve the adjoint system Y^T lambda = c,
+		 * c selecting the output from the solution vector */
+		for (j = 0; j < size; j++) {
+			lambda[j] = 0.0;
+			ilambda[j] = 0.0;
+		}
+		if (job->output_volt) {
+			lambda[job->output_pos->number] += 1.0;
+			lambda[job->output_neg->number] -= 1.0;
+		} else {
+			lambda[branch_eq] = 1.0;
+		}
+		SMPcaSolve(Y, lambda, ilambda, NULL, NULL);
+		lambda[0] = 0.0;
+		ilambda[0] = 0.0;
+
 		/* Use a different vector & matrix */
 
 		save_context(ckt->CKTrhs, saved_rhs);
@@ -329,28 +315,6 @@ int sens_sens(CKTcircuit *ckt, int restart)
 			sg; sgen_next(&sg))
 		{
 
-#ifdef ASDEBUG
-			DEBUG(2) {
-				printf("E/iE: %x/%x; delta_I/iI: %x/%x\n",
-					E, iE, delta_I, delta_iI);
-				printf("cktrhs/irhs: %x/%x\n",
-					ckt->CKTrhs, ckt->CKTirhs);
-
-				if (sg->is_instparam)
-					printf("%s:%s:%s -> param %s\n",
-					DEVices[sg->dev]->DEVpublic.name,
-						sg->model->GENmodName,
-						sg->instance->GENname,
-						sg->ptable[sg->param].keyword);
-				else
-					printf("%s:%s:%s -> mparam %s\n",
-					DEVices[sg->dev]->DEVpublic.name,
-						sg->model->GENmodName,
-						sg->instance->GENname,
-						sg->ptable[sg->param].keyword);
-			}
-#endif
-
 			SMPcClear(delta_Y);
 
 			for (j = 0; j < size; j++) {
@@ -392,21 +356,6 @@ int sens_sens(CKTcircuit *ckt, int restart)
 
 			/* Alter the parameter */
 
-#ifdef ASDEBUG
-			DEBUG(1) printf("Original value: %g\n", sg->value);
-#endif
-
-#ifdef ASDEBUG
-			DEBUG(2) {
-				printf("Effect of device:\n");
-				SMPprint(delta_Y, NULL);
-				printf("LHS:\n");
-				for (j = 0; j < size; j++)
-					printf("%d: %g, %g\n", j,
-						delta_I[j], delta_iI[j]);
-			}
-#endif
-
 			if (sg->value != 0.0)
 				delta_var = sg->value * Sens_Delta;
 			else
@@ -414,11 +363,6 @@ int sens_sens(CKTcircuit *ckt, int restart)
 
 			nvalue.rValue = sg->value + delta_var;
 
-#ifdef ASDEBUG
-			DEBUG(1)
-				printf("New value: %g\n", nvalue.rValue);
-#endif
-
 			sens_setp(sg, ckt, &nvalue);
 			if (error && error != E_BADPARM)
 				return error;
@@ -429,41 +373,11 @@ int sens_sens(CKTcircuit *ckt, int restart)
 				delta_iI[j] *= -1.0;
 			}
 
-#ifdef ASDEBUG
-			DEBUG(2) {
-				printf("Effect of negating matrix:\n");
-				SMPprint(delta_Y, NULL);
-				for (j = 0; j < size; j++)
-					printf("%d: %g, %g\n", j,
-						delta_I[j], delta_iI[j]);
-			}
-#endif
-
 			/* XXX swap back to temp states ??   Naw ... */
 			(void) sens_temp(sg, ckt);
 
-#ifdef ASDEBUG
-			DEBUG(1) {
-				if (sens_getp(sg, ckt, &value)) {
-					continue;
-				}
-
-				printf("New value in device: %g\n",
-					value.rValue);
-			}
-#endif
-
 			sens_load(sg, ckt, is_dc);
 
-#ifdef ASDEBUG
-			DEBUG(2) {
-				printf("Effect of changing the parameter:\n");
-				SMPprint(delta_Y, NULL);
-				for (j = 0; j < size; j++)
-					printf("%d: %g, %g\n", j,
-						delta_I[j], delta_iI[j]);
-			}
-#endif
 			/* Set the perturbed variable back to it's
 			 * original value
 			 */
@@ -474,98 +388,32 @@ int sens_sens(CKTcircuit *ckt, int restart)
 
 			/* Back to business . . . */
 
-#ifdef ASDEBUG
-			DEBUG(2)
-				for (j = 0; j < size; j++)
-					printf("          E [%d] = %20.15g\n",
-						j, E[j]);
-#endif
-
 			/* delta_Y E */
 			SMPmultiply(delta_Y, delta_I_delta_Y, E,
 				    delta_iI_delta_Y, iE);
 
-#ifdef ASDEBUG
-			DEBUG(2)
-				for (j = 0; j < size; j++)
-					printf("delta_Y * E [%d] = %20.15g\n",
-						j, delta_I_delta_Y[j]);
-#endif
-
 			/* delta_I - delta_Y E */
 			for (j = 0; j < size; j++) {
 				delta_I[j] -= delta_I_delta_Y[j];
 				delta_iI[j] -= delta_iI_delta_Y[j];
 			}
 
-#ifdef ASDEBUG
-			DEBUG(2) {
-				printf(">>> Y:\n");
-				SMPprint(Y, NULL);
-				for (j = 0; j < size; j++)
-					printf("%d: %g, %g\n", j,
-						delta_I[j], delta_iI[j]);
+			/* lambda^T (delta_I - delta_Y E), the `0' node
+			 * being implicit === 0 */
+			sens_re = 0.0;
+			sens_im = 0.0;
+			for (j = 1; j < size; j++) {
+				sens_re += lambda[j] * delta_I[j]
+					- ilambda[j] * delta_iI[j];
+				sens_im += lambda[j] * delta_iI[j]
+					+ ilambda[j] * delta_I[j];
 			}
-#endif
-			/* Solve; Y already factored */
-			SMPcSolve(Y, delta_I, delta_iI, NULL, NULL);
-
-                        /* the special `0' node
-                        *    the matrix indizes are [1..n]
-                        *    yet the vector indizes are [0..n]
-                        *    with [0] being implicit === 0
-                        */
-                        delta_I[0]  = 0.0;
-                        delta_iI[0] = 0.0;
-
-#ifdef ASDEBUG
-			DEBUG(2) {
-				for (j = 1; j < size; j++) {
-
-					if (sg->is_instparam)
-						printf("%d/%s.%s = %g, %g\n",
-							j,
-							sg->instance->GENname,
-						sg->ptable[sg->param].keyword,
-						delta_I[j], delta_iI[j]);
-					else
-						printf("%d/%s:%s = %g, %g\n",
-							j,
-							sg->instance->GENname,
-						sg->ptable[sg->param].keyword,
-						delta_I[j], delta_iI[j]);
-
-				}
-			}
-#endif
-
-			/* delta_I is now equal to delta_E */
 
 			if (is_dc) {
-				if (job->output_volt)
-					output_values[n] =
-					    delta_I [job->output_pos->number]
-					    - delta_I [job->output_neg->number];
-				else {
-					output_values[n] = delta_I[branch_eq];
-				}
-				output_values[n] /= delta_var;
+				output_values[n] = sens_re / delta_var;
 			} else {
-				if (job->output_volt) {
-					output_cvalues[n].real =
-					    delta_I [job->output_pos->number]
-					    - delta_I [job->output_neg->number];
-					output_cvalues[n].imag =
-					    delta_iI [job->output_pos->number]
-					    - delta_iI [job->output_neg->number];
-				} else {
-					output_cvalues[n].real =
-						delta_I[branch_eq];
-					output_cvalues[n].imag =
-						delta_iI[branch_eq];
-				}
-				output_cvalues[n].real /= delta_var;
-				output_cvalues[n].imag /= delta_var;
+				output_cvalues[n].real = sens_re / delta_var;
+				output_cvalues[n].imag = sens_im / delta_var;
 			}
 
 			n += 1;
@@ -608,6 +456,9 @@ int sens_sens(CKTcircuit *ckt, int restart)
 	FREE(delta_I_delta_Y);
 	FREE(delta_iI_delta_Y);
 
+	FREE(lambda);
+	FREE(ilambda);
+
 	ckt->CKTbypass = bypass;
 
 #ifdef notdef
@@ -622,6 +473,523 @@ int sens_sens(CKTcircuit *ckt, int restart)
 	return OK;
 }
 
+/* Output names of the sensitivity plot, one per parameter */
+static IFuid *
+sens_names(CKTcircuit *ckt, int is_dc, int *num_vars)
+{
+	sgen	*sg;
+	IFuid	*output_names;
+	char	namebuf[513];
+	int	k;
+
+	*num_vars = 0;
+	for (sg = sgen_init(ckt, is_dc); sg; sgen_next(&sg)) {
+		*num_vars += 1;
+	}
+
+	k = 0;
+	output_names = TMALLOC(IFuid, *num_vars);
+	for (sg = sgen_init(ckt, is_dc); sg; sgen_next(&sg)) {
+		if (!sg->is_instparam) {
+			sprintf(namebuf, "%s:%s",
+				sg->instance->GENname,
+				sg->ptable[sg->param].keyword);
+		} else if ((sg->ptable[sg->param].dataType
+			& IF_PRINCIPAL) && sg->is_principle == 1)
+		{
+			sprintf(namebuf, "%s", sg->instance->GENname);
+		} else {
+			sprintf(namebuf, "%s_%s",
+				sg->instance->GENname,
+				sg->ptable[sg->param].keyword);
+		}
+
+		SPfrontEnd->IFnewUid (ckt, output_names + k, NULL, namebuf, UID_OTHER, NULL);
+		k += 1;
+	}
+
+	return output_names;
+}
+
+
+/*
+ *	Transient sensitivity, adjoint method
+ *
+ *	The forward transient is run by DCtran(), which records the
+ *	solution x_n, the states and the integration formula of every
+ *	accepted timepoint t_n (sens_trace()).  The formula of NIintegrate()
+ *	for the charge derivative is written as
+ *
+ *		qdot_n = sum_i a_n[i] q_{n-i} - b_n qdot_{n-1}
+ *
+ *	a_n = ag for gear and for the first order trapezoidal rule, while
+ *	the second order one has a_n = (ag0, -ag0) and b_n = ag1.  The
+ *	circuit equations at t_n are then
+ *
+ *		F_n = f(x_n) + qdot_n = 0
+ *
+ *	with F_0 = f(x_0) the operating point.  The output is
+ *	g = c^T x_N at the final time.  The adjoint of this discrete
+ *	system is integrated backward from t_N:
+ *
+ *		xi_n = lambda_n - b_{n+1} xi_{n+1}
+ *		rho_n = sum_i a_{n+i}[i] xi_{n+i}
+ *		J_n^T lambda_n = (c at n = N) - C_n^T r_n
+ *		r_n = rho_n - a_n[0] xi_n evaluated before lambda_n is known
+ *
+ *	J_n = G_n + a_n[0] C_n is the matrix of the forward step, C_n the
+ *	derivative of the charges.  C_n^T r_n is the difference of two loads
+ *	with ag0 = a_n[0] and another value, the loads being linear in ag0.
+ *
+ *	Then  dg/dp = -sum_n lambda_n^T df_n/dp + rho_n^T dq_n/dp.  As in the
+ *	DC analysis, the derivatives are the difference of two loads of the
+ *	device alone with the original and the perturbed parameter; with
+ *	ag0 = 0 it gives df/dp, with ag0 = 1 df/dp + dq/dp.  So every
+ *	parameter costs a few loads of its own device per timepoint, but no
+ *	solve.
+ *
+ *	The result is the derivative of the discrete solution the forward
+ *	transient has computed, it agrees with finite differences of it as
+ *	long as the timestep control takes the same steps.
+ *
+ *	The LU factors of the forward run are not kept: the last one of each
+ *	timepoint belongs to the previous newton iterate, for a diode a few
+ *	millivolts off x_n and with it percents off in the conductance.  J_n
+ *	is loaded again at x_n and factored with the pivot order and fill-ins
+ *	of the forward run, reordering only if that fails.
+ */
+
+int
+sens_trace(CKTcircuit *ckt, int order)
+{
+	SENtrace	*tr = ckt->CKTsenTrace;
+	int		n = tr->num_points;
+	double		*coef;
+	int		i;
+
+	if (n == 0) {
+		tr->size = SMPmatSize(ckt->CKTmatrix) + 1;
+		tr->num_states = ckt->CKTnumStates;
+	}
+
+	/* a timepoint accepted again replaces the former one */
+	if (n > 0 && ckt->CKTtime <= tr->time[n - 1]) {
+		n -= 1;
+	} else {
+		if (n >= tr->max_points) {
+			tr->max_points = MAX(2 * tr->max_points, 64);
+			tr->time = TREALLOC(double, tr->time, tr->max_points);
+			tr->sol = TREALLOC(double *, tr->sol, tr->max_points);
+			tr->states = TREALLOC(double *, tr->states, tr->max_points);
+			tr->order = TREALLOC(int, tr->order, tr->max_points);
+			tr->coef = TREALLOC(double, tr->coef,
+					    SEN_NCOEF * tr->max_points);
+		}
+		tr->sol[n] = TMALLOC(double, tr->size);
+		tr->states[n] = TMALLOC(double, tr->num_states);
+	}
+
+	tr->time[n] = ckt->CKTtime;
+	memcpy(tr->sol[n], ckt->CKTrhsOld, (size_t) tr->size * sizeof(double));
+	memcpy(tr->states[n], ckt->CKTstate0,
+	       (size_t) tr->num_states * sizeof(double));
+
+	/* a_n[0..order] and b_n last, CKTag is still the one of the step,
+	 * the operating point has no charge derivative */
+	coef = tr->coef + SEN_NCOEF * n;
+	for (i = 0; i < SEN_NCOEF; i++)
+		coef[i] = 0.0;
+	if (n == 0) {
+		order = 0;
+	} else if (ckt->CKTintegrateMethod == TRAPEZOIDAL && order == 2) {
+		coef[0] = ckt->CKTag[0];
+		coef[1] = -ckt->CKTag[0];
+		coef[SEN_NCOEF - 1] = ckt->CKTag[1];
+	} else {
+		for (i = 0; i <= order; i++)
+			coef[i] = ckt->CKTag[i];
+	}
+	tr->order[n] = order;
+
+	tr->num_points = n + 1;
+
+	return OK;
+}
+
+
+static void
+sens_trace_free(SENtrace *tr)
+{
+	int	n;
+
+	for (n = 0; n < tr->num_points; n++) {
+		FREE(tr->sol[n]);
+		FREE(tr->states[n]);
+	}
+	FREE(tr->time);
+	FREE(tr->sol);
+	FREE(tr->states);
+	FREE(tr->order);
+	FREE(tr->coef);
+	tr->num_points = tr->max_points = 0;
+}
+
+
+/* Timestep leading to t_n, the operating point borrows the first one */
+static double
+sens_tran_step(SENtrace *tr, int n)
+{
+	if (n == 0)
+		n = 1;
+	return tr->time[n] - tr->time[n - 1];
+}
+
+
+/* Put the circuit back at timepoint n, with the integration
+ * coefficient ag0 = ag and a first order formula.  ag1 is zeroed, which
+ * drops the charges of t_{n-1} from the loads: their matrix does not
+ * depend on it, and the parameter derivatives must not see it, the
+ * devices applying some parameters (m, ...) to the integrated charge as
+ * a whole. */
+static void
+sens_tran_point(CKTcircuit *ckt, SENtrace *tr, int n, double *state0,
+		double ag)
+{
+	ckt->CKTrhsOld = tr->sol[n];
+	ckt->CKTstate0 = state0;
+	ckt->CKTstate1 = tr->states[n > 0 ? n - 1 : 0];
+	ckt->CKTtime = tr->time[n];
+	ckt->CKTdelta = ckt->CKTdeltaOld[0] = sens_tran_step(tr, n);
+	ckt->CKTag[0] = ag;
+	ckt->CKTag[1] = 0.0;
+	ckt->CKTorder = 1;
+	ckt->CKTmode = MODETRAN | MODEINITFLOAT;
+}
+
+
+/* sum_n (lambda_n - rho_n)^T T_n(0) + rho_n^T T_n(1),
+ * T = delta_I - delta_Y x_n being the contribution of the device of sg
+ * alone at timepoint n.  delta_Y is created complex, zero and scratch
+ * are its imaginary parts. */
+static int
+sens_tran_sum(sgen *sg, CKTcircuit *ckt, SENtrace *tr, double **lambda,
+	      double **rho, SMPmatrix *delta_Y, double *delta_I,
+	      double *delta_I_delta_Y, double *zero, double *scratch,
+	      double *state0, int first_state, int num_states, double *sum)
+{
+	int	n, j, pass;
+	int	size = tr->size;
+
+	*sum = 0.0;
+
+	for (n = 0; n < tr->num_points; n++) {
+		for (pass = 0; pass < 2; pass++) {
+
+			memcpy(state0 + first_state, tr->states[n] + first_state,
+			       (size_t) num_states * sizeof(double));
+			sens_tran_point(ckt, tr, n, state0, pass ? 1.0 : 0.0);
+
+			SMPclear(delta_Y);
+			for (j = 0; j < size; j++)
+				delta_I[j] = 0.0;
+
+			if (sens_load(sg, ckt, 1))
+				return error ? error : E_BADPARM;
+
+			SMPmultiply(delta_Y, delta_I_delta_Y, tr->sol[n],
+				    scratch, zero);
+
+			for (j = 1; j < size; j++) {
+				double w = pass ? rho[n][j]
+					: lambda[n][j] - rho[n][j];
+				*sum += w * (delta_I[j] - delta_I_delta_Y[j]);
+			}
+		}
+	}
+
+	return OK;
+}
+
+
+static int
+sens_tran(CKTcircuit *ckt, SENS_AN *job)
+{
+	JOB		*sens_job = ckt->CKTcurJob;
+	TRANan		tran;
+	SENtrace	trace;
+	sgen		*sg;
+	SMPmatrix	*Y = ckt->CKTmatrix, *delta_Y = NULL;
+	double		*save_rhs, *save_rhsOld, *save_state0, *save_state1;
+	double		**lambda = NULL, **rho = NULL;
+	double		*xi = NULL, *v = NULL, *w = NULL, *state0 = NULL,
+			*delta_I = NULL, *delta_I_delta_Y = NULL;
+	double		*output_values = NULL;
+	double		delta_var, sum0, sum1;
+	IFvalue		value, nvalue;
+	IFuid		*output_names;
+	runDesc		*sen_data = NULL;
+	int		num_vars, branch_eq = 0;
+	int		bypass = ckt->CKTbypass;
+	int		order = ckt->CKTorder;
+	int		size, last, first_state;
+	int		n, i, j, k;
+
+	if (job->tran_stop <= 0.0 || job->tran_step <= 0.0) {
+		SPfrontEnd->IFerrorf (ERR_WARNING,
+			"transient sensitivity needs tstep and tstop > 0");
+		return E_PARMVAL;
+	}
+
+	if (!job->output_volt)
+		branch_eq = CKTfndBranch(ckt, job->output_src);
+
+	/* The forward transient, recording its accepted timepoints */
+	memset(&tran, 0, sizeof(tran));
+	tran.JOBtype = ft_find_analysis("TRAN");
+	tran.JOBname = "Transient Analysis";
+	tran.TRANfinalTime = job->tran_stop;
+	tran.TRANstep = job->tran_step;
+	tran.TRANmode = MODETRAN;
+
+	memset(&trace, 0, sizeof(trace));
+
+	ckt->CKTcurJob = (JOB *) &tran;
+	error = TRANinit(ckt, ckt->CKTcurJob);
+	if (!error) {
+		ckt->CKTsenTrace = &trace;
+		error = DCtran(ckt, 1);
+		ckt->CKTsenTrace = NULL;
+	}
+	ckt->CKTcurJob = sens_job;
+	if (error) {
+		sens_trace_free(&trace);
+		return error;
+	}
+
+	if (trace.num_points < 2) {
+		sens_trace_free(&trace);
+		return E_PARMVAL;
+	}
+
+	/* DCtran() rotates these, save them as it left them */
+	save_rhs = ckt->CKTrhs;
+	save_rhsOld = ckt->CKTrhsOld;
+	save_state0 = ckt->CKTstate0;
+	save_state1 = ckt->CKTstate1;
+
+	size = trace.size;
+	last = trace.num_points - 1;
+
+	lambda = TMALLOC(double *, trace.num_points);
+	rho = TMALLOC(double *, trace.num_points);
+	for (n = 0; n <= last; n++) {
+		lambda[n] = TMALLOC(double, size);
+		rho[n] = TMALLOC(double, size);
+	}
+	xi = TMALLOC(double, size);
+	v = TMALLOC(double, size);
+	w = TMALLOC(double, size);
+	delta_I = TMALLOC(double, size);
+	delta_I_delta_Y = TMALLOC(double, size);
+	state0 = TMALLOC(double, trace.num_states);
+
+	ckt->CKTbypass = 0;
+
+	/* Integrate the adjoint system backward, xi holds xi_{n+1} and
+	 * rho[n] collects the a_m[m-n] xi_m of the timepoints m > n */
+	for (n = last; n >= 0; n--) {
+		double	*coef = trace.coef + SEN_NCOEF * n;
+		double	a0 = coef[0];
+		double	alpha = a0 != 0.0 ? 0.0 : 1.0;
+		double	b1 = n < last ? trace.coef[SEN_NCOEF * (n + 1)
+						   + SEN_NCOEF - 1] : 0.0;
+
+		if (SPfrontEnd->IFpauseTest()) {
+			error = E_PAUSE;
+			goto done;
+		}
+
+		memcpy(state0, trace.states[n],
+		       (size_t) trace.num_states * sizeof(double));
+
+		/* r_n, then C_n^T r_n from the loads with ag0 = alpha and
+		 * a_n[0], the one of J_n comes last */
+		for (j = 0; j < size; j++)
+			w[j] = rho[n][j] - a0 * b1 * xi[j];
+
+		if (n < last) {
+			sens_tran_point(ckt, &trace, n, state0, alpha);
+			error = CKTload(ckt);
+			if (error)
+				goto done;
+			SMPmultTransposed(Y, v, w, NULL, NULL);
+		}
+
+		sens_tran_point(ckt, &trace, n, state0, a0);
+		error = CKTload(ckt);
+		if (error)
+			goto done;
+
+		if (n < last) {
+			SMPmultTransposed(Y, lambda[n], w, NULL, NULL);
+			for (j = 0; j < size; j++)
+				lambda[n][j] = (v[j] - lambda[n][j])
+					/ (a0 - alpha);
+		} else {
+			for (j = 0; j < size; j++)
+				lambda[n][j] = 0.0;
+			if (job->output_volt) {
+				lambda[n][job->output_pos->number] += 1.0;
+				lambda[n][job->output_neg->number] -= 1.0;
+			} else {
+				lambda[n][branch_eq] = 1.0;
+			}
+		}
+
+		error = SMPluFac(Y, ckt->CKTpivotAbsTol, ckt->CKTdiagGmin);
+		if (error == E_SINGULAR)
+			error = SMPreorder(Y, ckt->CKTpivotAbsTol,
+					   ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
+		if (error)
+			goto done;
+
+		SMPaSolve(Y, lambda[n], NULL);
+		lambda[n][0] = 0.0;
+
+		/* xi_n, and its share of rho of the timepoints it used */
+		for (j = 0; j < size; j++)
+			xi[j] = lambda[n][j] - b1 * xi[j];
+		for (i = 0; i <= trace.order[n] && i <= n; i++)
+			for (j = 0; j < size; j++)
+				rho[n - i][j] += coef[i] * xi[j];
+	}
+
+	/* The sensitivity plot, one point at the final time */
+	output_names = sens_names(ckt, 0, &num_vars);
+	error = SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
+					   ckt->CKTcurJob->JOBname,
+					   NULL, IF_REAL,
+					   num_vars, output_names, IF_REAL,
+					   &sen_data);
+	FREE(output_names);
+	if (error)
+		goto done;
+
+	output_values = TMALLOC(double, num_vars);
+
+	/* calc. effect of each param, v and w now serve as the imaginary
+	 * parts of the products with delta_Y */
+	ckt->CKTrhs = delta_I;
+	for (j = 0; j < size; j++)
+		v[j] = 0.0;
+
+	k = 0;
+	for (sg = sgen_init(ckt, 0); sg; sgen_next(&sg)) {
+		int	(*fn) (SMPmatrix *, GENmodel *, CKTcircuit *, int *);
+
+		output_values[k] = 0.0;
+
+		error = SMPnewMatrix(&delta_Y, size - 1);
+		if (error)
+			goto done;
+		ckt->CKTmatrix = delta_Y;
+
+		ckt->CKTnumStates = sg->istate;
+		fn = DEVices[sg->dev]->DEVsetup;
+		if (fn) {
+			CKTnode *node = ckt->CKTlastNode;
+			fn (delta_Y, sg->model, ckt, &ckt->CKTnumStates);
+			if (node != ckt->CKTlastNode) {
+				fprintf(stderr, "Internal Error: node allocation in DEVsetup() during sensitivity analysis, this will cause serious troubles !, please report this issue !\n");
+				controlled_exit(EXIT_FAILURE);
+			}
+		}
+		first_state = sg->istate;
+
+		(void) sens_temp(sg, ckt);
+
+		error = sens_tran_sum(sg, ckt, &trace, lambda, rho, delta_Y,
+				      delta_I, delta_I_delta_Y, v, w, state0,
+				      first_state, ckt->CKTnumStates - first_state,
+				      &sum0);
+
+		if (!error) {
+			if (sg->value != 0.0)
+				delta_var = sg->value * Sens_Delta;
+			else
+				delta_var = Sens_Abs_Delta;
+
+			nvalue.rValue = sg->value + delta_var;
+			sens_setp(sg, ckt, &nvalue);
+			(void) sens_temp(sg, ckt);
+
+			error = sens_tran_sum(sg, ckt, &trace, lambda, rho,
+					      delta_Y, delta_I, delta_I_delta_Y,
+					      v, w, state0, first_state,
+					      ckt->CKTnumStates - first_state,
+					      &sum1);
+
+			/* Set the perturbed variable back to it's
+			 * original value
+			 */
+			value.rValue = sg->value;
+			sens_setp(sg, ckt, &value);
+			(void) sens_temp(sg, ckt);
+
+			if (!error)
+				output_values[k] = (sum1 - sum0) / delta_var;
+		}
+
+		SMPdestroy(delta_Y);
+		delta_Y = NULL;
+		ckt->CKTmatrix = Y;
+
+		if (error && error != E_BADPARM)
+			goto done;
+		error = OK;
+
+		k += 1;
+	}
+
+	nvalue.v.vec.rVec = output_values;
+	value.rValue = job->tran_stop;
+	SPfrontEnd->OUTpData (sen_data, &value, &nvalue);
+	SPfrontEnd->OUTendPlot (sen_data);
+	sen_data = NULL;
+
+done:
+	if (sen_data)
+		SPfrontEnd->OUTendPlot (sen_data);
+	if (delta_Y)
+		SMPdestroy(delta_Y);
+
+	ckt->CKTmatrix = Y;
+	ckt->CKTrhs = save_rhs;
+	ckt->CKTrhsOld = save_rhsOld;
+	ckt->CKTstate0 = save_state0;
+	ckt->CKTstate1 = save_state1;
+	ckt->CKTnumStates = trace.num_states;
+	ckt->CKTbypass = bypass;
+	ckt->CKTorder = order;
+
+	for (n = 0; n < trace.num_points; n++) {
+		FREE(lambda[n]);
+		FREE(rho[n]);
+	}
+	FREE(lambda);
+	FREE(rho);
+	FREE(xi);
+	FREE(v);
+	FREE(w);
+	FREE(delta_I);
+	FREE(delta_I_delta_Y);
+	FREE(state0);
+	FREE(output_values);
+	sens_trace_free(&trace);
+
+	return error;
+}
+
 double
 inc_freq(double freq, int type, double step_size)
 {
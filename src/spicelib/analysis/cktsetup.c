@@ -155,6 +155,7 @@ CKTunsetup(CKTcircuit *ckt)
     for(i=0;i<=ckt->CKTmaxOrder+1;i++) {
         tfree(ckt->CKTstates[i]);
     }
+    CKTtruncDestroy(ckt);
 
     /* added by HT 050802*/
     for(node=ckt->CKTnodes;node;node=node->next){
@@ -28,13 +28,40 @@ Modified: 2000 AlansFixes
 /* gtri - end - wbk - add includes */
 #endif
 
+/* The options read by CKTsetup() or by the DEVsetup() and
+ * DEVtemperature() of the devices.  The setup after alter (see
+ * cktalter.c) only sets up the altered instances and would miss a change,
+ * temperatures, maxord and the MOS defaults are compared there. */
+static int
+opt_changes_setup(int opt)
+{
+    switch(opt) {
+    case OPT_GMIN:
+    case OPT_RELTOL:
+    case OPT_ABSTOL:
+    case OPT_BYPASS:
+    case OPT_INDVERBOSITY:
+    case OPT_METHOD:
+    case OPT_TRYTOCOMPACT:
+    case OPT_COPYNODESETS:
+    case OPT_EPSMIN:
+#ifdef XSPICE
+    case OPT_ENH_RSHUNT:
+#endif
+        return 1;
+    default:
+        return 0;
+    }
+}
+
 /* ARGSUSED */
 int
 CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
 {
     TSKtask *task = (TSKtask *)anal;
 
-    NG_IGNORE(ckt);
+    if (opt_changes_setup(opt))
+        CKTalterFull(ckt);
 
     switch(opt) {
 
@@ -175,6 +202,37 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
     case OPT_CSHUNT:
         task->TSKcshunt = val->rValue;
         break;
+    case OPT_DCSEED:
+        task->TSKdcSeed = (val->iValue != 0);
+        break;
+    case OPT_WAVERELAX:
+        task->TSKwaveRelax = (val->iValue != 0);
+        break;
+    case OPT_MULTIRATE:
+        task->TSKmultiRate = (val->iValue != 0);
+        break;
+    case OPT_NOTRUNCBATCH:
+        task->TSKnoTruncBatch = (val->iValue != 0);
+        break;
+    case OPT_PZARNOLDI:
+        task->TSKpzArnoldi = (val->iValue != 0);
+        break;
+    case OPT_PZROOTS:
+        task->TSKpzRoots = val->iValue;
+        if (task->TSKpzRoots < 1) {
+            task->TSKpzRoots = 1;
+            fprintf(stderr,"\nWarning -- Option pzroots < 1 not allowed in ngspice\nSet to 1\n\n");
+        }
+        break;
+    case OPT_ALTERINC:
+        task->TSKalterInc = (val->iValue != 0);
+        break;
+    case OPT_OPREMEMBER:
+        task->TSKopRemember = (val->iValue != 0);
+        break;
+    case OPT_OPRACE:
+        task->TSKopRace = (val->iValue != 0);
+        break;
 /* gtri - begin - wbk - add new options */
 #ifdef XSPICE
     case OPT_EVT_MAX_OP_ALTER:
@@ -189,6 +247,14 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
         ckt->evt->options.op_alternate = MIF_FALSE;
         break;
 
+    case OPT_EVT_HIST_WINDOW:
+        ckt->evt->options.hist_window = val->iValue;
+        break;
+
+    case OPT_EVT_PARALLEL:
+        ckt->evt->options.parallel = MIF_TRUE;
+        break;
+
     case OPT_ENH_RAMPTIME:
         ckt->enh->ramp.ramptime = val->rValue;
         break;
@@ -233,6 +299,8 @@ static IFparm OPTtbl[] = {
  { "maxopalter", OPT_EVT_MAX_OP_ALTER, IF_SET|IF_INTEGER, "Maximum analog/event alternations in DCOP" },
  { "maxevtiter", OPT_EVT_MAX_EVT_PASSES, IF_SET|IF_INTEGER, "Maximum event iterations at analysis point" },
  { "noopalter", OPT_ENH_NOOPALTER, IF_SET|IF_FLAG, "Do not do analog/event alternation in DCOP" },
+ { "evtwindow", OPT_EVT_HIST_WINDOW, IF_SET|IF_INTEGER, "Event node records kept in memory, older ones go to a file" },
+ { "evtparallel", OPT_EVT_PARALLEL, IF_SET|IF_FLAG, "Call event-driven code models in parallel threads" },
  { "ramptime", OPT_ENH_RAMPTIME, IF_SET|IF_REAL, "Transient analysis supply ramping time" },
  { "convlimit", OPT_ENH_CONV_LIMIT, IF_SET|IF_FLAG, "Enable convergence assistance on code models" },
  { "convstep", OPT_ENH_CONV_STEP, IF_SET|IF_REAL, "Fractional step allowed by code model inputs between iterations" },
@@ -243,6 +311,15 @@ static IFparm OPTtbl[] = {
 #endif
  { "cshunt", OPT_CSHUNT, IF_SET|IF_REAL, "Shunt capacitor from analog nodes to ground" },
  { "noopiter", OPT_NOOPITER,IF_SET|IF_FLAG,"Go directly to gmin stepping" },
+ { "dcseed", OPT_DCSEED,IF_SET|IF_FLAG,"Seed nested DC sweeps by the previous inner sweep" },
+ { "waverelax", OPT_WAVERELAX,IF_SET|IF_FLAG,"Waveform relaxation of the subcircuits" },
+ { "multirate", OPT_MULTIRATE,IF_SET|IF_FLAG,"Multirate integration of the subcircuits" },
+ { "notruncbatch", OPT_NOTRUNCBATCH,IF_SET|IF_FLAG,"Truncation error device by device" },
+ { "pzarnoldi", OPT_PZARNOLDI,IF_SET|IF_FLAG,"Poles and zeros as eigenvalues by shift-and-invert Arnoldi" },
+ { "pzroots", OPT_PZROOTS,IF_SET|IF_INTEGER,"Number of poles and zeros from pzarnoldi" },
+ { "alterinc", OPT_ALTERINC,IF_SET|IF_FLAG,"Set up only the devices changed by alter and altermod" },
+ { "opremember", OPT_OPREMEMBER,IF_SET|IF_FLAG,"Try the homotopy of the last operating point first" },
+ { "oprace", OPT_OPRACE,IF_SET|IF_FLAG,"Run the operating point homotopies concurrently" },
  { "gmin", OPT_GMIN,IF_SET|IF_REAL,"Minimum conductance" },
  { "gshunt", OPT_GSHUNT,IF_SET|IF_REAL,"Shunt conductance" },
  { "reltol", OPT_RELTOL,IF_SET|IF_REAL ,"Relative error tolerence"},
@@ -296,6 +373,9 @@ static IFparm OPTtbl[] = {
  { "tranpoints", OPT_TRANPTS, IF_ASK|IF_INTEGER,"Transient timepoints" },
  { "accept", OPT_TRANACCPT, IF_ASK|IF_INTEGER,"Accepted timepoints" },
  { "rejected", OPT_TRANRJCT, IF_ASK|IF_INTEGER,"Rejected timepoints" },
+ { "ophomotopy", OPT_OPCHOSEN, IF_ASK|IF_STRING,"Operating point homotopy" },
+ { "optried", OPT_OPTRIED, IF_ASK|IF_STRING,"Operating point homotopies tried" },
+ { "blocksteps", OPT_BLOCKSTEPS, IF_ASK|IF_STRING,"Timepoints of the blocks" },
  { "time", OPT_TOTANALTIME, IF_ASK|IF_REAL,"Total analysis time (seconds)" },
  { "loadtime", OPT_LOADTIME, IF_ASK|IF_REAL,"Matrix load time" },
  { "synctime", OPT_SYNCTIME, IF_ASK|IF_REAL,"Matrix synchronize time" },
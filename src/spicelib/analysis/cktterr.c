@@ -8,6 +8,19 @@ Author: 1985 Thomas L. Quarles
 
 #define ccap (qcap+1)
 
+static double gearCoeff[] = {
+    .5,
+    .2222222222,
+    .1363636364,
+    .096,
+    .07299270073,
+    .05830903790
+};
+static double trapCoeff[] = {
+    .5,
+    .08333333333
+};
+
 
 void
 CKTterr(int qcap, CKTcircuit *ckt, double *timeStep)
@@ -21,18 +34,12 @@ CKTterr(int qcap, CKTcircuit *ckt, double *timeStep)
     double factor=0;
     int i;
     int j;
-    static double gearCoeff[] = {
-        .5,
-        .2222222222,
-        .1363636364,
-        .096,
-        .07299270073,
-        .05830903790
-    };
-    static double trapCoeff[] = {
-        .5,
-        .08333333333
-    };
+
+    /* CKTtrunc() collects the charge states of the batched device types */
+    if (ckt->CKTtruncRecord) {
+        CKTtruncAddState(ckt, qcap);
+        return;
+    }
 
     volttol = ckt->CKTabstol + ckt->CKTreltol * 
             MAX( fabs(ckt->CKTstate0[ccap]), fabs(ckt->CKTstate1[ccap]));
@@ -75,3 +82,95 @@ CKTterr(int qcap, CKTcircuit *ckt, double *timeStep)
     *timeStep = MIN(*timeStep,del);
     return;
 }
+
+
+/* The timesteps of CKTterr() for the charge states qcaps[0..num-1], in
+ * del[].  The divided differences of the timesteps are the same for all of
+ * them and computed once, the arithmetic per state is that of CKTterr()
+ * so that the results are identical. */
+
+static inline double
+terr_state(CKTcircuit *ckt, int qcap, int order, double den[][8],
+           double factor)
+{
+    double volttol, chargetol, tol, del;
+    double diff[8];
+    int i, j;
+
+    volttol = ckt->CKTabstol + ckt->CKTreltol *
+            MAX( fabs(ckt->CKTstate0[ccap]), fabs(ckt->CKTstate1[ccap]));
+
+    chargetol = MAX(fabs(ckt->CKTstate0[qcap]),fabs(ckt->CKTstate1[qcap]));
+    chargetol = ckt->CKTreltol * MAX(chargetol,ckt->CKTchgtol)/ckt->CKTdelta;
+    tol = MAX(volttol,chargetol);
+
+    for(i=order+1;i>=0;i--) {
+        diff[i] = ckt->CKTstates[i][qcap];
+    }
+    for(j=order;j>=0;j--) {
+        for(i=0;i <= j;i++) {
+            diff[i] = (diff[i] - diff[i+1])/den[order-j][i];
+        }
+    }
+
+    del = ckt->CKTtrtol * tol/MAX(ckt->CKTabstol,factor * fabs(diff[0]));
+    if(order == 2) {
+        del = sqrt(del);
+    } else if (order > 2) {
+        del = exp(log(del)/order);
+    }
+    return del;
+}
+
+
+void
+CKTterrBatch(CKTcircuit *ckt, int *qcaps, int num, double *del)
+{
+    double den[8][8];
+    double factor=0;
+    int order = ckt->CKTorder;
+    int i, j, k;
+
+    for(i=0 ; i <= order ; i++) {
+        den[0][i] = ckt->CKTdeltaOld[i];
+    }
+    for(j=order-1;j>=0;j--) {
+        for(i=0;i <= j;i++) {
+            den[order-j][i] = den[order-j-1][i+1] + ckt->CKTdeltaOld[i];
+        }
+    }
+    switch(ckt->CKTintegrateMethod) {
+        case GEAR:
+            factor = gearCoeff[order-1];
+            break;
+
+        case TRAPEZOIDAL:
+            factor = trapCoeff[order - 1] ;
+            break;
+    }
+
+    /* the common orders with constant loop bounds */
+    switch(order) {
+    case 1:
+#ifdef USE_OMP
+#pragma omp parallel for if (num > 4096)
+#endif
+        for(k=0;k<num;k++)
+            del[k] = terr_state(ckt, qcaps[k], 1, den, factor);
+        break;
+    case 2:
+#ifdef USE_OMP
+#pragma omp parallel for if (num > 4096)
+#endif
+        for(k=0;k<num;k++)
+            del[k] = terr_state(ckt, qcaps[k], 2, den, factor);
+        break;
+    default:
+#ifdef USE_OMP
+#pragma omp parallel for if (num > 4096)
+#endif
+        for(k=0;k<num;k++)
+            del[k] = terr_state(ckt, qcaps[k], order, den, factor);
+        break;
+    }
+}
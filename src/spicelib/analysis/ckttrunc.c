@@ -16,27 +16,122 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/sperror.h"
 
 
+/* The device types with DEV_TERR: their DEVtrunc() is nothing but
+ * CKTterr() on a set of charge states fixed at setup.  Their states are
+ * collected at the first call, and the truncation error of all of them
+ * is evaluated in one pass, unless option notruncbatch is set. */
+
+struct st_truncbatch {
+    char *batched;      /* device types in the batch */
+    int *start;         /* their states in qcaps[], by type */
+    int *qcaps;         /* charge states in the order of CKTterr() calls */
+    int num, max;
+    double *del;        /* the timesteps of the states */
+};
+
+
+void
+CKTtruncAddState(CKTcircuit *ckt, int qcap)
+{
+    struct st_truncbatch *tb = ckt->CKTtruncBatch;
+
+    if (tb->num == tb->max) {
+        tb->max = MAX(64, 2 * tb->max);
+        tb->qcaps = TREALLOC(int, tb->qcaps, tb->max);
+    }
+    tb->qcaps[tb->num++] = qcap;
+}
+
+
+/* The charge states CKTterr() is called for by the device types in the
+ * batch */
+static struct st_truncbatch *
+trunc_collect(CKTcircuit *ckt)
+{
+    struct st_truncbatch *tb = TMALLOC(struct st_truncbatch, 1);
+    int i;
+
+    tb->batched = TMALLOC(char, DEVmaxnum);
+    tb->start = TMALLOC(int, DEVmaxnum + 1);
+    ckt->CKTtruncBatch = tb;
+
+    ckt->CKTtruncRecord = 1;
+    for (i = 0; i < DEVmaxnum; i++) {
+        tb->start[i] = tb->num;
+        if (!DEVices[i] || !DEVices[i]->DEVtrunc || !ckt->CKThead[i])
+            continue;
+        if (!ckt->CKTnoTruncBatch &&
+            (DEVices[i]->DEVpublic.flags & DEV_TERR)) {
+            double timetemp = HUGE;
+            tb->batched[i] = 1;
+            DEVices[i]->DEVtrunc (ckt->CKThead[i], ckt, &timetemp);
+        }
+    }
+    tb->start[DEVmaxnum] = tb->num;
+    ckt->CKTtruncRecord = 0;
+
+    tb->del = TMALLOC(double, tb->num);
+    return tb;
+}
+
+
+void
+CKTtruncDestroy(CKTcircuit *ckt)
+{
+    struct st_truncbatch *tb = ckt->CKTtruncBatch;
+
+    if (!tb)
+        return;
+    tfree(tb->batched);
+    tfree(tb->start);
+    tfree(tb->qcaps);
+    tfree(tb->del);
+    tfree(tb);
+    ckt->CKTtruncBatch = NULL;
+}
+
+
 int
 CKTtrunc(CKTcircuit *ckt, double *timeStep)
 {
 #ifndef NEWTRUNC
-    int i;
+    int i, k;
     double timetemp;
 #ifdef STEPDEBUG
     double debugtemp;
 #endif /* STEPDEBUG */
     double startTime;
     int error = OK;
+    struct st_truncbatch *tb;
 
     startTime = SPfrontEnd->IFseconds();
 
+    /* waveform relaxation, the block which is integrated */
+    if (ckt->CKTwavrel) {
+        error = CKTwrTrunc(ckt, timeStep);
+        ckt->CKTstat->STATtranTruncTime += SPfrontEnd->IFseconds() - startTime;
+        return(error);
+    }
+
+    tb = ckt->CKTtruncBatch;
+    if (!tb)
+        tb = trunc_collect(ckt);
+    CKTterrBatch(ckt, tb->qcaps, tb->num, tb->del);
+
+    /* the minimum in the order of the device calls, as CKTterr() takes it */
     timetemp = HUGE;
     for (i=0;i<DEVmaxnum;i++) {
         if (DEVices[i] && DEVices[i]->DEVtrunc && ckt->CKThead[i]) {
 #ifdef STEPDEBUG
             debugtemp = timetemp;
 #endif /* STEPDEBUG */
-	    error = DEVices[i]->DEVtrunc (ckt->CKThead[i], ckt, &timetemp);
+            if (tb->batched[i]) {
+                for (k = tb->start[i]; k < tb->start[i+1]; k++)
+                    timetemp = MIN(timetemp, tb->del[k]);
+                error = OK;
+            } else {
+                error = DEVices[i]->DEVtrunc (ckt->CKThead[i], ckt, &timetemp);
+            }
 	    if(error) {
                 ckt->CKTstat->STATtranTruncTime += SPfrontEnd->IFseconds()
                     - startTime;
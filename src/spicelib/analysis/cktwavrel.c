@@ -0,0 +1,1509 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Waveform relaxation transient.
+ *
+ * With '.options waverelax' DCtran() hands the transient over to a
+ * Gauss-Jacobi waveform relaxation after its first timepoint.  The circuit
+ * is cut into blocks at the boundaries of the top level subcircuit
+ * instances: all devices of x1 (m.x1.m1, c.x1.x2.c3, ...) form one
+ * block, the devices of the top level another one.
+ * Independent and B sources are loaded in every block.  Every unknown is
+ * solved by one block, the first one which stamps it.
+ *
+ * The time axis is cut into windows.  In a window every block is
+ * integrated on its own, with its own timesteps and from its own history:
+ * the devices of the block, the sources and the devices of other blocks
+ * which are connected to its nodes are loaded, the unknowns solved by the
+ * other blocks are held at their waveforms of the previous sweep.  The
+ * sweeps are repeated until the waveforms do not change any more within
+ * the tolerances, and the window is written out at the union of the
+ * timepoints of all blocks.  A block is integrated again only when one of
+ * the held unknowns in its equations has moved in the last sweep.  A window
+ * which does not settle is repeated with a quarter of its length, one
+ * which settles fast is doubled.
+ *
+ * The blocks of a sweep only depend on the previous sweep.  In builds
+ * with OpenMP they are integrated in parallel, with num_threads threads:
+ * the first block on the circuit of the analysis, every other one on a
+ * copy of it made by CKTclone(), whose instances, nodes and states come
+ * in the same order.  This needs devices which may be copied, see
+ * DEV_CLONE in devdefs.h.  Otherwise all blocks are integrated one after
+ * the other on the circuit of the analysis, each with its own copy of
+ * CKTstates[].  A circuit keeps its matrix ordering from block to block.
+ *
+ * With '.options multirate' the blocks of a window are integrated once
+ * each instead, one after the other.  Every block keeps its own timestep
+ * control, CKTtrunc() is the truncation error of its devices.  A block
+ * reads the unknowns of the blocks integrated before it at their new
+ * waveforms, between their timepoints, and the ones of the blocks after it
+ * at a straight line from their values at the start of the window, with
+ * their slope at the end of the last one, or at the first step of a window
+ * which is repeated.  If the waveform of a block is off this line by more
+ * than trtol times the tolerances where a block before it has read it, the
+ * window is repeated with a quarter of its length, and the block is
+ * integrated before the one which has read it from then on.  So the fast
+ * blocks come first and read the slow ones at their lines.
+ *
+ * Devices with a history outside of CKTstates[] (transmission lines,
+ * NDEV), XSPICE code models, mutual inductors, which INDload() loads
+ * all at once, and the devices loaded by OpenMP over arrays of all
+ * instances are not supported.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/smpdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/hash.h"
+
+#ifdef USE_OMP
+extern int nthreads;
+#endif
+
+
+#define WR_MAXSWEEP 10
+
+enum { WR_LOAD, WR_TRUNC, WR_CONV, WR_ACCEPT };
+
+/* a run of instances of one model, loaded for one block */
+typedef struct {
+    int type;
+    GENmodel *model;
+    GENinstance *first, *last;
+    int first_n, last_n;    /* their numbers, counted over all types */
+} WRrun;
+
+typedef struct {
+    char *name;             /* its subcircuit, or "top" */
+    struct st_wavrel *view; /* of the circuit which integrates it */
+    int error;              /* of its last integration */
+    int *unknowns;          /* the unknowns it solves */
+    int num_unknowns;
+    int *reads;             /* the unknowns of other blocks it reads */
+    int num_reads;
+    double **states;        /* CKTstates[] at the start of the window */
+    double **states_end;    /* and at its end */
+    int order, order_end;
+    double delta, delta_end;
+    double save_delta, save_delta_end;
+    double delta_old[7], delta_old_end[7];
+    double *time[2];        /* waveforms of two sweeps */
+    double *val[2];
+    int num_points[2];
+    int max_points[2];
+    double *slope;          /* of the unknowns in the next window */
+    int steps;              /* timepoints of all windows */
+} WRblock;
+
+/* The waveform relaxation as seen by one circuit, the circuit of the
+ * analysis (main == itself) or a copy of it for a block */
+struct st_wavrel {
+    struct st_wavrel *main; /* the one of the circuit of the analysis */
+    CKTcircuit *ckt;
+    WRrun **runs;           /* the devices loaded for a block */
+    int *num_runs;
+    WRrun *shared;          /* sources, loaded for every block */
+    int num_shared;
+    int cur;                /* the block which is integrated */
+    double **diag;
+    int *row_start;         /* matrix elements by row */
+    double **row_elts;
+    double *xw;             /* solution at some time of the window */
+
+    /* the rest is kept by the main one */
+    int num_blocks;
+    WRblock *blocks;
+    int multirate;
+    int *order;             /* of the blocks in a multirate window */
+#ifdef USE_OMP
+    CKTcircuit **copies;    /* circuits of the blocks, if parallel */
+#endif
+    int sweep;              /* the waveforms the blocks write */
+    int *block;             /* block solving an unknown, -1 for all */
+    char *is_current;       /* branch current unknowns */
+    char *changed;          /* unknowns which moved in the last sweep */
+    double *x0;             /* solution at the start of the window */
+    double *breaks;         /* breakpoints at the start of the window */
+    int break_size;
+    double window;
+    int windows, sweeps, solves;
+};
+
+
+static const char *
+wr_method(CKTcircuit *ckt)
+{
+    return ckt->CKTmultiRate ? "multirate integration" : "waveform relaxation";
+}
+
+
+/* Can the blocks of the circuit be integrated one by one? */
+static int
+wr_supported(CKTcircuit *ckt)
+{
+    /* their history is not in CKTstates[], or, for mutual, their load
+     * runs in the one of the inductors, over all instances */
+    static char *types[] = { "LTRA", "Tranline", "TransLine", "CplLines",
+                             "NDEV", "mutual", NULL };
+    int i;
+
+#ifdef USE_OMP
+    /* their loads run over arrays of all instances of all models */
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && (DEVices[i]->DEVpublic.flags & DEV_OMPLOAD) &&
+            ckt->CKThead[i]) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "%s does not support OpenMP loads of %s devices",
+                wr_method(ckt), DEVices[i]->DEVpublic.name);
+            return 0;
+        }
+#endif
+
+    for (i = 0; types[i]; i++) {
+        int type = CKTtypelook(types[i]);
+        if (type >= 0 && ckt->CKThead[type]) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "%s does not support %s devices", wr_method(ckt), types[i]);
+            return 0;
+        }
+    }
+
+#ifdef XSPICE
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVpublic.cm_func && ckt->CKThead[i]) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "%s does not support XSPICE code models", wr_method(ckt));
+            return 0;
+        }
+#endif
+
+    if (ckt->CKTsenTrace) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "%s is not used for a transient sensitivity", wr_method(ckt));
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/* Loaded for every block: sources and behavioural devices, which may
+ * depend on time */
+static int
+wr_shared(int type)
+{
+    static char *types[] = { "Vsource", "Isource", "ASRC", NULL };
+    int i;
+
+    for (i = 0; types[i]; i++)
+        if (strcmp(DEVices[type]->DEVpublic.name, types[i]) == 0)
+            return 1;
+
+    return 0;
+}
+
+
+/* Call the load, truncation error, convergence test or accept function of
+ * the devices of some runs */
+static int
+wr_devcall(CKTcircuit *ckt, WRrun *runs, int num_runs, int what,
+           double *timeStep)
+{
+    int i, error = OK;
+
+    for (i = 0; i < num_runs; i++) {
+        WRrun *r = &runs[i];
+        SPICEdev *dev = DEVices[r->type];
+        GENmodel *next = r->model->GENnextModel;
+        GENinstance *first = r->model->GENinstances;
+        GENinstance *after = r->last->GENnextInstance;
+
+        r->model->GENnextModel = NULL;
+        r->model->GENinstances = r->first;
+        r->last->GENnextInstance = NULL;
+
+        switch (what) {
+        case WR_LOAD:
+            if (dev->DEVload) {
+                error = dev->DEVload(r->model, ckt);
+                if (ckt->CKTnoncon)
+                    ckt->CKTtroubleNode = 0;
+            }
+            break;
+        case WR_TRUNC:
+            if (dev->DEVtrunc)
+                error = dev->DEVtrunc(r->model, ckt, timeStep);
+            break;
+        case WR_CONV:
+            if (dev->DEVconvTest)
+                error = dev->DEVconvTest(r->model, ckt);
+            break;
+        case WR_ACCEPT:
+            if (dev->DEVaccept)
+                error = dev->DEVaccept(ckt, r->model);
+            break;
+        }
+
+        r->model->GENnextModel = next;
+        r->model->GENinstances = first;
+        r->last->GENnextInstance = after;
+
+        if (error || (what == WR_CONV && ckt->CKTnoncon))
+            break;
+    }
+
+    return error;
+}
+
+
+/* The runs of the instances for which sel[] is set, in the order of the
+ * instance lists */
+static WRrun *
+wr_runs(CKTcircuit *ckt, const char *sel, int *num_runs)
+{
+    WRrun *runs = NULL;
+    int t, n = 0, num = 0;
+
+    for (t = 0; t < DEVmaxnum; t++) {
+        GENmodel *model;
+        GENinstance *inst;
+        if (!DEVices[t] || !ckt->CKThead[t])
+            continue;
+        for (model = ckt->CKThead[t]; model; model = model->GENnextModel) {
+            WRrun *r = NULL;
+            for (inst = model->GENinstances; inst; inst = inst->GENnextInstance) {
+                if (!sel[n++]) {
+                    r = NULL;
+                } else if (r) {
+                    r->last = inst;
+                } else {
+                    runs = TREALLOC(WRrun, runs, num + 1);
+                    r = &runs[num++];
+                    r->type = t;
+                    r->model = model;
+                    r->first = r->last = inst;
+                    r->first_n = n - 1;
+                }
+                if (r)
+                    r->last_n = n - 1;
+            }
+        }
+    }
+
+    *num_runs = num;
+    return runs;
+}
+
+
+/* The values of the unknowns of a block at time t, linear between the
+ * points of its waveform s */
+static void
+wr_wave(WRblock *b, int s, double t, double *x)
+{
+    double *time = b->time[s];
+    double *v0, *v1, f = 0;
+    int lo = 0, hi = b->num_points[s] - 1, i;
+
+    if (hi > 0 && t >= time[hi]) {
+        lo = hi;
+    } else if (hi > 0 && t > time[0]) {
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            if (time[mid] <= t)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        f = (t - time[lo]) / (time[lo + 1] - time[lo]);
+    }
+
+    v0 = b->val[s] + (size_t) lo * (size_t) b->num_unknowns;
+    if (f == 0) {
+        for (i = 0; i < b->num_unknowns; i++)
+            x[b->unknowns[i]] = v0[i];
+    } else {
+        v1 = v0 + b->num_unknowns;
+        for (i = 0; i < b->num_unknowns; i++)
+            x[b->unknowns[i]] = v0[i] + f * (v1[i] - v0[i]);
+    }
+}
+
+
+/* Room for n points in the waveform s of a block */
+static void
+wr_grow(WRblock *b, int s, int n)
+{
+    if (n > b->max_points[s]) {
+        b->max_points[s] = MAX(n, 2 * b->max_points[s]);
+        b->time[s] = TREALLOC(double, b->time[s], b->max_points[s]);
+        b->val[s] = TREALLOC(double, b->val[s],
+                             (size_t) b->max_points[s] * (size_t) b->num_unknowns);
+    }
+}
+
+
+/* Append the solution at the present time to the waveform s of a block */
+static void
+wr_record(CKTcircuit *ckt, WRblock *b, int s)
+{
+    int n = b->num_points[s], i;
+    double *v;
+
+    wr_grow(b, s, n + 1);
+
+    b->time[s][n] = ckt->CKTtime;
+    v = b->val[s] + (size_t) n * (size_t) b->num_unknowns;
+    for (i = 0; i < b->num_unknowns; i++)
+        v[i] = ckt->CKTrhsOld[b->unknowns[i]];
+    b->num_points[s]++;
+}
+
+
+/* Add a load of some runs to the matrix and mark the terminals of their
+ * instances */
+static int
+wr_probe(CKTcircuit *ckt, WRrun *runs, int num_runs, char *mark)
+{
+    int i, j, error;
+
+    error = wr_devcall(ckt, runs, num_runs, WR_LOAD, NULL);
+    if (error || !mark)
+        return error;
+
+    for (i = 0; i < num_runs; i++) {
+        int *pterms = DEVices[runs[i].type]->DEVpublic.terms;
+        int terms = pterms ? *pterms : 0;
+        GENinstance *inst;
+        for (inst = runs[i].first; ; inst = inst->GENnextInstance) {
+            int *node = GENnode(inst);
+            for (j = 0; j < terms; j++)
+                if (node[j] > 0)
+                    mark[node[j]] = 1;
+            if (inst == runs[i].last)
+                break;
+        }
+    }
+
+    return OK;
+}
+
+
+/* Every unknown a diagonal element, to hold it, and the matrix elements
+ * by row, the rows of the held unknowns are replaced.  One ordering for
+ * all blocks of the circuit: a held row is zero but for its diagonal, a
+ * pivot which falls on one of its other elements makes NIiter() order
+ * again. */
+static void
+wr_matrix(struct st_wavrel *wr, CKTcircuit *ckt)
+{
+    int size = SMPmatSize(ckt->CKTmatrix);
+    double **elts;
+    int *rows, *cols, *fill;
+    int num_elts, n, j;
+
+    wr->diag = TMALLOC(double *, size + 1);
+    for (n = 1; n <= size; n++)
+        wr->diag[n] = SMPmakeElt(ckt->CKTmatrix, n, n);
+    ckt->CKTniState |= NISHOULDREORDER;
+
+    num_elts = SMPelementList(ckt->CKTmatrix, &elts, &rows, &cols);
+    wr->row_start = TMALLOC(int, size + 2);
+    wr->row_elts = TMALLOC(double *, num_elts);
+    for (j = 0; j < num_elts; j++)
+        wr->row_start[rows[j] + 1]++;
+    for (n = 0; n <= size; n++)
+        wr->row_start[n + 1] += wr->row_start[n];
+    fill = TMALLOC(int, size + 1);
+    memcpy(fill, wr->row_start, (size_t) (size + 1) * sizeof(int));
+    for (j = 0; j < num_elts; j++)
+        wr->row_elts[fill[rows[j]]++] = elts[j];
+    tfree(fill);
+    tfree(elts);
+    tfree(rows);
+    tfree(cols);
+}
+
+
+static void
+wr_view_free(struct st_wavrel *v)
+{
+    int k;
+
+    for (k = 0; k < v->main->num_blocks; k++)
+        tfree(v->runs[k]);
+    tfree(v->runs);
+    tfree(v->num_runs);
+    tfree(v->shared);
+    tfree(v->diag);
+    tfree(v->row_start);
+    tfree(v->row_elts);
+    tfree(v->xw);
+}
+
+
+#ifdef USE_OMP
+
+/* The instances of the circuit and their models in the order of wr_runs() */
+static int
+wr_instances(CKTcircuit *ckt, GENinstance **insts, GENmodel **models, int max)
+{
+    int t, n = 0;
+
+    for (t = 0; t < DEVmaxnum; t++) {
+        GENmodel *model;
+        GENinstance *inst;
+        if (!DEVices[t] || !ckt->CKThead[t])
+            continue;
+        for (model = ckt->CKThead[t]; model; model = model->GENnextModel)
+            for (inst = model->GENinstances; inst; inst = inst->GENnextInstance) {
+                if (n == max)
+                    return -1;
+                insts[n] = inst;
+                models[n++] = model;
+            }
+    }
+
+    return n;
+}
+
+
+/* The runs of a copy of the circuit, by the numbers of their instances */
+static WRrun *
+wr_map(WRrun *runs, int num_runs, GENinstance **insts, GENmodel **models)
+{
+    WRrun *map = TMALLOC(WRrun, num_runs);
+    int i;
+
+    for (i = 0; i < num_runs; i++) {
+        map[i] = runs[i];
+        map[i].model = models[runs[i].first_n];
+        map[i].first = insts[runs[i].first_n];
+        map[i].last = insts[runs[i].last_n];
+    }
+
+    return map;
+}
+
+
+static void
+wr_copies_free(struct st_wavrel *wr)
+{
+    int k;
+
+    if (!wr->copies)
+        return;
+
+    for (k = 1; k < wr->num_blocks; k++) {
+        struct st_wavrel *v = wr->blocks[k].view;
+        if (v != wr) {
+            wr_view_free(v);
+            tfree(v);
+            wr->copies[k]->CKTwavrel = NULL;
+        }
+        wr->blocks[k].view = wr;
+        CKTcloneFree(wr->copies[k]);
+    }
+    tfree(wr->copies);
+}
+
+
+/* Copies of the circuit for all blocks but the first one, to integrate
+ * the blocks in parallel.  None if a device may not be copied. */
+static void
+wr_copies(CKTcircuit *ckt, struct st_wavrel *wr, int num_inst)
+{
+    GENinstance **insts;
+    GENmodel **models;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    int k;
+
+    if (nthreads < 2 || !CKTcloneable(ckt))
+        return;
+
+    insts = TMALLOC(GENinstance *, num_inst);
+    models = TMALLOC(GENmodel *, num_inst);
+
+    wr->copies = TMALLOC(CKTcircuit *, wr->num_blocks);
+    for (k = 1; k < wr->num_blocks; k++) {
+        struct st_wavrel *v;
+        CKTcircuit *c;
+
+        if (CKTclone(ckt, &wr->copies[k]) != OK)
+            break;
+        c = wr->copies[k];
+        if (wr_instances(c, insts, models, num_inst) != num_inst)
+            break;
+
+        v = TMALLOC(struct st_wavrel, 1);
+        v->main = wr;
+        v->ckt = c;
+        v->runs = TMALLOC(WRrun *, wr->num_blocks);
+        v->num_runs = TMALLOC(int, wr->num_blocks);
+        v->runs[k] = wr_map(wr->runs[k], wr->num_runs[k], insts, models);
+        v->num_runs[k] = wr->num_runs[k];
+        v->shared = wr_map(wr->shared, wr->num_shared, insts, models);
+        v->num_shared = wr->num_shared;
+        v->xw = TMALLOC(double, size + 1);
+        wr_matrix(v, c);
+        c->CKTwavrel = v;
+        wr->blocks[k].view = v;
+    }
+
+    tfree(insts);
+    tfree(models);
+
+    if (k < wr->num_blocks) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "waveform relaxation: no circuit for block %d, the blocks are integrated one by one",
+            k);
+        wr_copies_free(wr);
+    }
+}
+
+#endif
+
+
+int
+CKTwrSetup(CKTcircuit *ckt)
+{
+    struct st_wavrel *wr;
+    NGHASHPTR names;
+    char **keys, *sel, *mark;
+    int *part, *first;
+    double **elts, *save0;
+    int *rows, *cols;
+    long save_mode;
+    int size, num_elts, num_keys, max_keys, num_inst, save_noncon;
+    int i, j, k, n, t, changed, error = OK;
+
+    if (!wr_supported(ckt))
+        return E_BADPARM;
+
+    /* the part of every instance, by its top level subcircuit: 0 for the
+     * shared ones, 1 for the top level */
+    num_inst = 0;
+    for (t = 0; t < DEVmaxnum; t++) {
+        GENmodel *model;
+        GENinstance *inst;
+        if (!DEVices[t] || !ckt->CKThead[t])
+            continue;
+        for (model = ckt->CKThead[t]; model; model = model->GENnextModel)
+            for (inst = model->GENinstances; inst; inst = inst->GENnextInstance)
+                num_inst++;
+    }
+    part = TMALLOC(int, num_inst);
+
+    max_keys = 16;
+    keys = TMALLOC(char *, max_keys);
+    num_keys = 2;
+    names = nghash_init(64);
+
+    n = 0;
+    for (t = 0; t < DEVmaxnum; t++) {
+        GENmodel *model;
+        GENinstance *inst;
+        if (!DEVices[t] || !ckt->CKThead[t])
+            continue;
+        for (model = ckt->CKThead[t]; model; model = model->GENnextModel)
+            for (inst = model->GENinstances; inst; inst = inst->GENnextInstance) {
+                char *name = inst->GENname, *dot, *end, *key;
+                void *found;
+                if (wr_shared(t)) {
+                    part[n++] = 0;
+                    continue;
+                }
+                /* m.x1.m1 belongs to x1 */
+                dot = strchr(name, '.');
+                end = dot ? strchr(dot + 1, '.') : NULL;
+                if (!end) {
+                    part[n++] = 1;
+                    continue;
+                }
+                key = copy_substring(dot + 1, end);
+                found = nghash_find(names, key);
+                if (found) {
+                    part[n++] = (int) ((char **) found - keys);
+                    tfree(key);
+                    continue;
+                }
+                if (num_keys == max_keys) {
+                    /* keys[] moves, rebuild the table */
+                    max_keys *= 2;
+                    keys = TREALLOC(char *, keys, max_keys);
+                    nghash_free(names, NULL, NULL);
+                    names = nghash_init(max_keys);
+                    for (i = 2; i < num_keys; i++)
+                        nghash_insert(names, keys[i], &keys[i]);
+                }
+                keys[num_keys] = key;
+                nghash_insert(names, key, &keys[num_keys]);
+                part[n++] = num_keys++;
+            }
+    }
+    nghash_free(names, NULL, NULL);
+
+    /* the parts with devices are the blocks */
+    first = TMALLOC(int, num_keys);
+    for (i = 0; i < num_keys; i++)
+        first[i] = -1;
+    for (n = 0; n < num_inst; n++)
+        first[part[n]] = 1;
+    k = 0;
+    for (i = 1; i < num_keys; i++)
+        first[i] = first[i] > 0 ? k++ : -1;
+    if (k < 2) {
+        SPfrontEnd->IFerrorf(ERR_WARNING,
+            "%s needs subcircuits to partition the circuit", wr_method(ckt));
+        for (i = 2; i < num_keys; i++)
+            tfree(keys[i]);
+        tfree(keys);
+        tfree(first);
+        tfree(part);
+        return E_BADPARM;
+    }
+
+    size = SMPmatSize(ckt->CKTmatrix);
+    wr = TMALLOC(struct st_wavrel, 1);
+    wr->main = wr;
+    wr->ckt = ckt;
+    wr->num_blocks = k;
+    wr->blocks = TMALLOC(WRblock, k);
+    for (i = 1; i < num_keys; i++)
+        if (first[i] >= 0)
+            wr->blocks[first[i]].name = copy(i == 1 ? "top" : keys[i]);
+    for (i = 2; i < num_keys; i++)
+        tfree(keys[i]);
+    tfree(keys);
+    wr->multirate = ckt->CKTmultiRate;
+    wr->order = TMALLOC(int, k);
+    for (i = 0; i < k; i++)
+        wr->order[i] = i;
+    wr->runs = TMALLOC(WRrun *, k);
+    wr->num_runs = TMALLOC(int, k);
+    wr->block = TMALLOC(int, size + 1);
+    wr->is_current = TMALLOC(char, size + 1);
+    wr->changed = TMALLOC(char, size + 1);
+    wr->x0 = TMALLOC(double, size + 1);
+    wr->xw = TMALLOC(double, size + 1);
+    {
+        CKTnode *node;
+        for (node = ckt->CKTnodes; node; node = node->next)
+            if (node->number > 0 && node->number <= size &&
+                node->type == SP_CURRENT)
+                wr->is_current[node->number] = 1;
+    }
+
+    wr_matrix(wr, ckt);
+
+    /* Loads of the parts find the unknowns they stamp, an unknown is solved
+     * by the first block which stamps it */
+    num_elts = SMPelementList(ckt->CKTmatrix, &elts, &rows, &cols);
+    for (n = 0; n <= size; n++)
+        wr->block[n] = -1;
+    mark = TMALLOC(char, size + 1);
+    sel = TMALLOC(char, num_inst);
+    save0 = TMALLOC(double, ckt->CKTnumStates);
+    memcpy(save0, ckt->CKTstate0, (size_t) ckt->CKTnumStates * sizeof(double));
+    save_mode = ckt->CKTmode;
+    save_noncon = ckt->CKTnoncon;
+    ckt->CKTmode = (save_mode & MODEUIC) | MODETRAN | MODEINITPRED;
+
+    for (i = num_keys - 1; i > 0 && !error; i--) {
+        WRrun *runs;
+        int num_runs;
+
+        if (first[i] < 0)
+            continue;
+        for (n = 0; n < num_inst; n++)
+            sel[n] = part[n] == i;
+        runs = wr_runs(ckt, sel, &num_runs);
+        memset(mark, 0, (size_t) (size + 1));
+        memset(ckt->CKTrhs, 0, (size_t) (size + 1) * sizeof(double));
+        SMPclear(ckt->CKTmatrix);
+        error = wr_probe(ckt, runs, num_runs, mark);
+        tfree(runs);
+        for (j = 0; j < num_elts; j++)
+            if (*elts[j] != 0.0)
+                mark[rows[j]] = mark[cols[j]] = 1;
+        for (n = 1; n <= size; n++)
+            if (mark[n] || ckt->CKTrhs[n] != 0.0)
+                wr->block[n] = first[i];
+    }
+
+    /* unknowns only the sources stamp go with the unknowns they are
+     * coupled to */
+    for (n = 0; n < num_inst; n++)
+        sel[n] = part[n] == 0;
+    wr->shared = wr_runs(ckt, sel, &wr->num_shared);
+    memset(ckt->CKTrhs, 0, (size_t) (size + 1) * sizeof(double));
+    SMPclear(ckt->CKTmatrix);
+    if (!error)
+        error = wr_probe(ckt, wr->shared, wr->num_shared, NULL);
+    if (!error)
+        do {
+            changed = 0;
+            for (j = 0; j < num_elts; j++) {
+                int r = rows[j], c = cols[j];
+                if (*elts[j] == 0.0)
+                    continue;
+                if (wr->block[r] < 0 && wr->block[c] >= 0) {
+                    wr->block[r] = wr->block[c];
+                    changed = 1;
+                } else if (wr->block[c] < 0 && wr->block[r] >= 0) {
+                    wr->block[c] = wr->block[r];
+                    changed = 1;
+                }
+            }
+        } while (changed);
+
+    /* The devices of every block: its own ones and all at the unknowns it
+     * solves.  The unknowns of the other blocks in its equations decide if
+     * it is integrated again in a sweep. */
+    for (k = 0; k < wr->num_blocks && !error; k++) {
+        WRblock *b = &wr->blocks[k];
+        int m = 0;
+
+        for (t = 0; t < DEVmaxnum; t++) {
+            GENmodel *model;
+            GENinstance *inst;
+            if (!DEVices[t] || !ckt->CKThead[t])
+                continue;
+            for (model = ckt->CKThead[t]; model; model = model->GENnextModel)
+                for (inst = model->GENinstances; inst; inst = inst->GENnextInstance, m++) {
+                    int *node = GENnode(inst);
+                    int *pterms = DEVices[t]->DEVpublic.terms;
+                    int terms = pterms ? *pterms : 0;
+                    sel[m] = part[m] > 0 && first[part[m]] == k;
+                    if (part[m] > 0)
+                        for (j = 0; j < terms && !sel[m]; j++)
+                            if (node[j] > 0 && wr->block[node[j]] == k)
+                                sel[m] = 1;
+                }
+        }
+        wr->runs[k] = wr_runs(ckt, sel, &wr->num_runs[k]);
+        b->view = wr;
+
+        memset(mark, 0, (size_t) (size + 1));
+        SMPclear(ckt->CKTmatrix);
+        error = wr_probe(ckt, wr->shared, wr->num_shared, NULL);
+        if (!error)
+            error = wr_probe(ckt, wr->runs[k], wr->num_runs[k], mark);
+        for (j = 0; j < num_elts; j++)
+            if (*elts[j] != 0.0 &&
+                (wr->block[rows[j]] == k || wr->block[rows[j]] < 0))
+                mark[cols[j]] = 1;
+        for (n = 1; n <= size; n++)
+            if (mark[n] && wr->block[n] >= 0 && wr->block[n] != k)
+                b->num_reads++;
+        b->reads = TMALLOC(int, b->num_reads);
+        b->num_reads = 0;
+        for (n = 1; n <= size; n++)
+            if (mark[n] && wr->block[n] >= 0 && wr->block[n] != k)
+                b->reads[b->num_reads++] = n;
+
+        /* the unknowns every block solves are kept with the first one */
+        for (n = 1; n <= size; n++)
+            if (wr->block[n] == k || (k == 0 && wr->block[n] < 0))
+                b->num_unknowns++;
+        b->unknowns = TMALLOC(int, b->num_unknowns);
+        b->num_unknowns = 0;
+        for (n = 1; n <= size; n++)
+            if (wr->block[n] == k || (k == 0 && wr->block[n] < 0))
+                b->unknowns[b->num_unknowns++] = n;
+        b->slope = TMALLOC(double, b->num_unknowns);
+
+        b->states = TMALLOC(double *, ckt->CKTmaxOrder + 2);
+        b->states_end = TMALLOC(double *, ckt->CKTmaxOrder + 2);
+        for (i = 0; i <= ckt->CKTmaxOrder + 1; i++) {
+            b->states[i] = TMALLOC(double, ckt->CKTnumStates);
+            b->states_end[i] = TMALLOC(double, ckt->CKTnumStates);
+            memcpy(b->states[i], ckt->CKTstates[i],
+                   (size_t) ckt->CKTnumStates * sizeof(double));
+        }
+        b->order = ckt->CKTorder;
+        b->delta = ckt->CKTdelta;
+        b->save_delta = ckt->CKTsaveDelta;
+        memcpy(b->delta_old, ckt->CKTdeltaOld, sizeof(b->delta_old));
+    }
+
+    ckt->CKTmode = save_mode;
+    ckt->CKTnoncon = save_noncon;
+    memcpy(ckt->CKTstate0, save0, (size_t) ckt->CKTnumStates * sizeof(double));
+    tfree(save0);
+    tfree(sel);
+    tfree(mark);
+    tfree(first);
+    tfree(part);
+
+    tfree(elts);
+    tfree(rows);
+    tfree(cols);
+
+    ckt->CKTwavrel = wr;
+    if (error) {
+        CKTwrDestroy(ckt);
+        return error;
+    }
+    wr->window = MAX(ckt->CKTstep, 10 * ckt->CKTdelta);
+
+    if (wr->multirate) {
+        SPfrontEnd->IFerrorf(ERR_INFO, "multirate integration of %d blocks",
+                             wr->num_blocks);
+        return OK;
+    }
+
+#ifdef USE_OMP
+    wr_copies(ckt, wr, num_inst);
+    if (wr->copies) {
+        SPfrontEnd->IFerrorf(ERR_INFO,
+            "waveform relaxation of %d blocks, in parallel", wr->num_blocks);
+        return OK;
+    }
+#endif
+
+    SPfrontEnd->IFerrorf(ERR_INFO, "waveform relaxation of %d blocks",
+                         wr->num_blocks);
+    return OK;
+}
+
+
+/* The device part of CKTload(): the devices of the block which is
+ * integrated, the unknowns of the others held at their last waveforms */
+int
+CKTwrLoad(CKTcircuit *ckt)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    struct st_wavrel *m = wr->main;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    int k, n, j, error;
+
+    error = wr_devcall(ckt, wr->shared, wr->num_shared, WR_LOAD, NULL);
+    if (!error)
+        error = wr_devcall(ckt, wr->runs[wr->cur], wr->num_runs[wr->cur],
+                           WR_LOAD, NULL);
+    if (error)
+        return error;
+
+    for (k = 0; k < m->num_blocks; k++)
+        if (k != wr->cur)
+            wr_wave(&m->blocks[k], 1 - m->sweep, ckt->CKTtime, wr->xw);
+
+    for (n = 1; n <= size; n++)
+        if (m->block[n] >= 0 && m->block[n] != wr->cur) {
+            for (j = wr->row_start[n]; j < wr->row_start[n + 1]; j++)
+                *wr->row_elts[j] = 0.0;
+            *wr->diag[n] = 1.0;
+            ckt->CKTrhs[n] = wr->xw[n];
+        }
+
+    return OK;
+}
+
+
+int
+CKTwrTrunc(CKTcircuit *ckt, double *timeStep)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    double timetemp = HUGE;
+    int error;
+
+    error = wr_devcall(ckt, wr->shared, wr->num_shared, WR_TRUNC, &timetemp);
+    if (!error)
+        error = wr_devcall(ckt, wr->runs[wr->cur], wr->num_runs[wr->cur],
+                           WR_TRUNC, &timetemp);
+
+    *timeStep = MIN(2 * *timeStep, timetemp);
+    return error;
+}
+
+
+int
+CKTwrConvTest(CKTcircuit *ckt)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int error;
+
+    error = wr_devcall(ckt, wr->shared, wr->num_shared, WR_CONV, NULL);
+    if (!error && !ckt->CKTnoncon)
+        error = wr_devcall(ckt, wr->runs[wr->cur], wr->num_runs[wr->cur],
+                           WR_CONV, NULL);
+
+    return error;
+}
+
+
+/* Integrate block k from t0 to t1 on the circuit of its view, the
+ * timestep control of DCtran() */
+static int
+wr_solve(struct st_wavrel *m, int k, double t0, double t1)
+{
+    WRblock *b = &m->blocks[k];
+    struct st_wavrel *wr = b->view;
+    CKTcircuit *ckt = wr->ckt;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    double *temp, olddelta, newdelta;
+    int i, converged, error;
+
+    wr->cur = k;
+    for (i = 0; i <= ckt->CKTmaxOrder + 1; i++)
+        memcpy(ckt->CKTstates[i], b->states[i],
+               (size_t) ckt->CKTnumStates * sizeof(double));
+    memcpy(ckt->CKTrhsOld, m->x0, (size_t) (size + 1) * sizeof(double));
+    tfree(ckt->CKTbreaks);
+    ckt->CKTbreaks = TMALLOC(double, m->break_size);
+    memcpy(ckt->CKTbreaks, m->breaks, (size_t) m->break_size * sizeof(double));
+    ckt->CKTbreakSize = m->break_size;
+    ckt->CKTtime = t0;
+    ckt->CKTorder = b->order;
+    ckt->CKTdelta = b->delta;
+    ckt->CKTsaveDelta = b->save_delta;
+    memcpy(ckt->CKTdeltaOld, b->delta_old, sizeof(b->delta_old));
+    ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODETRAN | MODEINITPRED;
+    ckt->CKTbreak = 0;
+
+    b->num_points[m->sweep] = 0;
+    wr_record(ckt, b, m->sweep);
+
+    while (t1 - ckt->CKTtime > ckt->CKTminBreak) {
+        ckt->CKTdelta = MIN(ckt->CKTdelta, ckt->CKTmaxStep);
+
+        /* first timepoint after a breakpoint */
+        if (AlmostEqualUlps(ckt->CKTtime, ckt->CKTbreaks[0], 100) ||
+            ckt->CKTbreaks[0] - ckt->CKTtime <= ckt->CKTdelmin) {
+            ckt->CKTorder = 1;
+            ckt->CKTdelta = MIN(ckt->CKTdelta, .1 * MIN(ckt->CKTsaveDelta,
+                ckt->CKTbreaks[1] - ckt->CKTbreaks[0]));
+            ckt->CKTdelta = MAX(ckt->CKTdelta, ckt->CKTdelmin * 2.0);
+        }
+        while ((ckt->CKTbreaks[0] <= ckt->CKTtime + ckt->CKTminBreak ||
+                AlmostEqualUlps(ckt->CKTbreaks[0], ckt->CKTtime, 100)) &&
+               ckt->CKTbreaks[0] < ckt->CKTfinalTime)
+            CKTclrBreak(ckt);
+        if (ckt->CKTtime + ckt->CKTdelta > ckt->CKTbreaks[0]) {
+            ckt->CKTbreak = 1;
+            ckt->CKTsaveDelta = ckt->CKTdelta;
+            ckt->CKTdelta = ckt->CKTbreaks[0] - ckt->CKTtime;
+        }
+        /* land on the end of the window */
+        if (ckt->CKTtime + ckt->CKTdelta > t1 - ckt->CKTminBreak)
+            ckt->CKTdelta = t1 - ckt->CKTtime;
+
+        for (i = 5; i >= 0; i--)
+            ckt->CKTdeltaOld[i + 1] = ckt->CKTdeltaOld[i];
+        ckt->CKTdeltaOld[0] = ckt->CKTdelta;
+
+        temp = ckt->CKTstates[ckt->CKTmaxOrder + 1];
+        for (i = ckt->CKTmaxOrder; i >= 0; i--)
+            ckt->CKTstates[i + 1] = ckt->CKTstates[i];
+        ckt->CKTstates[0] = temp;
+
+        for (;;) {
+            olddelta = ckt->CKTdelta;
+            ckt->CKTtime += ckt->CKTdelta;
+            ckt->CKTdeltaOld[0] = ckt->CKTdelta;
+            NIcomCof(ckt);
+
+            converged = NIiter(ckt, ckt->CKTtranMaxIter);
+            ckt->CKTstat->STATtimePts++;
+            ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODETRAN | MODEINITPRED;
+
+            if (converged != 0) {
+                ckt->CKTtime -= ckt->CKTdelta;
+                ckt->CKTstat->STATrejected++;
+                ckt->CKTdelta /= 8;
+                ckt->CKTorder = 1;
+            } else {
+                newdelta = ckt->CKTdelta;
+                error = CKTtrunc(ckt, &newdelta);
+                if (error)
+                    return error;
+                if (newdelta > .9 * ckt->CKTdelta) {
+                    if (ckt->CKTorder == 1 && ckt->CKTmaxOrder > 1) {
+                        newdelta = ckt->CKTdelta;
+                        ckt->CKTorder = 2;
+                        error = CKTtrunc(ckt, &newdelta);
+                        if (error)
+                            return error;
+                        if (newdelta <= 1.05 * ckt->CKTdelta)
+                            ckt->CKTorder = 1;
+                    }
+                    ckt->CKTdelta = newdelta;
+                    break;
+                }
+                ckt->CKTtime -= ckt->CKTdelta;
+                ckt->CKTstat->STATrejected++;
+                ckt->CKTdelta = newdelta;
+            }
+
+            if (ckt->CKTdelta <= ckt->CKTdelmin) {
+                if (olddelta > ckt->CKTdelmin)
+                    ckt->CKTdelta = ckt->CKTdelmin;
+                else
+                    return E_TIMESTEP;
+            }
+        }
+
+        error = wr_devcall(ckt, wr->shared, wr->num_shared, WR_ACCEPT, NULL);
+        if (!error)
+            error = wr_devcall(ckt, wr->runs[k], wr->num_runs[k], WR_ACCEPT,
+                               NULL);
+        if (error)
+            return error;
+        if (ckt->CKTtime > ckt->CKTbreaks[0])
+            CKTclrBreak(ckt);
+        ckt->CKTbreak = 0;
+
+        wr_record(ckt, b, m->sweep);
+    }
+
+    for (i = 0; i <= ckt->CKTmaxOrder + 1; i++)
+        memcpy(b->states_end[i], ckt->CKTstates[i],
+               (size_t) ckt->CKTnumStates * sizeof(double));
+    b->order_end = ckt->CKTorder;
+    b->delta_end = ckt->CKTdelta;
+    b->save_delta_end = ckt->CKTsaveDelta;
+    memcpy(b->delta_old_end, ckt->CKTdeltaOld, sizeof(b->delta_old_end));
+
+    return OK;
+}
+
+
+/* Mark the unknowns of a block whose waveform s has moved against its
+ * waveform 1 - s by more than scale times the tolerances.  Has any of
+ * them? */
+static int
+wr_block_moved(CKTcircuit *ckt, WRblock *b, int s, double scale)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int i, j, moved = 0;
+
+    for (i = 0; i < b->num_unknowns; i++)
+        wr->changed[b->unknowns[i]] = 0;
+    for (j = 0; j < b->num_points[s]; j++) {
+        double *v = b->val[s] + (size_t) j * (size_t) b->num_unknowns;
+        wr_wave(b, 1 - s, b->time[s][j], wr->xw);
+        for (i = 0; i < b->num_unknowns; i++) {
+            int n = b->unknowns[i];
+            double x = v[i], y = wr->xw[n];
+            double tol = ckt->CKTreltol * MAX(fabs(x), fabs(y)) +
+                (wr->is_current[n] ? ckt->CKTabstol : ckt->CKTvoltTol);
+            if (fabs(x - y) > scale * tol) {
+                wr->changed[n] = 1;
+                moved = 1;
+            }
+        }
+    }
+
+    return moved;
+}
+
+
+/* Mark the unknowns whose waveforms of sweep s have moved against the
+ * sweep before.  Has any of them? */
+static int
+wr_moved(CKTcircuit *ckt, int s)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int k, moved = 0;
+
+    for (k = 0; k < wr->num_blocks; k++)
+        if (wr_block_moved(ckt, &wr->blocks[k], s, 1.0))
+            moved = 1;
+
+    return moved;
+}
+
+
+/* Has an unknown a block reads moved in the last sweep? */
+static int
+wr_stale(struct st_wavrel *wr, WRblock *b)
+{
+    int i;
+
+    for (i = 0; i < b->num_reads; i++)
+        if (wr->changed[b->reads[i]])
+            return 1;
+
+    return 0;
+}
+
+
+/* Copy the waveform from of a block to its waveform to */
+static void
+wr_copy(WRblock *b, int from, int to)
+{
+    wr_grow(b, to, b->num_points[from]);
+    b->num_points[to] = b->num_points[from];
+    memcpy(b->time[to], b->time[from],
+           (size_t) b->num_points[to] * sizeof(double));
+    memcpy(b->val[to], b->val[from], (size_t) b->num_points[to] *
+           (size_t) b->num_unknowns * sizeof(double));
+}
+
+
+/* The straight line from the values of the unknowns of a block at t0 with
+ * their last slopes, as its waveform 1 */
+static void
+wr_predict(struct st_wavrel *wr, WRblock *b, double t0, double t1)
+{
+    double *v0, *v1;
+    int i;
+
+    wr_grow(b, 1, 2);
+    b->num_points[1] = 2;
+    b->time[1][0] = t0;
+    b->time[1][1] = t1;
+    v0 = b->val[1];
+    v1 = v0 + b->num_unknowns;
+    for (i = 0; i < b->num_unknowns; i++) {
+        v0[i] = wr->x0[b->unknowns[i]];
+        v1[i] = v0[i] + b->slope[i] * (t1 - t0);
+    }
+}
+
+
+/* The slopes of the unknowns of a block over the step to point j of its
+ * waveform s */
+static void
+wr_slope(WRblock *b, int s, int j)
+{
+    double *v1 = b->val[s] + (size_t) j * (size_t) b->num_unknowns;
+    double *v0 = v1 - b->num_unknowns;
+    double h = b->time[s][j] - b->time[s][j - 1];
+    int i;
+
+    for (i = 0; i < b->num_unknowns; i++)
+        b->slope[i] = (v1[i] - v0[i]) / h;
+}
+
+
+static int
+wr_compare(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+
+/* Sweeps over the window from t0 on until the waveforms settle.  Its end
+ * is left in t1, the waveforms in 1 - wr->sweep. */
+static int
+wr_relax(CKTcircuit *ckt, double t0, double *t1)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    int k, sweep, settled = 0, error = OK;
+
+    for (;;) {
+        *t1 = t0 + wr->window;
+        if (*t1 > ckt->CKTfinalTime - ckt->CKTminBreak)
+            *t1 = ckt->CKTfinalTime;
+
+        /* the first sweep holds the unknowns at their values at t0 */
+        wr->sweep = 0;
+        ckt->CKTtime = t0;
+        memcpy(ckt->CKTrhsOld, wr->x0, (size_t) (size + 1) * sizeof(double));
+        for (k = 0; k < wr->num_blocks; k++) {
+            wr->blocks[k].num_points[1] = 0;
+            wr_record(ckt, &wr->blocks[k], 1);
+        }
+
+        for (sweep = 1; sweep <= WR_MAXSWEEP; sweep++) {
+            int solves = 0;
+            double t_end = *t1;
+            /* every block writes its waveforms of this sweep and reads the
+             * ones of the others of the sweep before */
+#ifdef USE_OMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) reduction(+:solves) if (wr->copies != NULL)
+#endif
+            for (k = 0; k < wr->num_blocks; k++) {
+                WRblock *b = &wr->blocks[k];
+                b->error = OK;
+                if (sweep > 1 && !wr_stale(wr, b)) {
+                    /* the same waveforms as in the last sweep */
+                    wr_copy(b, 1 - wr->sweep, wr->sweep);
+                    continue;
+                }
+                b->error = wr_solve(wr, k, t0, t_end);
+                solves++;
+            }
+            wr->solves += solves;
+            for (k = 0; k < wr->num_blocks && !error; k++)
+                error = wr->blocks[k].error;
+            if (error)
+                break;
+            wr->sweeps++;
+            settled = !wr_moved(ckt, wr->sweep);
+            wr->sweep = 1 - wr->sweep;
+            if (settled)
+                break;
+        }
+
+        if (settled)
+            break;
+        if (wr->window < 100 * ckt->CKTdelmin) {
+            if (error) {
+                errMsg = CKTtrouble(ckt, "Timestep too small");
+                return error;
+            }
+            /* go on with the last sweep */
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "waveform relaxation does not settle at time %g", t0);
+            break;
+        }
+        if (error != OK && error != E_TIMESTEP)
+            return error;
+        wr->window /= 4;
+        error = OK;
+    }
+
+    if (sweep <= 3)
+        wr->window = MIN(2 * wr->window, ckt->CKTfinalTime / 10);
+    else if (sweep > 6)
+        wr->window /= 2;
+
+    return OK;
+}
+
+
+/* One pass of the blocks in wr->order over the window from t0 on.  Its
+ * end is left in t1, the waveforms in 1 - wr->sweep. */
+static int
+wr_multirate(CKTcircuit *ckt, double t0, double *t1)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int i, j, k, p, tries, missed, reader, error = OK;
+
+    for (tries = 1; ; tries++) {
+        *t1 = t0 + wr->window;
+        if (*t1 > ckt->CKTfinalTime - ckt->CKTminBreak)
+            *t1 = ckt->CKTfinalTime;
+
+        /* the blocks write their waveforms 0 and are read in 1 */
+        wr->sweep = 0;
+        for (k = 0; k < wr->num_blocks; k++)
+            wr_predict(wr, &wr->blocks[k], t0, *t1);
+
+        /* the first block off its line and the first one which read it */
+        missed = reader = -1;
+        for (p = 0; p < wr->num_blocks; p++) {
+            WRblock *b = &wr->blocks[wr->order[p]];
+            error = wr_solve(wr, wr->order[p], t0, *t1);
+            wr->solves++;
+            if (error)
+                break;
+            /* the line is an error of the integration of the blocks which
+             * have read it, it is held to the truncation error */
+            if (missed < 0 && wr_block_moved(ckt, b, 0, ckt->CKTtrtol))
+                for (i = 0; i < p && missed < 0; i++) {
+                    WRblock *a = &wr->blocks[wr->order[i]];
+                    for (j = 0; j < a->num_reads; j++)
+                        if (wr->changed[a->reads[j]] &&
+                            wr->block[a->reads[j]] == wr->order[p]) {
+                            missed = p;
+                            reader = i;
+                            break;
+                        }
+                }
+            wr_copy(b, 0, 1);
+        }
+
+        if (missed < 0 && !error)
+            break;
+        if (wr->window < 100 * ckt->CKTdelmin ||
+            wr->window < 16 * ckt->CKTminBreak) {
+            if (error) {
+                errMsg = CKTtrouble(ckt, "Timestep too small");
+                return error;
+            }
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "multirate integration does not settle at time %g", t0);
+            break;
+        }
+        if (error != OK && error != E_TIMESTEP)
+            return error;
+        /* again with the slopes at the first step of the blocks */
+        for (i = 0; i < p; i++) {
+            WRblock *b = &wr->blocks[wr->order[i]];
+            if (b->num_points[0] > 1)
+                wr_slope(b, 0, 1);
+        }
+        if (missed >= 0) {
+            k = wr->order[missed];
+            memmove(wr->order + reader + 1, wr->order + reader,
+                    (size_t) (missed - reader) * sizeof(int));
+            wr->order[reader] = k;
+        }
+        wr->window /= 4;
+        error = OK;
+    }
+
+    wr->sweep = 1;
+    if (tries == 1)
+        wr->window = MIN(2 * wr->window, ckt->CKTfinalTime / 10);
+
+    return OK;
+}
+
+
+/* One window of the waveform relaxation or the multirate integration from
+ * CKTtime on.  The timepoints inside of the window are written to plot,
+ * the solution at its end is left in CKTrhsOld for DCtran() to accept. */
+int
+CKTwrWindow(CKTcircuit *ckt, runDesc *plot)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    double t0 = ckt->CKTtime, t1, *times, last;
+    int i, k, s, num, error;
+
+    memcpy(wr->x0, ckt->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+    tfree(wr->breaks);
+    wr->breaks = TMALLOC(double, ckt->CKTbreakSize);
+    memcpy(wr->breaks, ckt->CKTbreaks, (size_t) ckt->CKTbreakSize * sizeof(double));
+    wr->break_size = ckt->CKTbreakSize;
+
+    if (wr->multirate)
+        error = wr_multirate(ckt, t0, &t1);
+    else
+        error = wr_relax(ckt, t0, &t1);
+    if (error)
+        return error;
+
+    /* the waveforms of the last sweep, at all timepoints of the blocks */
+    s = 1 - wr->sweep;
+    num = 0;
+    for (k = 0; k < wr->num_blocks; k++)
+        num += wr->blocks[k].num_points[s];
+    times = TMALLOC(double, num);
+    num = 0;
+    for (k = 0; k < wr->num_blocks; k++) {
+        WRblock *b = &wr->blocks[k];
+        memcpy(times + num, b->time[s], (size_t) b->num_points[s] * sizeof(double));
+        num += b->num_points[s];
+    }
+    qsort(times, (size_t) num, sizeof(double), wr_compare);
+
+    last = t0;
+    for (i = 0; i < num; i++) {
+        if (times[i] - last <= ckt->CKTminBreak ||
+            times[i] >= t1 - ckt->CKTminBreak)
+            continue;
+        for (k = 0; k < wr->num_blocks; k++)
+            wr_wave(&wr->blocks[k], s, times[i], ckt->CKTrhsOld);
+        ckt->CKTtime = times[i];
+        if (ckt->CKTtime >= ckt->CKTinitTime)
+            CKTdump(ckt, ckt->CKTtime, plot);
+        last = times[i];
+    }
+    tfree(times);
+
+    for (k = 0; k < wr->num_blocks; k++) {
+        WRblock *b = &wr->blocks[k];
+        double **temp = b->states;
+        int n = b->num_points[s];
+        wr_wave(b, s, t1, ckt->CKTrhsOld);
+        b->states = b->states_end;
+        b->states_end = temp;
+        b->order = b->order_end;
+        b->delta = b->delta_end;
+        b->save_delta = b->save_delta_end;
+        memcpy(b->delta_old, b->delta_old_end, sizeof(b->delta_old));
+        b->steps += n - 1;
+        if (n > 1)
+            wr_slope(b, s, n - 1);
+    }
+    memcpy(ckt->CKTrhs, ckt->CKTrhsOld, (size_t) (size + 1) * sizeof(double));
+    ckt->CKTtime = t1;
+    wr->windows++;
+
+    /* the timepoints and iterations of the other circuits */
+    for (k = 0; k < wr->num_blocks; k++) {
+        CKTcircuit *c = wr->blocks[k].view->ckt;
+        if (c != ckt) {
+            ckt->CKTstat->STATtimePts += c->CKTstat->STATtimePts;
+            ckt->CKTstat->STATrejected += c->CKTstat->STATrejected;
+            ckt->CKTstat->STATnumIter += c->CKTstat->STATnumIter;
+            c->CKTstat->STATtimePts = 0;
+            c->CKTstat->STATrejected = 0;
+            c->CKTstat->STATnumIter = 0;
+        }
+    }
+
+    return OK;
+}
+
+
+void
+CKTwrDestroy(CKTcircuit *ckt)
+{
+    struct st_wavrel *wr = ckt->CKTwavrel;
+    int i, k;
+
+    if (!wr)
+        return;
+
+    if (wr->windows > 0 && wr->multirate)
+        SPfrontEnd->IFerrorf(ERR_INFO,
+            "multirate integration: %d windows, %.1f block integrations "
+            "per window", wr->windows, (double) wr->solves / wr->windows);
+    else if (wr->windows > 0)
+        SPfrontEnd->IFerrorf(ERR_INFO,
+            "waveform relaxation: %d windows, %.1f sweeps and %.1f block "
+            "integrations per window", wr->windows,
+            (double) wr->sweeps / wr->windows,
+            (double) wr->solves / wr->windows);
+
+    /* the timepoints of the blocks, for 'rusage blocksteps' */
+    if (wr->windows > 0) {
+        size_t len = 1;
+        char *steps;
+        for (k = 0; k < wr->num_blocks; k++)
+            len += strlen(wr->blocks[k].name) + 16;
+        steps = TMALLOC(char, len);
+        for (k = 0; k < wr->num_blocks; k++)
+            sprintf(steps + strlen(steps), "%s%s %d", k ? ", " : "",
+                    wr->blocks[k].name, wr->blocks[k].steps);
+        tfree(ckt->CKTwrSteps);
+        ckt->CKTwrSteps = steps;
+    }
+
+#ifdef USE_OMP
+    wr_copies_free(wr);
+#endif
+    wr_view_free(wr);
+
+    for (k = 0; k < wr->num_blocks; k++) {
+        WRblock *b = &wr->blocks[k];
+        tfree(b->name);
+        tfree(b->unknowns);
+        tfree(b->reads);
+        tfree(b->slope);
+        if (b->states)
+            for (i = 0; i <= ckt->CKTmaxOrder + 1; i++) {
+                tfree(b->states[i]);
+                tfree(b->states_end[i]);
+            }
+        tfree(b->states);
+        tfree(b->states_end);
+        for (i = 0; i < 2; i++) {
+            tfree(b->time[i]);
+            tfree(b->val[i]);
+        }
+    }
+    tfree(wr->blocks);
+    tfree(wr->order);
+    tfree(wr->block);
+    tfree(wr->is_current);
+    tfree(wr->changed);
+    tfree(wr->x0);
+    tfree(wr->breaks);
+    tfree(wr);
+    ckt->CKTwavrel = NULL;
+}
@@ -120,6 +120,13 @@ DCpss(CKTcircuit *ckt,
     double *psstimes, *pssvalues;
     double *RHS_max, *RHS_min, *err_conv ;
 
+    /* Newton-Krylov shooting */
+    PSStrace trace ;
+    int krylov, newton, shoot_restart = 0 ;
+    double *err_tol, *x_shoot, *x_base, *shoot_dx, *x_end, *states_end ;
+    double delta_end = 0 ;
+    double shoot_period = 0, base_period = 0, shoot_lambda = 1, shoot_err = HUGE_VAL ;
+
     /* Francesco Lannutti's MOD */
     /* Stuff needed by frequency estimation reiteration, based on the DFT result */
     int position;
@@ -155,6 +162,15 @@ DCpss(CKTcircuit *ckt,
     RHS_max = TMALLOC (double, msize) ;
     RHS_min = TMALLOC (double, msize) ;
     err_conv = TMALLOC (double, msize) ;
+    err_tol = TMALLOC (double, msize) ;
+    x_shoot = TMALLOC (double, msize + 1) ;
+    x_base = TMALLOC (double, msize + 1) ;
+    shoot_dx = TMALLOC (double, msize + 1) ;
+    x_end = TMALLOC (double, msize + 1) ;
+    states_end = TMALLOC (double, ckt->CKTnumStates) ;
+
+    memset (&trace, 0, sizeof (trace)) ;
+    krylov = PSSshootSupported (ckt) ;
     
     for (i = 0 ; i < msize ; i++)
     {
@@ -588,6 +604,10 @@ DCpss(CKTcircuit *ckt,
                 RHS_max [i] = -HUGE_VAL ;
                 RHS_min [i] = HUGE_VAL ;
             }
+
+            /* First point of the period for the Newton-Krylov shooting */
+            if (krylov)
+                PSStraceAdd (ckt, &trace, save_order) ;
 	}
     }
     break;
@@ -595,6 +615,10 @@ DCpss(CKTcircuit *ckt,
     case SHOOTING:
     {
         double offset, interval, nextBreak ;
+
+        if (krylov)
+            PSStraceAdd (ckt, &trace, save_order) ;
+
         /* Calculation of error norms of RHS solution of every accepted nextTime */
         err = 0 ;
         for (i = 0 ; i < msize ; i++)
@@ -765,8 +789,9 @@ DCpss(CKTcircuit *ckt,
                 /* Voltage Node */
                 if (!strchr (node->name, '#'))
                 {
-                    if (fabs (err_conv [i]) > (fabs (RHS_max [i] - RHS_min [i]) * ckt->CKTreltol + ckt->CKTvoltTol) *
-                        ckt->CKTtrtol * ckt->CKTsteady_coeff)
+                    err_tol [i] = (fabs (RHS_max [i] - RHS_min [i]) * ckt->CKTreltol + ckt->CKTvoltTol) *
+                        ckt->CKTtrtol * ckt->CKTsteady_coeff ;
+                    if (fabs (err_conv [i]) > err_tol [i])
                     {
                         excessive_err_nodes++ ;
                     }
@@ -779,8 +804,9 @@ DCpss(CKTcircuit *ckt,
 
                 /* Current Node */
                 } else {
-                    if (fabs (err_conv [i]) > (fabs (RHS_max [i] - RHS_min [i]) * ckt->CKTreltol + ckt->CKTabstol) *
-                        ckt->CKTtrtol * ckt->CKTsteady_coeff)
+                    err_tol [i] = (fabs (RHS_max [i] - RHS_min [i]) * ckt->CKTreltol + ckt->CKTabstol) *
+                        ckt->CKTtrtol * ckt->CKTsteady_coeff ;
+                    if (fabs (err_conv [i]) > err_tol [i])
                     {
                         excessive_err_nodes++ ;
                     }
@@ -793,6 +819,47 @@ DCpss(CKTcircuit *ckt,
                 }
             }
 
+            /* Newton-Krylov step on the initial state and the period */
+            newton = 0 ;
+            shoot_restart = 0 ;
+            if (krylov && (dynamic_test > 0) && (excessive_err_nodes > 0) && (shooting_cycle_counter < ckt->CKTsc_iter))
+            {
+                if ((err >= shoot_err) && (shoot_lambda > 1.0 / 64))
+                {
+                    /* The last step has not reduced the residual: go back to its start with a shorter step */
+                    shoot_lambda /= 4 ;
+                    newton = 1 ;
+                }
+                else if (PSSshootStep (ckt, &trace, oscnNode, err_conv, err_tol, shoot_dx) == OK)
+                {
+                    for (i = 1 ; i <= msize ; i++)
+                        x_base [i] = trace.sol [0] [i] ;
+                    base_period = trace.time [trace.num_points - 1] - trace.time [0] ;
+                    shoot_err = err ;
+                    shoot_lambda = MIN (2 * shoot_lambda, 1.0) ;
+                    newton = 1 ;
+                }
+
+                if (newton)
+                {
+                    /* Keep the period in a sensible range, and the steps of the state within the dynamic of the last period */
+                    if (shoot_lambda * fabs (shoot_dx [oscnNode]) > 0.25 * base_period)
+                        shoot_lambda = 0.25 * base_period / fabs (shoot_dx [oscnNode]) ;
+                    for (i = 1 ; i <= msize ; i++)
+                    {
+                        double range = RHS_max [i - 1] - RHS_min [i - 1] + err_tol [i - 1] ;
+                        if ((i != oscnNode) && (shoot_lambda * fabs (shoot_dx [i]) > range))
+                            shoot_lambda = range / fabs (shoot_dx [i]) ;
+                    }
+
+                    for (i = 1 ; i <= msize ; i++)
+                        x_shoot [i] = (i == oscnNode) ? x_base [i] : x_base [i] + shoot_lambda * shoot_dx [i] ;
+                    shoot_period = base_period + shoot_lambda * shoot_dx [oscnNode] ;
+
+                    fprintf (stderr, "Newton-Krylov shooting step %g, period %1.10g\n", shoot_lambda, shoot_period) ;
+                }
+            }
+
             if (dynamic_test == 0)
             {
                 /* Test for dynamic existence */
@@ -805,11 +872,18 @@ DCpss(CKTcircuit *ckt,
                 FREE (RHS_max) ;
                 FREE (RHS_min) ;
                 FREE (err_conv) ;
+                FREE (err_tol) ;
+                FREE (x_shoot) ;
+                FREE (x_base) ;
+                FREE (shoot_dx) ;
+                FREE (x_end) ;
+                FREE (states_end) ;
+                PSStraceFree (&trace) ;
                 FREE (psstimes) ;
                 FREE (pssvalues) ;
                 return (E_PANIC) ; /* to be corrected with definition of new error macro in iferrmsg.h */
             }
-            else if ((time_err_min_0 - time_temp) < 0)
+            else if (!newton && ((time_err_min_0 - time_temp) < 0))
             {
                 /* Something has gone wrong... */
                 fprintf (stderr, "Cannot find a minimum for error vector in estimated period. Try to adjust tstab! PSS analysis aborted\n") ;
@@ -821,6 +895,13 @@ DCpss(CKTcircuit *ckt,
                 FREE (RHS_max) ;
                 FREE (RHS_min) ;
                 FREE (err_conv) ;
+                FREE (err_tol) ;
+                FREE (x_shoot) ;
+                FREE (x_base) ;
+                FREE (shoot_dx) ;
+                FREE (x_end) ;
+                FREE (states_end) ;
+                PSStraceFree (&trace) ;
                 FREE (psstimes) ;
                 FREE (pssvalues) ;
                 return (E_PANIC) ; /* to be corrected with definition of new error macro in iferrmsg.h */
@@ -840,7 +921,12 @@ DCpss(CKTcircuit *ckt,
             /***********************************/
             /*** FREQUENCY ESTIMATION UPDATE ***/
             /***********************************/
-            if ((err_min_0 == err) || (err_min_0 == HUGE_VAL))
+            if (newton)
+            {
+                /* The period comes with the Newton step */
+                ckt->CKTguessedFreq = 1 / shoot_period ;
+
+            } else if ((err_min_0 == err) || (err_min_0 == HUGE_VAL))
             {
                 /* Enters here if guessed frequency is higher than the 'real' value */
                 ckt->CKTguessedFreq = 1 / (1 / ckt->CKTguessedFreq + fabs (predsum)) ;
@@ -888,6 +974,35 @@ DCpss(CKTcircuit *ckt,
             for (i = 1 ; i <= msize ; i++)
                 RHS_copy_se [i - 1] = ckt->CKTrhsOld [i] ;
 
+            /* The next period starts from the state corrected by Newton */
+            if (newton)
+            {
+                /* Keep the end of the period, in case the transient cannot follow the step */
+                for (i = 1 ; i <= msize ; i++)
+                    x_end [i] = ckt->CKTrhsOld [i] ;
+                memcpy (states_end, ckt->CKTstate0, (size_t) ckt->CKTnumStates * sizeof (double)) ;
+                delta_end = ckt->CKTdelta ;
+                shoot_restart = 1 ;
+
+                error = PSSshootRestart (ckt, x_shoot) ;
+                if (error)
+                {
+                    UPDATE_STATS (DOING_TRAN) ;
+                    return (error) ;
+                }
+                for (i = 1 ; i <= msize ; i++)
+                {
+                    RHS_copy_se [i - 1] = x_shoot [i] ;
+                    RHS_copy_der [i - 1] = x_shoot [i] ;
+                }
+            }
+
+            if (krylov)
+            {
+                trace.num_points = 0 ;
+                PSStraceAdd (ckt, &trace, save_order) ;
+            }
+
 #ifdef STEPDEBUG
             fprintf (stderr, "RHS on new shooting cycle: ") ;
             for (i = 0 ; i < msize ; i++)
@@ -1087,6 +1202,13 @@ DCpss(CKTcircuit *ckt,
             FREE (RHS_max) ;
             FREE (RHS_min) ;
             FREE (err_conv) ;
+            FREE (err_tol) ;
+            FREE (x_shoot) ;
+            FREE (x_base) ;
+            FREE (shoot_dx) ;
+            FREE (x_end) ;
+            FREE (states_end) ;
+            PSStraceFree (&trace) ;
             FREE (psstimes) ;
             FREE (pssvalues) ;
             return (OK) ;
@@ -1492,6 +1614,33 @@ resume:
 #ifdef STEPDEBUG
                 fprintf (stderr, "delta at delmin\n");
 #endif
+            } else if (shoot_restart) {
+                /* The transient cannot follow the Newton step: start the
+                 * period again from where the last one ended, and go on
+                 * with the frequency estimation alone */
+                fprintf (stderr, "Newton-Krylov shooting step rejected, going on without it\n") ;
+                krylov = 0 ;
+                shoot_restart = 0 ;
+                trace.num_points = 0 ;
+                for (i = 1 ; i <= msize ; i++)
+                {
+                    ckt->CKTrhsOld [i] = x_end [i] ;
+                    RHS_copy_se [i - 1] = x_end [i] ;
+                    RHS_copy_der [i - 1] = x_end [i] ;
+                    RHS_max [i - 1] = -HUGE_VAL ;
+                    RHS_min [i - 1] = HUGE_VAL ;
+                }
+                for (i = 0 ; i <= ckt->CKTmaxOrder + 1 ; i++)
+                    memcpy (ckt->CKTstates [i], states_end, (size_t) ckt->CKTnumStates * sizeof (double)) ;
+                err_min_0 = HUGE_VAL ;
+                err_max = -HUGE_VAL ;
+                err_0 = HUGE_VAL ;
+                err_1 = -HUGE_VAL ;
+                ckt->CKTtime = time_temp ;
+                ckt->CKTorder = 1 ;
+                ckt->CKTdelta = delta_end ;
+                for (i = 0 ; i < 7 ; i++)
+                    ckt->CKTdeltaOld [i] = delta_end ;
             } else {
                 UPDATE_STATS(DOING_TRAN);
                 errMsg = CKTtrouble(ckt, "Timestep too small");
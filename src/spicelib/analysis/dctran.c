@@ -7,12 +7,16 @@ Modified: 2000  AlansFixes
 /* subroutine to do DC TRANSIENT analysis
         --- ONLY, unlike spice2 routine with the same name! */
 
+#include <time.h>
+
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
 #include "cktaccept.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/fteext.h"
+#include "ngspice/cpextern.h"
+#include "ngspice/sensdefs.h"
 #include "ngspice/missing_math.h"
 
 /* for setting breakpoints required by dbs data base */
@@ -87,7 +91,7 @@ DCtran(CKTcircuit *ckt,
     int save, save2, size;
     long save1;
 #endif
-    int save_order;
+    int save_order = 0;
     long save_mode;
     IFuid timeUid;
     IFuid *nameList;
@@ -96,6 +100,11 @@ DCtran(CKTcircuit *ckt,
 
     int ltra_num;
     CKTnode *node;
+    char ckpt_file[BSIZE_SP], restart_file[BSIZE_SP];
+    int ckpt_interval = 600;
+    bool ckpt;
+    time_t ckpt_last;
+    bool wr_setup = TRUE;
 #ifdef XSPICE
 /* gtri - add - wbk - 12/19/90 - Add IPC stuff */
     Ipc_Boolean_t  ipc_firsttime = IPC_TRUE;
@@ -108,6 +117,12 @@ DCtran(CKTcircuit *ckt,
 #if defined CLUSTER || defined SHARED_MODULE
     int redostep;
 #endif
+
+    /* periodic checkpoints, see cktcheckpt.c */
+    ckpt = cp_getvar("tran_checkpoint", CP_STRING, ckpt_file, sizeof(ckpt_file));
+    cp_getvar("tran_checkpoint_time", CP_NUM, &ckpt_interval, 0);
+    ckpt_last = time(NULL);
+
     if(restart || ckt->CKTtime == 0) {
         delta=MIN(ckt->CKTfinalTime/100,ckt->CKTstep)/10;
 
@@ -177,6 +192,12 @@ DCtran(CKTcircuit *ckt,
         if (ckt->CKTsoaCheck)
             error = CKTsoaInit();
 
+        /* blocks of a previous relaxation transient */
+        CKTwrDestroy(ckt);
+
+        /* the charge states of the devices may differ after altermod */
+        CKTtruncDestroy(ckt);
+
         ckt->CKTtime = 0;
         ckt->CKTdelta = 0;
         ckt->CKTbreak = 1;
@@ -199,6 +220,29 @@ DCtran(CKTcircuit *ckt,
                 }
         }
 
+        /* continue from a checkpoint instead of computing the op */
+        if (cp_getvar("tran_restart", CP_STRING, restart_file, sizeof(restart_file))) {
+            error = CKTcheckpointRead(ckt, restart_file);
+            /* one restart only, the next transient starts at zero */
+            cp_remvar("tran_restart");
+            if (error) {
+                SPfrontEnd->OUTendPlot(job->TRANplot);
+                job->TRANplot = NULL;
+                return(error);
+            }
+#ifdef XSPICE
+            g_mif_info.circuit.anal_init = MIF_TRUE;
+            g_mif_info.circuit.anal_type = MIF_TRAN;
+            g_mif_info.breakpoint.current = 1.0e30;
+            g_mif_info.breakpoint.last    = 1.0e30;
+#endif
+            ckt->CKTmode = (ckt->CKTmode&MODEUIC) | MODETRAN | MODEINITPRED;
+            firsttime = 0;
+            INIT_STATS();
+            CKTdump(ckt, ckt->CKTtime, job->TRANplot);
+            goto resume;
+        }
+
 #ifdef XSPICE
 /* gtri - begin - wbk - set a breakpoint at end of supply ramping time */
         /* must do this after CKTtime set to 0 above */
@@ -372,6 +416,15 @@ DCtran(CKTcircuit *ckt,
     }
     /* end LTRA code addition */
 
+    /* record the solution for the transient sensitivity */
+    if (ckt->CKTsenTrace) {
+        error = sens_trace(ckt, save_order);
+        if (error) {
+            UPDATE_STATS(DOING_TRAN);
+            return(error);
+        }
+    }
+
     error = CKTaccept(ckt);
     /* check if current breakpoint is outdated; if so, clear */
     if (ckt->CKTtime > ckt->CKTbreaks[0]) CKTclrBreak(ckt);
@@ -402,6 +455,11 @@ DCtran(CKTcircuit *ckt,
         UPDATE_STATS(DOING_TRAN);
         return(error);
     }
+    /* waveform relaxation or multirate from the first timepoint on */
+    if ((ckt->CKTwaveRelax || ckt->CKTmultiRate) && wr_setup && !ckt->CKTwavrel && ckt->CKTtime > 0) {
+        wr_setup = FALSE;
+        (void) CKTwrSetup(ckt);
+    }
 #ifdef XSPICE
 /* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
 
@@ -466,6 +524,12 @@ DCtran(CKTcircuit *ckt,
 /* gtri - end - wbk - Update event queues/data for accepted timepoint */
 #endif
     ckt->CKTstat->STAToldIter = ckt->CKTstat->STATnumIter;
+    if (ckpt && !ckt->CKTwavrel &&
+        difftime(time(NULL), ckpt_last) >= ckpt_interval) {
+        if (CKTcheckpointWrite(ckt, ckpt_file) != OK)
+            ckpt = FALSE;
+        ckpt_last = time(NULL);
+    }
     if (check_autostop("tran") ||
         ckt->CKTfinalTime - ckt->CKTtime < ckt->CKTminBreak) {
 #ifdef STEPDEBUG
@@ -475,6 +539,7 @@ DCtran(CKTcircuit *ckt,
         SPfrontEnd->OUTendPlot (job->TRANplot);
         job->TRANplot = NULL;
         UPDATE_STATS(0);
+        CKTwrDestroy(ckt);
 #ifdef WANT_SENSE2
         if(ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & TRANSEN)){
             ckt->CKTsenInfo->SENmode = save;
@@ -488,6 +553,15 @@ DCtran(CKTcircuit *ckt,
         return(E_PAUSE);
     }
 resume:
+    /* the waveform relaxation integrates a window of timepoints */
+    if (ckt->CKTwavrel) {
+        error = CKTwrWindow(ckt, job->TRANplot);
+        if (error) {
+            UPDATE_STATS(DOING_TRAN);
+            return(error);
+        }
+        goto nextTime;
+    }
 #ifdef STEPDEBUG
     if( (ckt->CKTdelta <= ckt->CKTfinalTime/50) &&
         (ckt->CKTdelta <= ckt->CKTmaxStep)) {
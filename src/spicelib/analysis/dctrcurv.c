@@ -202,6 +202,17 @@ DCtrCurv(CKTcircuit *ckt, int restart)
     if (error)
         return(error);
 
+    /* With option dcseed the first point of an inner sweep is seeded by
+     * the first point of the previous one, a single step of the outer
+     * source away, instead of starting from the junction voltages again. */
+    tfree(job->TRCVseedRhs);
+    tfree(job->TRCVseedState);
+    job->TRCVseedValid = 0;
+    if (ckt->CKTdcSeed && job->TRCVnestLevel > 0) {
+        job->TRCVseedRhs = TMALLOC(double, SMPmatSize(ckt->CKTmatrix) + 1);
+        job->TRCVseedState = TMALLOC(double, ckt->CKTnumStates);
+    }
+
     /* initialize CKTsoaCheck `warn' counters */
     if (ckt->CKTsoaCheck)
         error = CKTsoaInit();
@@ -297,6 +308,13 @@ DCtrCurv(CKTcircuit *ckt, int restart)
         if (ckt->evt->counts.num_insts == 0) {
             /* If no event-driven instances, do what SPICE normally does */
 #endif
+            if (firstTime && job->TRCVseedValid) {
+                memcpy(ckt->CKTrhsOld, job->TRCVseedRhs,
+                       (size_t) (SMPmatSize(ckt->CKTmatrix) + 1) * sizeof(double));
+                memcpy(ckt->CKTstate0, job->TRCVseedState,
+                       (size_t) ckt->CKTnumStates * sizeof(double));
+                ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEDCTRANCURVE | MODEINITFLOAT;
+            }
             converged = NIiter(ckt, ckt->CKTdcTrcvMaxIter);
             if (converged != 0) {
                 converged = CKTop(ckt,
@@ -446,6 +464,13 @@ DCtrCurv(CKTcircuit *ckt, int restart)
             firstTime = 0;
             memcpy(ckt->CKTstate1, ckt->CKTstate0,
                    (size_t) ckt->CKTnumStates * sizeof(double));
+            if (job->TRCVseedRhs) {
+                memcpy(job->TRCVseedRhs, ckt->CKTrhsOld,
+                       (size_t) (SMPmatSize(ckt->CKTmatrix) + 1) * sizeof(double));
+                memcpy(job->TRCVseedState, ckt->CKTstate0,
+                       (size_t) ckt->CKTnumStates * sizeof(double));
+                job->TRCVseedValid = 1;
+            }
         }
 
         i = 0;
@@ -504,6 +529,10 @@ DCtrCurv(CKTcircuit *ckt, int restart)
             CKTtemp(ckt);
         }
 
+    tfree(job->TRCVseedRhs);
+    tfree(job->TRCVseedState);
+    job->TRCVseedValid = 0;
+
     SPfrontEnd->OUTendPlot (plot);
 
     return(OK);
@@ -0,0 +1,800 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Harmonic balance analysis.
+ *
+ *	.hb f0 nharm <points>
+ *
+ * finds the periodic steady state of a circuit driven at the fundamental
+ * f0 (single tone), as a truncated Fourier series with nharm harmonics.
+ * The waveforms are held as <points> equidistant samples per period, by
+ * default the smallest power of two not below 4 * nharm, and restricted
+ * to the harmonics 0 ... nharm after every step.
+ *
+ * The devices are evaluated in the time domain by the transient loads.
+ * At each sample two loads, with ag0 = 0 and ag0 = 1, give the static
+ * currents i(x) and the charges q(x) and their Jacobians G = di/dx and
+ * C = dq/dx.  The residual of the HB equations is
+ *
+ *	F(x) = P (i(x) + D q(x))
+ *
+ * with D the spectral derivative and P the projection onto the retained
+ * harmonics.  Newton's method solves F = 0, each step J dx = -F with
+ *
+ *	J v = P (G_n v_n + D C_n v_n)
+ *
+ * by restarted GMRES.  The HB Jacobian is never formed: J v takes one
+ * sparse product per sample with copies of the loaded matrices, and an
+ * FFT per unknown, so memory stays linear in circuit size times samples.
+ * G_n and C_n are kept for all samples, because GMRES needs up to
+ * HB_MAXMV products per Newton step and each would otherwise cost two
+ * device loads per sample.  The copies hold twice the circuit matrix
+ * per sample, and HB refuses to start if they would exceed HB_MAXMEM.
+ * GMRES is preconditioned by the block diagonal of J at the operating
+ * point, which for harmonic k is the AC matrix G + j k w0 C as loaded by
+ * CKTacLoad(), factored once per harmonic on private clones of the
+ * circuit matrix (see cktacslot.c).
+ *
+ * The results are a time domain plot of one period and a spectrum plot,
+ * which holds the complex amplitudes of the harmonics in the convention
+ * of the AC analysis, x(t) = Re(X_k exp(j k w0 t)).
+ *
+ * Sources have to be periodic with f0.  Devices with a private history
+ * (LTRA, TXL and CPL lines) and XSPICE event-driven instances are not
+ * supported.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/acdefs.h"
+#include "ngspice/hbdefs.h"
+#include "ngspice/spmatrix.h"
+#include "ngspice/sperror.h"
+#include "ngspice/fftext.h"
+
+#ifdef XSPICE
+#include "ngspice/evt.h"
+#include "ngspice/mif.h"
+#endif
+
+#ifdef WITH_HB
+
+#define HB_RESTART  30      /* GMRES restart length */
+#define HB_MAXMV    300     /* GMRES matrix vector products per Newton step */
+#define HB_GMRESTOL 1e-6    /* relative residual of the inner solve */
+#define HB_MAXMEM   (1024.0 * 1024.0 * 1024.0)
+                            /* bytes for the per sample matrices */
+#define HB_ELTBYTES 48      /* bytes per matrix element, about */
+
+
+typedef struct {
+    CKTcircuit *ckt;
+    int size;           /* size of the circuit matrix */
+    int stride;         /* size + 1, a sample is laid out as CKTrhs */
+    int len;            /* stride * N, length of a HB vector */
+    int N;              /* samples per period */
+    int M;              /* log2(N) */
+    int K;              /* number of harmonics */
+    double omega;       /* 2 pi f0 */
+    SMPmatrix **G;      /* G_n, per sample */
+    SMPmatrix **GC;     /* G_n + C_n, per sample */
+    ACslots pre;        /* G + j k w0 C at the operating point, per harmonic */
+    double *fa, *fb;    /* FFT buffers, one row of N per unknown */
+    double *tmp;
+    double **states;    /* CKTstate0, per sample */
+    double *save;       /* one state vector */
+    double *F, *Q, *dX; /* residual, charges and Newton step */
+    double *F0;         /* residual at the operating point */
+    double *tol;        /* absolute tolerance per unknown */
+} HBsys;
+
+
+/* a <- P (a + D b), b may be NULL, b is destroyed */
+static void
+hb_combine(HBsys *hb, double *a, double *b)
+{
+    int N = hb->N, size = hb->size, stride = hb->stride;
+    int i, n, k;
+
+    for (i = 1; i <= size; i++)
+        for (n = 0; n < N; n++) {
+            hb->fa[(i - 1) * N + n] = a[n * stride + i];
+            if (b)
+                hb->fb[(i - 1) * N + n] = b[n * stride + i];
+        }
+
+    rffts(hb->fa, hb->M, size);
+    if (b)
+        rffts(hb->fb, hb->M, size);
+
+    for (i = 0; i < size; i++) {
+        double *fa = hb->fa + i * N;
+        double *fb = hb->fb + i * N;
+
+        /* bin 0 holds DC and Nyquist, k > 0 at 2k and 2k + 1 */
+        fa[1] = 0.0;
+        for (k = 1; k < N / 2; k++) {
+            if (k > hb->K) {
+                fa[2 * k] = fa[2 * k + 1] = 0.0;
+            } else if (b) {
+                double wk = k * hb->omega;
+                fa[2 * k] -= wk * fb[2 * k + 1];
+                fa[2 * k + 1] += wk * fb[2 * k];
+            }
+        }
+    }
+
+    riffts(hb->fa, hb->M, size);
+
+    for (n = 0; n < N; n++) {
+        a[n * stride] = 0.0;
+        for (i = 1; i <= size; i++)
+            a[n * stride + i] = hb->fa[(i - 1) * N + n];
+    }
+}
+
+
+/* y = J v */
+static void
+hb_matvec(HBsys *hb, double *v, double *y)
+{
+    int n, i;
+
+#ifdef USE_OMP
+#pragma omp parallel for private(i)
+#endif
+    for (n = 0; n < hb->N; n++) {
+        double *vn = v + n * hb->stride;
+        double *yn = y + n * hb->stride;
+        double *tn = hb->tmp + n * hb->stride;
+
+        SMPmultiply(hb->G[n], yn, vn, NULL, NULL);
+        SMPmultiply(hb->GC[n], tn, vn, NULL, NULL);
+        for (i = 1; i <= hb->size; i++)
+            tn[i] -= yn[i];
+    }
+
+    hb_combine(hb, y, hb->tmp);
+}
+
+
+/* w <- M^-1 w, harmonic by harmonic with the AC matrices */
+static void
+hb_precond(HBsys *hb, double *w)
+{
+    int N = hb->N, size = hb->size, stride = hb->stride;
+    int i, n, k;
+
+    for (i = 1; i <= size; i++)
+        for (n = 0; n < N; n++)
+            hb->fa[(i - 1) * N + n] = w[n * stride + i];
+
+    rffts(hb->fa, hb->M, size);
+
+#ifdef USE_OMP
+#pragma omp parallel for private(i) schedule(dynamic, 1)
+#endif
+    for (k = 0; k <= hb->K; k++) {
+        ACslot *slot = &hb->pre.slots[k];
+
+        slot->rhs[0] = slot->irhs[0] = 0.0;
+        for (i = 1; i <= size; i++) {
+            slot->rhs[i] = hb->fa[(i - 1) * N + 2 * k];
+            slot->irhs[i] = k ? hb->fa[(i - 1) * N + 2 * k + 1] : 0.0;
+        }
+        SMPcSolve(slot->matrix, slot->rhs, slot->irhs, NULL, NULL);
+        for (i = 1; i <= size; i++) {
+            hb->fa[(i - 1) * N + 2 * k] = slot->rhs[i];
+            if (k)
+                hb->fa[(i - 1) * N + 2 * k + 1] = slot->irhs[i];
+        }
+    }
+
+    for (i = 0; i < size; i++) {
+        double *fa = hb->fa + i * N;
+        fa[1] = 0.0;
+        for (k = hb->K + 1; k < N / 2; k++)
+            fa[2 * k] = fa[2 * k + 1] = 0.0;
+    }
+
+    riffts(hb->fa, hb->M, size);
+
+    for (n = 0; n < N; n++)
+        for (i = 1; i <= size; i++)
+            w[n * stride + i] = hb->fa[(i - 1) * N + n];
+}
+
+
+static double
+hb_dot(HBsys *hb, double *a, double *b)
+{
+    double sum = 0.0;
+    int j;
+
+    for (j = 0; j < hb->len; j++)
+        sum += a[j] * b[j];
+    return sum;
+}
+
+
+/* Solve J x = b by GMRES, preconditioned from the right */
+static void
+hb_gmres(HBsys *hb, double *b, double *x)
+{
+    int m = HB_RESTART, len = hb->len;
+    double **V = TMALLOC(double *, m + 1);
+    double *H = TMALLOC(double, (m + 1) * m);
+    double *cs = TMALLOC(double, m);
+    double *sn = TMALLOC(double, m);
+    double *g = TMALLOC(double, m + 1);
+    double *y = TMALLOC(double, m);
+    double *z = TMALLOC(double, len);
+    double bnorm, beta;
+    int i, j, l, mv = 0;
+
+    for (j = 0; j <= m; j++)
+        V[j] = TMALLOC(double, len);
+    for (l = 0; l < len; l++)
+        x[l] = 0.0;
+
+    bnorm = sqrt(hb_dot(hb, b, b));
+    memcpy(V[0], b, (size_t) len * sizeof(double));
+    beta = bnorm;
+
+    while (beta > HB_GMRESTOL * bnorm && mv < HB_MAXMV) {
+
+        for (l = 0; l < len; l++)
+            V[0][l] /= beta;
+        g[0] = beta;
+
+        for (j = 0; j < m && mv < HB_MAXMV; j++) {
+            memcpy(z, V[j], (size_t) len * sizeof(double));
+            hb_precond(hb, z);
+            hb_matvec(hb, z, V[j + 1]);
+            mv++;
+
+            /* modified Gram-Schmidt */
+            for (i = 0; i <= j; i++) {
+                double h = hb_dot(hb, V[j + 1], V[i]);
+                H[i * m + j] = h;
+                for (l = 0; l < len; l++)
+                    V[j + 1][l] -= h * V[i][l];
+            }
+            H[(j + 1) * m + j] = sqrt(hb_dot(hb, V[j + 1], V[j + 1]));
+            if (H[(j + 1) * m + j] != 0.0)
+                for (l = 0; l < len; l++)
+                    V[j + 1][l] /= H[(j + 1) * m + j];
+
+            /* Givens rotations */
+            for (i = 0; i < j; i++) {
+                double t = cs[i] * H[i * m + j] + sn[i] * H[(i + 1) * m + j];
+                H[(i + 1) * m + j] = -sn[i] * H[i * m + j] +
+                    cs[i] * H[(i + 1) * m + j];
+                H[i * m + j] = t;
+            }
+            {
+                double a = H[j * m + j], c = H[(j + 1) * m + j];
+                double r = hypot(a, c);
+                cs[j] = r != 0.0 ? a / r : 1.0;
+                sn[j] = r != 0.0 ? c / r : 0.0;
+                H[j * m + j] = r;
+                H[(j + 1) * m + j] = 0.0;
+                g[j + 1] = -sn[j] * g[j];
+                g[j] = cs[j] * g[j];
+            }
+
+            if (fabs(g[j + 1]) <= HB_GMRESTOL * bnorm) {
+                j++;
+                break;
+            }
+        }
+
+        /* x += M^-1 V y */
+        for (i = j - 1; i >= 0; i--) {
+            double s = g[i];
+            for (l = i + 1; l < j; l++)
+                s -= H[i * m + l] * y[l];
+            y[i] = H[i * m + i] != 0.0 ? s / H[i * m + i] : 0.0;
+        }
+        for (l = 0; l < len; l++)
+            z[l] = 0.0;
+        for (i = 0; i < j; i++)
+            for (l = 0; l < len; l++)
+                z[l] += y[i] * V[i][l];
+        hb_precond(hb, z);
+        for (l = 0; l < len; l++)
+            x[l] += z[l];
+
+        /* the true residual for the restart */
+        hb_matvec(hb, x, V[0]);
+        mv++;
+        for (l = 0; l < len; l++)
+            V[0][l] = b[l] - V[0][l];
+        beta = sqrt(hb_dot(hb, V[0], V[0]));
+    }
+
+    for (j = 0; j <= m; j++)
+        tfree(V[j]);
+    tfree(V);
+    tfree(H);
+    tfree(cs);
+    tfree(sn);
+    tfree(g);
+    tfree(y);
+    tfree(z);
+}
+
+
+/* Load all samples of X.  hb->F gets the static currents, hb->Q the
+ * charges, the matrices of the samples are kept for J.  Returns the
+ * number of devices which limited their voltages, or -1 with *error
+ * set. */
+static int
+hb_load(HBsys *hb, double *X, int *error)
+{
+    CKTcircuit *ckt = hb->ckt;
+    double period = 2.0 * M_PI / hb->omega;
+    size_t bytes = (size_t) ckt->CKTnumStates * sizeof(double);
+    int n, i, noncon = 0;
+
+    ckt->CKTorder = 1;
+    ckt->CKTdelta = period / hb->N;
+    for (i = 1; i < 7; i++)
+        ckt->CKTag[i] = 0.0;
+
+    for (n = 0; n < hb->N; n++) {
+        double *xn = X + n * hb->stride;
+        double *fn = hb->F + n * hb->stride;
+        double *qn = hb->Q + n * hb->stride;
+
+        ckt->CKTrhsOld = xn;
+        ckt->CKTstate0 = hb->states[n];
+        ckt->CKTstate1 = hb->states[n > 0 ? n - 1 : hb->N - 1];
+        ckt->CKTtime = n * period / hb->N;
+        ckt->CKTmode = MODETRAN | MODEINITFLOAT;
+        memcpy(hb->save, hb->states[n], bytes);
+
+        /* i(x) = G x - rhs */
+        ckt->CKTag[0] = 0.0;
+        ckt->CKTnoncon = 0;
+        *error = CKTload(ckt);
+        if (*error)
+            return -1;
+        noncon += ckt->CKTnoncon;
+        SMPcopyValues(hb->G[n], ckt->CKTmatrix);
+        spSetReal(hb->G[n]);
+        SMPmultiply(hb->G[n], fn, xn, NULL, NULL);
+        fn[0] = 0.0;
+        for (i = 1; i <= hb->size; i++)
+            fn[i] -= ckt->CKTrhs[i];
+
+        /* q(x) = (G + C) x - rhs - i(x), limited as the first load */
+        memcpy(hb->states[n], hb->save, bytes);
+        ckt->CKTag[0] = 1.0;
+        *error = CKTload(ckt);
+        if (*error)
+            return -1;
+        SMPcopyValues(hb->GC[n], ckt->CKTmatrix);
+        spSetReal(hb->GC[n]);
+        SMPmultiply(hb->GC[n], qn, xn, NULL, NULL);
+        qn[0] = 0.0;
+        for (i = 1; i <= hb->size; i++)
+            qn[i] -= ckt->CKTrhs[i] + fn[i];
+    }
+
+    return noncon;
+}
+
+
+/* Newton iterations for F(X) = (1 - lambda) F0.  Returns 1 if they
+ * converged, 0 if not or on error. */
+static int
+hb_newton(HBsys *hb, double *X, double lambda, int maxiter, int *error)
+{
+    CKTcircuit *ckt = hb->ckt;
+    int iter, n, i, noncon, converged = 0;
+
+    for (iter = 1; iter <= maxiter && !converged; iter++) {
+
+        if (SPfrontEnd->IFpauseTest()) {
+            *error = E_PAUSE;
+            break;
+        }
+
+        noncon = hb_load(hb, X, error);
+        if (noncon < 0)
+            break;
+        hb_combine(hb, hb->F, hb->Q);
+
+        for (i = 0; i < hb->len; i++)
+            hb->F[i] = (1.0 - lambda) * hb->F0[i] - hb->F[i];
+        hb_gmres(hb, hb->F, hb->dX);
+
+        converged = (noncon == 0 && iter > 1);
+        for (n = 0; n < hb->N; n++)
+            for (i = 1; i <= hb->size; i++) {
+                double *x = X + n * hb->stride + i;
+                double d = hb->dX[n * hb->stride + i];
+                if (isnan(d)) {
+                    ckt->CKTstat->STATnumIter += iter;
+                    return 0;
+                }
+                if (fabs(d) > ckt->CKTreltol * MAX(fabs(*x), fabs(*x + d)) +
+                    hb->tol[i])
+                    converged = 0;
+                *x += d;
+            }
+    }
+
+    ckt->CKTstat->STATnumIter += iter - 1;
+    return converged;
+}
+
+
+/* Factor G + j k w0 C at the operating point for all harmonics */
+static int
+hb_preconditioner(HBsys *hb)
+{
+    CKTcircuit *ckt = hb->ckt;
+    double f0 = hb->omega / (2.0 * M_PI);
+    int k, ignore, error, retry;
+
+    ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITSMSIG;
+    error = CKTload(ckt);
+    if (error)
+        return error;
+
+    ckt->CKTmode = MODEAC;
+    ckt->CKTomega = hb->omega;
+
+    for (retry = 0; retry < 2; retry++) {
+        /* set the pivot order on CKTmatrix, the clones inherit it */
+        error = CKTacLoad(ckt);
+        if (!error)
+            error = SMPcReorder(ckt->CKTmatrix, ckt->CKTpivotAbsTol,
+                                ckt->CKTpivotRelTol, &ignore);
+        if (error)
+            return error;
+
+        if (!hb->pre.slots)
+            error = CKTacSlotsCreate(ckt, &hb->pre, hb->K + 1, 0);
+        else
+            error = CKTacSlotsReclone(ckt, &hb->pre);
+        if (error)
+            return error;
+
+        for (k = 0; k <= hb->K; k++) {
+            error = CKTacSlotLoad(ckt, &hb->pre.slots[k], k * f0);
+            if (error)
+                return error;
+        }
+        CKTacSlotsSolve(ckt, &hb->pre, hb->K + 1, 0, 0, 0);
+
+        for (k = 0; k <= hb->K; k++)
+            if (hb->pre.slots[k].error)
+                break;
+        if (k > hb->K)
+            return OK;
+
+        /* reorder at the frequency which failed */
+        ckt->CKTomega = k * hb->omega;
+    }
+
+    return E_SINGULAR;
+}
+
+
+/* the circuit has all its history in CKTstates[] */
+static int
+hb_supported(CKTcircuit *ckt)
+{
+    static char *types[] = { "LTRA", "TransLine", "CplLines", NULL };
+    int i;
+
+    for (i = 0; types[i]; i++) {
+        int type = CKTtypelook(types[i]);
+        if (type >= 0 && ckt->CKThead[type]) {
+            SPfrontEnd->IFerrorf(ERR_FATAL,
+                "harmonic balance does not support %s devices", types[i]);
+            return 0;
+        }
+    }
+
+#ifdef XSPICE
+    if (ckt->evt->counts.num_insts > 0) {
+        SPfrontEnd->IFerrorf(ERR_FATAL,
+            "harmonic balance does not support event-driven instances");
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+
+static int
+hb_output(HBsys *hb, double *X)
+{
+    CKTcircuit *ckt = hb->ckt;
+    double period = 2.0 * M_PI / hb->omega;
+    double *save_rhsOld = ckt->CKTrhsOld, *save_irhsOld = ckt->CKTirhsOld;
+    double *re = TMALLOC(double, hb->stride);
+    double *im = TMALLOC(double, hb->stride);
+    IFuid timeUid, freqUid, *nameList;
+    runDesc *plot = NULL;
+    int numNames, error, n, i, k, N = hb->N;
+
+    error = CKTnames(ckt, &numNames, &nameList);
+    if (error)
+        goto done;
+
+    /* one period in the time domain, closed by t = T */
+    SPfrontEnd->IFnewUid (ckt, &timeUid, NULL, "time", UID_OTHER, NULL);
+    error = SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
+                                       "Harmonic Balance Time Domain",
+                                       timeUid, IF_REAL,
+                                       numNames, nameList, IF_REAL,
+                                       &plot);
+    if (!error) {
+        for (n = 0; n <= N; n++) {
+            ckt->CKTrhsOld = X + (n % N) * hb->stride;
+            CKTdump(ckt, n * period / N, plot);
+        }
+        SPfrontEnd->OUTendPlot (plot);
+    }
+
+    /* the spectrum */
+    if (!error) {
+        SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
+        error = SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
+                                           ckt->CKTcurJob->JOBname,
+                                           freqUid, IF_REAL,
+                                           numNames, nameList, IF_COMPLEX,
+                                           &plot);
+    }
+    tfree(nameList);
+
+    if (!error) {
+        for (i = 1; i <= hb->size; i++)
+            for (n = 0; n < N; n++)
+                hb->fa[(i - 1) * N + n] = X[n * hb->stride + i];
+        rffts(hb->fa, hb->M, hb->size);
+
+        ckt->CKTrhsOld = re;
+        ckt->CKTirhsOld = im;
+        re[0] = im[0] = 0.0;
+        for (k = 0; k <= hb->K; k++) {
+            for (i = 1; i <= hb->size; i++) {
+                double *fa = hb->fa + (i - 1) * N;
+                re[i] = (k ? 2.0 : 1.0) * fa[2 * k] / N;
+                im[i] = k ? 2.0 * fa[2 * k + 1] / N : 0.0;
+            }
+            CKTacDump(ckt, k * hb->omega / (2.0 * M_PI), plot);
+        }
+        SPfrontEnd->OUTendPlot (plot);
+    }
+
+done:
+    ckt->CKTrhsOld = save_rhsOld;
+    ckt->CKTirhsOld = save_irhsOld;
+    tfree(re);
+    tfree(im);
+    return error;
+}
+
+
+int
+HBan(CKTcircuit *ckt, int restart)
+{
+    HBAN *job = (HBAN *) ckt->CKTcurJob;
+    HBsys hb;
+    double *save_rhsOld = ckt->CKTrhsOld;
+    double *save_state0 = ckt->CKTstate0, *save_state1 = ckt->CKTstate1;
+    double save_ag[7];
+    int save_order = ckt->CKTorder;
+    size_t bytes = (size_t) ckt->CKTnumStates * sizeof(double);
+    double *X = NULL, *Xc = NULL, **statesc = NULL;
+    double lambda = 0.0, step = 1.0;
+    CKTnode *node;
+    int error, n, i, N;
+
+    NG_IGNORE(restart);
+
+    if (!hb_supported(ckt))
+        return E_BADPARM;
+
+    memset(&hb, 0, sizeof(hb));
+    hb.ckt = ckt;
+    hb.size = SMPmatSize(ckt->CKTmatrix);
+    hb.stride = hb.size + 1;
+    hb.K = job->HBharms;
+    hb.omega = 2.0 * M_PI * job->HBfreq;
+
+    N = job->HBpoints > 0 ? job->HBpoints : 4 * hb.K;
+    for (hb.M = 3; (1 << hb.M) < N || (1 << hb.M) < 2 * hb.K + 2; hb.M++)
+        ;
+    N = hb.N = 1 << hb.M;
+    if (job->HBpoints > 0 && job->HBpoints != N)
+        SPfrontEnd->IFerrorf(ERR_INFO,
+            "harmonic balance uses %d points per period", N);
+    hb.len = hb.stride * N;
+
+#ifdef XSPICE
+    g_mif_info.circuit.anal_type = MIF_DC;
+    g_mif_info.circuit.anal_init = MIF_TRUE;
+#endif
+
+    error = CKTop(ckt,
+                  (ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITJCT,
+                  (ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITFLOAT,
+                  ckt->CKTdcMaxIter);
+    if (error) {
+        fprintf(stdout, "\nHB operating point failed -\n");
+        CKTncDump(ckt);
+        return error;
+    }
+
+    {
+        double mem = 2.0 * N * HB_ELTBYTES * spElementCount(ckt->CKTmatrix);
+        if (mem > HB_MAXMEM) {
+            SPfrontEnd->IFerrorf(ERR_FATAL,
+                "harmonic balance: %d points would take %.0f MB for the "
+                "matrix copies, reduce nharm or points",
+                N, mem / (1024.0 * 1024.0));
+            return E_BADPARM;
+        }
+    }
+
+    fftInit(hb.M);
+
+    hb.fa = TMALLOC(double, hb.size * N);
+    hb.fb = TMALLOC(double, hb.size * N);
+    hb.tmp = TMALLOC(double, hb.len);
+    hb.G = TMALLOC(SMPmatrix *, N);
+    hb.GC = TMALLOC(SMPmatrix *, N);
+
+    error = hb_preconditioner(&hb);
+    if (error) {
+        SPfrontEnd->IFerrorf(ERR_FATAL,
+            "harmonic balance: singular matrix at the operating point");
+        goto done;
+    }
+
+    /* after the last reorder of CKTmatrix */
+    for (n = 0; n < N; n++) {
+        error = SMPcloneMatrix(ckt->CKTmatrix, &hb.G[n]);
+        if (!error)
+            error = SMPcloneMatrix(ckt->CKTmatrix, &hb.GC[n]);
+        if (error)
+            goto done;
+    }
+
+    /* start from the operating point */
+    X = TMALLOC(double, hb.len);
+    Xc = TMALLOC(double, hb.len);
+    hb.F = TMALLOC(double, hb.len);
+    hb.Q = TMALLOC(double, hb.len);
+    hb.dX = TMALLOC(double, hb.len);
+    hb.F0 = TMALLOC(double, hb.len);
+    hb.save = TMALLOC(double, ckt->CKTnumStates);
+    hb.states = TMALLOC(double *, N);
+    statesc = TMALLOC(double *, N);
+    for (n = 0; n < N; n++) {
+        memcpy(X + n * hb.stride, save_rhsOld,
+               (size_t) hb.stride * sizeof(double));
+        X[n * hb.stride] = 0.0;
+        hb.states[n] = TMALLOC(double, ckt->CKTnumStates);
+        statesc[n] = TMALLOC(double, ckt->CKTnumStates);
+        memcpy(hb.states[n], save_state0, bytes);
+    }
+
+    hb.tol = TMALLOC(double, hb.stride);
+    node = ckt->CKTnodes;
+    for (i = 1; i <= hb.size; i++) {
+        node = node->next;
+        hb.tol[i] = node->type == SP_VOLTAGE ? ckt->CKTvoltTol : ckt->CKTabstol;
+    }
+
+    memcpy(save_ag, ckt->CKTag, sizeof(save_ag));
+
+#ifdef XSPICE
+    g_mif_info.circuit.anal_type = MIF_TRAN;
+    g_mif_info.circuit.anal_init = MIF_FALSE;
+#endif
+
+    if (hb_load(&hb, X, &error) < 0)
+        goto restore;
+    hb_combine(&hb, hb.F, hb.Q);
+    memcpy(hb.F0, hb.F, (size_t) hb.len * sizeof(double));
+
+    /* Newton from the operating point.  If it fails, continuation: with
+     * the residual F0 at the operating point, F(X) = (1 - lambda) F0 is
+     * solved for lambda stepping from 0 to 1, as source stepping does
+     * for the operating point. */
+    while (lambda < 1.0) {
+        double target = MIN(lambda + step, 1.0);
+        int maxiter = lambda == 0.0 && step == 1.0 ?
+            ckt->CKTdcMaxIter : ckt->CKTdcTrcvMaxIter;
+
+        if (hb_newton(&hb, X, target, maxiter, &error)) {
+            lambda = target;
+            memcpy(Xc, X, (size_t) hb.len * sizeof(double));
+            for (n = 0; n < N; n++)
+                memcpy(statesc[n], hb.states[n], bytes);
+            step = MIN(2.0 * step, 1.0);
+            continue;
+        }
+        if (error)
+            goto restore;
+
+        if (lambda == 0.0 && step == 1.0)
+            SPfrontEnd->IFerrorf(ERR_INFO,
+                "harmonic balance: stepping the excitation");
+        step /= 4.0;
+        if (step < 1e-4) {
+            SPfrontEnd->IFerrorf(ERR_WARNING,
+                "harmonic balance did not converge");
+            error = E_ITERLIM;
+            goto restore;
+        }
+
+        /* back to the last solution */
+        if (lambda == 0.0) {
+            for (n = 0; n < N; n++) {
+                memcpy(X + n * hb.stride, save_rhsOld,
+                       (size_t) hb.stride * sizeof(double));
+                X[n * hb.stride] = 0.0;
+                memcpy(hb.states[n], save_state0, bytes);
+            }
+        } else {
+            memcpy(X, Xc, (size_t) hb.len * sizeof(double));
+            for (n = 0; n < N; n++)
+                memcpy(hb.states[n], statesc[n], bytes);
+        }
+    }
+
+restore:
+    ckt->CKTrhsOld = save_rhsOld;
+    ckt->CKTstate0 = save_state0;
+    ckt->CKTstate1 = save_state1;
+    ckt->CKTorder = save_order;
+    memcpy(ckt->CKTag, save_ag, sizeof(save_ag));
+
+    if (!error)
+        error = hb_output(&hb, X);
+
+done:
+    fftFree();
+    CKTacSlotsDestroy(&hb.pre);
+    for (n = 0; n < N; n++) {
+        if (hb.G[n])
+            SMPdestroy(hb.G[n]);
+        if (hb.GC[n])
+            SMPdestroy(hb.GC[n]);
+        if (hb.states)
+            tfree(hb.states[n]);
+        if (statesc)
+            tfree(statesc[n]);
+    }
+    tfree(hb.G);
+    tfree(hb.GC);
+    tfree(hb.fa);
+    tfree(hb.fb);
+    tfree(hb.tmp);
+    tfree(hb.states);
+    tfree(statesc);
+    tfree(X);
+    tfree(Xc);
+    tfree(hb.F);
+    tfree(hb.Q);
+    tfree(hb.dX);
+    tfree(hb.F0);
+    tfree(hb.save);
+    tfree(hb.tol);
+
+    return error;
+}
+#endif
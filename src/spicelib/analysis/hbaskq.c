@@ -0,0 +1,41 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+#include "ngspice/ngspice.h"
+#include "ngspice/ifsim.h"
+#include "ngspice/iferrmsg.h"
+#include "ngspice/hbdefs.h"
+#include "ngspice/cktdefs.h"
+
+#ifdef WITH_HB
+
+/* ARGSUSED */
+int
+HBaskQuest(CKTcircuit *ckt, JOB *anal, int which, IFvalue *value)
+{
+    HBAN *job = (HBAN *) anal;
+
+    NG_IGNORE(ckt);
+
+    switch(which) {
+
+    case HB_FREQ:
+        value->rValue = job->HBfreq;
+        break;
+
+    case HB_HARMS:
+        value->iValue = job->HBharms;
+        break;
+
+    case HB_POINTS:
+        value->iValue = job->HBpoints;
+        break;
+
+    default:
+        return(E_BADPARM);
+    }
+    return(OK);
+}
+#endif
@@ -0,0 +1,77 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+#include "ngspice/ngspice.h"
+#include "ngspice/ifsim.h"
+#include "ngspice/iferrmsg.h"
+#include "ngspice/hbdefs.h"
+#include "ngspice/cktdefs.h"
+
+#include "analysis.h"
+
+#ifdef WITH_HB
+
+/* ARGSUSED */
+int
+HBsetParm(CKTcircuit *ckt, JOB *anal, int which, IFvalue *value)
+{
+    HBAN *job = (HBAN *) anal;
+
+    NG_IGNORE(ckt);
+
+    switch(which) {
+
+    case HB_FREQ:
+        if (value->rValue <= 0.0) {
+            errMsg = copy("Frequency of <= 0 is invalid for HB");
+            job->HBfreq = 1.0;
+            return(E_PARMVAL);
+        }
+        job->HBfreq = value->rValue;
+        break;
+
+    case HB_HARMS:
+        if (value->iValue < 1) {
+            errMsg = copy("HB needs at least one harmonic");
+            job->HBharms = 1;
+            return(E_PARMVAL);
+        }
+        job->HBharms = value->iValue;
+        break;
+
+    case HB_POINTS:
+        job->HBpoints = value->iValue;
+        break;
+
+    default:
+        return(E_BADPARM);
+    }
+    return(OK);
+}
+
+
+static IFparm HBparms[] = {
+    { "freq",      HB_FREQ,   IF_SET|IF_ASK|IF_REAL,    "fundamental frequency" },
+    { "harmonics", HB_HARMS,  IF_SET|IF_ASK|IF_INTEGER, "number of harmonics" },
+    { "points",    HB_POINTS, IF_SET|IF_ASK|IF_INTEGER, "time samples per period" }
+};
+
+SPICEanalysis HBinfo  = {
+    {
+        "HB",
+        "Harmonic balance analysis",
+
+        NUMELEMS(HBparms),
+        HBparms
+    },
+    sizeof(HBAN),
+    FREQUENCYDOMAIN,
+    1,
+    HBsetParm,
+    HBaskQuest,
+    NULL,
+    HBan
+};
+#endif
@@ -27,6 +27,192 @@ extern int fixme_onoise_type;
 extern int fixme_inoise_type;
 
 
+/* Evaluate the noise at data->freq, with the solution of the AC system in
+ * CKTrhsOld/CKTirhsOld and the one of the adjoint system in CKTrhs/CKTirhs.
+ * The devices integrate the noise over frequency in their instances, so
+ * the points have to be evaluated in frequency order.
+ */
+static int
+NOISEpoint(CKTcircuit *ckt, NOISEAN *job, Ndata *data, int step,
+           int posOutNode, int negOutNode)
+{
+    double realVal;
+    double imagVal;
+    int error;
+
+    realVal = ckt->CKTrhsOld [posOutNode]
+              - ckt->CKTrhsOld [negOutNode];
+    imagVal = ckt->CKTirhsOld [posOutNode]
+              - ckt->CKTirhsOld [negOutNode];
+    data->GainSqInv = 1.0 / MAX(((realVal*realVal)
+                                 + (imagVal*imagVal)),N_MINGAIN);
+    data->lnGainInv = log(data->GainSqInv);
+
+    /* set up a block of "common" data so we don't have to
+     * recalculate it for every device
+     */
+
+    data->delFreq = data->freq - data->lstFreq;
+    data->lnFreq = log(MAX(data->freq,N_MINLOG));
+    data->lnLastFreq = log(MAX(data->lstFreq,N_MINLOG));
+    data->delLnFreq = data->lnFreq - data->lnLastFreq;
+
+    if ((job->NStpsSm != 0) && ((step % (job->NStpsSm)) == 0)) {
+        data->prtSummary = TRUE;
+    } else {
+        data->prtSummary = FALSE;
+    }
+
+    /*
+    data->outNumber = 1;
+    */
+
+    data->outNumber = 0;
+    /* the frequency will NOT be stored in array[0]  as before; instead,
+     * it will be given in refVal.rValue (see later)
+     */
+
+    /* now we use the adjoint system to calculate the noise
+     * contributions of each generator in the circuit
+     */
+
+    error = CKTnoise(ckt,N_DENS,N_CALC,data);
+    if (error) return(error);
+    data->lstFreq = data->freq;
+
+    return(OK);
+}
+
+
+#ifdef USE_OMP
+
+extern int nthreads;
+
+/* Advance freq to the next point of the sweep.
+ * Sets *done if the sweep ends after the current point. */
+static int
+NOISEnextFreq(NOISEAN *job, double *freq, int *done)
+{
+    switch (job->NstpType) {
+
+    case DECADE:
+    case OCTAVE:
+        *freq *= job->NfreqDelta;
+        break;
+
+    case LINEAR:
+        *freq += job->NfreqDelta;
+        break;
+
+    default:
+        return(E_INTERN);
+    }
+
+    *done = ((job->NnumSteps == 1) && (job->NstpType == LINEAR));
+    return(OK);
+}
+
+/* Solve the AC and the adjoint system on the shared matrix */
+static void
+NOISEsolveShared(CKTcircuit *ckt, double freq, int posOutNode, int negOutNode)
+{
+    ckt->CKTomega = 2.0 * M_PI * freq;
+    ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC | MODEACNOISE;
+    NIacIter(ckt);
+    NInzIter(ckt, posOutNode, negOutNode);
+}
+
+
+/* Threaded noise sweep.  The AC and adjoint solutions of a batch of
+ * frequencies are computed concurrently on private copies of the matrix
+ * (see cktacslot.c), the device noise contributions are then evaluated
+ * and integrated point by point in frequency order, as in the serial
+ * sweep.  Within a point the device types run concurrently, each into its
+ * own accumulators (see CKTnoise()).
+ *
+ * The whole batch is loaded before the noise of its first point is
+ * evaluated.  That relies on DEVacLoad() of every device with a DEVnoise()
+ * writing only into the matrix and the rhs, and not into its instances
+ * or models, see devdefs.h.  DEVnoise() gets the state of its point from
+ * CKTomega and the solutions restored by CKTacSlotRestore().
+ */
+static int
+NOISEsweepThreaded(CKTcircuit *ckt, NOISEAN *job, Ndata *data,
+                   GENinstance *inst, int *step, double freqTol,
+                   int posOutNode, int negOutNode)
+{
+    ACslots pool = { NULL, 0, 0, 0 };
+    double freq = data->freq;
+    int done = 0;
+    int error = OK;
+    int i, n;
+
+    ckt->noise_input = inst;
+
+    while (!error && !done && freq <= job->NstopFreq + freqTol) {
+
+        if (SPfrontEnd->IFpauseTest()) {
+            job->NsavFstp = *step;   /* save our results */
+            job->NsavOnoise = data->outNoiz; /* up until now     */
+            job->NsavInoise = data->inNoise;
+            error = E_PAUSE;
+            break;
+        }
+
+        /* The first point settles the complex pivot order of the shared
+         * matrix, which is then handed down to the slots. */
+        if (!pool.slots) {
+            NOISEsolveShared(ckt, freq, posOutNode, negOutNode);
+            data->freq = freq;
+            error = NOISEpoint(ckt, job, data, (*step)++, posOutNode, negOutNode);
+            if (error)
+                break;
+            error = NOISEnextFreq(job, &freq, &done);
+            data->freq = freq;
+            if (!error)
+                error = CKTacSlotsCreate(ckt, &pool, nthreads, 1);
+            continue;
+        }
+
+        /* load a batch of frequencies */
+        ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC | MODEACNOISE;
+        for (n = 0; n < pool.numSlots && !done && freq <= job->NstopFreq + freqTol; n++) {
+            error = CKTacSlotLoad(ckt, &pool.slots[n], freq);
+            if (!error)
+                error = NOISEnextFreq(job, &freq, &done);
+            if (error)
+                break;
+        }
+        if (error)
+            break;
+
+        CKTacSlotsSolve(ckt, &pool, n, 1, posOutNode, negOutNode);
+
+        /* evaluate the noise in frequency order */
+        for (i = 0; i < n; i++) {
+            ACslot *slot = &pool.slots[i];
+            if (slot->error == E_SINGULAR)
+                /* the pivot order does not fit this frequency */
+                error = CKTacSlotRedo(ckt, &pool, slot, 1, posOutNode, negOutNode);
+            else
+                error = slot->error;
+            if (error)
+                break;
+            CKTacSlotRestore(ckt, &pool, slot);
+            data->freq = slot->freq;
+            error = NOISEpoint(ckt, job, data, (*step)++, posOutNode, negOutNode);
+            if (error)
+                break;
+        }
+        data->freq = freq;
+    }
+
+    CKTacSlotsDestroy(&pool);
+    return error;
+}
+
+#endif
+
 int
 NOISEan (CKTcircuit *ckt, int restart)
 {
@@ -34,8 +220,6 @@ NOISEan (CKTcircuit *ckt, int restart)
     longer lasting noise anlysis */
     static Ndata *data;
 
-    double realVal;
-    double imagVal;
     int error;
     int posOutNode;
     int negOutNode;
@@ -238,6 +422,15 @@ NOISEan (CKTcircuit *ckt, int restart)
 
     data->lstFreq = data->freq;
 
+#ifdef USE_OMP
+    if (nthreads > 1) {
+        error = NOISEsweepThreaded(ckt, job, data, inst, &step, freqTol,
+                                   posOutNode, negOutNode);
+        if (error)
+            return(error);
+    } else
+#endif
+
     /* do the noise analysis over all frequencies */
 
     while (data->freq <= job->NstopFreq + freqTol) {
@@ -257,47 +450,10 @@ NOISEan (CKTcircuit *ckt, int restart)
          */
 
         NIacIter(ckt);
-        realVal = ckt->CKTrhsOld [posOutNode]
-                  - ckt->CKTrhsOld [negOutNode];
-        imagVal = ckt->CKTirhsOld [posOutNode]
-                  - ckt->CKTirhsOld [negOutNode];
-        data->GainSqInv = 1.0 / MAX(((realVal*realVal)
-                                     + (imagVal*imagVal)),N_MINGAIN);
-        data->lnGainInv = log(data->GainSqInv);
-
-        /* set up a block of "common" data so we don't have to
-         * recalculate it for every device
-         */
-
-        data->delFreq = data->freq - data->lstFreq;
-        data->lnFreq = log(MAX(data->freq,N_MINLOG));
-        data->lnLastFreq = log(MAX(data->lstFreq,N_MINLOG));
-        data->delLnFreq = data->lnFreq - data->lnLastFreq;
-
-        if ((job->NStpsSm != 0) && ((step % (job->NStpsSm)) == 0)) {
-            data->prtSummary = TRUE;
-        } else {
-            data->prtSummary = FALSE;
-        }
-
-        /*
-        data->outNumber = 1;
-        */
-
-        data->outNumber = 0;
-        /* the frequency will NOT be stored in array[0]  as before; instead,
-         * it will be given in refVal.rValue (see later)
-         */
-
         NInzIter(ckt,posOutNode,negOutNode);   /* solve the adjoint system */
 
-        /* now we use the adjoint system to calculate the noise
-         * contributions of each generator in the circuit
-         */
-
-        error = CKTnoise(ckt,N_DENS,N_CALC,data);
+        error = NOISEpoint(ckt, job, data, step, posOutNode, negOutNode);
         if (error) return(error);
-        data->lstFreq = data->freq;
 
         /* update the frequency */
 
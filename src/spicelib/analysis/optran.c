@@ -40,11 +40,16 @@ extern int sharedsync(double*, double*, double, double, double, int, int*, int);
 extern int ng_ident;      /* for debugging */
 #endif
 
-int OPclrBreak(CKTcircuit* ckt);
-int OPsetBreak(CKTcircuit* ckt, double time);
+/* the breakpoints of one OPtran() run, copies of a circuit made by
+   CKTclone() may run it concurrently */
+typedef struct {
+    double *breaks;
+    int size;
+} OPbreaks;
+
+static int OPclrBreak(OPbreaks *bp);
+static int OPsetBreak(CKTcircuit *ckt, OPbreaks *bp, double time);
 
-static double *opbreaks;
-static int OPbreakSize;
 static double opfinaltime = 1e-6;
 static double opstepsize = 1e-8;
 static double opramptime = 0.;
@@ -181,51 +186,49 @@ bugquit:
     fprintf(stderr, "Error in command 'optran'\n");
 }
 
-int OPclrBreak(CKTcircuit *ckt)
+static int OPclrBreak(OPbreaks *bp)
 {
     double *tmp;
     int j;
 
-    NG_IGNORE(ckt);
-
-    if (OPbreakSize > 2) {
-        tmp = TMALLOC(double, OPbreakSize - 1);
+    if (bp->size > 2) {
+        tmp = TMALLOC(double, bp->size - 1);
         if (tmp == NULL)
             return (E_NOMEM);
-        for (j = 1; j < OPbreakSize; j++) {
-            tmp[j - 1] = opbreaks[j];
+        for (j = 1; j < bp->size; j++) {
+            tmp[j - 1] = bp->breaks[j];
         }
-        FREE(opbreaks);
-        OPbreakSize--;
-        opbreaks = tmp;
+        FREE(bp->breaks);
+        bp->size--;
+        bp->breaks = tmp;
     }
     else {
-        opbreaks[0] = opbreaks[1];
-        opbreaks[1] = opfinaltime;
+        bp->breaks[0] = bp->breaks[1];
+        bp->breaks[1] = opfinaltime;
     }
     return (OK);
 }
 
 
-int OPsetBreak(CKTcircuit *ckt, double time)
+static int OPsetBreak(CKTcircuit *ckt, OPbreaks *bp, double time)
 {
     double *tmp;
     int i, j;
 
 
-    for (i = 0; i < OPbreakSize; i++) {
-        if (opbreaks[i] > time) { /* passed */
-            if ((opbreaks[i] - time) <= ckt->CKTminBreak) {
+    for (i = 0; i < bp->size; i++) {
+        if (bp->breaks[i] > time) { /* passed */
+            if ((bp->breaks[i] - time) <= ckt->CKTminBreak) {
                 /* very close together - take earlier point */
 #ifdef TRACE_BREAKPOINT
                 printf("[t:%e] \t %e replaces %e\n", ckt->CKTtime, time,
                         ckt->CKTbreaks[i]);
                 CKTbreakDump(ckt);
 #endif
-                opbreaks[i] = time;
+                bp->breaks[i] = time;
                 return (OK);
             }
-            if (i > 0 && time - opbreaks[i - 1] <= ckt->CKTminBreak) {
+            if (i > 0 && time - bp->breaks[i - 1] <= ckt->CKTminBreak) {
                 /* very close together, but after, so skip */
 #ifdef TRACE_BREAKPOINT
                 printf("[t:%e] \t %e skipped\n", ckt->CKTtime, time);
@@ -234,29 +237,29 @@ int OPsetBreak(CKTcircuit *ckt, double time)
                 return (OK);
             }
             /* fits in middle - new array & insert */
-            tmp = TMALLOC(double, OPbreakSize + 1);
+            tmp = TMALLOC(double, bp->size + 1);
             if (tmp == NULL)
                 return (E_NOMEM);
             for (j = 0; j < i; j++) {
-                tmp[j] = opbreaks[j];
+                tmp[j] = bp->breaks[j];
             }
             tmp[i] = time;
 #ifdef TRACE_BREAKPOINT
             printf("[t:%e] \t %e added\n", ckt->CKTtime, time);
             CKTbreakDump(ckt);
 #endif
-            for (j = i; j < OPbreakSize; j++) {
-                tmp[j + 1] = opbreaks[j];
+            for (j = i; j < bp->size; j++) {
+                tmp[j + 1] = bp->breaks[j];
             }
-            FREE(opbreaks);
-            OPbreakSize++;
-            opbreaks = tmp;
+            FREE(bp->breaks);
+            bp->size++;
+            bp->breaks = tmp;
 
             return (OK);
         }
     }
     /* never found it - beyond end of time - extend out idea of time */
-    if (time - opbreaks[OPbreakSize - 1] <= ckt->CKTminBreak) {
+    if (time - bp->breaks[bp->size - 1] <= ckt->CKTminBreak) {
         /* very close tegether - keep earlier, throw out new point */
 #ifdef TRACE_BREAKPOINT
         printf("[t:%e] \t %e skipped (at the end)\n", ckt->CKTtime, time);
@@ -265,9 +268,9 @@ int OPsetBreak(CKTcircuit *ckt, double time)
         return (OK);
     }
     /* fits at end - grow array & add on */
-    opbreaks = TREALLOC(double, opbreaks, OPbreakSize + 1);
-    OPbreakSize++;
-    opbreaks[OPbreakSize - 1] = time;
+    bp->breaks = TREALLOC(double, bp->breaks, bp->size + 1);
+    bp->size++;
+    bp->breaks[bp->size - 1] = time;
 #ifdef TRACE_BREAKPOINT
     printf("[t:%e] \t %e added at end\n", ckt->CKTtime, time);
     CKTbreakDump(ckt);
@@ -276,6 +279,14 @@ int OPsetBreak(CKTcircuit *ckt, double time)
 }
 
 
+/* TRUE if command 'optran' has enabled OPtran() */
+int
+OPtranEnabled(void)
+{
+    return !nooptran;
+}
+
+
 /* Do a simple transient simulation, starting with time 0 until opfinaltime.
    No output vectors are generated, actual times and breakpoints are kept local.
    When returning, the matrix is left in its current state.
@@ -299,6 +310,7 @@ OPtran(CKTcircuit *ckt, int oldconverged)
     double maxstepsize = 0.0, prevmaxstepsize = 0.0, prevstepsize=0.;
 
     int ltra_num;
+    OPbreaks bp;
 
 #if defined SHARED_MODULE
     int redostep;
@@ -370,11 +382,11 @@ OPtran(CKTcircuit *ckt, int oldconverged)
             ckt->CKTtimePoints = TMALLOC(double, ckt->CKTtimeListSize);
         /* end LTRA code addition */
 
-        opbreaks = TMALLOC(double, 2);
-        if(opbreaks == NULL) return(E_NOMEM);
-        opbreaks[0] = 0;
-        opbreaks[1] = opfinaltime;
-        OPbreakSize = 2;
+        bp.breaks = TMALLOC(double, 2);
+        if(bp.breaks == NULL) return(E_NOMEM);
+        bp.breaks[0] = 0;
+        bp.breaks[1] = opfinaltime;
+        bp.size = 2;
 
 #ifdef SHARED_MODULE
         add_bkpt();
@@ -437,8 +449,8 @@ OPtran(CKTcircuit *ckt, int oldconverged)
 
     error = CKTaccept(ckt);
     /* check if current breakpoint is outdated; if so, clear */
-    if (optime > opbreaks[0])
-        OPclrBreak(ckt);
+    if (optime > bp.breaks[0])
+        OPclrBreak(&bp);
 
     /*
  * Breakpoint handling scheme:
@@ -455,7 +467,7 @@ OPtran(CKTcircuit *ckt, int oldconverged)
     ckt->CKTbreak = 0;
     /* XXX Error will cause single process to bail. */
     if(error)  {
-        tfree(opbreaks);
+        tfree(bp.breaks);
         return(error);
     }
 #ifdef XSPICE
@@ -469,7 +481,7 @@ OPtran(CKTcircuit *ckt, int oldconverged)
 
     /* We are finished */
     if(AlmostEqualUlps( optime, opfinaltime, 100 ) ) {
-        tfree(opbreaks);
+        tfree(bp.breaks);
         SPfrontEnd->IFerrorf(ERR_INFO, "Transient op finished successfully");
         ckt->CKTmaxStep = prevmaxstepsize;
         ckt->CKTstep = prevstepsize;
@@ -495,9 +507,9 @@ resume:
 #endif
 
   /* are we at a breakpoint, or indistinguishably close? */
-    /* if ((optime == opbreaks[0]) || (opbreaks[0] - */
-    if ( AlmostEqualUlps( optime, opbreaks[0], 100 ) ||
-         opbreaks[0] - optime <= ckt->CKTdelmin) {
+    /* if ((optime == bp.breaks[0]) || (bp.breaks[0] - */
+    if ( AlmostEqualUlps( optime, bp.breaks[0], 100 ) ||
+         bp.breaks[0] - optime <= ckt->CKTdelmin) {
         /* first timepoint after a breakpoint - cut integration order */
         /* and limit timestep to .1 times minimum of time to next breakpoint,
          * and previous timestep
@@ -505,12 +517,12 @@ resume:
         ckt->CKTorder = 1;
 
         ckt->CKTdelta = MIN(ckt->CKTdelta, .1 * MIN(ckt->CKTsaveDelta,
-            opbreaks[1] - opbreaks[0]));
+            bp.breaks[1] - bp.breaks[0]));
 
         if(firsttime) {
             /* set a breakpoint to reduce ringing of current in devices */
             if (ckt->CKTmode & MODEUIC)
-                OPsetBreak(ckt, ckt->CKTstep);
+                OPsetBreak(ckt, &bp, ckt->CKTstep);
 
             ckt->CKTdelta /= 10;
 #ifdef STEPDEBUG
@@ -526,9 +538,9 @@ resume:
     }
 
 #ifndef XSPICE
-    else if(optime + ckt->CKTdelta >= opbreaks[0]) {
+    else if(optime + ckt->CKTdelta >= bp.breaks[0]) {
         ckt->CKTsaveDelta = ckt->CKTdelta;
-        ckt->CKTdelta = opbreaks[0] - optime;
+        ckt->CKTdelta = bp.breaks[0] - optime;
         ckt->CKTbreak = 1; /* why? the current pt. is not a bkpt. */
     }
 #endif /* !XSPICE */
@@ -554,24 +566,24 @@ resume:
     /* Throw out any permanent breakpoint times <= current time */
     for (;;) {
 #ifdef STEPDEBUG
-        printf("    brk_pt: %g    ckt_time: %g    ckt_min_break: %g\n",opbreaks[0], optime, ckt->CKTminBreak);
+        printf("    brk_pt: %g    ckt_time: %g    ckt_min_break: %g\n",bp.breaks[0], optime, ckt->CKTminBreak);
 #endif
-        if(AlmostEqualUlps(opbreaks[0], optime, 100) ||
-           opbreaks[0] <= optime + ckt->CKTminBreak) {
+        if(AlmostEqualUlps(bp.breaks[0], optime, 100) ||
+           bp.breaks[0] <= optime + ckt->CKTminBreak) {
 #ifdef STEPDEBUG
-            printf("throwing out permanent breakpoint times <= current time (brk pt: %g)\n",opbreaks[0]);
+            printf("throwing out permanent breakpoint times <= current time (brk pt: %g)\n",bp.breaks[0]);
             printf("    ckt_time: %g    ckt_min_break: %g\n",optime, ckt->CKTminBreak);
 #endif
-            OPclrBreak(ckt);
+            OPclrBreak(&bp);
         } else {
             break;
         }
     }
     /* Force the breakpoint if appropriate */
-    if(optime + ckt->CKTdelta > opbreaks[0]) {
+    if(optime + ckt->CKTdelta > bp.breaks[0]) {
         ckt->CKTbreak = 1;
         ckt->CKTsaveDelta = ckt->CKTdelta;
-        ckt->CKTdelta = opbreaks[0] - optime;
+        ckt->CKTdelta = bp.breaks[0] - optime;
     }
 
 /* gtri - end - wbk - Modify Breakpoint stuff */
@@ -607,9 +619,9 @@ resume:
 
             /* If any instances have forced an earlier */
             /* next analog time, cut the delta */
-            if(opbreaks[0] < g_mif_info.breakpoint.current)
-                if(opbreaks[0] > optime + ckt->CKTminBreak)
-                    g_mif_info.breakpoint.current = opbreaks[0];
+            if(bp.breaks[0] < g_mif_info.breakpoint.current)
+                if(bp.breaks[0] > optime + ckt->CKTminBreak)
+                    g_mif_info.breakpoint.current = bp.breaks[0];
             if(g_mif_info.breakpoint.current < optime + ckt->CKTdelta) {
                 /* Breakpoint must be > last accepted timepoint */
                 /* and >= current event time */
@@ -651,6 +663,12 @@ resume:
         redostep = 1;
 #endif
 
+        /* another homotopy has converged first, see CKTop() */
+        if (CKTopCancelled(ckt)) {
+            tfree(bp.breaks);
+            return(E_ITERLIM);
+        }
+
         olddelta=ckt->CKTdelta;
         /* time abort? */
         optime += ckt->CKTdelta;
@@ -709,7 +727,7 @@ resume:
         }
         /* txl, cpl addition */
         if (converged == 1111) {
-            tfree(opbreaks);
+            tfree(bp.breaks);
             return(converged);
         }
 
@@ -761,7 +779,7 @@ resume:
             newdelta = ckt->CKTdelta;
             error = CKTtrunc(ckt,&newdelta);
             if(error) {
-                tfree(opbreaks);
+                tfree(bp.breaks);
                 return(error);
             }
             if (newdelta > .9 * ckt->CKTdelta) {
@@ -770,7 +788,7 @@ resume:
                     ckt->CKTorder = 2;
                     error = CKTtrunc(ckt, &newdelta);
                     if (error) {
-                        tfree(opbreaks);
+                        tfree(bp.breaks);
                         return(error);
                     }
                     if (newdelta <= 1.05 * ckt->CKTdelta) {
@@ -804,8 +822,11 @@ resume:
             if (olddelta > ckt->CKTdelmin) {
                 ckt->CKTdelta = ckt->CKTdelmin;
             } else {
+#ifdef USE_OMP
+#pragma omp critical(ni_message)
+#endif
                 errMsg = CKTtrouble(ckt, "Timestep too small");
-                tfree(opbreaks);
+                tfree(bp.breaks);
                 return(E_TIMESTEP);
             }
         }
@@ -0,0 +1,484 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+Modified BSD license
+**********/
+
+/*
+ * Newton-Krylov shooting for the PSS analysis.
+ *
+ * At the end of a shooting cycle DCpss() knows the state x0 at the start
+ * of the estimated period T and the state x(T) at its end.  The periodic
+ * steady state is the solution of
+ *
+ *	x(x0, T) - x0 = 0,	x0[osc] fixed
+ *
+ * the value of the oscillating node being the phase condition of the
+ * autonomous circuit.  Its Newton step solves
+ *
+ *	(Phi - I) dx0 + dx/dt(T) dT = -(x(T) - x0)
+ *
+ * with dx0[osc] = 0.  The monodromy matrix Phi is never formed: GMRES
+ * only needs products Phi v, which propagate v along the accepted
+ * timepoints of the period, recorded by PSStraceAdd():
+ *
+ *	(G_n + a_n C_n) d_n = a_n C_{n-1} d_{n-1} - k_n G_{n-1} d_{n-1}
+ *
+ * a_n and k_n being the integration coefficients of the step (k_n = ag1
+ * for the trapezoidal rule of order 2, 0 otherwise, the other methods are
+ * linearized as backward Euler).  The matrices G_n + a_n C_n and G_n are
+ * loaded again from the recorded solution, as for the transient
+ * sensitivity, so the memory is that of the recorded period, linear in
+ * the size of the circuit, instead of the dense sensitivity matrix.
+ *
+ * Equations and unknowns are scaled by the convergence tolerances of
+ * the shooting, so that GMRES weighs voltages and currents alike.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/pssdefs.h"
+#include "ngspice/sperror.h"
+
+#ifdef XSPICE
+#include "ngspice/evt.h"
+#endif
+
+
+#define PSS_KRYLOV_DIM  40      /* GMRES iterations, no restart */
+#define PSS_KRYLOV_TOL  1e-2    /* relative residual of the Newton step */
+
+
+typedef struct {
+    CKTcircuit *ckt;
+    PSStrace *tr;
+    int size;           /* length of a solution vector, with ground */
+    int osc;            /* equation of the oscillating node */
+    double period;
+    double *deriv;      /* dx/dt at the end of the period */
+    double *tol;        /* tolerance of each unknown, from 0 */
+    double *state0;
+    double *rhs;        /* scratch CKTrhs of the loads */
+    double *d, *Gd, *Cd, *b, *spare;
+} PSSshoot;
+
+
+/* Can the circuit be restarted from a modified state ? */
+int
+PSSshootSupported(CKTcircuit *ckt)
+{
+    static char *types[] = { "LTRA", "TransLine", "CplLines", NULL };
+    int i;
+
+    for (i = 0; types[i]; i++) {
+        int type = CKTtypelook(types[i]);
+        if (type >= 0 && ckt->CKThead[type])
+            return 0;
+    }
+
+#ifdef XSPICE
+    if (ckt->evt->counts.num_insts > 0)
+        return 0;
+#endif
+
+    return 1;
+}
+
+
+/* Record the accepted timepoint, integrated with order 'order' */
+void
+PSStraceAdd(CKTcircuit *ckt, PSStrace *tr, int order)
+{
+    int n = tr->num_points;
+
+    if (n == 0) {
+        tr->size = SMPmatSize(ckt->CKTmatrix) + 1;
+        tr->num_states = ckt->CKTnumStates;
+    }
+
+    if (n >= tr->max_points) {
+        int m = MAX(2 * tr->max_points, 64);
+        tr->time = TREALLOC(double, tr->time, m);
+        tr->ag0 = TREALLOC(double, tr->ag0, m);
+        tr->ag1 = TREALLOC(double, tr->ag1, m);
+        tr->sol = TREALLOC(double *, tr->sol, m);
+        tr->states = TREALLOC(double *, tr->states, m);
+        for (; tr->max_points < m; tr->max_points++) {
+            tr->sol[tr->max_points] = NULL;
+            tr->states[tr->max_points] = NULL;
+        }
+    }
+    if (!tr->sol[n]) {
+        tr->sol[n] = TMALLOC(double, tr->size);
+        tr->states[n] = TMALLOC(double, tr->num_states);
+    }
+
+    /* the first step is taken as backward Euler, as after
+     * PSSshootRestart(), its history being that of the initial state */
+    tr->time[n] = ckt->CKTtime;
+    if (n > 1 && ckt->CKTintegrateMethod == TRAPEZOIDAL && order == 2) {
+        tr->ag0[n] = ckt->CKTag[0];
+        tr->ag1[n] = ckt->CKTag[1];
+    } else if (n > 0) {
+        tr->ag0[n] = 1.0 / (tr->time[n] - tr->time[n - 1]);
+        tr->ag1[n] = 0.0;
+    }
+    memcpy(tr->sol[n], ckt->CKTrhsOld, (size_t) tr->size * sizeof(double));
+    memcpy(tr->states[n], ckt->CKTstate0,
+           (size_t) tr->num_states * sizeof(double));
+    tr->num_points = n + 1;
+}
+
+
+void
+PSStraceFree(PSStrace *tr)
+{
+    int n;
+
+    for (n = 0; n < tr->max_points; n++) {
+        FREE(tr->sol[n]);
+        FREE(tr->states[n]);
+    }
+    FREE(tr->time);
+    FREE(tr->ag0);
+    FREE(tr->ag1);
+    FREE(tr->sol);
+    FREE(tr->states);
+    tr->num_points = tr->max_points = 0;
+}
+
+
+/* Load the matrix G_n + ag0 C_n of timepoint n */
+static int
+pss_load(PSSshoot *sh, int n, double ag0)
+{
+    CKTcircuit *ckt = sh->ckt;
+    PSStrace *tr = sh->tr;
+
+    memcpy(sh->state0, tr->states[n],
+           (size_t) tr->num_states * sizeof(double));
+    ckt->CKTrhsOld = tr->sol[n];
+    ckt->CKTrhs = sh->rhs;
+    ckt->CKTstate0 = sh->state0;
+    ckt->CKTstate1 = tr->states[n > 0 ? n - 1 : 0];
+    ckt->CKTtime = tr->time[n];
+    if (n > 0)
+        ckt->CKTdelta = ckt->CKTdeltaOld[0] = tr->time[n] - tr->time[n - 1];
+    memset(ckt->CKTag, 0, sizeof(ckt->CKTag));
+    ckt->CKTag[0] = ag0;
+    ckt->CKTmode = MODETRAN | MODEINITFLOAT;
+
+    return CKTload(ckt);
+}
+
+
+/* d = Phi d, along the recorded period */
+static int
+pss_propagate(PSSshoot *sh)
+{
+    CKTcircuit *ckt = sh->ckt;
+    PSStrace *tr = sh->tr;
+    SMPmatrix *matrix = ckt->CKTmatrix;
+    int size = sh->size;
+    int i, n, error;
+
+    /* C_0 d_0 and G_0 d_0 */
+    error = pss_load(sh, 0, 0.0);
+    if (error)
+        return error;
+    SMPmultiply(matrix, sh->Gd, sh->d, NULL, NULL);
+    error = pss_load(sh, 0, 1.0);
+    if (error)
+        return error;
+    SMPmultiply(matrix, sh->Cd, sh->d, NULL, NULL);
+    for (i = 0; i < size; i++)
+        sh->Cd[i] -= sh->Gd[i];
+
+    for (n = 1; n < tr->num_points; n++) {
+        double ag0 = tr->ag0[n], ag1 = tr->ag1[n];
+
+        for (i = 0; i < size; i++)
+            sh->b[i] = ag0 * sh->Cd[i] - ag1 * sh->Gd[i];
+        sh->b[0] = 0.0;
+
+        error = pss_load(sh, n, ag0);
+        if (error)
+            return error;
+        error = SMPluFac(matrix, ckt->CKTpivotAbsTol, ckt->CKTdiagGmin);
+        if (error == E_SINGULAR)
+            error = SMPreorder(matrix, ckt->CKTpivotAbsTol,
+                               ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
+        if (error)
+            return error;
+        memcpy(sh->d, sh->b, (size_t) size * sizeof(double));
+        SMPsolve(matrix, sh->d, sh->spare);
+        sh->d[0] = 0.0;
+
+        /* (G_n + ag0 C_n) d_n = b gives C_n d_n */
+        error = pss_load(sh, n, 0.0);
+        if (error)
+            return error;
+        SMPmultiply(matrix, sh->Gd, sh->d, NULL, NULL);
+        for (i = 0; i < size; i++)
+            sh->Cd[i] = (sh->b[i] - sh->Gd[i]) / ag0;
+    }
+
+    return OK;
+}
+
+
+/* y = (Phi - I) u + dx/dt dT in scaled variables, u[osc] being dT / T */
+static int
+pss_matvec(PSSshoot *sh, double *u, double *y)
+{
+    int size = sh->size;
+    int i, error;
+
+    sh->d[0] = 0.0;
+    for (i = 1; i < size; i++)
+        sh->d[i] = i == sh->osc ? 0.0 : u[i] * sh->tol[i - 1];
+
+    error = pss_propagate(sh);
+    if (error)
+        return error;
+
+    y[0] = 0.0;
+    for (i = 1; i < size; i++) {
+        double d0 = i == sh->osc ? 0.0 : u[i];
+        y[i] = sh->d[i] / sh->tol[i - 1] - d0 +
+            sh->deriv[i] * sh->period * u[sh->osc] / sh->tol[i - 1];
+    }
+
+    return OK;
+}
+
+
+static double
+pss_dot(double *x, double *y, int size)
+{
+    double sum = 0.0;
+    int i;
+
+    for (i = 1; i < size; i++)
+        sum += x[i] * y[i];
+    return sum;
+}
+
+
+/* GMRES without restart for A u = b, u = 0 on entry.  Returns the
+ * relative residual reached in *res. */
+static int
+pss_gmres(PSSshoot *sh, double *b, double *u, double *res)
+{
+    int size = sh->size;
+    int m = PSS_KRYLOV_DIM;
+    double **V = TMALLOC(double *, m + 1);
+    double *H = TMALLOC(double, (m + 1) * m);
+    double *cs = TMALLOC(double, m);
+    double *sn = TMALLOC(double, m);
+    double *g = TMALLOC(double, m + 1);
+    double *w = TMALLOC(double, size);
+    double beta;
+    int i, j, k = 0, error = OK;
+
+#define H_(i, j) H[(j) * (m + 1) + (i)]
+
+    beta = sqrt(pss_dot(b, b, size));
+    *res = 0.0;
+    if (beta == 0.0)
+        goto done;
+
+    V[0] = TMALLOC(double, size);
+    for (i = 1; i < size; i++)
+        V[0][i] = b[i] / beta;
+    g[0] = beta;
+
+    for (k = 0; k < m; k++) {
+        error = pss_matvec(sh, V[k], w);
+        if (error)
+            break;
+
+        /* modified Gram-Schmidt */
+        for (j = 0; j <= k; j++) {
+            double h = pss_dot(w, V[j], size);
+            H_(j, k) = h;
+            for (i = 1; i < size; i++)
+                w[i] -= h * V[j][i];
+        }
+        H_(k + 1, k) = sqrt(pss_dot(w, w, size));
+
+        for (j = 0; j < k; j++) {
+            double t = cs[j] * H_(j, k) + sn[j] * H_(j + 1, k);
+            H_(j + 1, k) = -sn[j] * H_(j, k) + cs[j] * H_(j + 1, k);
+            H_(j, k) = t;
+        }
+        {
+            double r = hypot(H_(k, k), H_(k + 1, k));
+            if (r == 0.0)
+                break;
+            cs[k] = H_(k, k) / r;
+            sn[k] = H_(k + 1, k) / r;
+            H_(k, k) = r;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+        }
+
+        if (fabs(g[k + 1]) <= PSS_KRYLOV_TOL * beta || H_(k + 1, k) == 0.0 ||
+            k + 1 == m) {
+            k++;
+            break;
+        }
+
+        V[k + 1] = TMALLOC(double, size);
+        for (i = 1; i < size; i++)
+            V[k + 1][i] = w[i] / H_(k + 1, k);
+    }
+
+    if (!error && k > 0) {
+        /* back substitution, u = V y */
+        for (j = k - 1; j >= 0; j--) {
+            double t = g[j];
+            for (i = j + 1; i < k; i++)
+                t -= H_(j, i) * g[i];
+            g[j] = t / H_(j, j);
+        }
+        for (j = 0; j < k; j++)
+            for (i = 1; i < size; i++)
+                u[i] += g[j] * V[j][i];
+        *res = fabs(g[k]) / beta;
+    }
+
+done:
+    for (j = 0; j <= m; j++)
+        tfree(V[j]);
+    tfree(V);
+    tfree(H);
+    tfree(cs);
+    tfree(sn);
+    tfree(g);
+    tfree(w);
+
+#undef H_
+
+    return error;
+}
+
+
+/* The Newton step of the shooting from the recorded period.  err is
+ * x(T) - x0 and tol the tolerance of each unknown, both from 0.  On
+ * success returns OK with the step of the initial state in dx (from 1),
+ * dx[osc] being the step of the period. */
+int
+PSSshootStep(CKTcircuit *ckt, PSStrace *tr, int osc, double *err,
+             double *tol, double *dx)
+{
+    PSSshoot sh;
+    double *save_rhs = ckt->CKTrhs, *save_rhsOld = ckt->CKTrhsOld;
+    double *save_state0 = ckt->CKTstate0, *save_state1 = ckt->CKTstate1;
+    double save_time = ckt->CKTtime, save_delta = ckt->CKTdelta;
+    double save_deltaOld = ckt->CKTdeltaOld[0];
+    double save_ag[7];
+    long save_mode = ckt->CKTmode;
+    int bypass = ckt->CKTbypass;
+    double *u, *b, res = 1.0, h;
+    int i, last = tr->num_points - 1, error;
+
+    if (tr->num_points < 2 || osc <= 0)
+        return E_PARMVAL;
+
+    sh.ckt = ckt;
+    sh.tr = tr;
+    sh.size = tr->size;
+    sh.osc = osc;
+    sh.period = tr->time[last] - tr->time[0];
+    sh.deriv = TMALLOC(double, sh.size);
+    sh.tol = tol;
+    sh.state0 = TMALLOC(double, tr->num_states);
+    sh.rhs = TMALLOC(double, sh.size);
+    sh.d = TMALLOC(double, sh.size);
+    sh.Gd = TMALLOC(double, sh.size);
+    sh.Cd = TMALLOC(double, sh.size);
+    sh.b = TMALLOC(double, sh.size);
+    sh.spare = TMALLOC(double, sh.size);
+    u = TMALLOC(double, sh.size);
+    b = TMALLOC(double, sh.size);
+
+    h = tr->time[last] - tr->time[last - 1];
+    for (i = 1; i < sh.size; i++)
+        sh.deriv[i] = (tr->sol[last][i] - tr->sol[last - 1][i]) / h;
+
+    memcpy(save_ag, ckt->CKTag, sizeof(save_ag));
+    ckt->CKTbypass = 0;
+
+    b[0] = 0.0;
+    for (i = 1; i < sh.size; i++)
+        b[i] = -err[i - 1] / tol[i - 1];
+
+    error = pss_gmres(&sh, b, u, &res);
+
+    ckt->CKTrhs = save_rhs;
+    ckt->CKTrhsOld = save_rhsOld;
+    ckt->CKTstate0 = save_state0;
+    ckt->CKTstate1 = save_state1;
+    ckt->CKTtime = save_time;
+    ckt->CKTdelta = save_delta;
+    ckt->CKTdeltaOld[0] = save_deltaOld;
+    memcpy(ckt->CKTag, save_ag, sizeof(save_ag));
+    ckt->CKTmode = save_mode;
+    ckt->CKTbypass = bypass;
+
+    /* the step is taken if GMRES has made some progress */
+    if (!error && res > 0.5)
+        error = E_ITERLIM;
+
+    if (!error) {
+        for (i = 1; i < sh.size; i++)
+            dx[i] = i == osc ? u[i] * sh.period : u[i] * tol[i - 1];
+    }
+
+    tfree(sh.deriv);
+    tfree(sh.state0);
+    tfree(sh.rhs);
+    tfree(sh.d);
+    tfree(sh.Gd);
+    tfree(sh.Cd);
+    tfree(sh.b);
+    tfree(sh.spare);
+    tfree(u);
+    tfree(b);
+
+    return error;
+}
+
+
+/* Continue the transient from the state x (from 1) at the current time.
+ * The device states are loaded from x and the integration restarts with
+ * backward Euler, as after the operating point. */
+int
+PSSshootRestart(CKTcircuit *ckt, double *x)
+{
+    int size = SMPmatSize(ckt->CKTmatrix);
+    double save_ag[7];
+    long save_mode = ckt->CKTmode;
+    int i, error;
+
+    memcpy(ckt->CKTrhsOld + 1, x + 1, (size_t) size * sizeof(double));
+
+    memcpy(save_ag, ckt->CKTag, sizeof(save_ag));
+    memset(ckt->CKTag, 0, sizeof(ckt->CKTag));
+    ckt->CKTmode = MODETRAN | MODEINITFLOAT;
+
+    error = CKTload(ckt);
+
+    memcpy(ckt->CKTag, save_ag, sizeof(save_ag));
+    ckt->CKTmode = save_mode;
+    if (error)
+        return error;
+
+    /* the new state has no history */
+    for (i = 1; i <= ckt->CKTmaxOrder + 1; i++)
+        memcpy(ckt->CKTstates[i], ckt->CKTstate0,
+               (size_t) ckt->CKTnumStates * sizeof(double));
+    ckt->CKTorder = 1;
+
+    return OK;
+}
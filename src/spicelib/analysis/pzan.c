@@ -13,6 +13,8 @@ Copyright 1990 Regents of the University of California.  All rights reserved.
 
 #define DEBUG	if (0)
 
+static int PZroots(CKTcircuit *ckt, PZtrial **rootinfo, int *rootcount);
+
 /* ARGSUSED */
 int
 PZan(CKTcircuit *ckt, int reset)
@@ -60,7 +62,7 @@ PZan(CKTcircuit *ckt, int reset)
 	error = CKTpzSetup(ckt, PZ_DO_POLES);
 	if (error != OK)
 	    return error;
-        error = CKTpzFindZeros(ckt, &job->PZpoleList, &job->PZnPoles);
+        error = PZroots(ckt, &job->PZpoleList, &job->PZnPoles);
         if (error != OK)
 	    return(error);
     }
@@ -69,7 +71,7 @@ PZan(CKTcircuit *ckt, int reset)
 	error = CKTpzSetup(ckt, PZ_DO_ZEROS);
 	if (error != OK)
 	    return error;
-        error = CKTpzFindZeros(ckt, &job->PZzeroList, &job->PZnZeros);
+        error = PZroots(ckt, &job->PZzeroList, &job->PZnZeros);
         if (error != OK)
 	    return(error);
     }
@@ -77,6 +79,27 @@ PZan(CKTcircuit *ckt, int reset)
     return PZpost(ckt);
 }
 
+/*
+ * Find the roots of the matrix set up by CKTpzSetup(), as eigenvalues with
+ * option pzarnoldi, else (and if that fails) by the search in s.
+ */
+
+static int
+PZroots(CKTcircuit *ckt, PZtrial **rootinfo, int *rootcount)
+{
+    int error;
+
+    if (ckt->CKTpzArnoldi) {
+        error = CKTpzArnoldi(ckt, rootinfo, rootcount);
+        if (error == OK || error == E_PAUSE)
+            return error;
+        SPfrontEnd->IFerrorf (ERR_WARNING,
+            "pzarnoldi failed, pole-zero analysis falls back to the search in s");
+    }
+
+    return CKTpzFindZeros(ckt, rootinfo, rootcount);
+}
+
 /*
  * Perform error checking
  */
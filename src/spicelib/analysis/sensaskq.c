@@ -35,9 +35,18 @@ SENSask(CKTcircuit *ckt, JOB *anal, int which, IFvalue *value)
     case SENS_OCTAVE:
     case SENS_LINEAR:
     case SENS_DC:
+    case SENS_TRAN:
 	value->iValue = job->step_type == which;
         break;
 
+    case SENS_TSTEP:
+	value->rValue = job->tran_step;
+	break;
+
+    case SENS_TSTOP:
+	value->rValue = job->tran_stop;
+	break;
+
     case SENS_DEFTOL:
 	value->rValue = job->deftol;
 	break;
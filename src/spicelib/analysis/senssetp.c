@@ -69,6 +69,18 @@ SENSsetParam(CKTcircuit *ckt, JOB *anal, int which, IFvalue *value)
 	job->step_type = SENS_DC;
 	break;
 
+    case SENS_TRAN:
+	job->step_type = SENS_TRAN;
+	break;
+
+    case SENS_TSTEP:
+	job->tran_step = value->rValue;
+	break;
+
+    case SENS_TSTOP:
+	job->tran_stop = value->rValue;
+	break;
+
     case SENS_DEFTOL:
 	job->deftol = value->rValue;
 	break;
@@ -101,6 +113,11 @@ static IFparm SENSparms[] = {
     { "oct",        SENS_OCTAVE,  IF_SET|IF_FLAG, "step by octaves" },
     { "lin",        SENS_LINEAR,  IF_SET|IF_FLAG, "step linearly" },
     { "dc",         SENS_DC,      IF_SET|IF_FLAG, "analysis at DC" },
+
+    /* transient parameters */
+    { "tran",       SENS_TRAN,    IF_SET|IF_FLAG, "transient analysis" },
+    { "tstep",      SENS_TSTEP, IF_SET|IF_ASK|IF_REAL, "transient time step" },
+    { "tstop",      SENS_TSTOP, IF_SET|IF_ASK|IF_REAL, "transient final time" },
 };
 
 SPICEanalysis SENSinfo  = {
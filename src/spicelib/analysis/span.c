@@ -70,6 +70,131 @@ cplx   Sopt;
 double Fmin = 0;
 double refPortY0;
 
+
+#ifdef USE_OMP
+
+extern int nthreads;
+
+/* Factored matrices of the upcoming frequencies, see cktacslot.c.
+ * Hangs off the job as SPpool. */
+struct SPpool {
+    ACslots slots;
+    int next;                   /* next slot to hand out */
+    int count;                  /* number of solved slots */
+    SMPmatrix* sharedMatrix;    /* CKTmatrix, while a slot matrix is lent */
+};
+
+
+static int
+SPthreaded(CKTcircuit* ckt)
+{
+    if (nthreads < 2 || ckt->CKTvarHertz)
+        return 0;
+#ifdef WANT_SENSE2
+    if (ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & ACSEN))
+        return 0;
+#endif
+    return 1;
+}
+
+
+/* Hand CKTmatrix back to the circuit, if it has been lent from the pool */
+static void
+SPreleaseMatrix(CKTcircuit* ckt, SPAN* job)
+{
+    struct SPpool* pool = job->SPpool;
+
+    if (pool && pool->sharedMatrix) {
+        ckt->CKTmatrix = pool->sharedMatrix;
+        pool->sharedMatrix = NULL;
+    }
+}
+
+
+static void
+SPdestroyPool(CKTcircuit* ckt, SPAN* job)
+{
+    if (!job->SPpool)
+        return;
+    SPreleaseMatrix(ckt, job);
+    CKTacSlotsDestroy(&job->SPpool->slots);
+    FREE(job->SPpool);
+}
+
+
+/* Threaded replacement of NIspPreload().  The matrices of the next few
+ * frequencies are loaded serially and factored concurrently.  A factored
+ * matrix is then lent to the circuit as CKTmatrix, with its port-less rhs
+ * in CKTrhs/CKTirhs, exactly as NIspPreload() would have left them.  The
+ * port excitations and the noise adjoint solves of the sweep loop then run
+ * unchanged.  SPreleaseMatrix() must be called once the point is done.
+ */
+static int
+SPpreload(CKTcircuit* ckt, SPAN* job, double freq, double freqTol)
+{
+    struct SPpool* pool = job->SPpool;
+    size_t bytes;
+    ACslot* slot;
+    int error;
+
+    /* The first point settles the pivot order handed down to the slots */
+    if (!pool) {
+        error = NIspPreload(ckt);
+        if (error)
+            return error;
+        pool = job->SPpool = TMALLOC(struct SPpool, 1);
+        return CKTacSlotsCreate(ckt, &pool->slots, nthreads, 0);
+    }
+
+    if (pool->next >= pool->count || pool->slots.slots[pool->next].freq != freq) {
+        double f = freq;
+        int n;
+
+        for (n = 0; n < pool->slots.numSlots && f <= job->SPstopFreq + freqTol; n++) {
+            error = CKTacSlotLoad(ckt, &pool->slots.slots[n], f);
+            if (error)
+                return error;
+
+            if (job->SPstepType == LINEAR) {
+                f += job->SPfreqDelta;
+                if (job->SPfreqDelta == 0)
+                    f = HUGE_VAL;
+            } else {
+                f *= job->SPfreqDelta;
+                if (job->SPfreqDelta == 1)
+                    f = HUGE_VAL;
+            }
+        }
+
+        CKTacSlotsSolve(ckt, &pool->slots, n, 0, 0, 0);
+        pool->next = 0;
+        pool->count = n;
+    }
+
+    slot = &pool->slots.slots[pool->next++];
+    ckt->CKTomega = 2.0 * M_PI * freq;
+
+    if (slot->error == E_SINGULAR) {
+        /* the pivot order does not fit this frequency */
+        error = CKTacSlotRedo(ckt, &pool->slots, slot, 0, 0, 0);
+        if (error)
+            return error;
+    } else if (slot->error) {
+        return slot->error;
+    }
+
+    bytes = (size_t) (pool->slots.size + 1) * sizeof(double);
+    memcpy(ckt->CKTrhs, slot->rhs, bytes);
+    memcpy(ckt->CKTirhs, slot->irhs, bytes);
+
+    pool->sharedMatrix = ckt->CKTmatrix;
+    ckt->CKTmatrix = slot->matrix;
+
+    return OK;
+}
+
+#endif
+
 int
 CKTspnoise(CKTcircuit* ckt, int mode, int operation, Ndata* data, NOISEAN* noisean)
 {
@@ -193,6 +318,9 @@ NInspIter(CKTcircuit* ckt, VSRCinstance* port)
 
 int initSPmatrix(CKTcircuit* ckt, int doNoise)
 {
+#ifdef USE_OMP
+    SPdestroyPool(ckt, (SPAN*)ckt->CKTcurJob);
+#endif
 
     if (ckt->CKTAmat != NULL) freecmat(ckt->CKTAmat);
     if (ckt->CKTBmat != NULL) freecmat(ckt->CKTBmat);
@@ -303,6 +431,10 @@ void deleteSPmatrix(CKTcircuit* ckt)
     iNoise = NULL;
     ckt->CKTNoiseCYmat = NULL;
     ckt->CKTadjointRHS = NULL;
+
+#ifdef USE_OMP
+    SPdestroyPool(ckt, (SPAN*)ckt->CKTcurJob);
+#endif
 }
 
 
@@ -672,6 +804,9 @@ SPan(CKTcircuit* ckt, int restart)
         if (SPfrontEnd->IFpauseTest()) {
             /* user asked us to pause via an interrupt */
             job->SPsaveFreq = freq;
+#ifdef USE_OMP
+            SPdestroyPool(ckt, job);
+#endif
             return(E_PAUSE);
         }
         ckt->CKTomega = 2.0 * M_PI * freq;
@@ -762,6 +897,11 @@ SPan(CKTcircuit* ckt, int restart)
 
 
         // Pre-load everything but RF Ports (these will be updated in the next cycle).
+#ifdef USE_OMP
+        if (SPthreaded(ckt))
+            error = SPpreload(ckt, job, freq, freqTol);
+        else
+#endif
         error = NIspPreload(ckt);
         if (error) return (error);
 
@@ -882,6 +1022,10 @@ SPan(CKTcircuit* ckt, int restart)
             data->lstFreq = freq;
         }
 
+#ifdef USE_OMP
+        SPreleaseMatrix(ckt, job);
+#endif
+
 
 #ifdef XSPICE
         /* gtri - modify - wbk - 12/19/90 - Send IPC stuff */
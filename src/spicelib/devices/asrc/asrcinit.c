@@ -18,7 +18,7 @@ SPICEdev ASRCinfo = {
         .instanceParms = ASRCpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_SHARED,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -37,6 +37,7 @@ SPICEdev ASRCinfo = {
     .DEVsetup = (int (*)(SMPmatrix *matrix, GENmodel *inModel,
             CKTcircuit *ckt, int *states)) ASRCsetup,
     .DEVunsetup = ASRCunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup =  (int (*)(SMPmatrix *matrix, GENmodel *inModel,
             CKTcircuit *ckt, int *states)) ASRCsetup,
     .DEVtemperature = ASRCtemp,
@@ -61,6 +62,7 @@ SPICEdev ASRCinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &ASRCiSize,
     .DEVmodSize = &ASRCmSize,
 
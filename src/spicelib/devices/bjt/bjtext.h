@@ -24,6 +24,7 @@ extern int BJTsSetup(SENstruct*,GENmodel*);
 extern int BJTsUpdate(GENmodel*,CKTcircuit*);
 extern int BJTsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
 extern int BJTunsetup(GENmodel*,CKTcircuit*);
+extern int BJTinstUnsetup(GENinstance*,CKTcircuit*);
 extern int BJTtemp(GENmodel*,CKTcircuit*);
 extern int BJTtrunc(GENmodel*,CKTcircuit*,double*);
 extern int BJTdisto(int,GENmodel*,CKTcircuit*);
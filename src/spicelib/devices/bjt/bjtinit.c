@@ -18,7 +18,7 @@ SPICEdev BJTinfo = {
 	.instanceParms = BJTpTable,
 	.numModelParms = &BJTmPTSize,
 	.modelParms = BJTmPTable,
-	.flags = DEV_DEFAULT,
+	.flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
 	.cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BJTinfo = {
     .DEVload = BJTload,
     .DEVsetup = BJTsetup,
     .DEVunsetup = BJTunsetup,
+    .DEVinstUnsetup = BJTinstUnsetup,
     .DEVpzSetup = BJTsetup,
     .DEVtemperature = BJTtemp,
     .DEVtrunc = BJTtrunc,
@@ -59,6 +60,7 @@ SPICEdev BJTinfo = {
     .DEVdisto = BJTdisto,
     .DEVnoise = BJTnoise,
     .DEVsoaCheck = BJTsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &BJTiSize,
     .DEVmodSize = &BJTmSize,
 
@@ -580,3 +580,26 @@ BJTunsetup(
     }
     return OK;
 }
+
+
+/* prime nodes shorted to their terminal are decided on again by
+ * BJTsetup() */
+int
+BJTinstUnsetup(
+    GENinstance *inInst,
+    CKTcircuit *ckt)
+{
+    BJTinstance *here = (BJTinstance *)inInst;
+
+    NG_IGNORE(ckt);
+
+    if (here->BJTemitPrimeNode == here->BJTemitNode)
+        here->BJTemitPrimeNode = 0;
+    if (here->BJTbasePrimeNode == here->BJTbaseNode)
+        here->BJTbasePrimeNode = 0;
+    if (here->BJTcolPrimeNode == here->BJTcollCXNode)
+        here->BJTcolPrimeNode = 0;
+    if (here->BJTcollCXNode == here->BJTcolNode)
+        here->BJTcollCXNode = 0;
+    return OK;
+}
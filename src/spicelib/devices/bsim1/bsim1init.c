@@ -18,7 +18,7 @@ SPICEdev B1info = {
         .instanceParms = B1pTable,
         .numModelParms = &B1mPTSize,
         .modelParms = B1mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev B1info = {
     .DEVload = B1load,
     .DEVsetup = B1setup,
     .DEVunsetup = B1unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B1setup,
     .DEVtemperature = B1temp,
     .DEVtrunc = B1trunc,
@@ -59,6 +60,7 @@ SPICEdev B1info = {
     .DEVdisto = B1disto,
     .DEVnoise = B1noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &B1iSize,
     .DEVmodSize = &B1mSize,
 
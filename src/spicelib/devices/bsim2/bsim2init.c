@@ -18,7 +18,7 @@ SPICEdev B2info = {
         .instanceParms = B2pTable,
         .numModelParms = &B2mPTSize,
         .modelParms = B2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev B2info = {
     .DEVload = B2load,
     .DEVsetup = B2setup,
     .DEVunsetup = B2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B2setup,
     .DEVtemperature = B2temp,
     .DEVtrunc = B2trunc,
@@ -59,6 +60,7 @@ SPICEdev B2info = {
     .DEVdisto = NULL,
     .DEVnoise = B2noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &B2iSize,
     .DEVmodSize = &B2mSize,
 
@@ -1161,6 +1161,22 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
     return(OK);
 }
 
+/* The DEVsetup() of the copy made by CKTclone() gives it its own array
+   of the instances for the parallel load, freed here with the copy */
+
+int
+BSIM3clone(GENmodel *inModel, GENmodel *source)
+{
+#ifdef USE_OMP
+    if (!source)
+        tfree(((BSIM3model *) inModel)->BSIM3InstanceArray);
+#else
+    NG_IGNORE(inModel);
+    NG_IGNORE(source);
+#endif
+    return OK;
+}
+
 int
 BSIM3unsetup(
     GENmodel *inModel,
@@ -26,4 +26,5 @@ extern int BSIM3temp(GENmodel*,CKTcircuit*);
 extern int BSIM3trunc(GENmodel*,CKTcircuit*,double*);
 extern int BSIM3noise(int,int,GENmodel*,CKTcircuit*,Ndata*,double*);
 extern int BSIM3unsetup(GENmodel*,CKTcircuit*);
+extern int BSIM3clone(GENmodel*,GENmodel*);
 extern int BSIM3soaCheck(CKTcircuit *, GENmodel *);
@@ -18,7 +18,7 @@ SPICEdev BSIM3info = {
         .instanceParms = BSIM3pTable,
         .numModelParms = &BSIM3mPTSize,
         .modelParms = BSIM3mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM3info = {
     .DEVload = BSIM3load,
     .DEVsetup = BSIM3setup,
     .DEVunsetup = BSIM3unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM3setup,
     .DEVtemperature = BSIM3temp,
     .DEVtrunc = BSIM3trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM3info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM3noise,
     .DEVsoaCheck = BSIM3soaCheck,
+    .DEVclone = BSIM3clone,
     .DEVinstSize = &BSIM3iSize,
     .DEVmodSize = &BSIM3mSize,
 
@@ -16,7 +16,7 @@ SPICEdev B3SOIDDinfo = {
         .instanceParms = B3SOIDDpTable,
         .numModelParms = &B3SOIDDmPTSize,
         .modelParms = B3SOIDDmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_SHARED | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -34,6 +34,7 @@ SPICEdev B3SOIDDinfo = {
     .DEVload = B3SOIDDload,
     .DEVsetup = B3SOIDDsetup,
     .DEVunsetup = B3SOIDDunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B3SOIDDsetup,
     .DEVtemperature = B3SOIDDtemp,
     .DEVtrunc = B3SOIDDtrunc,
@@ -57,6 +58,7 @@ SPICEdev B3SOIDDinfo = {
     .DEVdisto = NULL,
     .DEVnoise = B3SOIDDnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &B3SOIDDiSize,
     .DEVmodSize = &B3SOIDDmSize,
 
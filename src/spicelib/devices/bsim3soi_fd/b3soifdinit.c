@@ -16,7 +16,7 @@ SPICEdev B3SOIFDinfo = {
         .instanceParms = B3SOIFDpTable,
         .numModelParms = &B3SOIFDmPTSize,
         .modelParms = B3SOIFDmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_SHARED | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -34,6 +34,7 @@ SPICEdev B3SOIFDinfo = {
     .DEVload = B3SOIFDload,
     .DEVsetup = B3SOIFDsetup,
     .DEVunsetup = B3SOIFDunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B3SOIFDsetup,
     .DEVtemperature = B3SOIFDtemp,
     .DEVtrunc = B3SOIFDtrunc,
@@ -57,6 +58,7 @@ SPICEdev B3SOIFDinfo = {
     .DEVdisto = NULL,
     .DEVnoise = B3SOIFDnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &B3SOIFDiSize,
     .DEVmodSize = &B3SOIFDmSize,
 
@@ -17,7 +17,7 @@ SPICEdev B3SOIPDinfo = {
 	.instanceParms = B3SOIPDpTable,
 	.numModelParms = &B3SOIPDmPTSize,
 	.modelParms = B3SOIPDmPTable,
-	.flags = DEV_DEFAULT,
+	.flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
 	.cm_func = NULL,
@@ -35,6 +35,7 @@ SPICEdev B3SOIPDinfo = {
     .DEVload = B3SOIPDload,
     .DEVsetup = B3SOIPDsetup,
     .DEVunsetup = B3SOIPDunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B3SOIPDsetup,
     .DEVtemperature = B3SOIPDtemp,
     .DEVtrunc = B3SOIPDtrunc,
@@ -58,6 +59,7 @@ SPICEdev B3SOIPDinfo = {
     .DEVdisto = NULL,
     .DEVnoise = B3SOIPDnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &B3SOIPDiSize,
     .DEVmodSize = &B3SOIPDmSize,
 
@@ -17,7 +17,7 @@ SPICEdev B3v0info = {
         .instanceParms = BSIM3v0pTable,
         .numModelParms = &BSIM3v0mPTSize,
         .modelParms = BSIM3v0mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -35,6 +35,7 @@ SPICEdev B3v0info = {
     .DEVload = BSIM3v0load,
     .DEVsetup = BSIM3v0setup,
     .DEVunsetup = BSIM3v0unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM3v0setup,
     .DEVtemperature = BSIM3v0temp,
     .DEVtrunc = BSIM3v0trunc,
@@ -58,6 +59,7 @@ SPICEdev B3v0info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM3v0noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM3v0iSize,
     .DEVmodSize = &BSIM3v0mSize,
 
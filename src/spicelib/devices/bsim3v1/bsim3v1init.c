@@ -17,7 +17,7 @@ SPICEdev BSIM3v1info = {
         .instanceParms = BSIM3v1pTable,
         .numModelParms = &BSIM3v1mPTSize,
         .modelParms = BSIM3v1mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -35,6 +35,7 @@ SPICEdev BSIM3v1info = {
     .DEVload = BSIM3v1load,
     .DEVsetup = BSIM3v1setup,
     .DEVunsetup = BSIM3v1unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM3v1setup,
     .DEVtemperature = BSIM3v1temp,
     .DEVtrunc = BSIM3v1trunc,
@@ -58,6 +59,7 @@ SPICEdev BSIM3v1info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM3v1noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM3v1iSize,
     .DEVmodSize = &BSIM3v1mSize,
 
@@ -18,7 +18,7 @@ SPICEdev BSIM3v32info = {
         .instanceParms = BSIM3v32pTable,
         .numModelParms = &BSIM3v32mPTSize,
         .modelParms = BSIM3v32mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM3v32info = {
     .DEVload = BSIM3v32load,
     .DEVsetup = BSIM3v32setup,
     .DEVunsetup = BSIM3v32unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM3v32setup,
     .DEVtemperature = BSIM3v32temp,
     .DEVtrunc = BSIM3v32trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM3v32info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM3v32noise,
     .DEVsoaCheck = BSIM3v32soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM3v32iSize,
     .DEVmodSize = &BSIM3v32mSize,
 
@@ -2752,6 +2752,22 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
     return(OK);
 }  
 
+/* The DEVsetup() of the copy made by CKTclone() gives it its own array
+   of the instances for the parallel load, freed here with the copy */
+
+int
+BSIM4clone(GENmodel *inModel, GENmodel *source)
+{
+#ifdef USE_OMP
+    if (!source)
+        tfree(((BSIM4model *) inModel)->BSIM4InstanceArray);
+#else
+    NG_IGNORE(inModel);
+    NG_IGNORE(source);
+#endif
+    return OK;
+}
+
 int
 BSIM4unsetup(
 GENmodel *inModel,
@@ -79,4 +79,5 @@ extern int BSIM4temp(GENmodel*,CKTcircuit*);
 extern int BSIM4trunc(GENmodel*,CKTcircuit*,double*);
 extern int BSIM4noise(int,int,GENmodel*,CKTcircuit*,Ndata*,double*);
 extern int BSIM4unsetup(GENmodel*,CKTcircuit*);
+extern int BSIM4clone(GENmodel*,GENmodel*);
 extern int BSIM4soaCheck(CKTcircuit *, GENmodel *);
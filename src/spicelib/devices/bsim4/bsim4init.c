@@ -18,7 +18,7 @@ SPICEdev BSIM4info = {
         .instanceParms = BSIM4pTable,
         .numModelParms = &BSIM4mPTSize,
         .modelParms = BSIM4mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM4info = {
     .DEVload = BSIM4load,
     .DEVsetup = BSIM4setup,
     .DEVunsetup = BSIM4unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM4setup,
     .DEVtemperature = BSIM4temp,
     .DEVtrunc = BSIM4trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM4info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM4noise,
     .DEVsoaCheck = BSIM4soaCheck,
+    .DEVclone = BSIM4clone,
     .DEVinstSize = &BSIM4iSize,
     .DEVmodSize = &BSIM4mSize,
 
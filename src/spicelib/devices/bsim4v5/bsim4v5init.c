@@ -18,7 +18,7 @@ SPICEdev BSIM4v5info = {
         .instanceParms = BSIM4v5pTable,
         .numModelParms = &BSIM4v5mPTSize,
         .modelParms = BSIM4v5mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM4v5info = {
     .DEVload = BSIM4v5load,
     .DEVsetup = BSIM4v5setup,
     .DEVunsetup = BSIM4v5unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM4v5setup,
     .DEVtemperature = BSIM4v5temp,
     .DEVtrunc = BSIM4v5trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM4v5info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM4v5noise,
     .DEVsoaCheck = BSIM4v5soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM4v5iSize,
     .DEVmodSize = &BSIM4v5mSize,
 
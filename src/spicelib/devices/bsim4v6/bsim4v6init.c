@@ -18,7 +18,7 @@ SPICEdev BSIM4v6info = {
         .instanceParms = BSIM4v6pTable,
         .numModelParms = &BSIM4v6mPTSize,
         .modelParms = BSIM4v6mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM4v6info = {
     .DEVload = BSIM4v6load,
     .DEVsetup = BSIM4v6setup,
     .DEVunsetup = BSIM4v6unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM4v6setup,
     .DEVtemperature = BSIM4v6temp,
     .DEVtrunc = BSIM4v6trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM4v6info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM4v6noise,
     .DEVsoaCheck = BSIM4v6soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM4v6iSize,
     .DEVmodSize = &BSIM4v6mSize,
 
@@ -18,7 +18,7 @@ SPICEdev BSIM4v7info = {
         .instanceParms = BSIM4v7pTable,
         .numModelParms = &BSIM4v7mPTSize,
         .modelParms = BSIM4v7mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev BSIM4v7info = {
     .DEVload = BSIM4v7load,
     .DEVsetup = BSIM4v7setup,
     .DEVunsetup = BSIM4v7unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = BSIM4v7setup,
     .DEVtemperature = BSIM4v7temp,
     .DEVtrunc = BSIM4v7trunc,
@@ -59,6 +60,7 @@ SPICEdev BSIM4v7info = {
     .DEVdisto = NULL,
     .DEVnoise = BSIM4v7noise,
     .DEVsoaCheck = BSIM4v7soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &BSIM4v7iSize,
     .DEVmodSize = &BSIM4v7mSize,
 
@@ -16,7 +16,7 @@ SPICEdev B4SOIinfo = {
         .instanceParms = B4SOIpTable,
         .numModelParms = &B4SOImPTSize,
         .modelParms = B4SOImPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -34,6 +34,7 @@ SPICEdev B4SOIinfo = {
     .DEVload = B4SOIload,
     .DEVsetup = B4SOIsetup,
     .DEVunsetup = B4SOIunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = B4SOIsetup,
     .DEVtemperature = B4SOItemp,
     .DEVtrunc = B4SOItrunc,
@@ -57,6 +58,7 @@ SPICEdev B4SOIinfo = {
     .DEVdisto = NULL,
     .DEVnoise = B4SOInoise,
     .DEVsoaCheck = B4SOIsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &B4SOIiSize,
     .DEVmodSize = &B4SOImSize,
 
@@ -18,7 +18,7 @@ SPICEdev CAPinfo = {
         .instanceParms = CAPpTable,
         .numModelParms = &CAPmPTSize,
         .modelParms = CAPmPTable,
-        .flags = 0,
+        .flags = DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev CAPinfo = {
     .DEVload = CAPload,
     .DEVsetup = CAPsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = CAPsetup,
     .DEVtemperature = CAPtemp,
     .DEVtrunc = CAPtrunc,
@@ -59,6 +60,7 @@ SPICEdev CAPinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = CAPsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &CAPiSize,
     .DEVmodSize = &CAPmSize,
 
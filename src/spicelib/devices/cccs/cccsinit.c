@@ -18,7 +18,7 @@ SPICEdev CCCSinfo = {
         .instanceParms = CCCSpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev CCCSinfo = {
     .DEVload = CCCSload,
     .DEVsetup = CCCSsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = CCCSsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev CCCSinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &CCCSiSize,
     .DEVmodSize = &CCCSmSize,
 
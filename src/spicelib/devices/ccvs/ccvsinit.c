@@ -18,7 +18,7 @@ SPICEdev CCVSinfo = {
         .instanceParms = CCVSpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev CCVSinfo = {
     .DEVload = CCVSload,
     .DEVsetup = CCVSsetup,
     .DEVunsetup = CCVSunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = CCVSsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev CCVSinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &CCVSiSize,
     .DEVmodSize = &CCVSmSize,
 
@@ -106,6 +106,8 @@ CKTinit(CKTcircuit **ckt)		/* new circuit to create */
 
     /* Initialize options data */
     sckt->evt->options.op_alternate = MIF_TRUE;
+    sckt->evt->options.hist_window = 0;
+    sckt->evt->options.parallel = MIF_FALSE;
 
     /* Allocate enh data structure */
     sckt->enh = TMALLOC(Enh_Ckt_Data_t, 1);
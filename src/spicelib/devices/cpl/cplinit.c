@@ -18,7 +18,7 @@ SPICEdev CPLinfo = {
 	.instanceParms = CPLpTable,
 	.numModelParms = &CPLmPTSize,
 	.modelParms = CPLmPTable,
-	.flags = 0,
+	.flags = DEV_SHARED,
 
 #ifdef XSPICE
 	.cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev CPLinfo = {
     .DEVload = CPLload,
     .DEVsetup = CPLsetup,
     .DEVunsetup = CPLunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NULL,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev CPLinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &CPLiSize,
     .DEVmodSize = &CPLmSize,
 
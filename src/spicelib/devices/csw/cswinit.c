@@ -20,7 +20,7 @@ SPICEdev CSWinfo = {
         .instanceParms = CSWpTable,
         .numModelParms = &CSWmPTSize,
         .modelParms = CSWmPTable,
-        .flags = 0,
+        .flags = DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -38,6 +38,7 @@ SPICEdev CSWinfo = {
     .DEVload = CSWload,
     .DEVsetup = CSWsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = CSWsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = CSWtrunc,
@@ -61,6 +62,7 @@ SPICEdev CSWinfo = {
     .DEVdisto = NULL,
     .DEVnoise = CSWnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &CSWiSize,
     .DEVmodSize = &CSWmSize,
 
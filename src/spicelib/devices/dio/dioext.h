@@ -20,6 +20,7 @@ extern void DIOsPrint(GENmodel*,CKTcircuit*);
 extern int DIOsUpdate(GENmodel*,CKTcircuit*);
 extern int DIOsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
 extern int DIOunsetup(GENmodel*,CKTcircuit*);
+extern int DIOinstUnsetup(GENinstance*,CKTcircuit*);
 extern int DIOtemp(GENmodel*,CKTcircuit*);
 extern int DIOtrunc(GENmodel*,CKTcircuit*,double*);
 extern int DIOdisto(int,GENmodel*,CKTcircuit*);
@@ -19,7 +19,7 @@ SPICEdev DIOinfo = {
         .instanceParms = DIOpTable,
         .numModelParms = &DIOmPTSize,
         .modelParms = DIOmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -37,6 +37,7 @@ SPICEdev DIOinfo = {
     .DEVload = DIOload,
     .DEVsetup = DIOsetup,
     .DEVunsetup = DIOunsetup,
+    .DEVinstUnsetup = DIOinstUnsetup,
     .DEVpzSetup = DIOsetup,
     .DEVtemperature = DIOtemp,
     .DEVtrunc = DIOtrunc,
@@ -60,6 +61,7 @@ SPICEdev DIOinfo = {
     .DEVdisto = DIOdisto,
     .DEVnoise = DIOnoise,
     .DEVsoaCheck = DIOsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &DIOiSize,
     .DEVmodSize = &DIOmSize,
 
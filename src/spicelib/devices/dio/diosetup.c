@@ -376,3 +376,19 @@ DIOunsetup(
     }
     return OK;
 }
+
+
+/* the prime node shorted to the anode is decided on again by DIOsetup() */
+int
+DIOinstUnsetup(
+    GENinstance *inInst,
+    CKTcircuit *ckt)
+{
+    DIOinstance *here = (DIOinstance *)inInst;
+
+    NG_IGNORE(ckt);
+
+    if (here->DIOposPrimeNode == here->DIOposNode)
+        here->DIOposPrimeNode = 0;
+    return OK;
+}
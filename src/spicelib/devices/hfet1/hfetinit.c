@@ -18,7 +18,7 @@ SPICEdev HFETAinfo = {
         .instanceParms = HFETApTable,
         .numModelParms = &HFETAmPTSize,
         .modelParms = HFETAmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev HFETAinfo = {
     .DEVload = HFETAload,
     .DEVsetup = HFETAsetup,
     .DEVunsetup = HFETAunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HFETAsetup,
     .DEVtemperature = HFETAtemp,
     .DEVtrunc = HFETAtrunc,
@@ -59,6 +60,7 @@ SPICEdev HFETAinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &HFETAiSize,
     .DEVmodSize = &HFETAmSize,
 
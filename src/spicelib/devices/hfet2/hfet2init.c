@@ -18,7 +18,7 @@ SPICEdev HFET2info = {
         .instanceParms = HFET2pTable,
         .numModelParms = &HFET2mPTSize,
         .modelParms = HFET2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev HFET2info = {
     .DEVload = HFET2load,
     .DEVsetup = HFET2setup,
     .DEVunsetup = HFET2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HFET2setup,
     .DEVtemperature = HFET2temp,
     .DEVtrunc = HFET2trunc,
@@ -59,6 +60,7 @@ SPICEdev HFET2info = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &HFET2iSize,
     .DEVmodSize = &HFET2mSize,
 
@@ -27,7 +27,7 @@ SPICEdev HICUMinfo = {
         .instanceParms = HICUMpTable,
         .numModelParms = &HICUMmPTSize,
         .modelParms = HICUMmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -45,6 +45,7 @@ SPICEdev HICUMinfo = {
     .DEVload = HICUMload,
     .DEVsetup = HICUMsetup,
     .DEVunsetup = HICUMunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HICUMsetup,
     .DEVtemperature = HICUMtemp,
     .DEVtrunc = HICUMtrunc,
@@ -68,6 +69,7 @@ SPICEdev HICUMinfo = {
     .DEVdisto = NULL,
     .DEVnoise = HICUMnoise,
     .DEVsoaCheck = HICUMsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &HICUMiSize,
     .DEVmodSize = &HICUMmSize,
 
@@ -18,7 +18,7 @@ SPICEdev HSM2info = {
         .instanceParms = HSM2pTable,
         .numModelParms = &HSM2mPTSize,
         .modelParms = HSM2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR | DEV_OMPLOAD,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev HSM2info = {
     .DEVload = HSM2load,
     .DEVsetup = HSM2setup,
     .DEVunsetup = HSM2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HSM2setup,
     .DEVtemperature = HSM2temp,
     .DEVtrunc = HSM2trunc,
@@ -59,6 +60,7 @@ SPICEdev HSM2info = {
     .DEVdisto = NULL,
     .DEVnoise = HSM2noise,
     .DEVsoaCheck = HSM2soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &HSM2iSize,
     .DEVmodSize = &HSM2mSize,
 
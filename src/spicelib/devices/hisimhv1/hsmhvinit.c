@@ -18,7 +18,7 @@ SPICEdev HSMHVinfo = {
         .instanceParms = HSMHVpTable,
         .numModelParms = &HSMHVmPTSize,
         .modelParms = HSMHVmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev HSMHVinfo = {
     .DEVload = HSMHVload,
     .DEVsetup = HSMHVsetup,
     .DEVunsetup = HSMHVunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HSMHVsetup,
     .DEVtemperature = HSMHVtemp,
     .DEVtrunc = HSMHVtrunc,
@@ -59,6 +60,7 @@ SPICEdev HSMHVinfo = {
     .DEVdisto = NULL,
     .DEVnoise = HSMHVnoise,
     .DEVsoaCheck = HSMHVsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &HSMHViSize,
     .DEVmodSize = &HSMHVmSize,
 
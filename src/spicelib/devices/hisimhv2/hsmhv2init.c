@@ -18,7 +18,7 @@ SPICEdev HSMHV2info = {
         .instanceParms = HSMHV2pTable,
         .numModelParms = &HSMHV2mPTSize,
         .modelParms = HSMHV2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev HSMHV2info = {
     .DEVload = HSMHV2load,
     .DEVsetup = HSMHV2setup,
     .DEVunsetup = HSMHV2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = HSMHV2setup,
     .DEVtemperature = HSMHV2temp,
     .DEVtrunc = HSMHV2trunc,
@@ -59,6 +60,7 @@ SPICEdev HSMHV2info = {
     .DEVdisto = NULL,
     .DEVnoise = HSMHV2noise,
     .DEVsoaCheck = HSMHV2soaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &HSMHV2iSize,
     .DEVmodSize = &HSMHV2mSize,
 
@@ -18,7 +18,7 @@ SPICEdev INDinfo = {
         .instanceParms = INDpTable,
         .numModelParms = &INDmPTSize,
         .modelParms = INDmPTable,
-        .flags = 0,
+        .flags = DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev INDinfo = {
     .DEVload = INDload,
     .DEVsetup = INDsetup,
     .DEVunsetup = INDunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = INDsetup,
     .DEVtemperature = INDtemp,
     .DEVtrunc = INDtrunc,
@@ -59,6 +60,7 @@ SPICEdev INDinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &INDiSize,
     .DEVmodSize = &INDmSize,
 
@@ -80,7 +82,7 @@ SPICEdev MUTinfo = {
         .instanceParms = MUTpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = 0,
+        .flags = DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -98,6 +100,7 @@ SPICEdev MUTinfo = {
     .DEVload = NULL,
     .DEVsetup = MUTsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MUTsetup,
     .DEVtemperature = MUTtemp,
     .DEVtrunc = NULL,
@@ -121,6 +124,7 @@ SPICEdev MUTinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MUTiSize,
     .DEVmodSize = &MUTmSize,
 
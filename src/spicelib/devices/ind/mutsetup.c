@@ -43,16 +43,16 @@ MUTsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
                 return(E_INTERN);
             }
 
-            if (!here->MUTind1)
-                here->MUTind1 = (INDinstance *) CKTfndDev(ckt, here->MUTindName1);
+            /* again on each setup, a copy made by CKTclone() has the
+               pointers to the inductors of its source */
+            here->MUTind1 = (INDinstance *) CKTfndDev(ckt, here->MUTindName1);
             if (!here->MUTind1) {
                 SPfrontEnd->IFerrorf (ERR_FATAL,
                                       "%s: coupling to non-existant inductor %s.",
                                       here->MUTname, here->MUTindName1);
                 return(E_INTERN); /* We have to leave, or TSTALLOC will segfault */
             }
-            if (!here->MUTind2)
-                here->MUTind2 = (INDinstance *) CKTfndDev(ckt, here->MUTindName2);
+            here->MUTind2 = (INDinstance *) CKTfndDev(ckt, here->MUTindName2);
             if (!here->MUTind2) {
                 SPfrontEnd->IFerrorf (ERR_FATAL,
                                       "%s: coupling to non-existant inductor %s.",
@@ -240,13 +240,12 @@ ISRCaccept(CKTcircuit *ckt, GENmodel *inModel)
                         if (RTSAM > 0) {
                             double RTScapTime = state->RTScapTime;
                             double RTSemTime = state->RTSemTime;
-                            double RTSCAPT = state->RTSCAPT;
-                            double RTSEMT = state->RTSEMT;
 
                             if (ckt->CKTtime == 0) {
                                 /* initialzing here again needed for repeated calls to tran command */
-                                state->RTScapTime = RTScapTime = exprand(RTSCAPT);
-                                state->RTSemTime = RTSemTime = RTScapTime + exprand(RTSEMT);
+                                trnoise_rts_restart(state);
+                                RTScapTime = state->RTScapTime;
+                                RTSemTime = state->RTSemTime;
                                 if (ckt->CKTbreak) {
                                     error = CKTsetBreak(ckt, RTScapTime);
                                     if(error)
@@ -264,8 +263,8 @@ ISRCaccept(CKTcircuit *ckt, GENmodel *inModel)
 
                             if(AlmostEqualUlps(RTSemTime, ckt->CKTtime, 3)) {
                                 /* new values */
-                                RTScapTime = here -> ISRCtrnoise_state ->RTScapTime = ckt->CKTtime + exprand(RTSCAPT);
-                                here -> ISRCtrnoise_state ->RTSemTime = RTScapTime + exprand(RTSEMT);
+                                trnoise_rts_next(state, ckt->CKTtime);
+                                RTScapTime = state->RTScapTime;
 
                                 if (ckt->CKTbreak) {
                                     error = CKTsetBreak(ckt, RTScapTime);
@@ -282,6 +281,9 @@ ISRCaccept(CKTcircuit *ckt, GENmodel *inModel)
                         double TS = state -> TS;
                         double TD = state -> TD;
 
+                        if (ckt->CKTtime == 0)
+                            trrandom_state_restart(state);
+
                         double time = ckt->CKTtime - TD;
 
                         if (time < 0) break;
@@ -300,7 +302,7 @@ ISRCaccept(CKTcircuit *ckt, GENmodel *inModel)
                                 error = CKTsetBreak(ckt, next);
                                 if(error)
                                     return(error);
-                                state->value = trrandom_state_get(state);
+                                state->value = trrandom_state_get(state, (size_t) n);
                             }
                         }
                     }
@@ -21,3 +21,24 @@ ISRCdelete(GENinstance *gen_inst)
 
     return OK;
 }
+
+
+/* The copies of CKTclone() share the coefficients, but not the state of
+   transient noise and random sources, which load() advances */
+
+int
+ISRCclone(GENmodel *inModel, GENmodel *source)
+{
+    ISRCmodel *model;
+    ISRCinstance *here;
+
+    if (!source)
+        return OK;
+
+    for (model = (ISRCmodel *) inModel; model; model = ISRCnextModel(model))
+        for (here = ISRCinstances(model); here; here = ISRCnextInstance(here))
+            if (here->ISRCtrnoise_state || here->ISRCtrrandom_state)
+                return E_UNSUPP;
+
+    return OK;
+}
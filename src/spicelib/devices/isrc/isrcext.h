@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
 extern int ISRCaccept(CKTcircuit*,GENmodel*);
 extern int ISRCacLoad(GENmodel*,CKTcircuit*);
 extern int ISRCask(CKTcircuit*,GENinstance*,int,IFvalue*,IFvalue*);
+extern int ISRCclone(GENmodel*,GENmodel*);
 extern int ISRCdelete(GENinstance*);
 extern int ISRCload(GENmodel*,CKTcircuit*);
 extern int ISRCparam(int,IFvalue*,GENinstance*,IFvalue*);
@@ -18,7 +18,7 @@ SPICEdev ISRCinfo = {
         .instanceParms = ISRCpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev ISRCinfo = {
     .DEVload = ISRCload,
     .DEVsetup = NULL,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NULL,
     .DEVtemperature = ISRCtemp,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev ISRCinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = ISRCclone,
     .DEVinstSize = &ISRCiSize,
     .DEVmodSize = &ISRCmSize,
 
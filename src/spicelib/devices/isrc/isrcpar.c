@@ -214,7 +214,8 @@ ISRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
                with the new parameters. So free the old state first. */
             trnoise_state_free(here->ISRCtrnoise_state);
             here->ISRCtrnoise_state =
-                trnoise_state_init(NA, TS, NALPHA, NAMP, RTSAM, RTSCAPT, RTSEMT);
+                trnoise_state_init(NA, TS, NALPHA, NAMP, RTSAM, RTSCAPT, RTSEMT,
+                                   here->ISRCname);
         }
         break;
 
@@ -243,7 +244,7 @@ ISRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
                with the new parameters. So free the old state first. */
             tfree(here->ISRCtrrandom_state);
             here->ISRCtrrandom_state =
-                trrandom_state_init(rndtype, TS, TD, PARAM1, PARAM2);
+                trrandom_state_init(rndtype, TS, TD, PARAM1, PARAM2, here->ISRCname);
         }
         break;
 
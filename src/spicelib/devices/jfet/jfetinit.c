@@ -18,7 +18,7 @@ SPICEdev JFETinfo = {
         .instanceParms = JFETpTable,
         .numModelParms = &JFETmPTSize,
         .modelParms = JFETmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev JFETinfo = {
     .DEVload = JFETload,
     .DEVsetup = JFETsetup,
     .DEVunsetup = JFETunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = JFETsetup,
     .DEVtemperature = JFETtemp,
     .DEVtrunc = JFETtrunc,
@@ -59,6 +60,7 @@ SPICEdev JFETinfo = {
     .DEVdisto = JFETdisto,
     .DEVnoise = JFETnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &JFETiSize,
     .DEVmodSize = &JFETmSize,
 
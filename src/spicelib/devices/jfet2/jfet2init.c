@@ -18,7 +18,7 @@ SPICEdev JFET2info = {
         .instanceParms = JFET2pTable,
         .numModelParms = &JFET2mPTSize,
         .modelParms = JFET2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev JFET2info = {
     .DEVload = JFET2load,
     .DEVsetup = JFET2setup,
     .DEVunsetup = JFET2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = JFET2setup,
     .DEVtemperature = JFET2temp,
     .DEVtrunc = JFET2trunc,
@@ -59,6 +60,7 @@ SPICEdev JFET2info = {
     .DEVdisto = NULL,
     .DEVnoise = JFET2noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &JFET2iSize,
     .DEVmodSize = &JFET2mSize,
 
@@ -36,6 +36,7 @@ SPICEdev LTRAinfo = {
     .DEVload = LTRAload,
     .DEVsetup = LTRAsetup,
     .DEVunsetup = LTRAunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = LTRAsetup,
     .DEVtemperature = LTRAtemp,
     .DEVtrunc = LTRAtrunc,
@@ -59,6 +60,7 @@ SPICEdev LTRAinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &LTRAiSize,
     .DEVmodSize = &LTRAmSize,
 
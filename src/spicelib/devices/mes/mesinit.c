@@ -18,7 +18,7 @@ SPICEdev MESinfo = {
         .instanceParms = MESpTable,
         .numModelParms = &MESmPTSize,
         .modelParms = MESmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MESinfo = {
     .DEVload = MESload,
     .DEVsetup = MESsetup,
     .DEVunsetup = MESunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MESsetup,
     .DEVtemperature = MEStemp,
     .DEVtrunc = MEStrunc,
@@ -59,6 +60,7 @@ SPICEdev MESinfo = {
     .DEVdisto = MESdisto,
     .DEVnoise = MESnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MESiSize,
     .DEVmodSize = &MESmSize,
 
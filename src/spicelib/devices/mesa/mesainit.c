@@ -18,7 +18,7 @@ SPICEdev MESAinfo = {
         .instanceParms = MESApTable,
         .numModelParms = &MESAmPTSize,
         .modelParms = MESAmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MESAinfo = {
     .DEVload = MESAload,
     .DEVsetup = MESAsetup,
     .DEVunsetup = MESAunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MESAsetup,
     .DEVtemperature = MESAtemp,
     .DEVtrunc = MESAtrunc,
@@ -59,6 +60,7 @@ SPICEdev MESAinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MESAiSize,
     .DEVmodSize = &MESAmSize,
 
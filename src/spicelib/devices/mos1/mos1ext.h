@@ -20,6 +20,7 @@ extern int MOS1sSetup(SENstruct*,GENmodel*);
 extern int MOS1sUpdate(GENmodel*,CKTcircuit*);
 extern int MOS1setup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
 extern int MOS1unsetup(GENmodel*,CKTcircuit*);
+extern int MOS1instUnsetup(GENinstance*,CKTcircuit*);
 extern int MOS1temp(GENmodel*,CKTcircuit*);
 extern int MOS1trunc(GENmodel*,CKTcircuit*,double*);
 extern int MOS1convTest(GENmodel*,CKTcircuit*);
@@ -18,7 +18,7 @@ SPICEdev MOS1info = {
         .instanceParms = MOS1pTable,
         .numModelParms = &MOS1mPTSize,
         .modelParms = MOS1mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MOS1info = {
     .DEVload = MOS1load,
     .DEVsetup = MOS1setup,
     .DEVunsetup = MOS1unsetup,
+    .DEVinstUnsetup = MOS1instUnsetup,
     .DEVpzSetup = MOS1setup,
     .DEVtemperature = MOS1temp,
     .DEVtrunc = MOS1trunc,
@@ -59,6 +60,7 @@ SPICEdev MOS1info = {
     .DEVdisto = MOS1disto,
     .DEVnoise = MOS1noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MOS1iSize,
     .DEVmodSize = &MOS1mSize,
 
@@ -236,3 +236,20 @@ MOS1unsetup(GENmodel *inModel, CKTcircuit *ckt)
     }
     return OK;
 }
+
+
+/* source and drain prime nodes shorted to their terminal are decided on
+ * again by MOS1setup() */
+int
+MOS1instUnsetup(GENinstance *inInst, CKTcircuit *ckt)
+{
+    MOS1instance *here = (MOS1instance *)inInst;
+
+    NG_IGNORE(ckt);
+
+    if (here->MOS1sNodePrime == here->MOS1sNode)
+        here->MOS1sNodePrime = 0;
+    if (here->MOS1dNodePrime == here->MOS1dNode)
+        here->MOS1dNodePrime = 0;
+    return OK;
+}
@@ -18,7 +18,7 @@ SPICEdev MOS2info = {
         .instanceParms = MOS2pTable,
         .numModelParms = &MOS2mPTSize,
         .modelParms = MOS2mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MOS2info = {
     .DEVload = MOS2load,
     .DEVsetup = MOS2setup,
     .DEVunsetup = MOS2unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MOS2setup,
     .DEVtemperature = MOS2temp,
     .DEVtrunc = MOS2trunc,
@@ -59,6 +60,7 @@ SPICEdev MOS2info = {
     .DEVdisto = MOS2disto,
     .DEVnoise = MOS2noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MOS2iSize,
     .DEVmodSize = &MOS2mSize,
 
@@ -18,7 +18,7 @@ SPICEdev MOS3info = {
         .instanceParms = MOS3pTable,
         .numModelParms = &MOS3mPTSize,
         .modelParms = MOS3mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MOS3info = {
     .DEVload = MOS3load,
     .DEVsetup = MOS3setup,
     .DEVunsetup = MOS3unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MOS3setup,
     .DEVtemperature = MOS3temp,
     .DEVtrunc = MOS3trunc,
@@ -59,6 +60,7 @@ SPICEdev MOS3info = {
     .DEVdisto = MOS3disto,
     .DEVnoise = MOS3noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MOS3iSize,
     .DEVmodSize = &MOS3mSize,
 
@@ -18,7 +18,7 @@ SPICEdev MOS6info = {
         .instanceParms = MOS6pTable,
         .numModelParms = &MOS6mPTSize,
         .modelParms = MOS6mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MOS6info = {
     .DEVload = MOS6load,
     .DEVsetup = MOS6setup,
     .DEVunsetup = MOS6unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NULL,
     .DEVtemperature = MOS6temp,
     .DEVtrunc = MOS6trunc,
@@ -59,6 +60,7 @@ SPICEdev MOS6info = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MOS6iSize,
     .DEVmodSize = &MOS6mSize,
 
@@ -18,7 +18,7 @@ SPICEdev MOS9info = {
         .instanceParms = MOS9pTable,
         .numModelParms = &MOS9mPTSize,
         .modelParms = MOS9mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev MOS9info = {
     .DEVload = MOS9load,
     .DEVsetup = MOS9setup,
     .DEVunsetup = MOS9unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = MOS9setup,
     .DEVtemperature = MOS9temp,
     .DEVtrunc = MOS9trunc,
@@ -59,6 +60,7 @@ SPICEdev MOS9info = {
     .DEVdisto = MOS9disto,
     .DEVnoise = MOS9noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &MOS9iSize,
     .DEVmodSize = &MOS9mSize,
 
@@ -36,6 +36,7 @@ SPICEdev NBJTinfo = {
     .DEVload = NBJTload,
     .DEVsetup = NBJTsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NBJTsetup,
     .DEVtemperature = NBJTtemp,
     .DEVtrunc = NBJTtrunc,
@@ -59,6 +60,7 @@ SPICEdev NBJTinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NBJTiSize,
     .DEVmodSize = &NBJTmSize,
 
@@ -36,6 +36,7 @@ SPICEdev NBJT2info = {
     .DEVload = NBJT2load,
     .DEVsetup = NBJT2setup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NBJT2setup,
     .DEVtemperature = NBJT2temp,
     .DEVtrunc = NBJT2trunc,
@@ -59,6 +60,7 @@ SPICEdev NBJT2info = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NBJT2iSize,
     .DEVmodSize = &NBJT2mSize,
 
@@ -36,6 +36,7 @@ SPICEdev NDEVinfo = {
     .DEVload = NDEVload,
     .DEVsetup = NDEVsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NDEVsetup,
     .DEVtemperature = NDEVtemp,
     .DEVtrunc = NDEVtrunc,
@@ -59,6 +60,7 @@ SPICEdev NDEVinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NDEViSize,
     .DEVmodSize = &NDEVmSize,
 
@@ -36,6 +36,7 @@ SPICEdev NUMDinfo = {
     .DEVload = NUMDload,
     .DEVsetup = NUMDsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NUMDsetup,
     .DEVtemperature = NUMDtemp,
     .DEVtrunc = NUMDtrunc,
@@ -59,6 +60,7 @@ SPICEdev NUMDinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NUMDiSize,
     .DEVmodSize = &NUMDmSize,
 
@@ -36,6 +36,7 @@ SPICEdev NUMD2info = {
     .DEVload = NUMD2load,
     .DEVsetup = NUMD2setup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NUMD2setup,
     .DEVtemperature = NUMD2temp,
     .DEVtrunc = NUMD2trunc,
@@ -59,6 +60,7 @@ SPICEdev NUMD2info = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NUMD2iSize,
     .DEVmodSize = &NUMD2mSize,
 
@@ -36,6 +36,7 @@ SPICEdev NUMOSinfo = {
     .DEVload = NUMOSload,
     .DEVsetup = NUMOSsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NUMOSsetup,
     .DEVtemperature = NUMOStemp,
     .DEVtrunc = NUMOStrunc,
@@ -59,6 +60,7 @@ SPICEdev NUMOSinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &NUMOSiSize,
     .DEVmodSize = &NUMOSmSize,
 
@@ -18,7 +18,7 @@ SPICEdev RESinfo = {
         .instanceParms = RESpTable,
         .numModelParms = &RESmPTSize,
         .modelParms = RESmPTable,
-        .flags = 0,
+        .flags = DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev RESinfo = {
     .DEVload = RESload,
     .DEVsetup = RESsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = RESsetup,
     .DEVtemperature = REStemp,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev RESinfo = {
     .DEVdisto = NULL,
     .DEVnoise = RESnoise,
     .DEVsoaCheck = RESsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &RESiSize,
     .DEVmodSize = &RESmSize,
 
@@ -18,7 +18,7 @@ SPICEdev SOI3info = {
         .instanceParms = SOI3pTable,
         .numModelParms = &SOI3mPTSize,
         .modelParms = SOI3mPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev SOI3info = {
     .DEVload = SOI3load,
     .DEVsetup = SOI3setup,
     .DEVunsetup = SOI3unsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = SOI3setup,
     .DEVtemperature = SOI3temp,
     .DEVtrunc = SOI3trunc,
@@ -59,6 +60,7 @@ SPICEdev SOI3info = {
     .DEVdisto = NULL,
     .DEVnoise = SOI3noise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &SOI3iSize,
     .DEVmodSize = &SOI3mSize,
 
@@ -19,7 +19,7 @@ SPICEdev SWinfo = {
         .instanceParms = SWpTable,
         .numModelParms = &SWmPTSize,
         .modelParms = SWmPTable,
-        .flags = 0,
+        .flags = DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -37,6 +37,7 @@ SPICEdev SWinfo = {
     .DEVload = SWload,
     .DEVsetup = SWsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = SWsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = SWtrunc,
@@ -60,6 +61,7 @@ SPICEdev SWinfo = {
     .DEVdisto = NULL,
     .DEVnoise = SWnoise,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &SWiSize,
     .DEVmodSize = &SWmSize,
 
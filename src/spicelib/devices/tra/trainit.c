@@ -36,6 +36,7 @@ SPICEdev TRAinfo = {
     .DEVload = TRAload,
     .DEVsetup = TRAsetup,
     .DEVunsetup = TRAunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = TRAsetup,
     .DEVtemperature = TRAtemp,
     .DEVtrunc = TRAtrunc,
@@ -59,6 +60,7 @@ SPICEdev TRAinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &TRAiSize,
     .DEVmodSize = &TRAmSize,
 
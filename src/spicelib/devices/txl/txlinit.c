@@ -23,7 +23,7 @@ SPICEdev TXLinfo = {
 	.instanceParms = TXLpTable,
 	.numModelParms = &TXLmPTSize,
 	.modelParms = TXLmPTable,
-	.flags = 0,
+	.flags = DEV_SHARED,
 
 #ifdef XSPICE
 	.cm_func = NULL,
@@ -41,6 +41,7 @@ SPICEdev TXLinfo = {
     .DEVload = TXLload,
     .DEVsetup = TXLsetup,
     .DEVunsetup = TXLunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = NULL,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -64,6 +65,7 @@ SPICEdev TXLinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &TXLiSize,
     .DEVmodSize = &TXLmSize,
 
@@ -36,6 +36,7 @@ SPICEdev URCinfo = {
     .DEVload = NULL,
     .DEVsetup = URCsetup,
     .DEVunsetup = URCunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = URCsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev URCinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &URCiSize,
     .DEVmodSize = &URCmSize,
 
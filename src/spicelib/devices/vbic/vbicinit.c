@@ -23,7 +23,7 @@ SPICEdev VBICinfo = {
         .instanceParms = VBICpTable,
         .numModelParms = &VBICmPTSize,
         .modelParms = VBICmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -41,6 +41,7 @@ SPICEdev VBICinfo = {
     .DEVload = VBICload,
     .DEVsetup = VBICsetup,
     .DEVunsetup = VBICunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = VBICsetup,
     .DEVtemperature = VBICtemp,
     .DEVtrunc = VBICtrunc,
@@ -64,6 +65,7 @@ SPICEdev VBICinfo = {
     .DEVdisto = NULL,
     .DEVnoise = VBICnoise,
     .DEVsoaCheck = VBICsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &VBICiSize,
     .DEVmodSize = &VBICmSize,
 
@@ -18,7 +18,7 @@ SPICEdev VCCSinfo = {
         .instanceParms = VCCSpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev VCCSinfo = {
     .DEVload = VCCSload,
     .DEVsetup = VCCSsetup,
     .DEVunsetup = NULL,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = VCCSsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev VCCSinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &VCCSiSize,
     .DEVmodSize = &VCCSmSize,
 
@@ -18,7 +18,7 @@ SPICEdev VCVSinfo = {
         .instanceParms = VCVSpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev VCVSinfo = {
     .DEVload = VCVSload,
     .DEVsetup = VCVSsetup,
     .DEVunsetup = VCVSunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = VCVSsetup,
     .DEVtemperature = NULL,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev VCVSinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = NULL,
     .DEVinstSize = &VCVSiSize,
     .DEVmodSize = &VCVSmSize,
 
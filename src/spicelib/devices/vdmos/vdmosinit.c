@@ -18,7 +18,7 @@ SPICEdev VDMOSinfo = {
         .instanceParms = VDMOSpTable,
         .numModelParms = &VDMOSmPTSize,
         .modelParms = VDMOSmPTable,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE | DEV_TERR,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev VDMOSinfo = {
     .DEVload = VDMOSload,
     .DEVsetup = VDMOSsetup,
     .DEVunsetup = VDMOSunsetup,
+    .DEVinstUnsetup = NULL,
     .DEVpzSetup = VDMOSsetup,
     .DEVtemperature = VDMOStemp,
     .DEVtrunc = VDMOStrunc,
@@ -59,6 +60,7 @@ SPICEdev VDMOSinfo = {
     .DEVdisto = VDMOSdisto,
     .DEVnoise = VDMOSnoise,
     .DEVsoaCheck = VDMOSsoaCheck,
+    .DEVclone = NULL,
     .DEVinstSize = &VDMOSiSize,
     .DEVmodSize = &VDMOSmSize,
 
@@ -21,3 +21,24 @@ VSRCdelete(GENinstance *gen_inst)
 
     return OK;
 }
+
+
+/* The copies of CKTclone() share the coefficients, but not the state of
+   transient noise and random sources, which load() advances */
+
+int
+VSRCclone(GENmodel *inModel, GENmodel *source)
+{
+    VSRCmodel *model;
+    VSRCinstance *here;
+
+    if (!source)
+        return OK;
+
+    for (model = (VSRCmodel *) inModel; model; model = VSRCnextModel(model))
+        for (here = VSRCinstances(model); here; here = VSRCnextInstance(here))
+            if (here->VSRCtrnoise_state || here->VSRCtrrandom_state)
+                return E_UNSUPP;
+
+    return OK;
+}
@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
 extern int VSRCaccept(CKTcircuit*,GENmodel*);
 extern int VSRCacLoad(GENmodel*,CKTcircuit*);
 extern int VSRCask(CKTcircuit*,GENinstance*,int,IFvalue*,IFvalue*);
+extern int VSRCclone(GENmodel*,GENmodel*);
 extern int VSRCdelete(GENinstance*);
 extern int VSRCfindBr(CKTcircuit*,GENmodel*,IFuid);
 extern int VSRCload(GENmodel*,CKTcircuit*);
@@ -14,6 +15,7 @@ extern int VSRCparam(int,IFvalue*,GENinstance*,IFvalue*);
 extern int VSRCpzLoad(GENmodel*,CKTcircuit*,SPcomplex*);
 extern int VSRCsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
 extern int VSRCunsetup(GENmodel*,CKTcircuit*);
+extern int VSRCinstUnsetup(GENinstance*,CKTcircuit*);
 extern int VSRCpzSetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
 extern int VSRCtemp(GENmodel*,CKTcircuit*);
 #ifdef RFSPICE
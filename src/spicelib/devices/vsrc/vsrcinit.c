@@ -18,7 +18,7 @@ SPICEdev VSRCinfo = {
         .instanceParms = VSRCpTable,
         .numModelParms = NULL,
         .modelParms = NULL,
-        .flags = DEV_DEFAULT,
+        .flags = DEV_DEFAULT | DEV_CLONE,
 
 #ifdef XSPICE
         .cm_func = NULL,
@@ -36,6 +36,7 @@ SPICEdev VSRCinfo = {
     .DEVload = VSRCload,
     .DEVsetup = VSRCsetup,
     .DEVunsetup = VSRCunsetup,
+    .DEVinstUnsetup = VSRCinstUnsetup,
     .DEVpzSetup = VSRCpzSetup,
     .DEVtemperature = VSRCtemp,
     .DEVtrunc = NULL,
@@ -59,6 +60,7 @@ SPICEdev VSRCinfo = {
     .DEVdisto = NULL,
     .DEVnoise = NULL,
     .DEVsoaCheck = NULL,
+    .DEVclone = VSRCclone,
     .DEVinstSize = &VSRCiSize,
     .DEVmodSize = &VSRCmSize,
 
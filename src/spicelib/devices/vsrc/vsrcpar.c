@@ -245,7 +245,8 @@ VSRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
                with the new parameters. So free the old state first. */
             trnoise_state_free(here->VSRCtrnoise_state);
             here->VSRCtrnoise_state =
-                trnoise_state_init(NA, TS, NALPHA, NAMP, RTSAM, RTSCAPT, RTSEMT);
+                trnoise_state_init(NA, TS, NALPHA, NAMP, RTSAM, RTSCAPT, RTSEMT,
+                                   here->VSRCname);
         }
         break;
 
@@ -274,7 +275,7 @@ VSRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
                with the new parameters. So free the old state first. */
             tfree(here->VSRCtrrandom_state);
             here->VSRCtrrandom_state =
-                trrandom_state_init(rndtype, TS, TD, PARAM1, PARAM2);
+                trrandom_state_init(rndtype, TS, TD, PARAM1, PARAM2, here->VSRCname);
         }
         break;
 
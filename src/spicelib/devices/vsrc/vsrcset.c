@@ -120,3 +120,20 @@ VSRCunsetup(GENmodel *inModel, CKTcircuit *ckt)
     }
     return OK;
 }
+
+
+/* the branch is kept */
+int
+VSRCinstUnsetup(GENinstance *inInst, CKTcircuit *ckt)
+{
+    NG_IGNORE(ckt);
+
+#ifdef RFSPICE
+    /* VSRCsetup() makes the node of a port again */
+    if (((VSRCinstance *)inInst)->VSRCisPort)
+        return(E_NOCHANGE);
+#else
+    NG_IGNORE(inInst);
+#endif
+    return(OK);
+}
@@ -424,7 +424,8 @@ dot_sens(char *line, CKTcircuit *ckt, INPtables *tab, struct card *current,
 
     /* Format is:
      *      .sens <output>
-     *      + [ac [dec|lin|oct] <pts> <low freq> <high freq> | dc ]
+     *      + [ac [dec|lin|oct] <pts> <low freq> <high freq> | dc
+     *      +  | tran <tstep> <tstop>]
      */
     /* Get the output voltage or current */
     INPgetTok(&line, &name, 0);
@@ -479,9 +480,17 @@ dot_sens(char *line, CKTcircuit *ckt, INPtables *tab, struct card *current,
         parm = INPgetValue(ckt, &line, IF_REAL, tab); /* fstop */
         GCA(INPapName, (ckt, which, foo, "stop", parm));
         return (0);
+    } else if (name && !strcmp(name, "tran")) {
+        ptemp.iValue = 1;
+        GCA(INPapName, (ckt, which, foo, "tran", &ptemp));
+        parm = INPgetValue(ckt, &line, IF_REAL, tab); /* tstep */
+        GCA(INPapName, (ckt, which, foo, "tstep", parm));
+        parm = INPgetValue(ckt, &line, IF_REAL, tab); /* tstop */
+        GCA(INPapName, (ckt, which, foo, "tstop", parm));
+        return (0);
     } else if (name && *name && strcmp(name, "dc")) {
         /* Bad flag */
-        LITERR("Syntax error: 'ac' or 'dc' expected.\n");
+        LITERR("Syntax error: 'ac', 'dc' or 'tran' expected.\n");
         return 0;
     }
     return (0);
@@ -652,61 +661,34 @@ dot_sp(char* line, void* ckt, INPtables* tab, struct card* current,
 }
 
 #ifdef WITH_HB
-/*SP: Steady State Analyis */
+/* Harmonic Balance Analysis */
 static int
 dot_hb(char* line, void* ckt, INPtables* tab, struct card* current,
     void* task, void* gnode, JOB* foo)
 {
     int error;			/* error code temporary */
-    IFvalue ptemp;		/* a value structure to package resistance into */
     IFvalue* parm;		/* a pointer to a value struct for function returns */
-    char* nname;		/* the oscNode name */
-    CKTnode* nnode;		/* the oscNode node */
     int which;			/* which analysis we are performing */
-    char* word;			/* something to stick a word of input into */
 
     NG_IGNORE(gnode);
 
-    /* .pss Fguess StabTime OscNode <UIC>*/
-    which = ft_find_analysis("PSS");
+    /* .hb F0 NHARM <POINTS> */
+    which = ft_find_analysis("HB");
     if (which == -1) {
-        LITERR("Periodic steady state analysis unsupported.\n");
+        LITERR("Harmonic balance analysis unsupported.\n");
         return (0);
     }
-    IFC(newAnalysis, (ckt, which, "Harmonic Balance State Analysis", &foo, task));
+    IFC(newAnalysis, (ckt, which, "Harmonic Balance Analysis", &foo, task));
 
-    parm = INPgetValue(ckt, &line, IF_REALVEC, tab);		/* Fguess */
+    parm = INPgetValue(ckt, &line, IF_REAL, tab);		/* F0 */
     GCA(INPapName, (ckt, which, foo, "freq", parm));
 
-    parm = INPgetValue(ckt, &line, IF_INTVEC, tab);		/* StabTime */
-    GCA(INPapName, (ckt, which, foo, "harmonics", parm));
-
-    INPgetNetTok(&line, &nname, 0);
-    INPtermInsert(ckt, &nname, tab, &nnode);
-    ptemp.nValue = nnode;
-    GCA(INPapName, (ckt, which, foo, "oscnode", &ptemp));	/* OscNode given as string */
-
-    parm = INPgetValue(ckt, &line, IF_INTEGER, tab);		/* PSS points */
-    GCA(INPapName, (ckt, which, foo, "points", parm));
-
-    parm = INPgetValue(ckt, &line, IF_INTEGER, tab);		/* PSS harmonics */
+    parm = INPgetValue(ckt, &line, IF_INTEGER, tab);		/* harmonics */
     GCA(INPapName, (ckt, which, foo, "harmonics", parm));
 
-    parm = INPgetValue(ckt, &line, IF_INTEGER, tab);		/* SC iterations */
-    GCA(INPapName, (ckt, which, foo, "sc_iter", parm));
-
-    parm = INPgetValue(ckt, &line, IF_REAL, tab);		/* Steady coefficient */
-    GCA(INPapName, (ckt, which, foo, "steady_coeff", parm));
-
     if (*line) {
-        INPgetTok(&line, &word, 1);	/* uic? */
-        if (strcmp(word, "uic") == 0) {
-            ptemp.iValue = 1;
-            GCA(INPapName, (ckt, which, foo, "uic", &ptemp));
-        }
-        else {
-            fprintf(stderr, "Error: unknown parameter %s on .pss - ignored\n", word);
-        }
+        parm = INPgetValue(ckt, &line, IF_INTEGER, tab);	/* time points */
+        GCA(INPapName, (ckt, which, foo, "points", parm));
     }
     return (0);
 }
@@ -97,13 +97,13 @@ void cm_analog_alloc(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
     /* Scan states in instance struct and see if tag has already been used */
     for(i = 0; i < here->num_state; i++) {
         if(tag == here->state[i].tag) {
-            g_mif_info.errmsg = "ERROR - cm_analog_alloc() - Tag already used in previous call\n";
+            MIF_INFO.errmsg = "ERROR - cm_analog_alloc() - Tag already used in previous call\n";
             return;
         }
     }
@@ -166,8 +166,8 @@ void *cm_analog_get_ptr(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
     /* Scan states in instance struct and see if tag exists */
     for(got_tag = MIF_FALSE, i = 0; i < here->num_state; i++) {
@@ -180,13 +180,13 @@ void *cm_analog_get_ptr(
 
     /* Return error if tag not found */
     if(! got_tag) {
-        g_mif_info.errmsg = "ERROR - cm_analog_get_ptr() - Bad tag\n";
+        MIF_INFO.errmsg = "ERROR - cm_analog_get_ptr() - Bad tag\n";
         return(NULL);
     }
 
     /* Return error if timepoint is not 0 or 1 */
     if((timepoint < 0) || (timepoint > 1)) {
-        g_mif_info.errmsg = "ERROR - cm_analog_get_ptr() - Bad timepoint\n";
+        MIF_INFO.errmsg = "ERROR - cm_analog_get_ptr() - Bad timepoint\n";
         return(NULL);
     }
 
@@ -230,12 +230,12 @@ int  cm_analog_integrate(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
     /* Check to be sure we're in transient analysis */
-    if(g_mif_info.circuit.anal_type != MIF_TRAN) {
-        g_mif_info.errmsg =
+    if(MIF_INFO.circuit.anal_type != MIF_TRAN) {
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_integrate() - Called in non-transient analysis\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -243,7 +243,7 @@ int  cm_analog_integrate(
 
     /* Preliminary check to be sure argument was allocated by cm_analog_alloc() */
     if(ckt->CKTnumStates <= 0) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_integrate() - Integral must be memory allocated by cm_analog_alloc()\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -257,7 +257,7 @@ int  cm_analog_integrate(
     /* Check to be sure argument address is in range of state0 vector */
     if((byte_index < 0) ||
        (byte_index > (ckt->CKTnumStates - 1) * (int) sizeof(double))) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_integrate() - Argument must be in state vector 0\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -271,8 +271,8 @@ int  cm_analog_integrate(
     }
 
     /* Report error if not found and this is not the first load pass in tran analysis */
-    if((! got_index) && (! g_mif_info.circuit.anal_init)) {
-        g_mif_info.errmsg =
+    if((! got_index) && (! MIF_INFO.circuit.anal_init)) {
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_integrate() - New integral and not initialization pass\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -293,8 +293,8 @@ int  cm_analog_integrate(
         intgr = &(here->intgr[here->num_intgr - 1]);
         intgr->byte_index = byte_index;
         if(cm_analog_converge(integral)) {
-            printf("%s\n",g_mif_info.errmsg);
-            g_mif_info.errmsg = "ERROR - cm_analog_integrate() - Failure in cm_analog_converge() call\n";
+            printf("%s\n",MIF_INFO.errmsg);
+            MIF_INFO.errmsg = "ERROR - cm_analog_integrate() - Failure in cm_analog_converge() call\n";
             return(MIF_ERROR);
         }
     }
@@ -332,12 +332,12 @@ int  cm_analog_converge(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
     /* Preliminary check to be sure argument was allocated by cm_analog_alloc() */
     if(ckt->CKTnumStates <= 0) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_converge() - Argument must be memory allocated by cm_analog_alloc()\n";
         return(MIF_ERROR);
     }
@@ -350,7 +350,7 @@ int  cm_analog_converge(
     /* Check to be sure argument address is in range of state0 vector */
     if((byte_index < 0) ||
        (byte_index > (ckt->CKTnumStates - 1) * (int) sizeof(double))) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_converge() - Argument must be in state vector 0\n";
         return(MIF_ERROR);
     }
@@ -391,7 +391,7 @@ by a call to some code model support function.
 
 char *cm_message_get_errmsg(void)
 {
-    return(g_mif_info.errmsg);
+    return(MIF_INFO.errmsg);
 }
 
 
@@ -420,11 +420,11 @@ int cm_analog_set_temp_bkpt(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO.ckt;
 
     /* Make sure breakpoint is not prior to last accepted timepoint */
     if(time < ((ckt->CKTtime - ckt->CKTdelta) + ckt->CKTminBreak)) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_analog_set_temp_bkpt() - Time < last accepted timepoint\n";
         return(MIF_ERROR);
     }
@@ -438,8 +438,8 @@ int cm_analog_set_temp_bkpt(
     }
 
     /* If < current dynamic breakpoint, make it the current breakpoint */
-    if( time < g_mif_info.breakpoint.current)
-        g_mif_info.breakpoint.current = time;
+    if( time < MIF_INFO.breakpoint.current)
+        MIF_INFO.breakpoint.current = time;
 
     return(MIF_OK);
 }
@@ -471,7 +471,7 @@ int cm_analog_set_perm_bkpt(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO.ckt;
 
     /* Call cm_analog_set_temp_bkpt() to force backup if less than current time */
     if(time < (ckt->CKTtime + ckt->CKTminBreak))
@@ -500,7 +500,7 @@ double cm_analog_ramp_factor(void)
     CKTcircuit  *ckt;
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO.ckt;
 
 
     /* if ramptime == 0.0, no ramptime option given, so return 1.0 */
@@ -552,7 +552,7 @@ static void cm_static_integrate(int    byte_index,
 
 
     /* Get the address of the ckt struct from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO.ckt;
 
     /* Get integral values from current and previous timesteps */
     for(i = 0; i <= ckt->CKTorder; i++) {
@@ -647,7 +647,7 @@ its inputs to assist convergence.
 
 void cm_analog_not_converged(void)
 {
-    (g_mif_info.ckt->CKTnoncon)++;
+    (MIF_INFO.ckt->CKTnoncon)++;
 }
 
 
@@ -667,7 +667,7 @@ int cm_message_send(
     MIFinstance *here;
 
     /* Get the address of the instance struct from g_mif_info */
-    here = g_mif_info.instance;
+    here = MIF_INFO.instance;
 
     /* Print the name of the instance and the message */
     printf("\nInstance: %s   Message: %s\n", here->MIFname, msg);
@@ -695,7 +695,7 @@ calculations.
 
 void cm_analog_auto_partial(void)
 {
-    g_mif_info.auto_partial.local = MIF_TRUE;
+    MIF_INFO.auto_partial.local = MIF_TRUE;
 }
 
 /*
@@ -727,7 +727,7 @@ access to the (fundamental) ckt pointer.
 
 CKTcircuit *cm_get_circuit(void)
 {
-    return(g_mif_info.ckt);
+    return(MIF_INFO.ckt);
 }
 
 /* Get the name of a circuit node connected to a port. */
@@ -739,7 +739,7 @@ const char *cm_get_node_name(const char *port_name, unsigned int index)
     Mif_Port_Data_t  *port;
     int               i;
 
-    instance = g_mif_info.instance;
+    instance = MIF_INFO.instance;
     for (i = 0; i < instance->num_conn; ++i) {
         conn = instance->conn[i];
         if (!strcmp(port_name, conn->name)) {
@@ -750,7 +750,7 @@ const char *cm_get_node_name(const char *port_name, unsigned int index)
                 /* Event node, no name in port data. */
 
                 i = port->evt_data.node_index;
-                return g_mif_info.ckt->evt->info.node_table[i]->name;
+                return MIF_INFO.ckt->evt->info.node_table[i]->name;
             }
             return port->pos_node_str;
         }
@@ -775,7 +775,7 @@ bool cm_probe_node(unsigned int  conn_index,  // Connection index
     void             *hold;
     int               num_outputs;
 
-    instance = g_mif_info.instance;
+    instance = MIF_INFO.instance;
     if (conn_index >= (unsigned int)instance->num_conn)
         return FALSE;
     conn = instance->conn[conn_index];
@@ -785,11 +785,11 @@ bool cm_probe_node(unsigned int  conn_index,  // Connection index
     if (port->type != MIF_DIGITAL && port->type != MIF_USER_DEFINED)
         return FALSE;
     edata = &port->evt_data;
-    node_info = g_mif_info.ckt->evt->info.node_table[edata->node_index];
+    node_info = MIF_INFO.ckt->evt->info.node_table[edata->node_index];
     num_outputs = node_info->num_outputs;
     if (num_outputs <= 1)
         return num_outputs == 1;    // This should be the only output.
-    this = g_mif_info.ckt->evt->data.node->rhsold + edata->node_index;
+    this = MIF_INFO.ckt->evt->data.node->rhsold + edata->node_index;
 
     /* Replace the actual output with the test value and resolve.
      * It is assumed that the resolve function will not use its output
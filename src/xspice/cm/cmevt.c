@@ -79,13 +79,13 @@ void cm_event_alloc(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
 
     /* If not initialization pass, return error */
     if(here->initialized) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_event_alloc() - Cannot alloc when not initialization pass\n";
         return;
     }
@@ -103,7 +103,7 @@ void cm_event_alloc(
     num_tags = 1;
     while(desc) {
         if(desc->tag == tag) {
-            g_mif_info.errmsg =
+            MIF_INFO.errmsg =
             "ERROR - cm_event_alloc() - Duplicate tag\n";
             return;
         }
@@ -135,7 +135,7 @@ void cm_event_alloc(
         state->block = trealloc(state->block,
                              (size_t) state_data->total_size[inst_index]);
 
-    state->step = g_mif_info.circuit.evt_step;
+    state->step = MIF_INFO.circuit.evt_step;
 }
 
 
@@ -174,13 +174,13 @@ void *cm_event_get_ptr(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
 
     /* If initialization pass, return error */
     if((! here->initialized) && (timepoint > 0)) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_event_get_ptr() - Cannot get_ptr(tag,1) during initialization pass\n";
         return(NULL);
     }
@@ -199,7 +199,7 @@ void *cm_event_get_ptr(
     }
 
     if(desc == NULL) {
-        g_mif_info.errmsg =
+        MIF_INFO.errmsg =
         "ERROR - cm_event_get_ptr() - Specified tag not found\n";
         return(NULL);
     }
@@ -237,18 +237,18 @@ int  cm_event_queue(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO.instance;
+    ckt  = MIF_INFO.ckt;
 
     /* If breakpoint time <= current event time, return error */
-    if(time <= g_mif_info.circuit.evt_step) {
-        g_mif_info.errmsg =
+    if(time <= MIF_INFO.circuit.evt_step) {
+        MIF_INFO.errmsg =
         "ERROR - cm_event_queue() - Event time cannot be <= current time\n";
         return(MIF_ERROR);
     }
 
     /* Add the event time to the inst queue */
-    EVTqueue_inst(ckt, here->inst_index, g_mif_info.circuit.evt_step,
+    EVTqueue_inst(ckt, here->inst_index, MIF_INFO.circuit.evt_step,
                   time);
 
     return(MIF_OK);
@@ -83,8 +83,8 @@ double cm_netlist_get_c(void)
 
 
     /* Get the circuit data structure and current instance */
-    ckt = g_mif_info.ckt;
-    cmeter_inst = g_mif_info.instance;
+    ckt = MIF_INFO.ckt;
+    cmeter_inst = MIF_INFO.instance;
 
     /* Get internal node number for positive node of cmeter input */
     cmeter_node = cmeter_inst->conn[0]->port[0]->smp_data.pos_node;
@@ -214,8 +214,8 @@ double cm_netlist_get_l(void)
 
 
     /* Get the circuit data structure and current instance */
-    ckt = g_mif_info.ckt;
-    lmeter_inst = g_mif_info.instance;
+    ckt = MIF_INFO.ckt;
+    lmeter_inst = MIF_INFO.instance;
 
     /* Get internal node number for positive node of lmeter input */
     lmeter_node = lmeter_inst->conn[0]->port[0]->smp_data.pos_node;
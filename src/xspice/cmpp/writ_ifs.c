@@ -1010,6 +1010,7 @@ static int write_SPICEdev(
             "    .DEVload = MIFload,\n"
             "    .DEVsetup = MIFsetup,\n"
             "    .DEVunsetup = MIFunsetup,\n"
+            "    .DEVinstUnsetup = NULL,\n"
             "    .DEVpzSetup = NULL,\n"
             "    .DEVtemperature = NULL,\n"
             "    .DEVtrunc = MIFtrunc,\n"
@@ -1033,6 +1034,7 @@ static int write_SPICEdev(
             "    .DEVdisto = NULL,\n"
             "    .DEVnoise = NULL,\n"
             "    .DEVsoaCheck = NULL,\n"
+            "    .DEVclone = NULL,\n"
             "    .DEVinstSize = &val_sizeofMIFinstance,\n"
             "    .DEVmodSize = &val_sizeofMIFmodel,\n"
             "\n"
@@ -114,6 +114,14 @@ void EVTaccept(
         inst_queue->head[index] = next;
         if (!next)
             inst_queue->current[index] = &inst_queue->head[index];
+        /* Pending events may have been moved, update the heap */
+        if (inst_queue->pending.pos[index] >= 0) {
+            if (*(inst_queue->current[index]))
+                EVTheap_set(&(inst_queue->pending), index,
+                            (*(inst_queue->current[index]))->event_time);
+            else
+                EVTheap_remove(&(inst_queue->pending), index);
+        }
         /* Update last_step for this index */
         inst_queue->last_step[index] = inst_queue->current[index];
     }
@@ -147,6 +155,14 @@ void EVTaccept(
         output_queue->head[index] = next;
         if (!next)
             output_queue->current[index] = &output_queue->head[index];
+        /* Pending events may have been moved, update the heap */
+        if (output_queue->pending.pos[index] >= 0) {
+            if (*(output_queue->current[index]))
+                EVTheap_set(&(output_queue->pending), index,
+                            (*(output_queue->current[index]))->event_time);
+            else
+                EVTheap_remove(&(output_queue->pending), index);
+        }
         /* Update last_step for this index */
         output_queue->last_step[index] = output_queue->current[index];
     }
@@ -172,8 +188,22 @@ void EVTaccept(
 
         if (node_table[index]->save && ckt->CKTtime >= ckt->CKTinitTime &&
             (ckt->CKTtime > 0 || !(ckt->CKTmode & MODEUIC))) {
-            /* Update last_step for this index */
-            node_data->last_step[index] = node_data->tail[index];
+            if(node_data->hist && node_data->hist->stream[index]) {
+                Evt_Node_t *node;
+                int        num_new = 0;
+
+                /* Count the records accepted now, then write the */
+                /* oldest to the history file if there are too many */
+                for(node = *(node_data->last_step[index]);
+                        node && node != *(node_data->tail[index]);
+                        node = node->next)
+                    num_new++;
+                node_data->last_step[index] = node_data->tail[index];
+                EVThist_retire(ckt, index, num_new);
+            }
+            else
+                /* Update last_step for this index */
+                node_data->last_step[index] = node_data->tail[index];
         } else {
             Evt_Node_t *keep;
 
@@ -186,6 +216,8 @@ void EVTaccept(
             node_data->head[index] = keep;
             node_data->last_step[index] = node_data->tail[index] =
                 &node_data->head[index];
+            if(node_data->hist)
+                node_data->hist->num_accepted[index] = 0;
         }
     }
     /* Reset number modified to zero */
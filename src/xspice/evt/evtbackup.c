@@ -389,7 +389,6 @@ static void EVTbackup_inst_queue(
     int         j;
 
     int         num_modified;
-    int         num_pending;
     int         inst_index;
 
     Evt_Inst_Queue_t    *inst_queue;
@@ -397,9 +396,6 @@ static void EVTbackup_inst_queue(
     Evt_Inst_Event_t    **inst_ptr;
     Evt_Inst_Event_t    *inst;
 
-    double              next_time;
-    double              event_time;
-
 
     /* Get pointers for quick access */
     inst_queue = &(ckt->evt->queue.inst);
@@ -446,38 +442,16 @@ static void EVTbackup_inst_queue(
         inst_queue->current[inst_index] = inst_ptr;
     }
 
-    /* Add set of items modified to set of items pending before updating the */
-    /* pending list because things may have been pulled from the pending list */
+    /* Update the heap of pending items with the events now at the */
+    /* location pointed to by current */
     for(i = 0; i < num_modified; i++) {
-        j = inst_queue->modified_index[i];
-        if(! inst_queue->pending[j]) {
-            inst_queue->pending[j] = MIF_TRUE;
-            inst_queue->pending_index[(inst_queue->num_pending)++] = j;
-        }
-    }
-
-    /* Update the pending list and the next time by seeing if there */
-    /* is anything at the location pointed to by current */
-    next_time = 1e30;
-    num_pending = inst_queue->num_pending;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        inst_index = inst_queue->pending_index[i];
+        inst_index = inst_queue->modified_index[i];
         inst = *(inst_queue->current[inst_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
-        if(! inst) {
-            inst_queue->pending[inst_index] = MIF_FALSE;
-            (inst_queue->num_pending)--;
-        }
-        /* else, keep the index and update the next time */
-        else {
-            inst_queue->pending_index[j] = inst_queue->pending_index[i];
-            j++;
-            event_time = inst->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
-        }
+        if(inst)
+            EVTheap_set(&(inst_queue->pending), inst_index, inst->event_time);
+        else
+            EVTheap_remove(&(inst_queue->pending), inst_index);
     }
-    inst_queue->next_time = next_time;
 
     /* Update the modified list by looking for any queued events */
     /* with posted time > last_time */
@@ -524,18 +498,14 @@ static void EVTbackup_output_queue(
     int         j;
 
     int         num_modified;
-    int         num_pending;
 
-   int         output_index;
+    int         output_index;
 
     Evt_Output_Queue_t    *output_queue;
 
     Evt_Output_Event_t    **output_ptr;
     Evt_Output_Event_t    *output;
 
-    double              next_time;
-    double              event_time;
-
 
     /* Get pointers for quick access */
     output_queue = &(ckt->evt->queue.output);
@@ -585,38 +555,16 @@ static void EVTbackup_output_queue(
         output_queue->current[output_index] = output_ptr;
     }
 
-    /* Add set of items modified to set of items pending before updating the */
-    /* pending list because things may have been pulled from the pending list */
+    /* Update the heap of pending items with the events now at the */
+    /* location pointed to by current */
     for(i = 0; i < num_modified; i++) {
-        j = output_queue->modified_index[i];
-        if(! output_queue->pending[j]) {
-            output_queue->pending[j] = MIF_TRUE;
-            output_queue->pending_index[(output_queue->num_pending)++] = j;
-        }
-    }
-
-    /* Update the pending list and the next time by seeing if there */
-    /* is anything at the location pointed to by current */
-    next_time = 1e30;
-    num_pending = output_queue->num_pending;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        output_index = output_queue->pending_index[i];
+        output_index = output_queue->modified_index[i];
         output = *(output_queue->current[output_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
-        if(! output) {
-            output_queue->pending[output_index] = MIF_FALSE;
-            (output_queue->num_pending)--;
-        }
-        /* else, keep the index and update the next time */
-        else {
-            output_queue->pending_index[j] = output_queue->pending_index[i];
-            j++;
-            event_time = output->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
-        }
+        if(output)
+            EVTheap_set(&(output_queue->pending), output_index, output->event_time);
+        else
+            EVTheap_remove(&(output_queue->pending), output_index);
     }
-    output_queue->next_time = next_time;
 
     /* Update the modified list by looking for any queued events */
     /* with posted time > last_time */
@@ -96,17 +96,10 @@ static void EVTdequeue_output(
     double      time)          /* The event time of the events to dequeue */
 {
 
-    int         i;
-    int         j;
-
-    int         num_pending;
     int         index;
-    int         output_index;
-
-    double      next_time;
-    double      event_time;
 
     Evt_Output_Queue_t  *output_queue;
+    Evt_Heap_t          *heap;
 
     Evt_Output_Event_t  *output;
     Evt_Output_Event_t  **output_ptr;
@@ -114,29 +107,21 @@ static void EVTdequeue_output(
 
     /* Get pointers for fast access */
     output_queue = &(ckt->evt->queue.output);
+    heap = &(output_queue->pending);
 
-    /* Exit if nothing pending on output queue or if next_time */
-    /* != specified time */
-    if(output_queue->num_pending == 0)
-        return;
-    if(output_queue->next_time != time)
-        return;
-
-    /* Scan the list of outputs pending */
-    num_pending = output_queue->num_pending;
-    for(i = 0; i < num_pending; i++) {
+    /* Take the outputs with the earliest events from the heap */
+    /* as long as their event time matches the specified time */
+    while(heap->num > 0) {
 
         /* Get the index of the output */
-        index = output_queue->pending_index[i];
+        index = heap->index[0];
 
-        /* Get pointer to next event in queue at this index */
-        output = *(output_queue->current[index]);
+        /* If event time does not match current time, done */
+        if(heap->time[index] != time)
+            break;
 
-        /* If cleaned or event time does not match current time, skip */
-        if(!output || output->event_time != time)
-            continue;
-
-        /* It must match, so pull the event from the queue and process it */
+        /* Pull the event from the queue and process it */
+        output = *(output_queue->current[index]);
         EVTprocess_output(ckt, index, output->value);
 
         /* Move current to point to next non-removed item in list */
@@ -155,31 +140,13 @@ static void EVTdequeue_output(
             output_queue->modified[index] = MIF_TRUE;
             output_queue->modified_index[(output_queue->num_modified)++] = index;
         }
-    }
 
-
-    /* Update/compact the pending list and update the next_time */
-    next_time = 1e30;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        output_index = output_queue->pending_index[i];
-        output = *(output_queue->current[output_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
-        if(! output) {
-            output_queue->pending[output_index] = MIF_FALSE;
-            (output_queue->num_pending)--;
-        }
-        /* else, keep the index and update the next time */
-        else {
-            output_queue->pending_index[j] = output_queue->pending_index[i];
-            j++;
-            event_time = output->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
-        }
+        /* Update the heap with the next event of this output, if any */
+        if(output)
+            EVTheap_set(heap, index, output->event_time);
+        else
+            EVTheap_remove(heap, index);
     }
-    output_queue->next_time = next_time;
-
-
 }
 
 
@@ -197,46 +164,31 @@ void EVTdequeue_inst(
     double      time)    /* The event time of the events to dequeue */
 {
 
-    int         i;
-    int         j;
-
-    int         num_pending;
     int         index;
-    int         inst_index;
-
-    double      next_time;
-    double      event_time;
 
     Evt_Inst_Queue_t  *inst_queue;
+    Evt_Heap_t        *heap;
 
     Evt_Inst_Event_t  *inst;
 
 
     /* Get pointers for fast access */
     inst_queue = &(ckt->evt->queue.inst);
+    heap = &(inst_queue->pending);
 
-    /* Exit if nothing pending on inst queue or if next_time */
-    /* != specified time */
-    if(inst_queue->num_pending == 0)
-        return;
-    if(inst_queue->next_time != time)
-        return;
-
-    /* Scan the list of insts pending */
-    num_pending = inst_queue->num_pending;
-    for(i = 0; i < num_pending; i++) {
+    /* Take the insts with the earliest events from the heap */
+    /* as long as their event time matches the specified time */
+    while(heap->num > 0) {
 
         /* Get the index of the inst */
-        index = inst_queue->pending_index[i];
-
-        /* Get pointer to next event in queue at this index */
-        inst = *(inst_queue->current[index]);
+        index = heap->index[0];
 
-        /* If cleaned or event time does not match current time, skip */
-        if(!inst || inst->event_time != time)
-            continue;
+        /* If event time does not match current time, done */
+        if(heap->time[index] != time)
+            break;
 
-        /* It must match, so pull the event from the queue and process it */
+        /* Pull the event from the queue and flag the inst to be called */
+        inst = *(inst_queue->current[index]);
         if(! inst_queue->to_call[index]) {
             inst_queue->to_call[index] = MIF_TRUE;
             inst_queue->to_call_index[(inst_queue->num_to_call)++] =
@@ -251,32 +203,14 @@ void EVTdequeue_inst(
             inst_queue->modified[index] = MIF_TRUE;
             inst_queue->modified_index[(inst_queue->num_modified)++] = index;
         }
-    }
 
-
-    /* Update/compact the pending list and update the next_time */
-    next_time = 1e30;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        inst_index = inst_queue->pending_index[i];
-        inst = *(inst_queue->current[inst_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
-        if(! inst) {
-            inst_queue->pending[inst_index] = MIF_FALSE;
-            (inst_queue->num_pending)--;
-        }
-        /* else, keep the index and update the next time */
-        else {
-            inst_queue->pending_index[j] = inst_queue->pending_index[i];
-            j++;
-            event_time = inst->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
-        }
+        /* Update the heap with the next event of this inst, if any */
+        inst = inst->next;
+        if(inst)
+            EVTheap_set(heap, index, inst->event_time);
+        else
+            EVTheap_remove(heap, index);
     }
-    inst_queue->next_time = next_time;
-
-
-
 }
 
 
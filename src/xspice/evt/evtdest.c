@@ -6,6 +6,7 @@
 
 
 static void Evt_Node_destroy(Evt_Node_Info_t *info, Evt_Node_t *node);
+static void Evt_Node_values_destroy(Evt_Node_Info_t *info, Evt_Node_t *node);
 static void Evt_Node_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Node_Data_t *node_data);
 static void Evt_Msg_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Msg_Data_t *msg_data);
 static void Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue);
@@ -30,15 +31,6 @@ EVTdest(Evt_Ckt_Data_t *evt)
     return OK;
 }
 
-static void free_events(Evt_Inst_Event_t *event)
-{
-    while (event) {
-        Evt_Inst_Event_t *next = event->next;
-        tfree(event);
-        event = next;
-    }
-}
-
 static void
 Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue)
 {
@@ -48,10 +40,8 @@ Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue)
 
     int i;
 
-    for (i = 0; i < evt->counts.num_insts; i++) {
-        free_events(inst_queue->head[i]);
-        free_events(inst_queue->free[i]);
-    }
+    /* the events are in the pool */
+    EVTpool_release(&(inst_queue->pool));
 
     tfree(inst_queue->head);
     tfree(inst_queue->current);
@@ -60,10 +50,19 @@ Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue)
 
     tfree(inst_queue->modified_index);
     tfree(inst_queue->modified);
-    tfree(inst_queue->pending_index);
-    tfree(inst_queue->pending);
+    tfree(inst_queue->pending.index);
+    tfree(inst_queue->pending.pos);
+    tfree(inst_queue->pending.time);
     tfree(inst_queue->to_call_index);
     tfree(inst_queue->to_call);
+    tfree(inst_queue->parallel);
+
+    for (i = 0; i < inst_queue->num_defer; i++) {
+        tfree(inst_queue->defer[i].call_pos);
+        tfree(inst_queue->defer[i].posted_time);
+        tfree(inst_queue->defer[i].event_time);
+    }
+    tfree(inst_queue->defer);
 
     /* node queue */
 
@@ -79,17 +78,16 @@ Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue)
         while (event) {
             Evt_Output_Event_t *next = event->next;
             tfree(event->value);
-            tfree(event);
             event = next;
         }
         event = output_queue->free[i];
         while (event) {
             Evt_Output_Event_t *next = event->next;
             tfree(event->value);
-            tfree(event);
             event = next;
         }
     }
+    EVTpool_release(&(output_queue->pool));
     tfree(output_queue->head);
     tfree(output_queue->current);
     tfree(output_queue->last_step);
@@ -97,8 +95,9 @@ Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue)
 
     tfree(output_queue->modified_index);
     tfree(output_queue->modified);
-    tfree(output_queue->pending_index);
-    tfree(output_queue->pending);
+    tfree(output_queue->pending.index);
+    tfree(output_queue->pending.pos);
+    tfree(output_queue->pending.time);
     tfree(output_queue->changed_index);
     tfree(output_queue->changed);
 }
@@ -118,12 +117,18 @@ Evt_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Data_t *data)
 }
 */
 
+/* Only the first state of an instance, built by cm_event_alloc(), is
+   allocated on its own.  The others are in the pool, with the block
+   right behind the state. */
+
 static void free_state(Evt_State_t *state)
 {
     while (state) {
         Evt_State_t *next = state->next;
-        tfree(state->block);
-        tfree(state);
+        if (state->block != (void *) (state + 1)) {
+            tfree(state->block);
+            tfree(state);
+        }
         state = next;
     }
 }
@@ -140,6 +145,7 @@ Evt_State_Data_destroy(Evt_Ckt_Data_t *evt, Evt_State_Data_t *state_data)
         free_state(state_data->head[i]);
         free_state(state_data->free[i]);
     }
+    EVTpool_release(&(state_data->pool));
 
     tfree(state_data->head);
     tfree(state_data->tail);
@@ -177,18 +183,18 @@ Evt_Node_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Node_Data_t *node_data)
         node = node_data->head[i];
         while (node) {
             Evt_Node_t *next = node->next;
-            Evt_Node_destroy(info, node);
-            tfree(node);
+            Evt_Node_values_destroy(info, node);
             node = next;
         }
         node = node_data->free[i];
         while (node) {
             Evt_Node_t *next = node->next;
-            Evt_Node_destroy(info, node);
-            tfree(node);
+            Evt_Node_values_destroy(info, node);
             node = next;
         }
     }
+    /* the nodes and their output_value arrays are in the pool */
+    EVTpool_release(&(node_data->pool));
     tfree(node_data->head);
     tfree(node_data->tail);
     tfree(node_data->last_step);
@@ -206,11 +212,21 @@ Evt_Node_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Node_Data_t *node_data)
     tfree(node_data->rhs);
     tfree(node_data->rhsold);
     tfree(node_data->total_load);
+
+    EVThist_destroy(node_data);
 }
 
 
 static void
 Evt_Node_destroy(Evt_Node_Info_t *info, Evt_Node_t *node)
+{
+    Evt_Node_values_destroy(info, node);
+    tfree(node->output_value);
+}
+
+
+static void
+Evt_Node_values_destroy(Evt_Node_Info_t *info, Evt_Node_t *node)
 {
     tfree(node->node_value);
     tfree(node->inverted_value);
@@ -219,7 +235,6 @@ Evt_Node_destroy(Evt_Node_Info_t *info, Evt_Node_t *node)
         int k = info->num_outputs;
         while (--k >= 0)
             tfree(node->output_value[k]);
-        tfree(node->output_value);
     }
 }
 
@@ -239,7 +254,6 @@ Evt_Msg_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Msg_Data_t *msg_data)
             Evt_Msg_t *next = msg->next;
             if (msg->text)
                 tfree(msg->text);
-            tfree(msg);
             msg = next;
         }
         msg = msg_data->free[i];
@@ -247,10 +261,10 @@ Evt_Msg_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Msg_Data_t *msg_data)
             Evt_Msg_t *next = msg->next;
             if (msg->text)
                 tfree(msg->text);
-            tfree(msg);
             msg = next;
         }
     }
+    EVTpool_release(&(msg_data->pool));
 
     tfree(msg_data->head);
     tfree(msg_data->tail);
@@ -0,0 +1,422 @@
+/*============================================================================
+FILE    EVThist.c
+
+MEMBER OF process XSPICE
+
+This code is in the public domain.
+
+SUMMARY
+
+    This file contains the functions which bound the history of saved
+    event-driven nodes in memory.
+
+    If option evtwindow is set, only the latest records of a node are
+    kept in its linked list.  When more than twice the window have been
+    accepted, the oldest ones are written to a scratch file as a block
+    and their list items are put on the free list.  The file holds the
+    step, the op flag and the binary (IPC) form of the node value of
+    each record.
+
+    The print and plot functions walk the history with a cursor, which
+    reads the blocks of the node back from the file one record at a
+    time, and then continues with the records in memory.  The file
+    offsets of the blocks of each node are kept while writing, so that
+    the cursor goes to them directly.
+
+INTERFACES
+
+    void EVThist_setup(
+        CKTcircuit      *ckt,
+        Evt_Node_Data_t *node_data)
+
+    void EVThist_retire(
+        CKTcircuit      *ckt,
+        int             node_index,
+        int             num_new)
+
+    void EVThist_destroy(
+        Evt_Node_Data_t *node_data)
+
+    int EVThist_count(
+        Evt_Node_Data_t *node_data,
+        int             node_index)
+
+    Evt_Node_t *EVThist_first(
+        Evt_Hist_Cursor_t *cursor,
+        Evt_Node_Data_t   *node_data,
+        int               node_index,
+        int               udn_index)
+
+    Evt_Node_t *EVThist_next(
+        Evt_Hist_Cursor_t *cursor)
+
+    void EVThist_close(
+        Evt_Hist_Cursor_t *cursor)
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    None.
+
+============================================================================*/
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/cpextern.h"
+
+#include "ngspice/mif.h"
+#include "ngspice/evt.h"
+#include "ngspice/evtudn.h"
+
+#include "ngspice/evtproto.h"
+
+
+/* Header of a block of records of one node in the file */
+typedef struct {
+    int     node_index;     /* Index of the node */
+    int     num;            /* Number of records in the block */
+    int     size;           /* Bytes of the value in each record */
+} Evt_Hist_Block_t;
+
+/* A record is the step, the op flag and the value */
+#define EVT_HIST_RECORD(size)  (sizeof(double) + 1 + (size_t) (size))
+
+
+
+/*
+EVThist_setup
+
+This function opens the scratch file of a new node data structure if
+option evtwindow is set.  The records of a node are streamed only if
+its node type has a binary form which is the value itself, as the
+built-in types have.  Otherwise they stay in memory.
+*/
+
+
+void EVThist_setup(
+    CKTcircuit      *ckt,         /* The circuit structure */
+    Evt_Node_Data_t *node_data)   /* The new node data */
+{
+
+    int  i;
+    int  num_nodes;
+    int  udn_index;
+    int  size;
+
+    void *value;
+    void *ipc_value;
+
+    Evt_Node_Hist_t  *hist;
+
+
+    node_data->hist = NULL;
+
+    if(ckt->evt->options.hist_window <= 0)
+        return;
+
+    hist = TMALLOC(Evt_Node_Hist_t, 1);
+
+    hist->file = tmpfile();
+    if(! hist->file) {
+        fprintf(cp_err, "WARNING - No scratch file for event node history, "
+                "keeping all of it in memory\n");
+        tfree(hist);
+        return;
+    }
+
+    /* The item before the last accepted one must stay in the list */
+    hist->window = MAX(ckt->evt->options.hist_window, 2);
+
+    num_nodes = ckt->evt->counts.num_nodes;
+    hist->num_nodes = num_nodes;
+    hist->stream = TMALLOC(Mif_Boolean_t, num_nodes);
+    hist->num_accepted = TMALLOC(int, num_nodes);
+    hist->num_file = TMALLOC(int, num_nodes);
+    hist->blocks = TMALLOC(long *, num_nodes);
+    hist->num_blocks = TMALLOC(int, num_nodes);
+
+    for(i = 0; i < num_nodes; i++) {
+        udn_index = ckt->evt->info.node_table[i]->udn_index;
+        value = NULL;
+        g_evt_udn_info[udn_index]->create (&value);
+        g_evt_udn_info[udn_index]->ipc_val (value, &ipc_value, &size);
+        hist->stream[i] = (ipc_value == value && size > 0);
+        tfree(value);
+    }
+
+    node_data->hist = hist;
+}
+
+
+
+/*
+EVThist_retire
+
+This function is called by EVTaccept() with the number of records of a
+saved node accepted at this time.  If there are more than twice the
+window, the oldest are written to the file and go to the free list.
+*/
+
+
+void EVThist_retire(
+    CKTcircuit  *ckt,           /* The circuit structure */
+    int         node_index,     /* The node */
+    int         num_new)        /* Number of records accepted now */
+{
+
+    int     i;
+    int     n;
+    int     udn_index;
+    int     size;
+    size_t  bytes;
+    long    offset;
+    char    *buf;
+    char    *ptr;
+    void    *ipc_value;
+
+    Evt_Node_Data_t   *node_data;
+    Evt_Node_Hist_t   *hist;
+    Evt_Node_t        *head;
+    Evt_Node_t        *last;
+    Evt_Hist_Block_t  block;
+
+
+    /* Get pointers for fast access */
+    node_data = ckt->evt->data.node;
+    hist = node_data->hist;
+
+    hist->num_accepted[node_index] += num_new;
+    if(hist->num_accepted[node_index] < 2 * hist->window)
+        return;
+
+    /* Pack the oldest records into one block */
+    udn_index = ckt->evt->info.node_table[node_index]->udn_index;
+    head = node_data->head[node_index];
+    g_evt_udn_info[udn_index]->ipc_val (head->node_value, &ipc_value, &size);
+
+    block.node_index = node_index;
+    block.num = hist->num_accepted[node_index] - hist->window;
+    block.size = size;
+
+    bytes = sizeof(block) + (size_t) block.num * EVT_HIST_RECORD(size);
+    buf = TMALLOC(char, bytes);
+    memcpy(buf, &block, sizeof(block));
+    ptr = buf + sizeof(block);
+
+    last = NULL;
+    for(i = 0; i < block.num; i++) {
+        last = last ? last->next : head;
+        memcpy(ptr, &(last->step), sizeof(double));
+        ptr += sizeof(double);
+        *ptr++ = (char) (last->op ? 1 : 0);
+        memcpy(ptr, last->node_value, (size_t) size);
+        ptr += size;
+    }
+
+    /* Append the block to the file.  If this fails, the rest of the */
+    /* history stays in memory. */
+    fseek(hist->file, 0L, SEEK_END);
+    offset = ftell(hist->file);
+    if(fwrite(buf, 1, bytes, hist->file) != bytes || fflush(hist->file) != 0) {
+        fprintf(cp_err, "WARNING - Cannot write the event node history file, "
+                "keeping the rest of it in memory\n");
+        fseek(hist->file, offset, SEEK_SET);
+        for(i = 0; i < ckt->evt->counts.num_nodes; i++)
+            hist->stream[i] = MIF_FALSE;
+        tfree(buf);
+        return;
+    }
+    tfree(buf);
+
+    /* Index the block, the list doubles when full */
+    n = hist->num_blocks[node_index];
+    if(n == 0 || (n & (n - 1)) == 0)
+        hist->blocks[node_index] =
+            TREALLOC(long, hist->blocks[node_index], MAX(1, 2 * n));
+    hist->blocks[node_index][n] = offset;
+    hist->num_blocks[node_index] = n + 1;
+
+    /* Move the records written to the free list */
+    node_data->head[node_index] = last->next;
+    last->next = node_data->free[node_index];
+    node_data->free[node_index] = head;
+
+    hist->num_accepted[node_index] -= block.num;
+    hist->num_file[node_index] += block.num;
+}
+
+
+
+/*
+EVThist_destroy
+
+This function closes the scratch file of a node data structure and
+frees the history data.
+*/
+
+
+void EVThist_destroy(
+    Evt_Node_Data_t *node_data)   /* The node data */
+{
+    Evt_Node_Hist_t  *hist = node_data->hist;
+    int              i;
+
+    if(! hist)
+        return;
+
+    fclose(hist->file);
+    for(i = 0; i < hist->num_nodes; i++)
+        tfree(hist->blocks[i]);
+    tfree(hist->blocks);
+    tfree(hist->num_blocks);
+    tfree(hist->stream);
+    tfree(hist->num_accepted);
+    tfree(hist->num_file);
+    tfree(hist);
+    node_data->hist = NULL;
+}
+
+
+
+/*
+EVThist_count
+
+This function returns the number of records in the history of a node,
+in the file and in memory.
+*/
+
+
+int EVThist_count(
+    Evt_Node_Data_t *node_data,   /* The node data */
+    int             node_index)   /* The node */
+{
+    int         count;
+    Evt_Node_t  *node;
+
+    count = node_data->hist ? node_data->hist->num_file[node_index] : 0;
+
+    for(node = node_data->head[node_index]; node; node = node->next)
+        count++;
+
+    return(count);
+}
+
+
+
+/*
+EVThist_first
+
+This function sets up a cursor on the history of a node and returns its
+first record, or NULL if there is none.  A record read from the file is
+valid until the next call with the same cursor.  EVThist_close() has to
+be called when done.
+*/
+
+
+Evt_Node_t *EVThist_first(
+    Evt_Hist_Cursor_t *cursor,     /* The cursor */
+    Evt_Node_Data_t   *node_data,  /* The node data */
+    int               node_index,  /* The node */
+    int               udn_index)   /* The node type */
+{
+    cursor->node_data = node_data;
+    cursor->node_index = node_index;
+    cursor->udn_index = udn_index;
+    cursor->block = 0;
+    cursor->offset = 0;
+    cursor->num_block = 0;
+    cursor->value_size = 0;
+    cursor->num_file = node_data->hist ? node_data->hist->num_file[node_index] : 0;
+    cursor->next = node_data->head[node_index];
+
+    cursor->record.next = NULL;
+    cursor->record.output_value = NULL;
+    cursor->record.node_value = NULL;
+    cursor->record.inverted_value = NULL;
+    if(cursor->num_file > 0)
+        g_evt_udn_info[udn_index]->create (&(cursor->record.node_value));
+
+    return(EVThist_next(cursor));
+}
+
+
+
+/*
+EVThist_next
+
+This function returns the next record of the history of a node, or
+NULL at the end.
+*/
+
+
+Evt_Node_t *EVThist_next(
+    Evt_Hist_Cursor_t *cursor)     /* The cursor */
+{
+    FILE              *file;
+    Evt_Node_t        *node;
+    Evt_Hist_Block_t  block;
+    char              op;
+
+
+    /* Records in memory follow those in the file */
+    if(cursor->num_file <= 0) {
+        node = cursor->next;
+        if(node)
+            cursor->next = node->next;
+        return(node);
+    }
+
+    file = cursor->node_data->hist->file;
+
+    /* Go to the next block of the node */
+    while(cursor->num_block <= 0) {
+        if(cursor->block >= cursor->node_data->hist->num_blocks[cursor->node_index])
+            goto read_error;
+        cursor->offset =
+            cursor->node_data->hist->blocks[cursor->node_index][cursor->block++];
+        if(fseek(file, cursor->offset, SEEK_SET) != 0 ||
+                fread(&block, sizeof(block), 1, file) != 1 ||
+                block.node_index != cursor->node_index)
+            goto read_error;
+        cursor->offset += (long) sizeof(block);
+        cursor->num_block = block.num;
+        cursor->value_size = block.size;
+    }
+
+    /* Read the record into the value of the cursor */
+    if(fseek(file, cursor->offset, SEEK_SET) != 0 ||
+            fread(&(cursor->record.step), sizeof(double), 1, file) != 1 ||
+            fread(&op, 1, 1, file) != 1 ||
+            fread(cursor->record.node_value, (size_t) cursor->value_size, 1, file) != 1)
+        goto read_error;
+    cursor->offset += (long) EVT_HIST_RECORD(cursor->value_size);
+    cursor->record.op = op ? MIF_TRUE : MIF_FALSE;
+
+    (cursor->num_block)--;
+    (cursor->num_file)--;
+
+    return(&(cursor->record));
+
+read_error:
+    fprintf(cp_err, "ERROR - Cannot read the event node history file\n");
+    cursor->num_file = 0;
+    return(EVThist_next(cursor));
+}
+
+
+
+/*
+EVThist_close
+
+This function frees the value held by a cursor.
+*/
+
+
+void EVThist_close(
+    Evt_Hist_Cursor_t *cursor)     /* The cursor */
+{
+    tfree(cursor->record.node_value);
+}
@@ -300,10 +300,12 @@ static int EVTinit_queue(
     CKALLOC(inst_queue->free, num_insts, Evt_Inst_Event_t *)
     CKALLOC(inst_queue->modified_index, num_insts, int)
     CKALLOC(inst_queue->modified, num_insts, Mif_Boolean_t)
-    CKALLOC(inst_queue->pending_index, num_insts, int)
-    CKALLOC(inst_queue->pending, num_insts, Mif_Boolean_t)
+    CKALLOC(inst_queue->pending.index, num_insts, int)
+    CKALLOC(inst_queue->pending.pos, num_insts, int)
+    CKALLOC(inst_queue->pending.time, num_insts, double)
     CKALLOC(inst_queue->to_call_index, num_insts, int)
     CKALLOC(inst_queue->to_call, num_insts, Mif_Boolean_t)
+    CKALLOC(inst_queue->parallel, num_insts, Mif_Boolean_t)
 
 
     /* Allocate elements in the node queue */
@@ -328,8 +330,9 @@ static int EVTinit_queue(
     CKALLOC(output_queue->free, num_outputs, Evt_Output_Event_t *)
     CKALLOC(output_queue->modified_index, num_outputs, int)
     CKALLOC(output_queue->modified, num_outputs, Mif_Boolean_t)
-    CKALLOC(output_queue->pending_index, num_outputs, int)
-    CKALLOC(output_queue->pending, num_outputs, Mif_Boolean_t)
+    CKALLOC(output_queue->pending.index, num_outputs, int)
+    CKALLOC(output_queue->pending.pos, num_outputs, int)
+    CKALLOC(output_queue->pending.time, num_outputs, double)
     CKALLOC(output_queue->changed_index, num_outputs, int)
     CKALLOC(output_queue->changed, num_outputs, Mif_Boolean_t)
 
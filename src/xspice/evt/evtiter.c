@@ -51,6 +51,10 @@ NON-STANDARD FEATURES
 #include "ngspice/evtproto.h"
 
 
+/* Minimum number of instances to call in parallel threads */
+#define EVT_PARALLEL_MIN  32
+
+
 /*
 EVTiter
 
@@ -74,7 +78,8 @@ Do:
         into the node data structure.
 
     Scan instance to_call list
-        Call EVTload for each instance on list.
+        Call EVTload for each instance on list, or
+        EVTload_parallel for all of them.
 
 While there are changed outputs
 
@@ -253,6 +258,17 @@ int EVTiter(
 
         /* Call the instances with inputs on nodes that have changed */
         num_to_call = inst_queue->num_to_call;
+#ifdef USE_OMP
+        /* If there are enough of them, call them in parallel threads */
+        if(ckt->evt->options.parallel &&
+                (g_mif_info.circuit.anal_type == MIF_TRAN) &&
+                (num_to_call >= EVT_PARALLEL_MIN)) {
+            for(i = 0; i < num_to_call; i++)
+                inst_queue->to_call[inst_queue->to_call_index[i]] = MIF_FALSE;
+            EVTload_parallel(ckt, num_to_call, inst_queue->to_call_index);
+        }
+        else
+#endif
         for(i = 0; i < num_to_call; i++) {
             inst_index = inst_queue->to_call_index[i];
             inst_queue->to_call[inst_index] = MIF_FALSE;
@@ -22,12 +22,15 @@ SUMMARY
     This file contains function EVTload which is used to call a
     specified event-driven or hybrid code model during an event-driven
     iteration.  The 'CALL_TYPE' is set to 'EVENT_DRIVEN' when the
-    model is called from this function.
+    model is called from this function.  EVTload_parallel calls the
+    code models of a list of instances in parallel threads.
 
 INTERFACES
 
     int EVTload(CKTcircuit *ckt, int inst_index)
 
+    void EVTload_parallel(CKTcircuit *ckt, int num_calls, int *inst_index)
+
 REFERENCED FILES
 
     None.
@@ -51,6 +54,22 @@ NON-STANDARD FEATURES
 #include "ngspice/mifproto.h"
 #include "ngspice/evtproto.h"
 
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+
+static void EVTload_inputs(
+    CKTcircuit  *ckt,
+    int         inst_index);
+
+static void EVTload_call(
+    CKTcircuit  *ckt,
+    MIFinstance *inst);
+
+static void EVTload_outputs(
+    CKTcircuit  *ckt,
+    int         inst_index);
 
 static void EVTcreate_state(
     CKTcircuit  *ckt,
@@ -91,19 +110,154 @@ int EVTload(
     CKTcircuit *ckt,        /* The circuit structure */
     int        inst_index)  /* The instance to call code model for */
 {
+    MIFinstance         *inst;
+
+    inst = ckt->evt->info.inst_table[inst_index]->inst_ptr;
+
+    EVTload_inputs(ckt, inst_index);
+    EVTload_call(ckt, inst);
+    EVTload_outputs(ckt, inst_index);
+
+    return(OK);
+}
+
+
+
+/*
+EVTload_parallel
+
+This function calls the code models of a list of instances, as
+EVTload() does for each of them in turn, but the code models of
+event-driven instances are called by parallel threads.
+
+The inputs of all instances are prepared first.  Then the code
+models are called in parallel.  They read only their inputs and
+their own states, and leave their outputs on their ports.  Events
+queued by cm_event_queue() go into a buffer of the thread.  Last,
+the outputs and the buffered events are processed in the order of
+the list, so that the queues are the same as after serial calls.
+
+This is done only in transient analysis.  In DC analysis, the
+outputs are processed immediately and change the inputs of the
+instances called later.  Hybrid instances, which may set analog
+breakpoints, and instances not initialized yet are called
+serially in the last step.
+*/
+
+
+void EVTload_parallel(
+    CKTcircuit *ckt,          /* The circuit structure */
+    int        num_calls,     /* Number of instances to call */
+    int        *inst_index)   /* The instances to call */
+{
+#ifdef USE_OMP
+    int                 i;
+    int                 t;
+    int                 num_threads;
+
+    Evt_Inst_Queue_t    *inst_queue;
+    Evt_Inst_Defer_t    *defer;
+    MIFinstance         *inst;
+
+
+    /* Get pointers for fast access */
+    inst_queue = &(ckt->evt->queue.inst);
+
+    /* Get a buffer for each thread */
+    num_threads = omp_get_max_threads();
+    if(inst_queue->num_defer < num_threads) {
+        inst_queue->defer = TREALLOC(Evt_Inst_Defer_t, inst_queue->defer, num_threads);
+        memset(inst_queue->defer + inst_queue->num_defer, 0,
+               (size_t) (num_threads - inst_queue->num_defer) * sizeof(Evt_Inst_Defer_t));
+        inst_queue->num_defer = num_threads;
+    }
+    for(t = 0; t < inst_queue->num_defer; t++) {
+        inst_queue->defer[t].num = 0;
+        inst_queue->defer[t].next = 0;
+    }
+
+    /* Prepare the inputs of the instances called in parallel */
+    for(i = 0; i < num_calls; i++) {
+        inst = ckt->evt->info.inst_table[inst_index[i]]->inst_ptr;
+        inst_queue->parallel[i] = inst->initialized && ! inst->analog;
+        if(inst_queue->parallel[i])
+            EVTload_inputs(ckt, inst_index[i]);
+    }
+
+    /* Call their code models */
+    inst_queue->deferring = MIF_TRUE;
+
+#pragma omp parallel num_threads(num_threads) private(inst)
+    {
+        /* The cm_... functions of this thread use a copy of g_mif_info */
+        Mif_Info_t  info = g_mif_info;
+
+        g_mif_thread_info = &info;
+
+#pragma omp for schedule(static)
+        for(i = 0; i < num_calls; i++) {
+            if(! inst_queue->parallel[i])
+                continue;
+            inst = ckt->evt->info.inst_table[inst_index[i]]->inst_ptr;
+            inst_queue->defer[omp_get_thread_num()].call = i;
+            EVTload_call(ckt, inst);
+        }
+
+        g_mif_thread_info = NULL;
+    }
+
+    inst_queue->deferring = MIF_FALSE;
+
+    /* Process the outputs in the order of the list */
+    for(i = 0; i < num_calls; i++) {
+        if(! inst_queue->parallel[i]) {
+            EVTload(ckt, inst_index[i]);
+            continue;
+        }
+        for(t = 0; t < num_threads; t++) {
+            defer = &(inst_queue->defer[t]);
+            while(defer->next < defer->num && defer->call_pos[defer->next] == i) {
+                EVTqueue_inst(ckt, inst_index[i], defer->posted_time[defer->next],
+                              defer->event_time[defer->next]);
+                (defer->next)++;
+            }
+        }
+        g_mif_info.instance = ckt->evt->info.inst_table[inst_index[i]]->inst_ptr;
+        EVTload_outputs(ckt, inst_index[i]);
+    }
+#else
+    int i;
+
+    for(i = 0; i < num_calls; i++)
+        EVTload(ckt, inst_index[i]);
+#endif
+}
+
+
+
+/*
+EVTload_inputs
+
+This function prepares the ports of an instance for the call of its
+code model, creates a new state in transient analysis, and the
+output events.
+*/
+
+
+static void EVTload_inputs(
+    CKTcircuit *ckt,        /* The circuit structure */
+    int        inst_index)  /* The instance to call code model for */
+{
 
     int                 i;
     int                 j;
 
     int                 num_conn;
     int                 num_port;
-    int                 mod_type;
 
     Mif_Conn_Data_t     *conn;
     Mif_Port_Data_t     *port;
 
-    Mif_Private_t       cm_data;
-
     MIFinstance         *inst;
 
     Evt_Node_Data_t     *node_data;
@@ -111,45 +265,15 @@ int EVTload(
     void                *value_ptr;
 
 
-    /* ***************************** */
-    /* Prepare the code model inputs */
-    /* ***************************** */
-
     /* Get pointer to instance data structure and other data */
     /* needed for fast access */
     inst = ckt->evt->info.inst_table[inst_index]->inst_ptr;
     node_data = ckt->evt->data.node;
 
-    /* Setup circuit data in struct to be passed to code model function */
-
-    if(inst->initialized)
-        cm_data.circuit.init = MIF_FALSE;
-    else
-        cm_data.circuit.init = MIF_TRUE;
-
-    cm_data.circuit.anal_init = MIF_FALSE;
-    cm_data.circuit.anal_type = g_mif_info.circuit.anal_type;
-
-    if(g_mif_info.circuit.anal_type == MIF_TRAN)
-        cm_data.circuit.time = g_mif_info.circuit.evt_step;
-    else
-        cm_data.circuit.time = 0.0;
-
-    cm_data.circuit.call_type = MIF_EVENT_DRIVEN;
-    cm_data.circuit.temperature = ckt->CKTtemp - 273.15;
-
-
     /* Setup data needed by cm_... functions */
 
     g_mif_info.ckt = ckt;
     g_mif_info.instance = inst;
-    g_mif_info.errmsg = "";
-    g_mif_info.circuit.call_type = MIF_EVENT_DRIVEN;
-
-    if(inst->initialized)
-        g_mif_info.circuit.init = MIF_FALSE;
-    else
-        g_mif_info.circuit.init = MIF_TRUE;
 
 
     /* If after initialization and in transient analysis mode */
@@ -215,6 +339,59 @@ int EVTload(
 
         } /* end for number of ports */
     } /* end for number of connections */
+}
+
+
+
+/*
+EVTload_call
+
+This function calls the code model of an instance.  It changes only
+the ports and states of the instance, and MIF_INFO, the g_mif_info
+of the calling thread.
+*/
+
+
+static void EVTload_call(
+    CKTcircuit  *ckt,       /* The circuit structure */
+    MIFinstance *inst)      /* The instance to call code model for */
+{
+
+    int                 mod_type;
+
+    Mif_Private_t       cm_data;
+
+
+    /* Setup circuit data in struct to be passed to code model function */
+
+    if(inst->initialized)
+        cm_data.circuit.init = MIF_FALSE;
+    else
+        cm_data.circuit.init = MIF_TRUE;
+
+    cm_data.circuit.anal_init = MIF_FALSE;
+    cm_data.circuit.anal_type = MIF_INFO.circuit.anal_type;
+
+    if(MIF_INFO.circuit.anal_type == MIF_TRAN)
+        cm_data.circuit.time = MIF_INFO.circuit.evt_step;
+    else
+        cm_data.circuit.time = 0.0;
+
+    cm_data.circuit.call_type = MIF_EVENT_DRIVEN;
+    cm_data.circuit.temperature = ckt->CKTtemp - 273.15;
+
+
+    /* Setup data needed by cm_... functions */
+
+    MIF_INFO.ckt = ckt;
+    MIF_INFO.instance = inst;
+    MIF_INFO.errmsg = "";
+    MIF_INFO.circuit.call_type = MIF_EVENT_DRIVEN;
+
+    if(inst->initialized)
+        MIF_INFO.circuit.init = MIF_FALSE;
+    else
+        MIF_INFO.circuit.init = MIF_TRUE;
 
 
     /* Prepare the structure to be passed to the code model */
@@ -233,11 +410,40 @@ int EVTload(
 
     mod_type = MIFmodPtr(inst)->MIFmodType;
     DEVices[mod_type]->DEVpublic.cm_func (&cm_data);
+}
+
+
+
+/*
+EVTload_outputs
+
+This function processes the messages, loads and event outputs left on
+the ports of an instance by its code model.
+*/
+
+
+static void EVTload_outputs(
+    CKTcircuit *ckt,        /* The circuit structure */
+    int        inst_index)  /* The instance called */
+{
 
+    int                 i;
+    int                 j;
+
+    int                 num_conn;
+    int                 num_port;
 
-    /* ****************************** */
-    /* Process the code model outputs */
-    /* ****************************** */
+    Mif_Conn_Data_t     *conn;
+    Mif_Port_Data_t     *port;
+
+    MIFinstance         *inst;
+
+    Evt_Node_Data_t     *node_data;
+
+
+    /* Get pointers for fast access */
+    inst = ckt->evt->info.inst_table[inst_index]->inst_ptr;
+    node_data = ckt->evt->data.node;
 
     /* Loop through all connections and ports and process the msgs */
     /* and event outputs */
@@ -297,8 +503,6 @@ int EVTload(
 
     /* Mark that the instance has been called once */
     inst->initialized = MIF_TRUE;
-
-    return(OK);
 }
 
 
@@ -343,10 +547,10 @@ static void EVTcreate_state(
     }
     else 
 	{
-		
-        new_state = TMALLOC(Evt_State_t, 1);
-        new_state->block = tmalloc(total_size);
-
+        /* The block follows the state struct in the pool item */
+        new_state = EVTpool_alloc(&(state_data->pool),
+                                  sizeof(Evt_State_t) + total_size);
+        new_state->block = new_state + 1;
     }
 
     /* Splice the new state into the state data linked list */
@@ -394,7 +598,7 @@ static void EVTcreate_output_event(
     }
     else {
         /* Create a new event */
-        event = TMALLOC(Evt_Output_Event_t, 1);
+        event = EVTpool_alloc(&(output_queue->pool), sizeof(Evt_Output_Event_t));
         event->next = NULL;
 
         /* Initialize the value */
@@ -448,7 +652,7 @@ static void EVTadd_msg(
             tfree((*msg_ptr)->text);
     }
     else {
-        *msg_ptr = TMALLOC(Evt_Msg_t, 1);
+        *msg_ptr = EVTpool_alloc(&(msg_data->pool), sizeof(Evt_Msg_t));
     }
 
     /* Fill in the values */
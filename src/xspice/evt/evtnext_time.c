@@ -66,6 +66,8 @@ double EVTnext_time(
     Evt_Inst_Queue_t    *inst_queue;
     Evt_Output_Queue_t  *output_queue;
 
+    Evt_Heap_t          *heap;
+
 
     /* Initialize next time to machine infinity */
     next_time = 1e30;
@@ -75,16 +77,18 @@ double EVTnext_time(
     output_queue = &(ckt->evt->queue.output);
 
     /* If anything pending in inst queue, set next time */
-    /* to minimum of itself and the inst queue next time */
-    if(inst_queue->num_pending)
-        if(inst_queue->next_time < next_time)
-            next_time = inst_queue->next_time;
+    /* to minimum of itself and the earliest inst event */
+    heap = &(inst_queue->pending);
+    if(heap->num)
+        if(heap->time[heap->index[0]] < next_time)
+            next_time = heap->time[heap->index[0]];
 
     /* If anything pending in output queue, set next time */
-    /* to minimum of itself and the output queue next time */
-    if(output_queue->num_pending)
-        if(output_queue->next_time < next_time)
-            next_time = output_queue->next_time;
+    /* to minimum of itself and the earliest output event */
+    heap = &(output_queue->pending);
+    if(heap->num)
+        if(heap->time[heap->index[0]] < next_time)
+            next_time = heap->time[heap->index[0]];
 
     return(next_time);
 }
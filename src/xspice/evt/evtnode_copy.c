@@ -113,12 +113,15 @@ void EVTnode_copy(
         }
         else 
 		{
-            here = TMALLOC(Evt_Node_t, 1);
+            /* Take a new one from the pool, for a node with several */
+            /* outputs with the output_value array behind it */
+            here = EVTpool_alloc(&(node_data->pool), sizeof(Evt_Node_t) +
+                    (size_t) (num_outputs > 1 ? num_outputs : 0) * sizeof(void *));
             *to = here;
             /* Allocate/initialize the data in the new node struct */
             if(num_outputs > 1) 
 			{
-                here->output_value = TMALLOC(void *, num_outputs);
+                here->output_value = (void **) (here + 1);
                 
 				for(i = 0; i < num_outputs; i++) 
 				{
@@ -90,8 +90,8 @@ struct dvec *EVTfindvec(
 
   Mif_Boolean_t   found;
   Evt_Node_Info_t **node_table;
-  Evt_Node_t      *head;
   Evt_Node_t      *event;
+  Evt_Hist_Cursor_t cursor;
 
   double *anal_point_vec;
   double *value_vec;
@@ -159,10 +159,7 @@ struct dvec *EVTfindvec(
   }
 
   /* Count the number of events */
-  head = g_mif_info.ckt->evt->data.node->head[i];
-
-  for(event = head, num_events = 0; event; event = event->next)
-    num_events++;
+  num_events = EVThist_count(g_mif_info.ckt->evt->data.node, i);
 
   /* Allocate arrays to hold the analysis point and node value vectors */
   anal_point_vec = TMALLOC(double, 2 * (num_events + 2));
@@ -172,7 +169,8 @@ struct dvec *EVTfindvec(
   /* Note that we create vertical segments every time an event occurs. */
   /* Need to modify this in the future to complete the vector out to the */
   /* last analysis point... */
-  for(i = 0, event = head; event; event = event->next) {
+  event = EVThist_first(&cursor, g_mif_info.ckt->evt->data.node, i, udn_index);
+  for(i = 0; event; event = EVThist_next(&cursor)) {
 
     /* If not first point, put the second value of the horizontal line in the vectors */
     if(i > 0) {
@@ -193,6 +191,7 @@ struct dvec *EVTfindvec(
     i++;
 
   }
+  EVThist_close(&cursor);
 
   /* Allocate dvec structures and assign the vectors into them. */
   /* See FTE/OUTinterface.c:plotInit() for initialization example. */
@@ -0,0 +1,134 @@
+/*============================================================================
+FILE    EVTpool.c
+
+MEMBER OF process XSPICE
+
+This code is in the public domain.
+
+SUMMARY
+
+    This file contains the pools from which the event queues and the
+    event data take their events, node records, states and messages.
+
+    A pool hands out items of one size from large blocks.  Items are
+    never returned one by one, the queues and data structures keep
+    them on their own free lists for reuse, as before.  All blocks of
+    a pool are released together when the queue is cleared for a new
+    analysis or when the data of a job are destroyed.
+
+INTERFACES
+
+    void *EVTpool_alloc(
+        Evt_Pool_t  **pools,
+        size_t      size)
+
+    void EVTpool_release(
+        Evt_Pool_t  **pools)
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    None.
+
+============================================================================*/
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+
+#include "ngspice/mif.h"
+#include "ngspice/evt.h"
+
+#include "ngspice/evtproto.h"
+
+
+#define EVT_POOL_ALIGN   16       /* Alignment of the items */
+#define EVT_POOL_BLOCK   65536    /* Approximate bytes per block */
+
+
+/*
+EVTpool_alloc
+
+This function returns a zeroed item of the specified size from the
+pool for this size in the list of pools, creating the pool if there
+is none yet.
+*/
+
+
+void *EVTpool_alloc(
+    Evt_Pool_t  **pools,    /* The list of pools */
+    size_t      size)       /* The size of the item */
+{
+
+    Evt_Pool_t  *pool;
+    void        **block;
+    void        *item;
+    int         num;
+
+
+    /* Round the size up to keep all items aligned */
+    size = (size + EVT_POOL_ALIGN - 1) & ~((size_t) EVT_POOL_ALIGN - 1);
+
+    /* Find the pool for this size, there are only a few sizes */
+    for(pool = *pools; pool; pool = pool->next)
+        if(pool->size == size)
+            break;
+
+    if(! pool) {
+        pool = TMALLOC(Evt_Pool_t, 1);
+        pool->size = size;
+        pool->next = *pools;
+        *pools = pool;
+    }
+
+    /* Start a new block if the current one is used up */
+    if(pool->num_avail <= 0) {
+        num = (int) (EVT_POOL_BLOCK / size);
+        if(num < 16)
+            num = 16;
+        block = tmalloc(EVT_POOL_ALIGN + (size_t) num * size);
+        *block = pool->blocks;
+        pool->blocks = block;
+        pool->avail = (char *) block + EVT_POOL_ALIGN;
+        pool->num_avail = num;
+    }
+
+    /* Blocks are zeroed by tmalloc */
+    item = pool->avail;
+    pool->avail += size;
+    (pool->num_avail)--;
+
+    return(item);
+}
+
+
+
+/*
+EVTpool_release
+
+This function releases all blocks of all pools in the list, and the
+pools themselves.
+*/
+
+
+void EVTpool_release(
+    Evt_Pool_t  **pools)    /* The list of pools */
+{
+
+    Evt_Pool_t  *pool;
+    void        *block;
+
+
+    while(*pools) {
+        pool = *pools;
+        *pools = pool->next;
+        while(pool->blocks) {
+            block = pool->blocks;
+            pool->blocks = *((void **) block);
+            tfree(block);
+        }
+        tfree(pool);
+    }
+}
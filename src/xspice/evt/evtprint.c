@@ -111,6 +111,8 @@ void EVTprint(
     Evt_Node_t  *node_data[EPRINT_MAXARGS];
     char        *node_value[EPRINT_MAXARGS];
 
+    Evt_Hist_Cursor_t  cursor[EPRINT_MAXARGS];
+
     CKTcircuit  *ckt;
 
     Evt_Node_Info_t  **node_table;
@@ -164,16 +166,20 @@ void EVTprint(
             return;
         }
         udn_index[i] = node_table[node_index[i]]->udn_index;
-        if (ckt->evt->data.node)
-            node_data[i] = ckt->evt->data.node->head[node_index[i]];
-        else  {
-            fprintf(cp_err, "ERROR - No node data: simulation not yet run?\n");
-            return;
-        }
         node_value[i] = "";
         w = w->wl_next;
     }
 
+    if (!ckt->evt->data.node) {
+        fprintf(cp_err, "ERROR - No node data: simulation not yet run?\n");
+        return;
+    }
+
+    /* Start reading the history of each node */
+    for(i = 0; i < nargs; i++)
+        node_data[i] = EVThist_first(&(cursor[i]), ckt->evt->data.node,
+                                     node_index[i], udn_index[i]);
+
     out_init();
 
     /* Print results data */
@@ -201,7 +207,7 @@ void EVTprint(
         (*(g_evt_udn_info[udn_index[i]]->print_val))
                 (node_data[i]->node_value, "all", &value);
         node_value[i] = value;
-        node_data[i] = node_data[i]->next;
+        node_data[i] = EVThist_next(&(cursor[i]));
         if(node_data[i]) {
             more = MIF_TRUE;
             if(node_data[i]->step < next_step)
@@ -226,7 +232,7 @@ void EVTprint(
                     (*(g_evt_udn_info[udn_index[i]]->print_val))
                             (node_data[i]->node_value, "all", &value);
                     node_value[i] = value;
-                    node_data[i] = node_data[i]->next;
+                    node_data[i] = EVThist_next(&(cursor[i]));
                 }
                 if(node_data[i]) {
                     more = MIF_TRUE;
@@ -243,6 +249,9 @@ void EVTprint(
     } /* end while there is more data */
     out_printf("\n\n");
 
+    for(i = 0; i < nargs; i++)
+        EVThist_close(&(cursor[i]));
+
 
     /* Print messages for all ports */
     out_printf("\n**** Messages ****\n\n");
@@ -425,18 +434,12 @@ EVTdisplay(wordlist *wl)
 
     node_index = 0;
     while (node) {
-        Evt_Node_t  *node_data = NULL;
         int count = 0;
         char *type;
 
         udn_index = node_table[node_index]->udn_index;
-        if (ckt->evt->data.node) {
-            node_data = ckt->evt->data.node->head[node_index];
-            while (node_data) {
-                count++;
-                node_data = node_data->next;
-            }
-        }
+        if (ckt->evt->data.node)
+            count = EVThist_count(ckt->evt->data.node, node_index);
         type = g_evt_udn_info[udn_index]->name;
         out_printf("    %-20s: %-5s, %5d\n", node->name, type, count);
 
@@ -521,6 +524,8 @@ EVTprintvcd(wordlist *wl)
     char        *old_node_value[EPRINT_MAXARGS];
     char        node_ident[EPRINT_MAXARGS + 1];
 
+    Evt_Hist_Cursor_t  cursor[EPRINT_MAXARGS];
+
     CKTcircuit  *ckt;
 
     Evt_Node_Info_t  **node_table;
@@ -569,12 +574,15 @@ EVTprintvcd(wordlist *wl)
             return;
         }
         udn_index[i] = node_table[node_index[i]]->udn_index;
-
-        node_data[i] = ckt->evt->data.node->head[node_index[i]];
         node_value[i] = "";
         w = w->wl_next;
     }
 
+    /* Start reading the history of each node */
+    for (i = 0; i < nargs; i++)
+        node_data[i] = EVThist_first(&(cursor[i]), ckt->evt->data.node,
+                                     node_index[i], udn_index[i]);
+
     /* generate the vcd identifier code made of the printable
        ASCII character set from ! to ~ (decimal 33 to 126) */
     for (i = 0; i < nargs; i++)
@@ -638,7 +646,7 @@ EVTprintvcd(wordlist *wl)
         g_evt_udn_info[udn_index[i]]->print_val
             (node_data[i]->node_value, "all", &value);
         old_node_value[i] = node_value[i] = value;
-        node_data[i] = node_data[i]->next;
+        node_data[i] = EVThist_next(&(cursor[i]));
         if (node_data[i]) {
             more = MIF_TRUE;
             if (next_step > node_data[i]->step)
@@ -688,7 +696,7 @@ EVTprintvcd(wordlist *wl)
                     g_evt_udn_info[udn_index[i]]->print_val
                         (node_data[i]->node_value, "all", &value);
                     node_value[i] = value;
-                    node_data[i] = node_data[i]->next;
+                    node_data[i] = EVThist_next(&(cursor[i]));
                 }
                 if (node_data[i]) {
                     more = MIF_TRUE;
@@ -714,6 +722,9 @@ EVTprintvcd(wordlist *wl)
     } /* end while there is more data */
 
     out_printf("\n\n");
+
+    for (i = 0; i < nargs; i++)
+        EVThist_close(&(cursor[i]));
 }
 
 /* Mark event nodes whose data should be saved for printing.
@@ -20,7 +20,8 @@ MODIFICATIONS
 SUMMARY
 
     This file contains functions that place new events into the output and
-    instance queues.
+    instance queues, and the binary heap which orders the outputs and
+    instances with pending events by the time of their next event.
 
 INTERFACES
 
@@ -38,6 +39,15 @@ INTERFACES
         double     posted_time,
         double     event_time)
 
+    void EVTheap_set(
+        Evt_Heap_t *heap,
+        int        index,
+        double     time)
+
+    void EVTheap_remove(
+        Evt_Heap_t *heap,
+        int        index)
+
 REFERENCED FILES
 
     None.
@@ -59,6 +69,10 @@ NON-STANDARD FEATURES
 
 #include "ngspice/evtproto.h"
 
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
 
 
 /*
@@ -104,11 +118,6 @@ void EVTqueue_output(
     new_event->posted_time = posted_time;
     new_event->removed = MIF_FALSE;
 
-    /* Update next_time in output queue */
-    if((output_queue->num_pending <= 0) ||
-            (event_time < output_queue->next_time))
-        output_queue->next_time = event_time;
-
     /* Find location at which to insert event */
     splice = MIF_FALSE;
     here = output_queue->current[output_index];
@@ -148,12 +157,9 @@ void EVTqueue_output(
                 output_index;
     }
 
-    /* Add to the list of outputs with events pending */
-    if(! output_queue->pending[output_index]) {
-        output_queue->pending[output_index] = MIF_TRUE;
-        output_queue->pending_index[(output_queue->num_pending)++] =
-                output_index;
-    }
+    /* Update the time of the next pending event of this output */
+    EVTheap_set(&(output_queue->pending), output_index,
+            (*(output_queue->current[output_index]))->event_time);
 }
 
 
@@ -168,6 +174,10 @@ The linked list in the queue for the specified inst is
 searched beginning at the current head of the pending events
 to find the location at which to insert the new event.  The
 events are ordered in the list by event_time.
+
+While code models are called in parallel, the event is put into
+the buffer of the thread instead, and queued by EVTload_parallel()
+afterwards.
 */
 
 
@@ -191,10 +201,22 @@ void EVTqueue_inst(
     /* Get pointers for fast access */
     inst_queue = &(ckt->evt->queue.inst);
 
-    /* Update next_time in inst queue */
-    if((inst_queue->num_pending <= 0) ||
-            (event_time < inst_queue->next_time))
-        inst_queue->next_time = event_time;
+#ifdef USE_OMP
+    if(inst_queue->deferring) {
+        Evt_Inst_Defer_t *defer = &(inst_queue->defer[omp_get_thread_num()]);
+        if(defer->num >= defer->size) {
+            defer->size = MAX(2 * defer->size, 16);
+            defer->call_pos = TREALLOC(int, defer->call_pos, defer->size);
+            defer->posted_time = TREALLOC(double, defer->posted_time, defer->size);
+            defer->event_time = TREALLOC(double, defer->event_time, defer->size);
+        }
+        defer->call_pos[defer->num] = defer->call;
+        defer->posted_time[defer->num] = posted_time;
+        defer->event_time[defer->num] = event_time;
+        (defer->num)++;
+        return;
+    }
+#endif
 
     /* Find location at which to insert event */
     splice = MIF_FALSE;
@@ -217,7 +239,7 @@ void EVTqueue_inst(
         inst_queue->free[inst_index] = new_event->next;
     }
     else {
-        new_event = TMALLOC(Evt_Inst_Event_t, 1);
+        new_event = EVTpool_alloc(&(inst_queue->pool), sizeof(Evt_Inst_Event_t));
     }
     new_event->event_time = event_time;
     new_event->posted_time = posted_time;
@@ -242,10 +264,139 @@ void EVTqueue_inst(
                 inst_index;
     }
 
-    /* Add to the list of insts with events pending */
-    if(! inst_queue->pending[inst_index]) {
-        inst_queue->pending[inst_index] = MIF_TRUE;
-        inst_queue->pending_index[(inst_queue->num_pending)++] =
-                inst_index;
+    /* Update the time of the next pending event of this inst */
+    EVTheap_set(&(inst_queue->pending), inst_index,
+            (*(inst_queue->current[inst_index]))->event_time);
+}
+
+
+
+/*
+EVTheap_before
+
+Heap order: earlier time first, equal times by ascending index,
+so that simultaneous events are always taken in the same order.
+*/
+
+
+static Mif_Boolean_t EVTheap_before(
+    Evt_Heap_t  *heap,      /* The heap */
+    int         a,          /* First index */
+    int         b)          /* Second index */
+{
+    if(heap->time[a] != heap->time[b])
+        return(heap->time[a] < heap->time[b]);
+    return(a < b);
+}
+
+
+
+/*
+EVTheap_move
+
+This function moves the entry at heap position pos up or down
+until the heap order is restored.
+*/
+
+
+static void EVTheap_move(
+    Evt_Heap_t  *heap,      /* The heap */
+    int         pos)        /* Position of the entry to move */
+{
+
+    int         index;
+    int         parent;
+    int         child;
+
+
+    index = heap->index[pos];
+
+    /* Move up while earlier than the parent */
+    while(pos > 0) {
+        parent = (pos - 1) / 2;
+        if(! EVTheap_before(heap, index, heap->index[parent]))
+            break;
+        heap->index[pos] = heap->index[parent];
+        heap->pos[heap->index[pos]] = pos;
+        pos = parent;
+    }
+
+    /* Move down while a child is earlier */
+    for(;;) {
+        child = 2 * pos + 1;
+        if(child >= heap->num)
+            break;
+        if((child + 1 < heap->num) &&
+                EVTheap_before(heap, heap->index[child + 1], heap->index[child]))
+            child++;
+        if(! EVTheap_before(heap, heap->index[child], index))
+            break;
+        heap->index[pos] = heap->index[child];
+        heap->pos[heap->index[pos]] = pos;
+        pos = child;
+    }
+
+    heap->index[pos] = index;
+    heap->pos[index] = pos;
+}
+
+
+
+/*
+EVTheap_set
+
+This function sets the time of the next pending event of the
+specified output or instance, and enters it into the heap if it
+had no pending events.  The earliest pending event is then found
+at heap->index[0].
+*/
+
+
+void EVTheap_set(
+    Evt_Heap_t  *heap,      /* The heap */
+    int         index,      /* The output or instance index */
+    double      time)       /* Time of its next pending event */
+{
+    heap->time[index] = time;
+
+    if(heap->pos[index] < 0) {
+        heap->index[heap->num] = index;
+        heap->pos[index] = heap->num;
+        (heap->num)++;
+    }
+
+    EVTheap_move(heap, heap->pos[index]);
+}
+
+
+
+/*
+EVTheap_remove
+
+This function removes the specified output or instance from the
+heap when it has no more pending events.
+*/
+
+
+void EVTheap_remove(
+    Evt_Heap_t  *heap,      /* The heap */
+    int         index)      /* The output or instance index */
+{
+
+    int         pos;
+
+
+    pos = heap->pos[index];
+    if(pos < 0)
+        return;
+
+    heap->pos[index] = -1;
+    (heap->num)--;
+
+    /* Fill the gap with the last entry */
+    if(pos < heap->num) {
+        heap->index[pos] = heap->index[heap->num];
+        heap->pos[heap->index[pos]] = pos;
+        EVTheap_move(heap, pos);
     }
 }
@@ -181,7 +181,6 @@ static int EVTsetup_queues(
     Evt_Node_Queue_t    *node_queue;
     Evt_Output_Queue_t  *output_queue;
 
-    Evt_Inst_Event_t    *inst_event;
     Evt_Output_Event_t  *output_event;
 
     void                *ptr;
@@ -193,35 +192,25 @@ static int EVTsetup_queues(
     num_insts = ckt->evt->counts.num_insts;
     inst_queue = &(ckt->evt->queue.inst);
 
+    /* All events are in the pool */
+    EVTpool_release(&(inst_queue->pool));
+
     for(i = 0; i < num_insts; i++) {
-        inst_event = inst_queue->head[i];
-        while(inst_event) {
-            ptr = inst_event;
-            inst_event = inst_event->next;
-            FREE(ptr);
-        }
-        inst_event = inst_queue->free[i];
-        while(inst_event) {
-            ptr = inst_event;
-            inst_event = inst_event->next;
-            FREE(ptr);
-        }
         inst_queue->head[i] = NULL;
         inst_queue->current[i] = &(inst_queue->head[i]);
         inst_queue->last_step[i] = &(inst_queue->head[i]);
         inst_queue->free[i] = NULL;
     }
 
-    inst_queue->next_time = 0.0;
     inst_queue->last_time = 0.0;
 
     inst_queue->num_modified = 0;
-    inst_queue->num_pending = 0;
+    inst_queue->pending.num = 0;
     inst_queue->num_to_call = 0;
 
     for(i = 0; i < num_insts; i++) {
         inst_queue->modified[i] = MIF_FALSE;
-        inst_queue->pending[i] = MIF_FALSE;
+        inst_queue->pending.pos[i] = -1;
         inst_queue->to_call[i] = MIF_FALSE;
     }
 
@@ -248,16 +237,17 @@ static int EVTsetup_queues(
     num_outputs = ckt->evt->counts.num_outputs;
     output_queue = &(ckt->evt->queue.output);
 
+    /* Free the values, the events are in the pool */
     for(i = 0; i < num_outputs; i++) {
         output_event = output_queue->head[i];
         while(output_event) {
-            ptr = output_event;
+            ptr = output_event->value;
             output_event = output_event->next;
             FREE(ptr);
         }
         output_event = output_queue->free[i];
         while(output_event) {
-            ptr = output_event;
+            ptr = output_event->value;
             output_event = output_event->next;
             FREE(ptr);
         }
@@ -266,17 +256,17 @@ static int EVTsetup_queues(
         output_queue->last_step[i] = &(output_queue->head[i]);
         output_queue->free[i] = NULL;
     }
+    EVTpool_release(&(output_queue->pool));
 
-    output_queue->next_time = 0.0;
     output_queue->last_time = 0.0;
 
     output_queue->num_modified = 0;
-    output_queue->num_pending = 0;
+    output_queue->pending.num = 0;
     output_queue->num_changed = 0;
 
     for(i = 0; i < num_outputs; i++) {
         output_queue->modified[i] = MIF_FALSE;
-        output_queue->pending[i] = MIF_FALSE;
+        output_queue->pending.pos[i] = -1;
         output_queue->changed[i] = MIF_FALSE;
     }
 
@@ -396,6 +386,9 @@ static int EVTsetup_data(
         node_data->total_load[i] = 0.0;
     }
 
+    /* Open the file for the older history, if requested */
+    EVThist_setup(ckt, node_data);
+
 
     /* Allocate and initialize state data */
 
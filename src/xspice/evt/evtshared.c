@@ -91,7 +91,8 @@ EVTshareddata(
 
     int         node_index;
     int         udn_index;
-    Evt_Node_t  *node_data, *count_data;
+    Evt_Node_t  *node_data;
+    Evt_Hist_Cursor_t  cursor;
     char        *node_value;
 
     CKTcircuit  *ckt;
@@ -129,7 +130,8 @@ EVTshareddata(
     }
     udn_index = node_table[node_index]->udn_index;
     if (ckt->evt->data.node)
-        node_data = ckt->evt->data.node->head[node_index];
+        node_data = EVThist_first(&cursor, ckt->evt->data.node,
+                                  node_index, udn_index);
     else  {
         fprintf(cp_err, "ERROR - No node data: simulation not yet run?\n");
         return NULL;
@@ -152,20 +154,15 @@ EVTshareddata(
     (*(g_evt_udn_info[udn_index]->print_val))
             (node_data->node_value, "all", &value);
     node_value = value;
-    node_data = node_data->next;
+    node_data = EVThist_next(&cursor);
     if(node_data) {
         more = MIF_TRUE;
         if(node_data->step < next_step)
             next_step = node_data->step;
     }
 
-    /* Count the number of data points of this node */
-    count_data = node_data;
-    num_points = 0;
-    while (count_data) {
-        num_points++;
-        count_data = count_data->next;
-    }
+    /* Count the number of data points of this node after the first */
+    num_points = EVThist_count(ckt->evt->data.node, node_index) - 1;
 
     /* Store the data */
     return_node = TMALLOC(pevt_data, num_points + 1);
@@ -188,7 +185,7 @@ EVTshareddata(
                 (*(g_evt_udn_info[udn_index]->print_val))
                         (node_data->node_value, "all", &value);
                 node_value = value;
-                node_data = node_data->next;
+                node_data = EVThist_next(&cursor);
             }
             if(node_data) {
                 more = MIF_TRUE;
@@ -205,6 +202,7 @@ EVTshareddata(
         return_node[i] = newnode;
         i++;
     } /* end while there is more data */
+    EVThist_close(&cursor);
     return_all = TMALLOC(evt_shared_data, 1);
     return_all->evt_dect = return_node;
     return_all->num_steps = i;
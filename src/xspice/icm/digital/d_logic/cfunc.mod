@@ -0,0 +1,771 @@
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE d_logic/cfunc.mod
+
+AUTHORS
+
+    18 Oct 2026     ngspice developers
+
+SUMMARY
+
+    This file contains the functional description of the d_logic
+    code model.
+
+    The model evaluates a network of zero-delay gates between its
+    input and output ports, as generated by the U-device translator
+    from a PSpice LOGICEXP, or from the gates with timing model
+    d0_gate of a subcircuit.  Only the ports are event nodes, the
+    internal signals of the network are not.
+
+    The parameter 'program' lists the gates.  Each gate is an
+    operator, the signal it drives and its operands:
+
+        and | nand | or | nor | xor | xnor | buf | inv  out  in ...
+
+    Signals are numbered.  The inputs are 0 ... n-1, the outputs
+    n ... n+m-1, and the internal signals follow.  An operand
+    prefixed by '!' is inverted.  '~' is taken too, but a '~' ends
+    the value of a parameter on a .model line.  Any other character
+    may separate the fields.  A program in a .model inside a .subckt
+    must not have blanks, the quotes are lost in subckt expansion.
+    A half adder:
+
+        program = "xor 2 0 1 and 3 0 1"
+        program = "xor:2:0:1/and:3:0:1"
+
+    The program is compiled once.  Its gates are sorted by level,
+    so that each gate comes after the gates driving its operands.
+    The gates of a level with the same operator, inversion and fan-in
+    are put in chunks of up to 64 gates.  The signal values are packed 64 to
+    a word in two bit planes, one bit set for a ONE and one for a
+    ZERO, and none for an UNKNOWN.  The outputs of a chunk are the
+    bits of one word, so that a chunk is evaluated by one word
+    operation per operand.  The operand words of a chunk are shifted
+    out of the bit planes if the operands are consecutive signals,
+    as for a bus, and gathered bit by bit otherwise.
+
+    The rise and fall delays are those of a single gate.  An output
+    changes after its level times the delay, its level being the
+    number of gates on the longest path from an input.  This is the
+    timing of the single gates if all paths to the output have the
+    same length and the rise and fall delays are equal.  A change
+    through a shorter path comes later than with the single gates,
+    and glitches of the internal signals are not seen.
+
+LICENSE
+
+    This software is in the public domain.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+    CMutil.c             int cm_message_printf()
+
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+
+
+/*=== CONSTANTS ========================*/
+
+#define LOGIC_AND   0
+#define LOGIC_OR    1
+#define LOGIC_XOR   2
+
+
+
+/*=== MACROS ===========================*/
+
+/* Separator of the fields of a program */
+#define IS_SEP(c)       ((c) != '\0' && !isalnum((unsigned char) (c)) && \
+                         (c) != '~' && (c) != '!')
+
+/* Word and bit of a signal in the bit planes */
+#define SIG_WORD(s)     ((s) >> 6)
+#define SIG_SHIFT(s)    ((s) & 63)
+
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+typedef struct {
+    int     op;             /* LOGIC_AND, LOGIC_OR or LOGIC_XOR */
+    int     invert;         /* Invert the result */
+    int     out;            /* Signal driven by the gate */
+    int     first;          /* First operand in the operand list */
+    int     num;            /* Number of operands */
+    int     level;          /* Longest path from an input */
+} Logic_Gate_t;
+
+typedef struct {
+    int     op;             /* LOGIC_AND, LOGIC_OR or LOGIC_XOR */
+    int     invert;         /* Invert the results */
+    int     num;            /* Number of operands of each gate */
+    int     width;          /* Number of gates, 1 ... 64 */
+    int     word;           /* Word of the outputs, bit i of gate i */
+    int     first;          /* First operand word in the source list */
+} Logic_Chunk_t;
+
+typedef struct {
+    int         sig;        /* Bit of gate 0 if consecutive, else -1 */
+    int         first;      /* Else the first bit in the gather list */
+    uint64_t    invert;     /* Bits of the inverted operands */
+} Logic_Source_t;
+
+typedef struct {
+    int             num_in;         /* Input ports, bits 0 ... num_in-1 */
+    int             num_out;        /* Output ports */
+    int             num_chunks;     /* Chunks, in level order */
+    Logic_Chunk_t   *chunk;
+    Logic_Source_t  *source;        /* Operand words of the chunks */
+    int             *gather;        /* Bits of the operands not consecutive */
+    int             *out_bit;       /* Bit of each output */
+    int             *out_level;     /* Level of each output */
+    uint64_t        *one;           /* Bit plane of the ONE values */
+    uint64_t        *zero;          /* Bit plane of the ZERO values */
+} Logic_Program_t;
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+static Logic_Program_t *logic_compile(const char *text,
+        int num_in, int num_out, char *errmsg, size_t errlen);
+
+static int logic_gate_cmp(const void *pa, const void *pb);
+
+static void logic_free(Logic_Program_t *prog);
+
+static void logic_run(Logic_Program_t *prog);
+
+
+
+static void
+logic_callback(ARGS, Mif_Callback_Reason_t reason)
+{
+    switch (reason) {
+        case MIF_CB_DESTROY: {
+            Logic_Program_t *prog = STATIC_VAR (locdata);
+            if (prog) {
+                logic_free(prog);
+                STATIC_VAR (locdata) = NULL;
+            }
+            break;
+        }
+    }
+}
+
+
+/*==============================================================================
+
+FUNCTION logic_compile()
+
+SUMMARY
+
+    Parses the program text, checks that every output and internal
+    signal is driven by exactly one gate and that there is no
+    combinational loop, and sorts the gates by level.  Returns NULL
+    with a message in errmsg if the program is not valid.
+
+==============================================================================*/
+
+static Logic_Program_t *
+logic_compile(const char *text, int num_in, int num_out,
+              char *errmsg, size_t errlen)
+{
+    Logic_Program_t *prog;
+    Logic_Gate_t    *gate = NULL;
+    int     *operand = NULL, *driver = NULL, *level = NULL,
+            *pending = NULL, *fanout = NULL, *fanout_first = NULL,
+            *queue = NULL, *bit;
+    int     num_gates = 0, max_gates = 0, num_ops = 0, max_ops = 0,
+            num_signals, num_words, num_sources, num_bits,
+            head, tail, i, j, k, s;
+    const char *p = text;
+    char    *end;
+
+    num_signals = num_in + num_out;
+
+    /* Parse the gates */
+    for (;;) {
+        static const struct {
+            const char *name;
+            int op, invert;
+        } ops[] = {
+            { "and", LOGIC_AND, 0 }, { "nand", LOGIC_AND, 1 },
+            { "or",  LOGIC_OR,  0 }, { "nor",  LOGIC_OR,  1 },
+            { "xor", LOGIC_XOR, 0 }, { "xnor", LOGIC_XOR, 1 },
+            { "buf", LOGIC_AND, 0 }, { "inv",  LOGIC_AND, 1 }
+        };
+        size_t len;
+
+        while (IS_SEP(*p))
+            p++;
+        if (*p == '\0')
+            break;
+
+        for (len = 0; isalpha((unsigned char) p[len]); len++)
+            ;
+        for (k = 0; k < (int) (sizeof(ops) / sizeof(ops[0])); k++)
+            if (strlen(ops[k].name) == len && strncmp(p, ops[k].name, len) == 0)
+                break;
+        if (len == 0 || k == (int) (sizeof(ops) / sizeof(ops[0]))) {
+            snprintf(errmsg, errlen, "unknown gate at '%.20s'", p);
+            goto error;
+        }
+        p += len;
+
+        if (num_gates == max_gates) {
+            max_gates = max_gates ? 2 * max_gates : 64;
+            gate = (Logic_Gate_t *) realloc(gate, (size_t) max_gates * sizeof(Logic_Gate_t));
+        }
+        gate[num_gates].op = ops[k].op;
+        gate[num_gates].invert = ops[k].invert;
+        gate[num_gates].first = num_ops;
+        gate[num_gates].num = -1;
+
+        /* The driven signal, then the operands */
+        for (;;) {
+            int invert = 0;
+            while (IS_SEP(*p))
+                p++;
+            /* The next gate begins with its operator */
+            if (*p == '\0' || isalpha((unsigned char) *p))
+                break;
+            if (*p == '~' || *p == '!') {
+                invert = 1;
+                p++;
+            }
+            s = (int) strtol(p, &end, 10);
+            if (end == p || s < 0) {
+                snprintf(errmsg, errlen, "bad signal at '%.20s'", p);
+                goto error;
+            }
+            p = end;
+            if (s >= num_signals)
+                num_signals = s + 1;
+
+            if (gate[num_gates].num < 0) {
+                if (invert || s < num_in) {
+                    snprintf(errmsg, errlen, "gate %d drives an input", num_gates + 1);
+                    goto error;
+                }
+                gate[num_gates].out = s;
+            }
+            else {
+                if (num_ops == max_ops) {
+                    max_ops = max_ops ? 2 * max_ops : 256;
+                    operand = (int *) realloc(operand, (size_t) max_ops * sizeof(int));
+                }
+                operand[num_ops++] = 2 * s + invert;
+            }
+            gate[num_gates].num++;
+        }
+        if (gate[num_gates].num < 1 ||
+                ((k == 6 || k == 7) && gate[num_gates].num != 1)) {
+            snprintf(errmsg, errlen, "gate %d has wrong operands", num_gates + 1);
+            goto error;
+        }
+        num_gates++;
+    }
+
+    /* Each signal other than an input has exactly one driver */
+    driver = (int *) malloc((size_t) num_signals * sizeof(int));
+    for (s = 0; s < num_signals; s++)
+        driver[s] = -1;
+    for (i = 0; i < num_gates; i++) {
+        if (driver[gate[i].out] >= 0) {
+            snprintf(errmsg, errlen, "signal %d has two drivers", gate[i].out);
+            goto error;
+        }
+        driver[gate[i].out] = i;
+    }
+    for (s = num_in; s < num_signals; s++) {
+        if (driver[s] < 0) {
+            snprintf(errmsg, errlen, "signal %d is not driven", s);
+            goto error;
+        }
+    }
+
+    /* Levelize.  The fanout of each gate is set up first, then the */
+    /* gates are taken in topological order and get one level more */
+    /* than the highest level of their operands. */
+    pending = (int *) calloc((size_t) num_gates + 1, sizeof(int));
+    fanout_first = (int *) calloc((size_t) num_gates + 1, sizeof(int));
+    fanout = (int *) malloc(((size_t) num_ops + 1) * sizeof(int));
+    queue = (int *) malloc(((size_t) num_gates + 1) * sizeof(int));
+    level = (int *) calloc((size_t) num_signals, sizeof(int));
+
+    for (i = 0; i < num_ops; i++) {
+        j = driver[operand[i] / 2];
+        if (j >= 0)
+            fanout_first[j]++;
+    }
+    for (j = 0, k = 0; j <= num_gates; j++) {
+        int n = fanout_first[j];
+        fanout_first[j] = k;
+        k += n;
+    }
+    for (i = 0; i < num_gates; i++) {
+        for (k = gate[i].first; k < gate[i].first + gate[i].num; k++) {
+            j = driver[operand[k] / 2];
+            if (j >= 0) {
+                fanout[fanout_first[j] + pending[j]] = i;
+                pending[j]++;
+            }
+        }
+    }
+    for (i = 0; i < num_gates; i++)
+        pending[i] = 0;
+    for (i = 0; i < num_gates; i++)
+        for (k = gate[i].first; k < gate[i].first + gate[i].num; k++)
+            if (driver[operand[k] / 2] >= 0)
+                pending[i]++;
+
+    head = tail = 0;
+    for (i = 0; i < num_gates; i++)
+        if (pending[i] == 0)
+            queue[tail++] = i;
+
+    while (head < tail) {
+        int lev = 0;
+        i = queue[head++];
+        for (k = gate[i].first; k < gate[i].first + gate[i].num; k++)
+            if (level[operand[k] / 2] > lev)
+                lev = level[operand[k] / 2];
+        level[gate[i].out] = lev + 1;
+        for (k = fanout_first[i]; k < fanout_first[i + 1]; k++)
+            if (--pending[fanout[k]] == 0)
+                queue[tail++] = fanout[k];
+    }
+    if (tail < num_gates) {
+        snprintf(errmsg, errlen, "combinational loop");
+        goto error;
+    }
+
+    /* Sort the gates by level, then by operator and fan-in, and */
+    /* put them into chunks.  The input bits come first, then the */
+    /* words of the chunks. */
+    for (i = 0; i < num_gates; i++)
+        gate[i].level = level[gate[i].out];
+    qsort(gate, (size_t) num_gates, sizeof(Logic_Gate_t), logic_gate_cmp);
+
+    prog = (Logic_Program_t *) calloc(1, sizeof(Logic_Program_t));
+    prog->num_in = num_in;
+    prog->num_out = num_out;
+    prog->chunk = (Logic_Chunk_t *) malloc(((size_t) num_gates + 1) * sizeof(Logic_Chunk_t));
+
+    bit = (int *) malloc((size_t) num_signals * sizeof(int));
+    for (s = 0; s < num_in; s++)
+        bit[s] = s;
+    num_words = SIG_WORD(num_in + 63);
+    num_sources = 0;
+    for (i = 0; i < num_gates; i = j) {
+        Logic_Chunk_t *ch = prog->chunk + prog->num_chunks++;
+        for (j = i + 1; j < num_gates && j - i < 64; j++)
+            if (logic_gate_cmp(gate + i, gate + j) != -2)
+                break;
+        ch->op = gate[i].op;
+        ch->invert = gate[i].invert;
+        ch->num = gate[i].num;
+        ch->width = j - i;
+        ch->word = num_words++;
+        ch->first = num_sources;
+        num_sources += ch->num;
+        for (k = i; k < j; k++)
+            bit[gate[k].out] = 64 * ch->word + (k - i);
+    }
+
+    /* The operand words, shifted out of the bit planes if the */
+    /* operands are consecutive bits */
+    prog->source = (Logic_Source_t *) malloc(((size_t) num_sources + 1) * sizeof(Logic_Source_t));
+    prog->gather = (int *) malloc(((size_t) num_ops + 1) * sizeof(int));
+    num_bits = 0;
+    for (i = 0, k = 0; k < prog->num_chunks; k++) {
+        Logic_Chunk_t *ch = prog->chunk + k;
+        Logic_Gate_t *g = gate + i;
+        for (j = 0; j < ch->num; j++) {
+            Logic_Source_t *src = prog->source + ch->first + j;
+            int b0 = bit[operand[g[0].first + j] >> 1], n;
+            src->sig = b0;
+            src->invert = 0;
+            for (n = 0; n < ch->width; n++) {
+                int op = operand[g[n].first + j];
+                if (bit[op >> 1] != b0 + n)
+                    src->sig = -1;
+                if (op & 1)
+                    src->invert |= (uint64_t) 1 << n;
+            }
+            src->first = num_bits;
+            if (src->sig < 0)
+                for (n = 0; n < ch->width; n++)
+                    prog->gather[num_bits++] = bit[operand[g[n].first + j] >> 1];
+        }
+        i += ch->width;
+    }
+
+    prog->out_bit = (int *) malloc(((size_t) num_out + 1) * sizeof(int));
+    prog->out_level = (int *) malloc(((size_t) num_out + 1) * sizeof(int));
+    for (k = 0; k < num_out; k++) {
+        prog->out_bit[k] = bit[num_in + k];
+        prog->out_level[k] = level[num_in + k];
+    }
+
+    prog->one = (uint64_t *) calloc((size_t) num_words + 1, sizeof(uint64_t));
+    prog->zero = (uint64_t *) calloc((size_t) num_words + 1, sizeof(uint64_t));
+
+    free(gate);
+    free(operand);
+    free(driver);
+    free(pending);
+    free(fanout_first);
+    free(fanout);
+    free(queue);
+    free(level);
+    free(bit);
+
+    return prog;
+
+error:
+    free(gate);
+    free(operand);
+    free(driver);
+    free(pending);
+    free(fanout_first);
+    free(fanout);
+    free(queue);
+    free(level);
+
+    return NULL;
+}
+
+
+/* Order of the gates: by level, operator, inversion and fan-in, then */
+/* as in the program.  -2 if a and b may be in the same chunk. */
+static int
+logic_gate_cmp(const void *pa, const void *pb)
+{
+    const Logic_Gate_t *a = (const Logic_Gate_t *) pa;
+    const Logic_Gate_t *b = (const Logic_Gate_t *) pb;
+
+    if (a->level != b->level)
+        return (a->level < b->level) ? -1 : 1;
+    if (a->op != b->op)
+        return (a->op < b->op) ? -1 : 1;
+    if (a->invert != b->invert)
+        return (a->invert < b->invert) ? -1 : 1;
+    if (a->num != b->num)
+        return (a->num < b->num) ? -1 : 1;
+    return (a->first < b->first) ? -2 : 1;
+}
+
+
+static void
+logic_free(Logic_Program_t *prog)
+{
+    free(prog->chunk);
+    free(prog->source);
+    free(prog->gather);
+    free(prog->out_bit);
+    free(prog->out_level);
+    free(prog->one);
+    free(prog->zero);
+    free(prog);
+}
+
+
+/*==============================================================================
+
+FUNCTION logic_run()
+
+SUMMARY
+
+    Evaluates the chunks in level order.  The input bits must be set
+    in the bit planes.  A gate has the value ONE or ZERO if this
+    follows from the known values of its operands, as for the d_and,
+    d_or and d_xor gates, and UNKNOWN otherwise:
+
+        and     ONE if all operands are ONE, ZERO if any is ZERO
+        or      ONE if any operand is ONE, ZERO if all are ZERO
+        xor     the parity if all operands are known
+
+==============================================================================*/
+
+static void
+logic_run(Logic_Program_t *prog)
+{
+    uint64_t        *one = prog->one, *zero = prog->zero;
+    Logic_Chunk_t   *ch, *last;
+
+    last = prog->chunk + prog->num_chunks;
+    for (ch = prog->chunk; ch < last; ch++) {
+
+        Logic_Source_t *src = prog->source + ch->first;
+        uint64_t r1, r0, b1, b0, t, mask;
+        int j, n;
+
+        r1 = (ch->op == LOGIC_OR) ? 0 : ~(uint64_t) 0;
+        r0 = (ch->op == LOGIC_AND) ? 0 : ~(uint64_t) 0;
+        if (ch->op == LOGIC_XOR)
+            r0 = 0;
+
+        for (j = 0; j < ch->num; j++, src++) {
+
+            if (src->sig >= 0) {
+                int w = SIG_WORD(src->sig), sh = SIG_SHIFT(src->sig);
+                b1 = one[w] >> sh;
+                b0 = zero[w] >> sh;
+                if (sh && sh + ch->width > 64) {
+                    b1 |= one[w + 1] << (64 - sh);
+                    b0 |= zero[w + 1] << (64 - sh);
+                }
+            }
+            else {
+                int *g = prog->gather + src->first;
+                b1 = b0 = 0;
+                for (n = 0; n < ch->width; n++) {
+                    b1 |= ((one[SIG_WORD(g[n])] >> SIG_SHIFT(g[n])) & 1) << n;
+                    b0 |= ((zero[SIG_WORD(g[n])] >> SIG_SHIFT(g[n])) & 1) << n;
+                }
+            }
+
+            /* swap ONE and ZERO of the inverted operands */
+            t = (b1 ^ b0) & src->invert;
+            b1 ^= t;
+            b0 ^= t;
+
+            switch (ch->op) {
+            case LOGIC_AND:
+                r1 &= b1;
+                r0 |= b0;
+                break;
+            case LOGIC_OR:
+                r1 |= b1;
+                r0 &= b0;
+                break;
+            default:
+                /* r1 is the set of known results, r0 the parity */
+                r1 &= b1 | b0;
+                r0 ^= b1;
+                break;
+            }
+        }
+
+        if (ch->op == LOGIC_XOR) {
+            t = r1;
+            r1 = t & r0;
+            r0 = t & ~r0;
+        }
+
+        if (ch->invert) {
+            t = r1;
+            r1 = r0;
+            r0 = t;
+        }
+
+        mask = (ch->width == 64) ? ~(uint64_t) 0 :
+            ((uint64_t) 1 << ch->width) - 1;
+        one[ch->word] = r1 & mask;
+        zero[ch->word] = r0 & mask;
+    }
+}
+
+
+/*==============================================================================
+
+FUNCTION cm_d_logic()
+
+AUTHORS
+
+    18 Oct 2026     ngspice developers
+
+SUMMARY
+
+    This function implements the d_logic code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+    CMutil.c             int cm_message_printf()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_D_LOGIC ROUTINE ===*/
+
+void cm_d_logic(ARGS)
+{
+    int         i,      /* generic loop counter index */
+                isize,  /* number of input ports */
+                osize;  /* number of output ports */
+
+    Digital_State_t *out,       /* outputs of the program */
+                    *out_old;   /* previous outputs */
+
+    double      level;          /* gates on the longest path to an output */
+
+    Logic_Program_t *prog;      /* compiled program */
+
+    isize = PORT_SIZE(in);
+    osize = PORT_SIZE(out);
+
+    /*** Setup required state variables ***/
+
+    if (INIT) {  /* initial pass */
+
+        char errmsg[128];
+
+        /* compile the program */
+        prog = logic_compile(PARAM(program), isize, osize,
+                             errmsg, sizeof(errmsg));
+        if (!prog)
+            cm_message_printf("d_logic program error: %s, outputs are unknown",
+                              errmsg);
+        STATIC_VAR (locdata) = prog;
+        CALLBACK = logic_callback;
+
+        /* allocate storage for the outputs */
+        cm_event_alloc(0, osize * (int) sizeof(Digital_State_t));
+
+        /* set loading for inputs */
+        for (i = 0; i < isize; i++)
+            LOAD(in[i]) = PARAM(input_load);
+
+        /* retrieve storage for the outputs */
+        out = out_old = (Digital_State_t *) cm_event_get_ptr(0, 0);
+    }
+    else {      /* Retrieve previous values */
+
+        /* retrieve the program */
+        prog = STATIC_VAR (locdata);
+
+        /* retrieve storage for the outputs */
+        out = (Digital_State_t *) cm_event_get_ptr(0, 0);
+        out_old = (Digital_State_t *) cm_event_get_ptr(0, 1);
+    }
+
+    /*** Calculate new output values by running the program ***/
+
+    if (prog) {
+        for (i = 0; i < isize; i++) {
+            uint64_t bit = (uint64_t) 1 << SIG_SHIFT(i);
+            prog->one[SIG_WORD(i)] &= ~bit;
+            prog->zero[SIG_WORD(i)] &= ~bit;
+            switch (INPUT_STATE(in[i])) {
+            case ONE:
+                prog->one[SIG_WORD(i)] |= bit;
+                break;
+            case ZERO:
+                prog->zero[SIG_WORD(i)] |= bit;
+                break;
+            default:
+                break;
+            }
+        }
+
+        logic_run(prog);
+
+        for (i = 0; i < osize; i++) {
+            int s = prog->out_bit[i];
+            if ((prog->one[SIG_WORD(s)] >> SIG_SHIFT(s)) & 1)
+                out[i] = ONE;
+            else if ((prog->zero[SIG_WORD(s)] >> SIG_SHIFT(s)) & 1)
+                out[i] = ZERO;
+            else
+                out[i] = UNKNOWN;
+        }
+    }
+    else {
+        for (i = 0; i < osize; i++)
+            out[i] = UNKNOWN;
+    }
+
+    /*** Determine analysis type and output appropriate values ***/
+
+    for (i = 0; i < osize; i++) {
+
+        level = prog ? prog->out_level[i] : 1.0;
+
+        if (ANALYSIS == DC) {   /** DC analysis...output w/o delays **/
+
+            OUTPUT_STATE(out[i]) = out[i];
+
+        }
+
+        else {      /** Transient Analysis **/
+
+            if (out[i] != out_old[i]) { /* output value is changing */
+
+                switch (out[i]) {
+
+                /* fall to zero value */
+                case ZERO:
+                    OUTPUT_STATE(out[i]) = ZERO;
+                    OUTPUT_DELAY(out[i]) = level * PARAM(fall_delay);
+                    break;
+
+                /* rise to one value */
+                case ONE:
+                    OUTPUT_STATE(out[i]) = ONE;
+                    OUTPUT_DELAY(out[i]) = level * PARAM(rise_delay);
+                    break;
+
+                /* unknown output */
+                default:
+                    OUTPUT_STATE(out[i]) = UNKNOWN;
+
+                    /* based on old value, add rise or fall delay */
+                    if (ZERO == out_old[i])
+                        OUTPUT_DELAY(out[i]) = level * PARAM(rise_delay);
+                    else
+                        OUTPUT_DELAY(out[i]) = level * PARAM(fall_delay);
+                    break;
+                }
+            }
+            else {                    /* output value not changing */
+                OUTPUT_CHANGED(out[i]) = FALSE;
+            }
+        }
+
+        OUTPUT_STRENGTH(out[i]) = STRONG;
+    }
+}
@@ -57,3 +57,7 @@ Mif_Info_t  g_mif_info = {
   { 0.0, 0.0,},
   { MIF_FALSE, MIF_FALSE,},
 };
+
+#ifdef USE_OMP
+Mif_Info_t  *g_mif_thread_info = NULL;
+#endif
@@ -8,6 +8,9 @@
 /* S parameter analysis */
 #define RFSPICE 1
 
+/* Harmonic balance analysis */
+#define WITH_HB 1
+
 /* Define if you want PSS analysis */
 #define WITH_PSS /**/
 